@@ -0,0 +1,709 @@
+#include "hiopLinAlgFactory.hpp"
+#include "hiopVector.hpp"
+#include "hiopVectorInt.hpp"
+#include "hiopMatrixDense.hpp"
+#include "hiopMatrixSparseTriplet.hpp"
+#include "hiopMatrixSparseCSRSeq.hpp"
+#include "hiopVectorPar.hpp"
+#include "hiopTimer.hpp"
+
+#ifdef HIOP_USE_RAJA
+#include "hiopMatrixRajaDense.hpp"
+#include "hiopMatrixRajaSparseTriplet.hpp"
+#endif
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstdio>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace hiop;
+
+/**
+ * Microbenchmark of the linear algebra kernels of HiOp.
+ *
+ * The driver times the kernels (virtual methods) of hiopVector, hiopMatrixDense, hiopMatrixSparseTriplet,
+ * hiopMatrixSymSparseTriplet, and hiopMatrixSparseCSRSeq over a sweep of sizes, for each memory space
+ * (implementation) reachable from LinearAlgebraFactory in the current build. For each kernel the average
+ * wall-clock time per call is reported together with the effective memory bandwidth (GB/s) and the
+ * floating point throughput (GFLOP/s). The byte and flop counts are the nominal (minimum) traffic and
+ * operation counts of each kernel, hence the reported rates are a lower bound of the achieved rates.
+ *
+ * Usage: hpc_linalg_benchmark.exe [max_size] [min_time_per_kernel]
+ *   - max_size: largest (global) vector length in the sweep; dense matrices are square of dimension
+ *     sqrt(size) and sparse matrices have approximately 'size' nonzeros (default 4194304)
+ *   - min_time_per_kernel: minimum time in seconds each kernel is repeatedly run for (default 0.05)
+ *
+ * Kernels that are not implemented by a given class (i.e., assert in the implementation) are not timed.
+ *
+ * The driver can be run with multiple MPI ranks, in which case the vectors are distributed. Only the
+ * master rank prints; the reported times and rates are for the master rank.
+ */
+
+static const size_type default_max_size = 4194304;
+static const size_type min_size = 1024;
+static const size_type size_multiplier = 4;
+static const double default_min_time = 0.05;
+static const int max_repetitions = 100000;
+
+/// entries per row of the sparse matrices used in the benchmark
+static const int sparse_entries_per_row = 5;
+/// max dimension of the dense matrices that are outputs of sparse kernels
+static const size_type max_sparse_to_dense_dim = 2048;
+
+class hiopLinAlgBenchmark
+{
+public:
+  hiopLinAlgBenchmark(const std::string& mem_space, double min_time, MPI_Comm comm)
+    : mem_space_(mem_space),
+      min_time_(min_time),
+      comm_(comm),
+      my_rank_(0),
+      num_ranks_(1)
+  {
+#ifdef HIOP_USE_MPI
+    int ierr = MPI_Comm_rank(comm_, &my_rank_); assert(MPI_SUCCESS==ierr);
+    ierr = MPI_Comm_size(comm_, &num_ranks_); assert(MPI_SUCCESS==ierr);
+#endif
+  }
+
+  void print_header() const
+  {
+    if(my_rank_ == 0) {
+      printf("\n%-26s %-8s %-46s %12s %10s %12s %10s %10s\n",
+             "class", "memspace", "kernel", "size", "nnz", "usec/call", "GB/s", "GFLOP/s");
+    }
+  }
+
+  /**
+   * Times 'kernel' by repeating it until at least 'min_time_' seconds elapsed. 'bytes' and 'flops' are
+   * the nominal memory traffic and flops of one call and are used to compute the rates.
+   *
+   * 'reset' is called before each repetition, outside of the timed region, to restore the operands
+   * modified by 'kernel'.
+   */
+  template<class KERNEL, class RESET>
+  void time_kernel(const char* class_name,
+                   const char* kernel_name,
+                   size_type size,
+                   size_type nnz,
+                   double bytes,
+                   double flops,
+                   KERNEL kernel,
+                   RESET reset)
+  {
+    //warm-up (first touch, lazy allocations, etc)
+    reset();
+    kernel();
+
+    hiopTimer t;
+    int reps = 0;
+    double elapsed = 0.;
+    while(elapsed < min_time_ && reps < max_repetitions) {
+      reset();
+      t.start();
+      kernel();
+      t.stop();
+      reps++;
+      elapsed = t.getElapsedTime();
+    }
+
+    const double tm_call = elapsed/reps;
+    if(my_rank_ == 0) {
+      printf("%-26s %-8s %-46s %12lld %10lld %12.3f %10.3f %10.3f\n",
+             class_name,
+             mem_space_.c_str(),
+             kernel_name,
+             static_cast<long long>(size),
+             static_cast<long long>(nnz),
+             1e6*tm_call,
+             bytes/tm_call*1e-9,
+             flops/tm_call*1e-9);
+      fflush(stdout);
+    }
+  }
+
+  /// Times a kernel that does not need its operands to be restored between repetitions
+  template<class KERNEL>
+  void time_kernel(const char* class_name,
+                   const char* kernel_name,
+                   size_type size,
+                   size_type nnz,
+                   double bytes,
+                   double flops,
+                   KERNEL kernel)
+  {
+    time_kernel(class_name, kernel_name, size, nnz, bytes, flops, kernel, []() {});
+  }
+
+  void run_vector(size_type glob_n);
+  void run_matrix_dense(size_type n);
+  void run_matrix_sparse(size_type nnz);
+  void run_matrix_sym_sparse(size_type nnz);
+  void run_matrix_sparse_csr(size_type nnz);
+
+  bool is_default_mem_space() const
+  {
+    return mem_space_ == "DEFAULT";
+  }
+
+private:
+  /// Fills 'v' with values in [lo, lo+range) following a deterministic pattern
+  void fill_vector(hiopVector& v, double lo, double range) const;
+
+  /// Fills the entries of 'A' with values in [1, 2) following a deterministic pattern
+  void fill_dense(hiopMatrixDense& A) const;
+
+  /// Populates a banded sparsity pattern with 'sparse_entries_per_row' per row; upper triangle only if 'sym'
+  void fill_sparse(hiopMatrixSparse& A, bool sym) const;
+
+  /// Column partitioning used for distributed vectors
+  std::vector<index_type> col_partitioning(size_type glob_n) const;
+
+private:
+  std::string mem_space_;
+  double min_time_;
+  MPI_Comm comm_;
+  int my_rank_;
+  int num_ranks_;
+};
+
+std::vector<index_type> hiopLinAlgBenchmark::col_partitioning(size_type glob_n) const
+{
+  std::vector<index_type> cols(num_ranks_+1, 0);
+  for(int r=1; r<=num_ranks_; r++) {
+    cols[r] = cols[r-1] + glob_n/num_ranks_ + (r-1 < glob_n%num_ranks_ ? 1 : 0);
+  }
+  return cols;
+}
+
+void hiopLinAlgBenchmark::fill_vector(hiopVector& v, double lo, double range) const
+{
+  const size_type n_loc = v.get_local_size();
+  double* data = v.local_data_host();
+  for(index_type i=0; i<n_loc; i++) {
+    data[i] = lo + range*((i*7919)%1000)/1000.;
+  }
+  v.copyToDev();
+}
+
+void hiopLinAlgBenchmark::fill_dense(hiopMatrixDense& A) const
+{
+  double* data = A.local_data();
+#ifdef HIOP_USE_RAJA
+  hiopMatrixRajaDense* A_raja = dynamic_cast<hiopMatrixRajaDense*>(&A);
+  if(A_raja) {
+    data = A_raja->local_data_host();
+  }
+#endif
+  const size_type nnz = A.m()*A.get_local_size_n();
+  for(index_type i=0; i<nnz; i++) {
+    data[i] = 1. + ((i*7919)%1000)/1000.;
+  }
+#ifdef HIOP_USE_RAJA
+  if(A_raja) {
+    A_raja->copyToDev();
+  }
+#endif
+}
+
+void hiopLinAlgBenchmark::fill_sparse(hiopMatrixSparse& A, bool sym) const
+{
+  index_type* irow = A.i_row();
+  index_type* jcol = A.j_col();
+  double* vals = A.M();
+#ifdef HIOP_USE_RAJA
+  hiopMatrixRajaSparseTriplet* A_raja = dynamic_cast<hiopMatrixRajaSparseTriplet*>(&A);
+  if(A_raja) {
+    irow = A_raja->i_row_host();
+    jcol = A_raja->j_col_host();
+    vals = A_raja->M_host();
+  }
+#endif
+  const size_type m = A.m();
+  const size_type n = A.n();
+  const size_type nnz = A.numberOfNonzeros();
+  assert(nnz == m*sparse_entries_per_row);
+
+  index_type itnz = 0;
+  for(index_type i=0; i<m; i++) {
+    //for symmetric matrices the band is only to the right of the diagonal to keep the entries in the
+    //upper triangle; the entries that would fall outside the matrix in the last rows are put on the
+    //diagonal (duplicates are allowed in the triplet format)
+    index_type cols[sparse_entries_per_row];
+    for(int k=0; k<sparse_entries_per_row; k++) {
+      if(sym) {
+        cols[k] = i+k<n ? i+k : i;
+      } else {
+        cols[k] = (i+k*(n/sparse_entries_per_row)) % n;
+      }
+    }
+    //ordered column indexes within each row are needed by the CSR kernels
+    std::sort(cols, cols+sparse_entries_per_row);
+    for(int k=0; k<sparse_entries_per_row; k++) {
+      irow[itnz] = i;
+      jcol[itnz] = cols[k];
+      vals[itnz] = 1. + (itnz%13)/13.;
+      itnz++;
+    }
+  }
+  assert(itnz == nnz);
+#ifdef HIOP_USE_RAJA
+  if(A_raja) {
+    A_raja->copyToDev();
+  }
+#endif
+}
+
+void hiopLinAlgBenchmark::run_vector(size_type glob_n)
+{
+  std::vector<index_type> cols = col_partitioning(glob_n);
+  index_type* col_part = num_ranks_>1 ? cols.data() : nullptr;
+
+  hiopVector* x = LinearAlgebraFactory::create_vector(mem_space_, glob_n, col_part, comm_);
+  hiopVector* y = x->alloc_clone();
+  hiopVector* z = x->alloc_clone();
+  hiopVector* w = x->alloc_clone();
+  hiopVector* pattern = x->alloc_clone();
+
+  fill_vector(*x, 1., 1.);
+  fill_vector(*y, 2., 1.);
+  fill_vector(*z, 0.5, 1.);
+  w->setToZero();
+  pattern->setToConstant(1.);
+
+  const size_type n_loc = x->get_local_size();
+  const double n = static_cast<double>(n_loc);
+  const double d = sizeof(double);
+
+  hiopVectorInt* idxs = LinearAlgebraFactory::create_vector_int(mem_space_, n_loc);
+  {
+    index_type* idxs_host = idxs->local_data_host();
+    for(index_type i=0; i<n_loc; i++) {
+      idxs_host[i] = (i*7919)%n_loc;
+    }
+    idxs->copy_to_dev();
+  }
+
+  const char* cn = "hiopVector";
+  time_kernel(cn, "setToZero", glob_n, 0, d*n, 0., [&]() { w->setToZero(); });
+  time_kernel(cn, "setToConstant", glob_n, 0, d*n, 0., [&]() { w->setToConstant(1.5); });
+  time_kernel(cn, "setToConstant_w_patternSelect", glob_n, 0, 2*d*n, 0.,
+              [&]() { w->setToConstant_w_patternSelect(1.5, *pattern); });
+  time_kernel(cn, "copyFrom", glob_n, 0, 2*d*n, 0., [&]() { w->copyFrom(*x); });
+  time_kernel(cn, "copyFromStarting", glob_n, 0, 2*d*n, 0., [&]() { w->copyFromStarting(0, *x); });
+  time_kernel(cn, "copy_from_indexes", glob_n, 0, 2*d*n+sizeof(index_type)*n, 0.,
+              [&]() { w->copy_from_indexes(*x, *idxs); });
+  time_kernel(cn, "startingAtCopyFromStartingAt", glob_n, 0, 2*d*n, 0.,
+              [&]() { w->startingAtCopyFromStartingAt(0, *x, 0); });
+  time_kernel(cn, "copyToStarting", glob_n, 0, 2*d*n, 0., [&]() { x->copyToStarting(*w, 0); });
+  time_kernel(cn, "copyToStartingAt_w_pattern", glob_n, 0, 3*d*n, 0.,
+              [&]() { x->copyToStartingAt_w_pattern(*w, 0, *pattern); });
+  time_kernel(cn, "startingAtCopyToStartingAt", glob_n, 0, 2*d*n, 0.,
+              [&]() { x->startingAtCopyToStartingAt(0, *w, 0); });
+  time_kernel(cn, "twonorm", glob_n, 0, d*n, 2*n, [&]() { x->twonorm(); });
+  time_kernel(cn, "infnorm", glob_n, 0, d*n, n, [&]() { x->infnorm(); });
+  time_kernel(cn, "infnorm_local", glob_n, 0, d*n, n, [&]() { x->infnorm_local(); });
+  time_kernel(cn, "onenorm", glob_n, 0, d*n, n, [&]() { x->onenorm(); });
+  time_kernel(cn, "onenorm_local", glob_n, 0, d*n, n, [&]() { x->onenorm_local(); });
+  //the kernels below modify 'w', whose values are reset before each repetition to avoid under/overflows
+  auto reset_w = [&]() { w->copyFrom(*x); };
+  auto reset_w_y = [&]() { w->copyFrom(*y); };
+  time_kernel(cn, "componentMult", glob_n, 0, 3*d*n, n, [&]() { w->componentMult(*z); }, reset_w);
+  time_kernel(cn, "componentDiv", glob_n, 0, 3*d*n, n, [&]() { w->componentDiv(*z); }, reset_w);
+  time_kernel(cn, "componentDiv_w_selectPattern", glob_n, 0, 4*d*n, n,
+              [&]() { w->componentDiv_w_selectPattern(*z, *pattern); }, reset_w);
+  time_kernel(cn, "component_min(const)", glob_n, 0, 2*d*n, n, [&]() { w->component_min(1.5); }, reset_w);
+  time_kernel(cn, "component_min(vec)", glob_n, 0, 3*d*n, n, [&]() { w->component_min(*y); }, reset_w);
+  time_kernel(cn, "component_max(const)", glob_n, 0, 2*d*n, n, [&]() { w->component_max(1.5); }, reset_w);
+  time_kernel(cn, "component_max(vec)", glob_n, 0, 3*d*n, n, [&]() { w->component_max(*x); }, reset_w);
+  time_kernel(cn, "component_abs", glob_n, 0, 2*d*n, n, [&]() { w->component_abs(); }, reset_w);
+  time_kernel(cn, "component_sgn", glob_n, 0, 2*d*n, n, [&]() { w->component_sgn(); }, reset_w);
+  time_kernel(cn, "component_sqrt", glob_n, 0, 2*d*n, n, [&]() { w->component_sqrt(); }, reset_w);
+  time_kernel(cn, "scale", glob_n, 0, 2*d*n, n, [&]() { w->scale(-1.); }, reset_w);
+  time_kernel(cn, "axpy", glob_n, 0, 3*d*n, 2*n, [&]() { w->axpy(1e-8, *x); }, reset_w);
+  time_kernel(cn, "axpy(indexes)", glob_n, 0, 3*d*n+sizeof(index_type)*n, 2*n,
+              [&]() { w->axpy(1e-8, *x, *idxs); }, reset_w);
+  time_kernel(cn, "axzpy", glob_n, 0, 4*d*n, 3*n, [&]() { w->axzpy(1e-8, *x, *z); }, reset_w);
+  time_kernel(cn, "axdzpy", glob_n, 0, 4*d*n, 3*n, [&]() { w->axdzpy(1e-8, *x, *z); }, reset_w);
+  time_kernel(cn, "axdzpy_w_pattern", glob_n, 0, 5*d*n, 3*n,
+              [&]() { w->axdzpy_w_pattern(1e-8, *x, *z, *pattern); }, reset_w);
+  time_kernel(cn, "addConstant", glob_n, 0, 2*d*n, n, [&]() { w->addConstant(1e-8); }, reset_w);
+  time_kernel(cn, "addConstant_w_patternSelect", glob_n, 0, 3*d*n, n,
+              [&]() { w->addConstant_w_patternSelect(1e-8, *pattern); }, reset_w);
+  time_kernel(cn, "dotProductWith", glob_n, 0, 2*d*n, 2*n, [&]() { x->dotProductWith(*y); });
+  time_kernel(cn, "negate", glob_n, 0, 2*d*n, n, [&]() { w->negate(); }, reset_w);
+  time_kernel(cn, "invert", glob_n, 0, 2*d*n, n, [&]() { w->invert(); }, reset_w);
+  time_kernel(cn, "logBarrier_local", glob_n, 0, 2*d*n, 2*n, [&]() { x->logBarrier_local(*pattern); });
+  time_kernel(cn, "addLogBarrierGrad", glob_n, 0, 4*d*n, 2*n,
+              [&]() { w->addLogBarrierGrad(1e-8, *x, *pattern); }, reset_w);
+  time_kernel(cn, "sum_local", glob_n, 0, d*n, n, [&]() { x->sum_local(); });
+  time_kernel(cn, "linearDampingTerm_local", glob_n, 0, 3*d*n, 2*n,
+              [&]() { x->linearDampingTerm_local(*pattern, *z, 1e-5, 1e-8); });
+  time_kernel(cn, "addLinearDampingTerm", glob_n, 0, 4*d*n, 2*n,
+              [&]() { w->addLinearDampingTerm(*pattern, *z, 1e-5, 1e-8); }, reset_w);
+  time_kernel(cn, "allPositive", glob_n, 0, d*n, n, [&]() { x->allPositive(); });
+  time_kernel(cn, "allPositive_w_patternSelect", glob_n, 0, 2*d*n, n,
+              [&]() { x->allPositive_w_patternSelect(*pattern); });
+  time_kernel(cn, "min", glob_n, 0, d*n, n, [&]() { x->min(); });
+  time_kernel(cn, "min_w_pattern", glob_n, 0, 2*d*n, n, [&]() { x->min_w_pattern(*pattern); });
+  time_kernel(cn, "projectIntoBounds_local", glob_n, 0, 6*d*n, 6*n,
+              [&]() { w->projectIntoBounds_local(*x, *pattern, *z, *pattern, 1e-2, 1e-2); }, reset_w_y);
+  time_kernel(cn, "fractionToTheBdry_local", glob_n, 0, 2*d*n, 3*n,
+              [&]() { x->fractionToTheBdry_local(*z, 0.99); });
+  time_kernel(cn, "fractionToTheBdry_w_pattern_local", glob_n, 0, 3*d*n, 3*n,
+              [&]() { x->fractionToTheBdry_w_pattern_local(*z, 0.99, *pattern); });
+  time_kernel(cn, "selectPattern", glob_n, 0, 3*d*n, 0., [&]() { w->selectPattern(*pattern); }, reset_w);
+  time_kernel(cn, "matchesPattern", glob_n, 0, 2*d*n, 0., [&]() { x->matchesPattern(*pattern); });
+  time_kernel(cn, "adjustDuals_plh", glob_n, 0, 4*d*n, 6*n,
+              [&]() { w->adjustDuals_plh(*x, *pattern, 1e-2, 1e10); }, reset_w_y);
+  time_kernel(cn, "isnan_local", glob_n, 0, d*n, 0., [&]() { x->isnan_local(); });
+  time_kernel(cn, "isinf_local", glob_n, 0, d*n, 0., [&]() { x->isinf_local(); });
+  time_kernel(cn, "isfinite_local", glob_n, 0, d*n, 0., [&]() { x->isfinite_local(); });
+  time_kernel(cn, "numOfElemsLessThan", glob_n, 0, d*n, n, [&]() { x->numOfElemsLessThan(1.5); });
+  time_kernel(cn, "numOfElemsAbsLessThan", glob_n, 0, d*n, n, [&]() { x->numOfElemsAbsLessThan(1.5); });
+  time_kernel(cn, "alloc_clone+delete", glob_n, 0, 0., 0., [&]() { delete x->alloc_clone(); });
+  time_kernel(cn, "new_copy+delete", glob_n, 0, 2*d*n, 0., [&]() { delete x->new_copy(); });
+
+  delete idxs;
+  delete pattern;
+  delete w;
+  delete z;
+  delete y;
+  delete x;
+}
+
+void hiopLinAlgBenchmark::run_matrix_dense(size_type n)
+{
+  //square, local matrices
+  hiopMatrixDense* A = LinearAlgebraFactory::create_matrix_dense(mem_space_, n, n, nullptr, MPI_COMM_SELF, 2*n);
+  hiopMatrixDense* B = A->alloc_clone();
+  hiopMatrixDense* W = A->alloc_clone();
+  hiopVector* x = LinearAlgebraFactory::create_vector(mem_space_, n);
+  hiopVector* y = x->alloc_clone();
+
+  fill_vector(*x, 1., 1.);
+  fill_vector(*y, 1., 1.);
+  fill_dense(*A);
+  B->copyFrom(*A);
+  W->setToZero();
+
+  const double dn = static_cast<double>(n);
+  const double nn = dn*dn;
+  const double d = sizeof(double);
+  std::vector<index_type> rows_idxs(n/2);
+  for(index_type i=0; i<n/2; i++) {
+    rows_idxs[i] = 2*i;
+  }
+
+  const char* cn = "hiopMatrixDense";
+  time_kernel(cn, "setToZero", n, 0, d*nn, 0., [&]() { W->setToZero(); });
+  time_kernel(cn, "setToConstant", n, 0, d*nn, 0., [&]() { W->setToConstant(1.); });
+  time_kernel(cn, "copyFrom", n, 0, 2*d*nn, 0., [&]() { W->copyFrom(*A); });
+  time_kernel(cn, "timesVec", n, 0, d*(nn+3*dn), 2*nn, [&]() { A->timesVec(0.5, *y, 1e-3, *x); });
+  time_kernel(cn, "transTimesVec", n, 0, d*(nn+3*dn), 2*nn, [&]() { A->transTimesVec(0.5, *y, 1e-3, *x); });
+  time_kernel(cn, "timesMat", n, 0, 4*d*nn, 2*nn*dn, [&]() { A->timesMat(0., *W, 1., *B); });
+  time_kernel(cn, "timesMat_local", n, 0, 4*d*nn, 2*nn*dn, [&]() { A->timesMat_local(0., *W, 1., *B); });
+  time_kernel(cn, "transTimesMat", n, 0, 4*d*nn, 2*nn*dn, [&]() { A->transTimesMat(0., *W, 1., *B); });
+  time_kernel(cn, "timesMatTrans", n, 0, 4*d*nn, 2*nn*dn, [&]() { A->timesMatTrans(0., *W, 1., *B); });
+  time_kernel(cn, "timesMatTrans_local", n, 0, 4*d*nn, 2*nn*dn,
+              [&]() { A->timesMatTrans_local(0., *W, 1., *B); });
+  time_kernel(cn, "addDiagonal(vec)", n, 0, 3*d*dn, 2*dn, [&]() { W->addDiagonal(1e-8, *x); });
+  time_kernel(cn, "addDiagonal(const)", n, 0, 2*d*dn, dn, [&]() { W->addDiagonal(1e-8); });
+  time_kernel(cn, "addSubDiagonal", n, 0, 3*d*dn, 2*dn, [&]() { W->addSubDiagonal(1e-8, 0, *x); });
+  time_kernel(cn, "addMatrix", n, 0, 3*d*nn, 2*nn, [&]() { W->addMatrix(1e-8, *A); });
+  {
+    //the transpose of 'A' is added in the upper right block of a 2n x 2n matrix
+    hiopMatrixDense* W2 = LinearAlgebraFactory::create_matrix_dense(mem_space_, 2*n, 2*n);
+    W2->setToZero();
+    time_kernel(cn, "transAddToSymDenseMatrixUpperTriangle", n, 0, 3*d*nn, 2*nn,
+                [&]() { A->transAddToSymDenseMatrixUpperTriangle(0, n, 1e-8, *W2); });
+    delete W2;
+  }
+  time_kernel(cn, "addUpperTriangleToSymDenseMatrixUpperTriangle", n, 0, 1.5*d*nn, nn,
+              [&]() { A->addUpperTriangleToSymDenseMatrixUpperTriangle(0, 1e-8, *W); });
+  {
+    hiopMatrixDense* W_half = LinearAlgebraFactory::create_matrix_dense(mem_space_, n/2, n);
+    time_kernel(cn, "copyRowsFrom(indexes)", n, 0, d*nn, 0.,
+                [&]() { W_half->copyRowsFrom(*A, rows_idxs.data(), n/2); });
+    time_kernel(cn, "copyBlockFromMatrix", n, 0, d*nn, 0.,
+                [&]() { W->copyBlockFromMatrix(n/2, 0, *W_half); });
+    delete W_half;
+  }
+  time_kernel(cn, "shiftRows", n, 0, 2*d*nn, 0., [&]() { W->shiftRows(1); });
+  time_kernel(cn, "replaceRow", n, 0, 2*d*dn, 0., [&]() { W->replaceRow(n/2, *x); });
+  time_kernel(cn, "getRow", n, 0, 2*d*dn, 0., [&]() { W->getRow(n/2, *y); });
+#ifdef HIOP_DEEPCHECKS
+  time_kernel(cn, "overwriteUpperTriangleWithLower", n, 0, d*nn, 0.,
+              [&]() { W->overwriteUpperTriangleWithLower(); });
+  time_kernel(cn, "overwriteLowerTriangleWithUpper", n, 0, d*nn, 0.,
+              [&]() { W->overwriteLowerTriangleWithUpper(); });
+#endif
+  time_kernel(cn, "max_abs_value", n, 0, d*nn, nn, [&]() { A->max_abs_value(); });
+  time_kernel(cn, "row_max_abs_value", n, 0, d*(nn+dn), nn, [&]() { A->row_max_abs_value(*y); });
+  W->copyFrom(*A);
+  time_kernel(cn, "scale_row", n, 0, d*(2*nn+dn), nn, [&]() { W->scale_row(*x, false); W->scale_row(*x, true); });
+  time_kernel(cn, "isfinite", n, 0, d*nn, 0., [&]() { A->isfinite(); });
+  time_kernel(cn, "new_copy+delete", n, 0, 2*d*nn, 0., [&]() { delete A->new_copy(); });
+
+  delete y;
+  delete x;
+  delete W;
+  delete B;
+  delete A;
+}
+
+void hiopLinAlgBenchmark::run_matrix_sparse(size_type nnz)
+{
+  const size_type m = nnz/sparse_entries_per_row;
+  nnz = m*sparse_entries_per_row;
+
+  hiopMatrixSparse* A = LinearAlgebraFactory::create_matrix_sparse(mem_space_, m, m, nnz);
+  fill_sparse(*A, false);
+  hiopMatrixSparse* B = A->new_copy();
+  hiopVector* x = LinearAlgebraFactory::create_vector(mem_space_, m);
+  hiopVector* y = x->alloc_clone();
+  fill_vector(*x, 1., 1.);
+  fill_vector(*y, 1., 1.);
+
+  const double dnnz = static_cast<double>(nnz);
+  const double dm = static_cast<double>(m);
+  const double d = sizeof(double);
+  const double ti = sizeof(index_type);
+  //nonzero entry: value, row, and column indexes
+  const double bytes_nnz = d + 2*ti;
+
+  const char* cn = "hiopMatrixSparseTriplet";
+  time_kernel(cn, "setToZero", m, nnz, d*dnnz, 0., [&]() { B->setToZero(); });
+  time_kernel(cn, "setToConstant", m, nnz, d*dnnz, 0., [&]() { B->setToConstant(1.); });
+  time_kernel(cn, "timesVec", m, nnz, bytes_nnz*dnnz+3*d*dm, 2*dnnz, [&]() { A->timesVec(0.5, *y, 1e-3, *x); });
+  time_kernel(cn, "transTimesVec", m, nnz, bytes_nnz*dnnz+3*d*dm, 2*dnnz,
+              [&]() { A->transTimesVec(0.5, *y, 1e-3, *x); });
+  time_kernel(cn, "max_abs_value", m, nnz, d*dnnz, dnnz, [&]() { A->max_abs_value(); });
+  time_kernel(cn, "row_max_abs_value", m, nnz, (d+ti)*dnnz+d*dm, dnnz, [&]() { A->row_max_abs_value(*y); });
+  time_kernel(cn, "scale_row", m, nnz, (2*d+ti)*dnnz+d*dm, dnnz,
+              [&]() { B->scale_row(*x, false); B->scale_row(*x, true); });
+  time_kernel(cn, "isfinite", m, nnz, d*dnnz, 0., [&]() { A->isfinite(); });
+  time_kernel(cn, "copySubDiagonalFrom", m, nnz, 2*d*dm, dm,
+              [&]() { B->copySubDiagonalFrom(0, m, *x, nnz-m); });
+  time_kernel(cn, "setSubDiagonalTo", m, nnz, d*dm, 0., [&]() { B->setSubDiagonalTo(0, m, 1., nnz-m); });
+  fill_sparse(*B, false);
+  time_kernel(cn, "copyRowsBlockFrom", m, nnz, 2*bytes_nnz*dnnz, 0.,
+              [&]() { B->copyRowsBlockFrom(*A, 0, m, 0, 0); });
+  time_kernel(cn, "new_copy+delete", m, nnz, 2*bytes_nnz*dnnz, 0., [&]() { delete A->new_copy(); });
+
+  //kernels with dense outputs are benchmarked only for matrices of moderate size
+  if(m <= max_sparse_to_dense_dim) {
+    hiopMatrixDense* W = LinearAlgebraFactory::create_matrix_dense(mem_space_, 2*m, 2*m);
+    W->setToZero();
+    const double flops_MMt = 2.*dnnz*sparse_entries_per_row;
+
+    hiopMatrixDense* W_mxm = LinearAlgebraFactory::create_matrix_dense(mem_space_, m, m);
+    time_kernel(cn, "timesMatTrans", m, nnz, 2*bytes_nnz*dnnz+d*dm*dm, flops_MMt,
+                [&]() { A->timesMatTrans(0., *W_mxm, 1., *B); });
+    time_kernel(cn, "copy_to(dense)", m, nnz, bytes_nnz*dnnz+d*dm*dm, 0.,
+                [&]() { A->copy_to(*W_mxm); });
+    delete W_mxm;
+    time_kernel(cn, "transAddToSymDenseMatrixUpperTriangle", m, nnz, bytes_nnz*dnnz+d*dnnz, dnnz,
+                [&]() { A->transAddToSymDenseMatrixUpperTriangle(0, m, 1e-8, *W); });
+    time_kernel(cn, "addMDinvMtransToDiagBlockOfSymDeMatUTri", m, nnz, bytes_nnz*dnnz+d*dm*dm/2, flops_MMt,
+                [&]() { A->addMDinvMtransToDiagBlockOfSymDeMatUTri(0, 1e-8, *x, *W); });
+    time_kernel(cn, "addMDinvNtransToSymDeMatUTri", m, nnz, 2*bytes_nnz*dnnz+d*dm*dm, flops_MMt,
+                [&]() { A->addMDinvNtransToSymDeMatUTri(0, m, 1e-8, *x, *B, *W); });
+    delete W;
+  }
+
+  delete y;
+  delete x;
+  delete B;
+  delete A;
+}
+
+void hiopLinAlgBenchmark::run_matrix_sym_sparse(size_type nnz)
+{
+  const size_type m = nnz/sparse_entries_per_row;
+  nnz = m*sparse_entries_per_row;
+
+  hiopMatrixSparse* A = LinearAlgebraFactory::create_matrix_sym_sparse(mem_space_, m, nnz);
+  fill_sparse(*A, true);
+  hiopVector* x = LinearAlgebraFactory::create_vector(mem_space_, m);
+  hiopVector* y = x->alloc_clone();
+  fill_vector(*x, 1., 1.);
+  fill_vector(*y, 1., 1.);
+
+  const double dnnz = static_cast<double>(nnz);
+  const double dm = static_cast<double>(m);
+  const double d = sizeof(double);
+  const double ti = sizeof(index_type);
+  const double bytes_nnz = d + 2*ti;
+
+  const char* cn = "hiopMatrixSymSparseTriplet";
+  time_kernel(cn, "timesVec", m, nnz, bytes_nnz*dnnz+3*d*dm, 4*dnnz, [&]() { A->timesVec(0.5, *y, 1e-3, *x); });
+  time_kernel(cn, "max_abs_value", m, nnz, d*dnnz, dnnz, [&]() { A->max_abs_value(); });
+  time_kernel(cn, "isfinite", m, nnz, d*dnnz, 0., [&]() { A->isfinite(); });
+  time_kernel(cn, "startingAtAddSubDiagonalToStartingAt", m, nnz, 2*ti*dnnz+2*d*dm, 2*dm,
+              [&]() { A->startingAtAddSubDiagonalToStartingAt(0, 1e-8, *y, 0); });
+  time_kernel(cn, "new_copy+delete", m, nnz, 2*bytes_nnz*dnnz, 0., [&]() { delete A->new_copy(); });
+
+  if(m <= max_sparse_to_dense_dim) {
+    hiopMatrixDense* W = LinearAlgebraFactory::create_matrix_dense(mem_space_, m, m);
+    W->setToZero();
+    time_kernel(cn, "addUpperTriangleToSymDenseMatrixUpperTriangle", m, nnz, bytes_nnz*dnnz+d*dnnz, 2*dnnz,
+                [&]() { A->addUpperTriangleToSymDenseMatrixUpperTriangle(0, 1e-8, *W); });
+    delete W;
+  }
+
+  delete y;
+  delete x;
+  delete A;
+}
+
+void hiopLinAlgBenchmark::run_matrix_sparse_csr(size_type nnz)
+{
+  //only the sequential (host) CSR implementation is available
+  assert(is_default_mem_space());
+  const size_type m = nnz/sparse_entries_per_row;
+  nnz = m*sparse_entries_per_row;
+
+  hiopMatrixSparseTriplet A_trip(m, m, nnz);
+  fill_sparse(A_trip, false);
+  hiopVectorPar D(m);
+  fill_vector(D, 1., 1.);
+
+  const double dnnz = static_cast<double>(nnz);
+  const double dm = static_cast<double>(m);
+  const double d = sizeof(double);
+  const double ti = sizeof(index_type);
+  //triplet entry (value, row and column index) and CSR entry (value and column index)
+  const double bytes_trip = d + 2*ti;
+  const double bytes_csr = d + ti;
+
+  hiopMatrixSparseCSRSeq A;
+  hiopMatrixSparseCSRSeq At;
+  const char* cn = "hiopMatrixSparseCSRSeq";
+  time_kernel(cn, "form_from_symbolic", m, nnz, (bytes_trip+bytes_csr)*dnnz, 0.,
+              [&]() { A.form_from_symbolic(A_trip); });
+  time_kernel(cn, "form_from_numeric", m, nnz, 2*d*dnnz, 0., [&]() { A.form_from_numeric(A_trip); });
+  //the symbolic transpose can be done only once per CSR object, so the allocation is timed as well
+  time_kernel(cn, "form_transpose_from_symbolic+alloc", m, nnz, (bytes_trip+bytes_csr)*dnnz, 0.,
+              [&]() { hiopMatrixSparseCSRSeq T; T.form_transpose_from_symbolic(A_trip); });
+  At.form_transpose_from_symbolic(A_trip);
+  time_kernel(cn, "form_transpose_from_numeric", m, nnz, (bytes_trip+d)*dnnz, 0.,
+              [&]() { At.form_transpose_from_numeric(A_trip); });
+  time_kernel(cn, "setToZero", m, nnz, d*dnnz, 0., [&]() { At.setToZero(); });
+  time_kernel(cn, "setToConstant", m, nnz, d*dnnz, 0., [&]() { At.setToConstant(1.); });
+  time_kernel(cn, "max_abs_value", m, nnz, d*dnnz, dnnz, [&]() { A.max_abs_value(); });
+  time_kernel(cn, "isfinite", m, nnz, d*dnnz, 0., [&]() { A.isfinite(); });
+  //the scalings compound over the repetitions, so the values are reset before each of them
+  auto reset_At = [&]() { At.setToConstant(1.); };
+  time_kernel(cn, "scale_cols", m, nnz, (2*d+ti)*dnnz+d*dm, dnnz, [&]() { At.scale_cols(D); }, reset_At);
+  time_kernel(cn, "scale_rows", m, nnz, 2*d*dnnz+d*dm, dnnz, [&]() { At.scale_rows(D); }, reset_At);
+
+  hiopMatrixSparseCSRSeq Diag;
+  time_kernel(cn, "form_diag_from_symbolic", m, m, (ti+bytes_csr)*dm, 0., [&]() { Diag.form_diag_from_symbolic(D); });
+  time_kernel(cn, "form_diag_from_numeric", m, m, 2*d*dm, 0., [&]() { Diag.form_diag_from_numeric(D); });
+  time_kernel(cn, "set_diagonal", m, m, 2*d*dm, 0., [&]() { Diag.set_diagonal(1.); });
+
+  hiopMatrixSparseCSR* AAt = A.times_mat_alloc(At);
+  time_kernel(cn, "times_mat_alloc+delete", m, nnz, 2*bytes_csr*dnnz, 0.,
+              [&]() { delete A.times_mat_alloc(At); });
+  time_kernel(cn, "times_mat_symbolic", m, nnz, 2*bytes_csr*dnnz+bytes_csr*AAt->numberOfNonzeros(), 0.,
+              [&]() { A.times_mat_symbolic(*AAt, At); });
+  const double flops_AAt = 2.*dnnz*sparse_entries_per_row;
+  time_kernel(cn, "times_mat_numeric", m, nnz, 2*bytes_csr*dnnz+bytes_csr*AAt->numberOfNonzeros(), flops_AAt,
+              [&]() { A.times_mat_numeric(0., *AAt, 1., At); });
+
+  hiopMatrixSparseCSR* ApAt = A.add_matrix_alloc(At);
+  time_kernel(cn, "add_matrix_alloc+delete", m, nnz, 2*bytes_csr*dnnz, 0.,
+              [&]() { delete A.add_matrix_alloc(At); });
+  time_kernel(cn, "add_matrix_symbolic", m, nnz, 2*bytes_csr*dnnz+bytes_csr*ApAt->numberOfNonzeros(), 0.,
+              [&]() { A.add_matrix_symbolic(*ApAt, At); });
+  time_kernel(cn, "add_matrix_numeric", m, nnz, 2*bytes_csr*dnnz+bytes_csr*ApAt->numberOfNonzeros(), 2*dnnz,
+              [&]() { A.add_matrix_numeric(0., *ApAt, 1., At, 1.); });
+
+  delete ApAt;
+  delete AAt;
+}
+
+int main(int argc, char **argv)
+{
+  int my_rank = 0;
+#ifdef HIOP_USE_MPI
+  MPI_Init(&argc, &argv);
+  int ierr = MPI_Comm_rank(MPI_COMM_WORLD, &my_rank); assert(MPI_SUCCESS==ierr);
+#endif
+
+  size_type max_size = default_max_size;
+  double min_time = default_min_time;
+  if(argc>1) {
+    max_size = std::atol(argv[1]);
+    if(max_size < min_size) {
+      if(0==my_rank) {
+        printf("max_size should be at least %lld; will use the default value of %lld\n",
+               static_cast<long long>(min_size), static_cast<long long>(default_max_size));
+      }
+      max_size = default_max_size;
+    }
+  }
+  if(argc>2) {
+    min_time = std::atof(argv[2]);
+    if(min_time <= 0.) {
+      min_time = default_min_time;
+    }
+  }
+
+  //memory spaces reachable from LinearAlgebraFactory for which the kernels are (host) executable
+  std::vector<std::string> mem_spaces;
+  mem_spaces.push_back("DEFAULT");
+#ifdef HIOP_USE_RAJA
+  mem_spaces.push_back("HOST");
+#endif
+
+  if(0==my_rank) {
+    printf("HiOp linear algebra benchmark: sizes %lld to %lld (x%lld), min time per kernel %.3f sec\n",
+           static_cast<long long>(min_size),
+           static_cast<long long>(max_size),
+           static_cast<long long>(size_multiplier),
+           min_time);
+  }
+
+  for(auto& mem_space : mem_spaces) {
+    hiopLinAlgBenchmark bench(mem_space, min_time, MPI_COMM_WORLD);
+
+    bench.print_header();
+    for(size_type n=min_size; n<=max_size; n*=size_multiplier) {
+      bench.run_vector(n);
+    }
+
+    bench.print_header();
+    for(size_type n=min_size; n<=max_size; n*=size_multiplier) {
+      bench.run_matrix_dense(static_cast<size_type>(std::sqrt(static_cast<double>(n))));
+    }
+
+    bench.print_header();
+    for(size_type n=min_size; n<=max_size; n*=size_multiplier) {
+      bench.run_matrix_sparse(n);
+    }
+
+    bench.print_header();
+    for(size_type n=min_size; n<=max_size; n*=size_multiplier) {
+      bench.run_matrix_sym_sparse(n);
+    }
+
+    if(bench.is_default_mem_space()) {
+      bench.print_header();
+      for(size_type n=min_size; n<=max_size; n*=size_multiplier) {
+        bench.run_matrix_sparse_csr(n);
+      }
+    }
+  }
+
+#ifdef HIOP_USE_MPI
+  MPI_Finalize();
+#endif
+  return 0;
+}
@@ -0,0 +1,358 @@
+#include "nlpDenseCons_ex2.hpp"
+#include "nlpMDS_ex4.hpp"
+#ifdef HIOP_SPARSE
+#include "nlpSparse_ex6.hpp"
+#endif
+
+#include "hiopNlpFormulation.hpp"
+#include "hiopAlgFilterIPM.hpp"
+#include "hiopVersion.hpp"
+#include "hiopTimer.hpp"
+
+#include <sys/resource.h>
+
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <cassert>
+#include <string>
+#include <vector>
+
+using namespace hiop;
+
+/**
+ * End-to-end scaling benchmark of the HiOp IPM solver.
+ *
+ * The driver solves synthetic NLPs of increasing size and emits a scaling report containing, for each
+ * problem instance, the number of iterations, the total and per-iteration times, the time spent in the
+ * main phases of the algorithm (setup, starting point, HiOp internal computations, KKT linear systems and
+ * the factorizations and solves within, and user function evaluations), and the peak resident memory of
+ * the process during the solve.
+ *
+ * The test problems are the (parameterized) synthetic problems of the examples:
+ *  - 'dense': nlpDenseCons_ex2 (Ex2), solved with the quasi-Newton IPM hiopAlgFilterIPMQuasiNewton
+ *  - 'mds': nlpMDS_ex4 (Ex4), solved with hiopAlgFilterIPMNewton; the size of the sparse block is swept
+ *    while the dense block is kept fixed. Since Ex4 has a number of constraints proportional to the number
+ *    of variables and the MDS KKT linear system is dense in the constraints, the MDS problems are swept
+ *    only up to 'mds_max_size' variables
+ *  - 'sparse': nlpSparse_ex6 (Ex6), solved with hiopAlgFilterIPMNewton (only in HIOP_SPARSE builds)
+ *
+ * Usage: hpc_solver_benchmark.exe [dense|mds|sparse|all] [max_size] [-csv file]
+ *   - the problem class to benchmark (default 'all')
+ *   - max_size: largest number of variables of the sweep, which starts at 'min_size' and increases by
+ *     'size_multiplier' (default 1048576); the sweep can go up to tens of millions of variables
+ *   - -csv file: the report is also appended, in CSV format, to 'file'. Each line contains the HiOp version,
+ *     which allows tracking the solver's performance across versions
+ *
+ * The peak memory is measured as the high-water mark of the resident set size (VmHWM), which is reset before
+ * each solve when the OS allows it (Linux' /proc/self/clear_refs); otherwise, the peak memory of the process
+ * up to the end of the solve is reported. Under MPI, the times and memory are those of the master rank.
+ */
+
+static const size_type min_size = 1024;
+static const size_type size_multiplier = 4;
+static const size_type default_max_size = 1048576;
+/// size of the dense block of the MDS problems
+static const size_type mds_dense_size = 128;
+/// max number of variables of the MDS problems (the MDS KKT is dense in the constraints of Ex4)
+static const size_type mds_max_size = 16384;
+
+struct hiopSolverBenchmarkResult
+{
+  std::string problem;
+  size_type n;
+  size_type m;
+  int status;
+  int iters;
+  double obj;
+  double tm_total;
+  double tm_setup;
+  double tm_startpt;
+  double tm_internal;
+  double tm_kkt;
+  double tm_kkt_fact;
+  double tm_kkt_solve;
+  double tm_evals;
+  double peak_mem_mb;
+};
+
+/// Resets the peak resident set size of the process; returns false if not supported.
+static bool reset_peak_memory()
+{
+  FILE* f = fopen("/proc/self/clear_refs", "w");
+  if(nullptr == f) {
+    return false;
+  }
+  //writing '5' resets the peak RSS (VmHWM)
+  const bool success = fputs("5", f) >= 0;
+  fclose(f);
+  return success;
+}
+
+/// Returns the peak resident set size of the process in MB.
+static double get_peak_memory_mb()
+{
+  FILE* f = fopen("/proc/self/status", "r");
+  if(f) {
+    char line[256];
+    while(fgets(line, sizeof(line), f)) {
+      if(0 == strncmp(line, "VmHWM:", 6)) {
+        long long kb = atoll(line+6);
+        fclose(f);
+        return kb/1024.;
+      }
+    }
+    fclose(f);
+  }
+  //fall back to the process-lifetime maximum
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss/1024.;
+}
+
+static void collect_stats(hiopNlpFormulation& nlp,
+                          hiopAlgFilterIPMBase& solver,
+                          int status,
+                          hiopSolverBenchmarkResult& r)
+{
+  hiopRunStats& st = nlp.runStats;
+  r.n = nlp.n();
+  r.m = nlp.m();
+  r.status = status;
+  r.iters = solver.getNumIterations();
+  r.obj = solver.getObjective();
+  r.tm_total = st.tmOptimizTotal.getElapsedTime();
+  r.tm_startpt = st.tmStartingPoint.getElapsedTime();
+  r.tm_internal = st.tmSolverInternal.getElapsedTime();
+  r.tm_kkt = st.kkt.tmTotal;
+  r.tm_kkt_fact = st.kkt.tmTotalUpdateInnerFact;
+  r.tm_kkt_solve = st.kkt.tmTotalSolveInner;
+  r.tm_evals = st.tmEvalObj.getElapsedTime() + st.tmEvalGrad_f.getElapsedTime() +
+    st.tmEvalCons.getElapsedTime() + st.tmEvalJac_con.getElapsedTime() + st.tmEvalHessL.getElapsedTime();
+}
+
+static void set_benchmark_options(hiopNlpFormulation& nlp)
+{
+  nlp.options->SetIntegerValue("verbosity_level", 0);
+}
+
+static hiopSolverBenchmarkResult run_dense(size_type n)
+{
+  hiopSolverBenchmarkResult r;
+  r.problem = "dense";
+  reset_peak_memory();
+
+  hiopTimer t_setup;
+  t_setup.start();
+  Ex2 nlp_interface(n);
+  hiopNlpDenseConstraints nlp(nlp_interface);
+  set_benchmark_options(nlp);
+  hiopAlgFilterIPMQuasiNewton solver(&nlp);
+  t_setup.stop();
+
+  const int status = solver.run();
+  collect_stats(nlp, solver, status, r);
+  r.tm_setup = t_setup.getElapsedTime();
+  r.peak_mem_mb = get_peak_memory_mb();
+  return r;
+}
+
+static hiopSolverBenchmarkResult run_mds(size_type n)
+{
+  hiopSolverBenchmarkResult r;
+  r.problem = "mds";
+  reset_peak_memory();
+
+  //Ex4 has 2*ns+nd variables
+  const size_type ns = (n-mds_dense_size)/2;
+  hiopTimer t_setup;
+  t_setup.start();
+  Ex4 nlp_interface(ns, mds_dense_size);
+  hiopNlpMDS nlp(nlp_interface);
+  set_benchmark_options(nlp);
+  hiopAlgFilterIPMNewton solver(&nlp);
+  t_setup.stop();
+
+  const int status = solver.run();
+  collect_stats(nlp, solver, status, r);
+  r.tm_setup = t_setup.getElapsedTime();
+  r.peak_mem_mb = get_peak_memory_mb();
+  return r;
+}
+
+#ifdef HIOP_SPARSE
+static hiopSolverBenchmarkResult run_sparse(size_type n)
+{
+  hiopSolverBenchmarkResult r;
+  r.problem = "sparse";
+  reset_peak_memory();
+
+  hiopTimer t_setup;
+  t_setup.start();
+  Ex6 nlp_interface(n, 1.0);
+  hiopNlpSparse nlp(nlp_interface);
+  set_benchmark_options(nlp);
+  hiopAlgFilterIPMNewton solver(&nlp);
+  t_setup.stop();
+
+  const int status = solver.run();
+  collect_stats(nlp, solver, status, r);
+  r.tm_setup = t_setup.getElapsedTime();
+  r.peak_mem_mb = get_peak_memory_mb();
+  return r;
+}
+#endif
+
+static void print_header()
+{
+  printf("\n%-7s %11s %9s %6s %5s %10s %10s %9s %9s %9s %9s %9s %9s %9s %10s\n",
+         "problem", "n", "m", "status", "iter", "total(s)", "s/iter", "setup", "startpt",
+         "internal", "kkt", "kkt-fact", "kkt-solve", "evals", "peak(MB)");
+}
+
+static void print_result(const hiopSolverBenchmarkResult& r)
+{
+  printf("%-7s %11lld %9lld %6d %5d %10.3f %10.4f %9.3f %9.3f %9.3f %9.3f %9.3f %9.3f %9.3f %10.1f\n",
+         r.problem.c_str(),
+         static_cast<long long>(r.n),
+         static_cast<long long>(r.m),
+         r.status,
+         r.iters,
+         r.tm_total,
+         r.iters>0 ? r.tm_total/r.iters : 0.,
+         r.tm_setup,
+         r.tm_startpt,
+         r.tm_internal,
+         r.tm_kkt,
+         r.tm_kkt_fact,
+         r.tm_kkt_solve,
+         r.tm_evals,
+         r.peak_mem_mb);
+  fflush(stdout);
+}
+
+static void write_csv(const std::string& filename, const std::vector<hiopSolverBenchmarkResult>& results)
+{
+  FILE* f = fopen(filename.c_str(), "a");
+  if(nullptr == f) {
+    printf("could not open '%s' for writing the CSV report\n", filename.c_str());
+    return;
+  }
+  //header is written only for new (empty) files
+  fseek(f, 0, SEEK_END);
+  if(0 == ftell(f)) {
+    fprintf(f, "version,problem,n,m,status,iter,total,time_per_iter,setup,startpt,internal,kkt,"
+            "kkt_fact,kkt_solve,evals,objective,peak_mem_mb\n");
+  }
+  for(auto& r : results) {
+    fprintf(f, "%s,%s,%lld,%lld,%d,%d,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%.12e,%.3f\n",
+            hiopVersion::version().c_str(),
+            r.problem.c_str(),
+            static_cast<long long>(r.n),
+            static_cast<long long>(r.m),
+            r.status,
+            r.iters,
+            r.tm_total,
+            r.iters>0 ? r.tm_total/r.iters : 0.,
+            r.tm_setup,
+            r.tm_startpt,
+            r.tm_internal,
+            r.tm_kkt,
+            r.tm_kkt_fact,
+            r.tm_kkt_solve,
+            r.tm_evals,
+            r.obj,
+            r.peak_mem_mb);
+  }
+  fclose(f);
+}
+
+static void usage(const char* exe_name)
+{
+  printf("HiOp solver scaling benchmark\n");
+  printf("Usage: \n");
+  printf("  '$ %s [dense|mds|sparse|all] [max_size] [-csv file]'\n", exe_name);
+}
+
+int main(int argc, char **argv)
+{
+  int my_rank = 0;
+#ifdef HIOP_USE_MPI
+  MPI_Init(&argc, &argv);
+  int ierr = MPI_Comm_rank(MPI_COMM_WORLD, &my_rank); assert(MPI_SUCCESS==ierr);
+#endif
+
+  std::string problem = "all";
+  size_type max_size = default_max_size;
+  std::string csv_file;
+
+  int positional = 0;
+  for(int i=1; i<argc; i++) {
+    if(std::string(argv[i]) == "-csv" && i+1<argc) {
+      csv_file = argv[++i];
+    } else if(positional == 0 && std::atoll(argv[i]) == 0) {
+      problem = argv[i];
+      positional++;
+    } else {
+      max_size = std::atoll(argv[i]);
+      positional = 2;
+    }
+  }
+  const bool run_all = problem == "all";
+  if((!run_all && problem != "dense" && problem != "mds" && problem != "sparse") || max_size < min_size) {
+    if(0==my_rank) {
+      usage(argv[0]);
+    }
+#ifdef HIOP_USE_MPI
+    MPI_Finalize();
+#endif
+    return 1;
+  }
+#ifndef HIOP_SPARSE
+  if(problem == "sparse") {
+    if(0==my_rank) {
+      printf("HiOp was built without sparse linear algebra, sparse problems are not available\n");
+    }
+#ifdef HIOP_USE_MPI
+    MPI_Finalize();
+#endif
+    return 1;
+  }
+#endif
+
+  if(0==my_rank) {
+    printf("%s\n", hiopVersion::fullVersionInfo().c_str());
+    printf("Solver scaling benchmark: sizes %lld to %lld (x%lld)\n",
+           static_cast<long long>(min_size),
+           static_cast<long long>(max_size),
+           static_cast<long long>(size_multiplier));
+    print_header();
+  }
+
+  std::vector<hiopSolverBenchmarkResult> results;
+  for(size_type n=min_size; n<=max_size; n*=size_multiplier) {
+    if(run_all || problem == "dense") {
+      results.push_back(run_dense(n));
+      if(0==my_rank) print_result(results.back());
+    }
+    if((run_all || problem == "mds") && n <= mds_max_size) {
+      results.push_back(run_mds(n));
+      if(0==my_rank) print_result(results.back());
+    }
+#ifdef HIOP_SPARSE
+    if(run_all || problem == "sparse") {
+      results.push_back(run_sparse(n));
+      if(0==my_rank) print_result(results.back());
+    }
+#endif
+  }
+
+  if(0==my_rank && !csv_file.empty()) {
+    write_csv(csv_file, results);
+  }
+
+#ifdef HIOP_USE_MPI
+  MPI_Finalize();
+#endif
+  return 0;
+}
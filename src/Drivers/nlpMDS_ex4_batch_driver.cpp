@@ -0,0 +1,227 @@
+#include "nlpMDS_ex4.hpp"
+#include "hiopNlpFormulation.hpp"
+#include "hiopAlgFilterIPM.hpp"
+#include "hiopBatchSolver.hpp"
+#include "hiopOptions.hpp"
+#include "hiopTimer.hpp"
+
+#include <cstdlib>
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+using namespace hiop;
+
+/**
+ * Driver for the batch solver: solves instances of Ex4 that differ in the bounds of the variables
+ * and of the inequalities, and in which variable is fixed and removed, first one by one with separate NLP and solver objects and then with
+ * hiopBatchSolver, sequentially and with multiple threads. The batch also contains an instance of
+ * a different size and an instance whose sparse Jacobian has the same size but permuted nonzeros, which
+ * should both be rejected.
+ */
+class Ex4Batch : public Ex4
+{
+public:
+  Ex4Batch(int ns_in, int nd_in, double scale, int fixed_var, bool permute=false)
+    : Ex4(ns_in, nd_in), scale_(scale), fixed_var_(fixed_var), permute_(permute)
+  {
+  }
+  virtual ~Ex4Batch()
+  {
+  }
+
+  bool get_vars_info(const size_type& n, double *xlow, double* xupp, NonlinearityType* type)
+  {
+    if(!Ex4::get_vars_info(n, xlow, xupp, type)) {
+      return false;
+    }
+    for(int i=0; i<ns; ++i) {
+      xupp[i] *= scale_;
+    }
+    //one of the slacks s, which are bounded below by zero, is fixed at its bound
+    xupp[ns+fixed_var_] = xlow[ns+fixed_var_];
+    return true;
+  }
+
+  bool get_cons_info(const size_type& m, double* clow, double* cupp, NonlinearityType* type)
+  {
+    if(!Ex4::get_cons_info(m, clow, cupp, type)) {
+      return false;
+    }
+    for(int i=ns; i<m; ++i) {
+      if(clow[i]>-1e20) clow[i] *= scale_;
+      if(cupp[i]<1e20) cupp[i] *= scale_;
+    }
+    return true;
+  }
+
+  bool eval_Jac_cons(const size_type& n, const size_type& m,
+                     const size_type& num_cons, const index_type* idx_cons,
+                     const double* x, bool new_x,
+                     const size_type& nsparse, const size_type& ndense,
+                     const size_type& nnzJacS, index_type* iJacS, index_type* jJacS, double* MJacS,
+                     double* JacD)
+  {
+    if(!Ex4::eval_Jac_cons(n, m, num_cons, idx_cons, x, new_x, nsparse, ndense,
+                           nnzJacS, iJacS, jJacS, MJacS, JacD)) {
+      return false;
+    }
+    //the nonzeros of the sparse block of the equalities are given in the reverse order
+    if(permute_ && num_cons==ns) {
+      if(iJacS!=NULL && jJacS!=NULL) {
+        std::reverse(iJacS, iJacS+nnzJacS);
+        std::reverse(jJacS, jJacS+nnzJacS);
+      }
+      if(MJacS!=NULL) {
+        std::reverse(MJacS, MJacS+nnzJacS);
+      }
+    }
+    return true;
+  }
+private:
+  double scale_;
+  int fixed_var_;
+  bool permute_;
+};
+
+static void set_options(hiopOptions& options)
+{
+  options.SetStringValue("Hessian", "analytical_exact");
+  options.SetStringValue("KKTLinsys", "xdycyd");
+  options.SetStringValue("compute_mode", "cpu");
+  options.SetStringValue("fixed_var", "remove");
+  options.SetIntegerValue("verbosity_level", 0);
+  options.SetNumericValue("mu0", 1e-1);
+  options.SetNumericValue("tolerance", 1e-5);
+}
+
+static void usage(const char* exeName)
+{
+  printf("HiOp driver %s that solves a batch of instances of Ex4 with the same structure\n", exeName);
+  printf("Usage: \n");
+  printf("  '$ %s num_instances num_threads sp_vars_size de_vars_size -selfcheck'\n", exeName);
+  printf("Arguments, all integers, excepting strings '-selfcheck'\n");
+  printf("  'num_instances': # of instances in the batch [default 8, optional]\n");
+  printf("  'num_threads': # of threads used by the batch solver [default 2, optional]\n");
+  printf("  'sp_vars_size': # of sparse variables [default 400, optional]\n");
+  printf("  'de_vars_size': # of dense variables [default 100, optional]\n");
+  printf("  '-selfcheck': checks that the batch solves reproduce the individual solves. [optional]\n");
+}
+
+int main(int argc, char **argv)
+{
+  int provided;
+  int ierr = MPI_Init_thread(&argc, &argv, MPI_THREAD_MULTIPLE, &provided);
+  assert(MPI_SUCCESS==ierr);
+  int comm_size;
+  ierr = MPI_Comm_size(MPI_COMM_WORLD, &comm_size); assert(MPI_SUCCESS==ierr);
+  if(comm_size != 1) {
+    printf("[error] driver detected more than one rank but the driver should be run "
+           "in serial only; will exit\n");
+    MPI_Finalize();
+    return 1;
+  }
+
+  int num_inst = 8, num_threads = 2, n_sp = 400, n_de = 100;
+  bool self_check = false;
+  int* int_args[] = {&num_inst, &num_threads, &n_sp, &n_de};
+  int num_int_args = 0;
+  for(int i=1; i<argc; i++) {
+    if(std::string(argv[i]) == "-selfcheck") {
+      self_check = true;
+    } else if(num_int_args<4) {
+      *int_args[num_int_args++] = std::atoi(argv[i]);
+    } else {
+      usage(argv[0]);
+      MPI_Finalize();
+      return 1;
+    }
+  }
+  if(num_inst<=0 || num_threads<=0 || n_sp<=0 || n_de<=0) {
+    usage(argv[0]);
+    MPI_Finalize();
+    return 1;
+  }
+
+  std::vector<Ex4Batch*> instances;
+  for(int k=0; k<num_inst; k++) {
+    instances.push_back(new Ex4Batch(n_sp, n_de, 0.5 + k/(double)num_inst, k%n_sp));
+  }
+  //an instance with a different structure, which the batch solver should not solve
+  Ex4Batch instance_bad(n_sp+4, n_de, 1., 0);
+  //an instance with the same sizes and numbers of nonzeros, but with a permuted sparsity pattern
+  Ex4Batch instance_perm(n_sp, n_de, 1., 0, true);
+
+  //reference: each instance solved with its own NLP and solver objects
+  std::vector<hiopSolveStatus> status_ref(num_inst);
+  std::vector<double> obj_ref(num_inst);
+  std::vector<int> iter_ref(num_inst);
+  hiopTimer t_ref;
+  t_ref.start();
+  for(int k=0; k<num_inst; k++) {
+    hiopNlpMDS nlp(*instances[k]);
+    set_options(*nlp.options);
+    hiopAlgFilterIPMNewton solver(&nlp);
+    status_ref[k] = solver.run();
+    obj_ref[k] = solver.getObjective();
+    iter_ref[k] = solver.getNumIterations();
+  }
+  t_ref.stop();
+
+  std::vector<hiopInterfaceMDS*> batch_instances(instances.begin(), instances.end());
+  batch_instances.push_back(&instance_bad);
+  batch_instances.push_back(&instance_perm);
+
+  int ret_code = 0;
+  for(int nthreads : {1, num_threads}) {
+    hiopBatchSolver batch(batch_instances);
+    set_options(*batch.options);
+    batch.set_num_threads(nthreads);
+
+    hiopTimer t_batch;
+    t_batch.start();
+    hiopSolveStatus status = batch.run();
+    t_batch.stop();
+
+    printf("batch of %d instances solved with %d thread(s) in %.3f sec (individual solves took %.3f sec)\n",
+           num_inst, nthreads, t_batch.getElapsedTime(), t_ref.getElapsedTime());
+
+    for(int k=0; k<num_inst; k++) {
+      const bool match = batch.get_status(k) == status_ref[k] &&
+                         batch.get_num_iterations(k) == iter_ref[k] &&
+                         std::fabs(batch.get_objective(k)-obj_ref[k]) <= 1e-8*(1.+std::fabs(obj_ref[k]));
+      if(!match || status_ref[k]<0) {
+        printf("instance %d: batch solve (status %d, %d iterations, obj=%18.12e) differs from individual "
+               "solve (status %d, %d iterations, obj=%18.12e)\n",
+               k, batch.get_status(k), batch.get_num_iterations(k), batch.get_objective(k),
+               status_ref[k], iter_ref[k], obj_ref[k]);
+        ret_code = -1;
+      }
+    }
+    if(batch.get_status(num_inst) != Invalid_Problem_Definition || status != Invalid_Problem_Definition) {
+      printf("the instance with a different structure was not rejected by the batch solver (status %d)\n",
+             batch.get_status(num_inst));
+      ret_code = -1;
+    }
+    if(batch.get_status(num_inst+1) != Invalid_Problem_Definition) {
+      printf("the instance with a permuted sparsity pattern was not rejected by the batch solver (status %d)\n",
+             batch.get_status(num_inst+1));
+      ret_code = -1;
+    }
+  }
+
+  if(0==ret_code) {
+    if(self_check) {
+      printf("selfcheck passed\n");
+    } else {
+      printf("batch solves reproduced the individual solves\n");
+    }
+  }
+
+  for(auto* instance : instances) {
+    delete instance;
+  }
+  MPI_Finalize();
+  return ret_code;
+}
@@ -0,0 +1,187 @@
+#include "nlpMDS_ex4.hpp"
+#include "hiopNlpFormulation.hpp"
+#include "hiopAlgFilterIPM.hpp"
+
+#include <cstdlib>
+#include <cmath>
+#include <string>
+
+using namespace hiop;
+
+/**
+ * Driver for the equilibration of the KKT linear system: the objective of Ex4 is multiplied by a large 
+ * factor, which makes the Hessian block of the KKT matrix badly scaled with respect to the Jacobian blocks, 
+ * and the problem is solved with and without the (Ruiz) equilibration of the KKT matrix. The factorization 
+ * times and the iteration counts of the two solves are reported.
+ */
+template<class Ex4Base>
+class Ex4BadlyScaled : public Ex4Base
+{
+public:
+  Ex4BadlyScaled(int ns_in, int nd_in, double obj_scale)
+    : Ex4Base(ns_in, nd_in), obj_scale_(obj_scale)
+  {
+  }
+  virtual ~Ex4BadlyScaled()
+  {
+  }
+
+  bool eval_f(const size_type& n, const double* x, bool new_x, double& obj_value)
+  {
+    if(!Ex4Base::eval_f(n, x, new_x, obj_value)) {
+      return false;
+    }
+    obj_value *= obj_scale_;
+    return true;
+  }
+
+  bool eval_grad_f(const size_type& n, const double* x, bool new_x, double* gradf)
+  {
+    if(!Ex4Base::eval_grad_f(n, x, new_x, gradf)) {
+      return false;
+    }
+    for(int i=0; i<n; ++i) {
+      gradf[i] *= obj_scale_;
+    }
+    return true;
+  }
+
+  bool eval_Hess_Lagr(const size_type& n, const size_type& m,
+                      const double* x, bool new_x, const double& obj_factor,
+                      const double* lambda, bool new_lambda,
+                      const size_type& nsparse, const size_type& ndense,
+                      const size_type& nnzHSS, index_type* iHSS, index_type* jHSS, double* MHSS,
+                      double* HDD,
+                      size_type& nnzHSD, index_type* iHSD, index_type* jHSD, double* MHSD)
+  {
+    return Ex4Base::eval_Hess_Lagr(n, m, x, new_x, obj_factor*obj_scale_, lambda, new_lambda,
+                                   nsparse, ndense, nnzHSS, iHSS, jHSS, MHSS, HDD,
+                                   nnzHSD, iHSD, jHSD, MHSD);
+  }
+private:
+  double obj_scale_;
+};
+
+static double solve(hiopInterfaceMDS& ex4, const char* kkt_equilibration, hiopSolveStatus& status)
+{
+  hiopNlpMDS nlp(ex4);
+  nlp.options->SetStringValue("kkt_equilibration", kkt_equilibration);
+  nlp.options->SetStringValue("scaling_type", "none");
+  nlp.options->SetStringValue("Hessian", "analytical_exact");
+  nlp.options->SetStringValue("compute_mode", "cpu");
+  nlp.options->SetIntegerValue("verbosity_level", 0);
+  nlp.options->SetNumericValue("mu0", 1e-1);
+  nlp.options->SetNumericValue("tolerance", 1e-6);
+
+  hiopAlgFilterIPMNewton solver(&nlp);
+  status = solver.run();
+  printf("  kkt_equilibration=%-4s: status %d, %3d iterations, fact %.3f sec, inertia corrections %d, "
+         "equilibrations %d, IR %g iter\n",
+         kkt_equilibration,
+         status,
+         solver.getNumIterations(),
+         nlp.runStats.kkt.tmTotalUpdateInnerFact,
+         nlp.runStats.kkt.nUpdateICCorr,
+         nlp.runStats.kkt.nTotalEquilUpdates,
+         nlp.runStats.kkt.nTotalIterRefinInner);
+  return solver.getObjective();
+}
+
+static bool compare(hiopInterfaceMDS& ex4, const char* name)
+{
+  printf("%s:\n", name);
+  hiopSolveStatus status_none, status_ruiz;
+  const double obj_none = solve(ex4, "none", status_none);
+  const double obj_ruiz = solve(ex4, "ruiz", status_ruiz);
+  if(status_none<0 || status_ruiz<0) {
+    printf("%s: solver returned negative solve status: %d (kkt_equilibration=none) and %d "
+           "(kkt_equilibration=ruiz)\n", name, status_none, status_ruiz);
+    return false;
+  }
+  if(std::fabs(obj_none-obj_ruiz) > 1e-5*(1.+std::fabs(obj_none))) {
+    printf("%s: objective with the KKT equilibration %18.12e differs from the one without it %18.12e\n",
+           name, obj_ruiz, obj_none);
+    return false;
+  }
+  return true;
+}
+
+static void usage(const char* exeName)
+{
+  printf("HiOp driver %s that solves a badly scaled Ex4 with and without the KKT equilibration\n", exeName);
+  printf("Usage: \n");
+  printf("  '$ %s sp_vars_size de_vars_size obj_scale -selfcheck'\n", exeName);
+  printf("Arguments, all integers, excepting 'obj_scale' and strings '-selfcheck'\n");
+  printf("  'sp_vars_size': # of sparse variables [default 400, optional]\n");
+  printf("  'de_vars_size': # of dense variables [default 100, optional]\n");
+  printf("  'obj_scale': factor multiplying the objective [default 1e4, optional]\n");
+  printf("  '-selfcheck': checks that the solves with and without the equilibration give the same "
+         "objective. [optional]\n");
+}
+
+int main(int argc, char **argv)
+{
+#ifdef HIOP_USE_MPI
+  MPI_Init(&argc, &argv);
+  int comm_size;
+  int ierr = MPI_Comm_size(MPI_COMM_WORLD, &comm_size); assert(MPI_SUCCESS==ierr);
+  if(comm_size != 1) {
+    printf("[error] driver detected more than one rank but the driver should be run "
+           "in serial only; will exit\n");
+    MPI_Finalize();
+    return 1;
+  }
+#endif
+
+  int n_sp = 400, n_de = 100;
+  double obj_scale = 1e4;
+  bool self_check = false;
+  int num_args = 0;
+  for(int i=1; i<argc; i++) {
+    if(std::string(argv[i]) == "-selfcheck") {
+      self_check = true;
+    } else if(num_args<2) {
+      (0==num_args ? n_sp : n_de) = std::atoi(argv[i]);
+      num_args++;
+    } else if(num_args<3) {
+      obj_scale = std::atof(argv[i]);
+      num_args++;
+    } else {
+      usage(argv[0]);
+#ifdef HIOP_USE_MPI
+      MPI_Finalize();
+#endif
+      return 1;
+    }
+  }
+  if(n_sp<=0 || n_de<=0 || obj_scale<=0.) {
+    usage(argv[0]);
+#ifdef HIOP_USE_MPI
+    MPI_Finalize();
+#endif
+    return 1;
+  }
+
+  int ret_code = 0;
+  {
+    Ex4BadlyScaled<Ex4> ex4(n_sp, n_de, obj_scale);
+    if(!compare(ex4, "Ex4")) {
+      ret_code = -1;
+    }
+  }
+  {
+    Ex4BadlyScaled<Ex4OneCallCons> ex4(n_sp, n_de, obj_scale);
+    if(!compare(ex4, "Ex4OneCallCons")) {
+      ret_code = -1;
+    }
+  }
+
+  if(0==ret_code && self_check) {
+    printf("selfcheck passed\n");
+  }
+
+#ifdef HIOP_USE_MPI
+  MPI_Finalize();
+#endif
+  return ret_code;
+}
@@ -0,0 +1,157 @@
+#include "nlpMDS_ex4.hpp"
+#include "hiopNlpFormulation.hpp"
+#include "hiopAlgFilterIPM.hpp"
+
+#include <cstdlib>
+#include <cmath>
+#include <string>
+
+using namespace hiop;
+
+/**
+ * Driver for the removal of fixed variables in the MDS NLP formulation: a number of the sparse variables
+ * 's' and of the dense variables 'y' of Ex4 are fixed and the problem is solved with the fixed variables
+ * relaxed and removed. The example is solved with both the split and the one-call constraints Jacobian.
+ */
+template<class Ex4Base>
+class Ex4FixedVars : public Ex4Base
+{
+public:
+  Ex4FixedVars(int ns_in, int nd_in, int nfixed)
+    : Ex4Base(ns_in, nd_in), nfixed_(nfixed)
+  {
+  }
+  virtual ~Ex4FixedVars()
+  {
+  }
+
+  bool get_vars_info(const size_type& n, double *xlow, double* xupp, hiopInterfaceBase::NonlinearityType* type)
+  {
+    if(!Ex4Base::get_vars_info(n, xlow, xupp, type)) {
+      return false;
+    }
+    const int ns = this->ns;
+    //every other of the first 2*nfixed_ sparse variables 's' and the first nfixed_ dense variables 'y',
+    //excepting y[0], which has bounds
+    for(int i=0; i<nfixed_ && 2*i<ns; ++i) {
+      xlow[ns+2*i] = xupp[ns+2*i] = 0.1;
+    }
+    for(int i=1; i<=nfixed_ && i<this->nd; ++i) {
+      xlow[2*ns+i] = xupp[2*ns+i] = 0.;
+    }
+    return true;
+  }
+private:
+  int nfixed_;
+};
+
+static double solve(hiopInterfaceMDS& ex4, const char* fixed_var, hiopSolveStatus& status)
+{
+  hiopNlpMDS nlp(ex4);
+  nlp.options->SetStringValue("fixed_var", fixed_var);
+  nlp.options->SetStringValue("Hessian", "analytical_exact");
+  nlp.options->SetStringValue("KKTLinsys", "xdycyd");
+  nlp.options->SetStringValue("compute_mode", "cpu");
+  nlp.options->SetIntegerValue("verbosity_level", 0);
+  nlp.options->SetNumericValue("mu0", 1e-1);
+  nlp.options->SetNumericValue("tolerance", 1e-6);
+
+  hiopAlgFilterIPMNewton solver(&nlp);
+  status = solver.run();
+  return solver.getObjective();
+}
+
+static bool compare(hiopInterfaceMDS& ex4, const char* name)
+{
+  hiopSolveStatus status_relax, status_remove;
+  const double obj_relax = solve(ex4, "relax", status_relax);
+  const double obj_remove = solve(ex4, "remove", status_remove);
+  if(status_relax<0 || status_remove<0) {
+    printf("%s: solver returned negative solve status: %d (fixed_var=relax) and %d (fixed_var=remove)\n",
+           name, status_relax, status_remove);
+    return false;
+  }
+  if(std::fabs(obj_relax-obj_remove) > 1e-5*(1.+std::fabs(obj_relax))) {
+    printf("%s: objective with the fixed variables removed %18.12e differs from the one with the fixed "
+           "variables relaxed %18.12e\n", name, obj_remove, obj_relax);
+    return false;
+  }
+  printf("%s: objective %18.12e (fixed_var=remove) and %18.12e (fixed_var=relax)\n", name, obj_remove, obj_relax);
+  return true;
+}
+
+static void usage(const char* exeName)
+{
+  printf("HiOp driver %s that solves Ex4 with some of the variables fixed\n", exeName);
+  printf("Usage: \n");
+  printf("  '$ %s sp_vars_size de_vars_size num_fixed -selfcheck'\n", exeName);
+  printf("Arguments, all integers, excepting strings '-selfcheck'\n");
+  printf("  'sp_vars_size': # of sparse variables [default 400, optional]\n");
+  printf("  'de_vars_size': # of dense variables [default 100, optional]\n");
+  printf("  'num_fixed': # of fixed sparse and of fixed dense variables [default 10, optional]\n");
+  printf("  '-selfcheck': checks that removing and relaxing the fixed variables give the same "
+         "objective. [optional]\n");
+}
+
+int main(int argc, char **argv)
+{
+#ifdef HIOP_USE_MPI
+  MPI_Init(&argc, &argv);
+  int comm_size;
+  int ierr = MPI_Comm_size(MPI_COMM_WORLD, &comm_size); assert(MPI_SUCCESS==ierr);
+  if(comm_size != 1) {
+    printf("[error] driver detected more than one rank but the driver should be run "
+           "in serial only; will exit\n");
+    MPI_Finalize();
+    return 1;
+  }
+#endif
+
+  int n_sp = 400, n_de = 100, n_fixed = 10;
+  bool self_check = false;
+  int* int_args[] = {&n_sp, &n_de, &n_fixed};
+  int num_int_args = 0;
+  for(int i=1; i<argc; i++) {
+    if(std::string(argv[i]) == "-selfcheck") {
+      self_check = true;
+    } else if(num_int_args<3) {
+      *int_args[num_int_args++] = std::atoi(argv[i]);
+    } else {
+      usage(argv[0]);
+#ifdef HIOP_USE_MPI
+      MPI_Finalize();
+#endif
+      return 1;
+    }
+  }
+  if(n_sp<=0 || n_de<=1 || n_fixed<=0) {
+    usage(argv[0]);
+#ifdef HIOP_USE_MPI
+    MPI_Finalize();
+#endif
+    return 1;
+  }
+
+  int ret_code = 0;
+  {
+    Ex4FixedVars<Ex4> ex4(n_sp, n_de, n_fixed);
+    if(!compare(ex4, "Ex4")) {
+      ret_code = -1;
+    }
+  }
+  {
+    Ex4FixedVars<Ex4OneCallCons> ex4(n_sp, n_de, n_fixed);
+    if(!compare(ex4, "Ex4OneCallCons")) {
+      ret_code = -1;
+    }
+  }
+
+  if(0==ret_code && self_check) {
+    printf("selfcheck passed\n");
+  }
+
+#ifdef HIOP_USE_MPI
+  MPI_Finalize();
+#endif
+  return ret_code;
+}
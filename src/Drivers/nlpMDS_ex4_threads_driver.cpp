@@ -0,0 +1,207 @@
+#include "nlpMDS_ex4.hpp"
+#include "hiopNlpFormulation.hpp"
+#include "hiopAlgFilterIPM.hpp"
+
+#include "mpi.h"
+
+#include <cstdlib>
+#include <cmath>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace hiop;
+
+/**
+ * Stress test for concurrent solves: several threads of the same MPI process each solve an
+ * independent instance of Ex4 (of different sizes), concurrently, and the results are checked
+ * against the ones obtained by solving the same instances one after the other.
+ *
+ * Each instance uses its own communicator, a duplicate of MPI_COMM_SELF created by the main thread.
+ * Every other instance uses a host memory pool and tracks its memory, and the last instance has a memory 
+ * budget too small to complete the solve, which should stop that instance only.
+ */
+class Ex4Threads : public Ex4
+{
+public:
+  Ex4Threads(int ns_in, int nd_in, MPI_Comm comm_in)
+    : Ex4(ns_in, nd_in), comm_(comm_in)
+  {
+  }
+  virtual ~Ex4Threads()
+  {
+  }
+  virtual bool get_MPI_comm(MPI_Comm& comm_out) { comm_out=comm_; return true;}
+private:
+  MPI_Comm comm_;
+};
+
+struct SolveResult
+{
+  hiopSolveStatus status;
+  double obj_value;
+  int num_iter;
+};
+
+/// Memory options of each instance
+struct MemorySettings
+{
+  bool pool;
+  double budget;
+};
+
+static void solve_instance(int n_sp, int n_de, MPI_Comm comm, MemorySettings mem, SolveResult* res)
+{
+  Ex4Threads my_nlp(n_sp, n_de, comm);
+
+  hiopNlpMDS nlp(my_nlp);
+  nlp.options->SetStringValue("Hessian", "analytical_exact");
+  nlp.options->SetStringValue("KKTLinsys", "xdycyd");
+  nlp.options->SetStringValue("compute_mode", "cpu");
+  nlp.options->SetIntegerValue("verbosity_level", 0);
+  nlp.options->SetNumericValue("mu0", 1e-1);
+  nlp.options->SetNumericValue("tolerance", 1e-5);
+  if(mem.pool) {
+    nlp.options->SetStringValue("mem_space_pool", "yes");
+    nlp.options->SetStringValue("memory_tracking", "yes");
+  }
+  nlp.options->SetNumericValue("memory_budget", mem.budget);
+
+  hiopAlgFilterIPMNewton solver(&nlp);
+  res->status = solver.run();
+  res->obj_value = solver.getObjective();
+  res->num_iter = solver.getNumIterations();
+}
+
+static void usage(const char* exeName)
+{
+  printf("HiOp driver %s that solves independent instances of Ex4 concurrently in multiple threads\n",
+         exeName);
+  printf("Usage: \n");
+  printf("  '$ %s num_threads num_rounds -selfcheck'\n", exeName);
+  printf("Arguments, all integers, excepting strings '-selfcheck'\n");
+  printf("  'num_threads': # of concurrent solves [default 4, optional]\n");
+  printf("  'num_rounds': # of times the concurrent solves are repeated [default 2, optional]\n");
+  printf("  '-selfcheck': checks that the concurrent solves reproduce the sequential ones. [optional]\n");
+}
+
+int main(int argc, char **argv)
+{
+  int provided;
+  int ierr = MPI_Init_thread(&argc, &argv, MPI_THREAD_MULTIPLE, &provided);
+  assert(MPI_SUCCESS==ierr);
+  int comm_size;
+  ierr = MPI_Comm_size(MPI_COMM_WORLD, &comm_size); assert(MPI_SUCCESS==ierr);
+  if(comm_size != 1) {
+    printf("[error] driver detected more than one rank but the driver should be run "
+           "in serial only; will exit\n");
+    MPI_Finalize();
+    return 1;
+  }
+
+  int num_threads = 4, num_rounds = 2;
+  bool self_check = false;
+  for(int i=1; i<argc; i++) {
+    if(std::string(argv[i]) == "-selfcheck") {
+      self_check = true;
+    } else if(i==1) {
+      num_threads = std::atoi(argv[i]);
+    } else if(i==2) {
+      num_rounds = std::atoi(argv[i]);
+    } else {
+      usage(argv[0]);
+      MPI_Finalize();
+      return 1;
+    }
+  }
+  if(num_threads<=0 || num_rounds<=0) {
+    usage(argv[0]);
+    MPI_Finalize();
+    return 1;
+  }
+
+  if(provided < MPI_THREAD_MULTIPLE) {
+    printf("[warning] MPI does not provide MPI_THREAD_MULTIPLE; solves will run sequentially\n");
+  }
+
+  //instances of different sizes so that the threads are out of phase
+  std::vector<int> n_sp(num_threads), n_de(num_threads);
+  std::vector<MemorySettings> mem(num_threads);
+  for(int t=0; t<num_threads; t++) {
+    n_sp[t] = 400 + 40*t;
+    n_de[t] = 100 + 10*(t%3);
+    mem[t].pool = 0==t%2;
+    mem[t].budget = 0.;
+  }
+  //a budget of 10KB, which is exceeded by the iterates alone
+  if(num_threads>1) {
+    mem[num_threads-1].budget = 0.01;
+  }
+
+  std::vector<MPI_Comm> comms(num_threads);
+  for(int t=0; t<num_threads; t++) {
+    ierr = MPI_Comm_dup(MPI_COMM_SELF, &comms[t]); assert(MPI_SUCCESS==ierr);
+  }
+
+  //reference solves, one after the other
+  std::vector<SolveResult> ref(num_threads);
+  for(int t=0; t<num_threads; t++) {
+    solve_instance(n_sp[t], n_de[t], comms[t], mem[t], &ref[t]);
+  }
+
+  int ret_code = 0;
+  for(int r=0; r<num_rounds; r++) {
+    std::vector<SolveResult> res(num_threads);
+    if(provided >= MPI_THREAD_MULTIPLE) {
+      std::vector<std::thread> threads;
+      for(int t=0; t<num_threads; t++) {
+        threads.emplace_back(solve_instance, n_sp[t], n_de[t], comms[t], mem[t], &res[t]);
+      }
+      for(auto& th : threads) {
+        th.join();
+      }
+    } else {
+      for(int t=0; t<num_threads; t++) {
+        solve_instance(n_sp[t], n_de[t], comms[t], mem[t], &res[t]);
+      }
+    }
+
+    for(int t=0; t<num_threads; t++) {
+      const bool match = res[t].status == ref[t].status &&
+                         res[t].num_iter == ref[t].num_iter &&
+                         std::fabs(res[t].obj_value-ref[t].obj_value) <= 1e-8*(1.+std::fabs(ref[t].obj_value));
+      if(!match) {
+        printf("round %d, thread %d (ns=%d nd=%d): status %d, %d iterations, obj=%18.12e differ from "
+               "sequential solve: status %d, %d iterations, obj=%18.12e\n",
+               r, t, n_sp[t], n_de[t], res[t].status, res[t].num_iter, res[t].obj_value,
+               ref[t].status, ref[t].num_iter, ref[t].obj_value);
+        ret_code = -1;
+      }
+      if(mem[t].budget>0.) {
+        if(res[t].status != Memory_Alloc_Problem) {
+          printf("round %d, thread %d: solver did not stop on the memory budget (status %d)\n", 
+                 r, t, res[t].status);
+          ret_code = -1;
+        }
+      } else if(res[t].status<0) {
+        printf("round %d, thread %d: solver returned negative solve status: %d\n", r, t, res[t].status);
+        ret_code = -1;
+      }
+    }
+  }
+
+  if(0==ret_code) {
+    if(self_check) {
+      printf("selfcheck passed\n");
+    } else {
+      printf("%d concurrent solves repeated %d times reproduced the sequential solves\n",
+             num_threads, num_rounds);
+    }
+  }
+
+  for(int t=0; t<num_threads; t++) {
+    MPI_Comm_free(&comms[t]);
+  }
+  MPI_Finalize();
+  return ret_code;
+}
@@ -0,0 +1,177 @@
+#include "nlpMDS_ex4.hpp"
+#include "hiopNlpFormulation.hpp"
+#include "hiopAlgFilterIPM.hpp"
+
+#include <cstdlib>
+#include <cmath>
+#include <string>
+
+using namespace hiop;
+
+/**
+ * Driver for warm starting from a saved solver state: an instance of Ex4 is solved, its state is
+ * saved, the upper bounds of the first 'ns' variables, which are active at the solution, are
+ * perturbed and the perturbed problem is solved again, once from scratch and once warm started
+ * from the saved state.
+ */
+class Ex4Perturbed : public Ex4
+{
+public:
+  Ex4Perturbed(int ns_in, int nd_in)
+    : Ex4(ns_in, nd_in), xupp_(0.25)
+  {
+  }
+  virtual ~Ex4Perturbed()
+  {
+  }
+
+  void set_xupp(double xupp) { xupp_ = xupp; }
+
+  bool get_vars_info(const size_type& n, double *xlow, double* xupp, NonlinearityType* type)
+  {
+    if(!Ex4::get_vars_info(n, xlow, xupp, type)) {
+      return false;
+    }
+    //the unconstrained minimizer of the objective w.r.t. these variables is 0.5
+    for(int i=0; i<ns; ++i) {
+      xupp[i] = xupp_;
+    }
+    return true;
+  }
+private:
+  double xupp_;
+};
+
+static void set_options(hiopOptions& options)
+{
+  options.SetStringValue("Hessian", "analytical_exact");
+  options.SetStringValue("KKTLinsys", "xdycyd");
+  options.SetStringValue("compute_mode", "cpu");
+  options.SetIntegerValue("verbosity_level", 0);
+  options.SetNumericValue("mu0", 1e-1);
+  options.SetNumericValue("tolerance", 1e-6);
+}
+
+static void usage(const char* exeName)
+{
+  printf("HiOp driver %s that warm starts a perturbed instance of Ex4 from a saved solver state\n", exeName);
+  printf("Usage: \n");
+  printf("  '$ %s sp_vars_size de_vars_size perturbation -selfcheck'\n", exeName);
+  printf("Arguments, excepting string '-selfcheck'\n");
+  printf("  'sp_vars_size': # of sparse variables [default 400, optional]\n");
+  printf("  'de_vars_size': # of dense variables [default 100, optional]\n");
+  printf("  'perturbation': relative perturbation of the active bounds [default 0.01, optional]\n");
+  printf("  '-selfcheck': checks that the warm start reaches the solution of the cold start in "
+         "fewer iterations. [optional]\n");
+}
+
+int main(int argc, char **argv)
+{
+  int rank=0;
+#ifdef HIOP_USE_MPI
+  MPI_Init(&argc, &argv);
+  int comm_size;
+  int ierr = MPI_Comm_size(MPI_COMM_WORLD, &comm_size); assert(MPI_SUCCESS==ierr);
+  ierr = MPI_Comm_rank(MPI_COMM_WORLD, &rank); assert(MPI_SUCCESS==ierr);
+  if(comm_size != 1) {
+    printf("[error] driver detected more than one rank but the driver should be run "
+           "in serial only; will exit\n");
+    MPI_Finalize();
+    return 1;
+  }
+#endif
+
+  int n_sp = 400, n_de = 100;
+  double perturb = 0.01;
+  bool self_check = false;
+  int num_args = 0;
+  for(int i=1; i<argc; i++) {
+    if(std::string(argv[i]) == "-selfcheck") {
+      self_check = true;
+    } else if(num_args==0) {
+      n_sp = std::atoi(argv[i]); num_args++;
+    } else if(num_args==1) {
+      n_de = std::atoi(argv[i]); num_args++;
+    } else if(num_args==2) {
+      perturb = std::atof(argv[i]); num_args++;
+    } else {
+      usage(argv[0]);
+#ifdef HIOP_USE_MPI
+      MPI_Finalize();
+#endif
+      return 1;
+    }
+  }
+  if(n_sp<=0 || n_de<=0 || perturb<=-1.) {
+    usage(argv[0]);
+#ifdef HIOP_USE_MPI
+    MPI_Finalize();
+#endif
+    return 1;
+  }
+
+  int ret_code = 0;
+  Ex4Perturbed my_nlp(n_sp, n_de);
+  hiopNlpMDS nlp(my_nlp);
+  set_options(*nlp.options);
+
+  //solve the nominal problem and save the state of the solver
+  hiopAlgFilterIPMNewton solver(&nlp);
+  hiopSolveStatus status = solver.run();
+  const int iter_nominal = solver.getNumIterations();
+  hiopAlgFilterIPMState* state = solver.save_state();
+  if(status<0) {
+    printf("solver returned negative solve status for the nominal problem: %d\n", status);
+    ret_code = -1;
+  }
+
+  //cold start of the perturbed problem
+  my_nlp.set_xupp(0.25*(1.+perturb));
+  nlp.reload_problem_data();
+  status = solver.run();
+  const int iter_cold = solver.getNumIterations();
+  const double obj_cold = solver.getObjective();
+  if(status<0) {
+    printf("solver returned negative solve status for the perturbed problem: %d\n", status);
+    ret_code = -1;
+  }
+
+  //warm start of the perturbed problem from the state of the nominal solve
+  solver.set_warm_start_state(state);
+  status = solver.run();
+  const int iter_warm = solver.getNumIterations();
+  const double obj_warm = solver.getObjective();
+  solver.set_warm_start_state(nullptr);
+  if(status<0) {
+    printf("solver returned negative solve status for the warm started problem: %d\n", status);
+    ret_code = -1;
+  }
+
+  if(rank==0) {
+    printf("iterations: nominal %d, perturbed cold start %d, perturbed warm start %d\n",
+           iter_nominal, iter_cold, iter_warm);
+    printf("objective: perturbed cold start %18.12e, perturbed warm start %18.12e\n", obj_cold, obj_warm);
+  }
+
+  if(self_check) {
+    if(std::fabs(obj_warm-obj_cold) > 1e-5*(1.+std::fabs(obj_cold))) {
+      printf("selfcheck failure: the objective of the warm start %18.12e differs from the one of the "
+             "cold start %18.12e\n", obj_warm, obj_cold);
+      ret_code = -1;
+    }
+    if(iter_warm >= iter_cold) {
+      printf("selfcheck failure: the warm start took %d iterations, the cold start %d\n",
+             iter_warm, iter_cold);
+      ret_code = -1;
+    }
+    if(0==ret_code) {
+      printf("selfcheck passed\n");
+    }
+  }
+
+  delete state;
+#ifdef HIOP_USE_MPI
+  MPI_Finalize();
+#endif
+  return ret_code;
+}
@@ -0,0 +1,408 @@
+#include "hiopInterface.hpp"
+#include "hiopNlpFormulation.hpp"
+#include "hiopAlgFilterIPM.hpp"
+
+#include <cstdlib>
+#include <cstdio>
+#include <cmath>
+#include <string>
+
+using namespace hiop;
+
+/**
+ * Driver for the linear constraints of the MDS NLP formulation: the Jacobian rows of the constraints
+ * declared linear are requested from the user only once per solve when the row-subset callbacks are
+ * provided, and the remaining rows are merged with them by the positions of their nonzeros.
+ *
+ * The problem has 3 sparse variables xs and 2 dense variables xd
+ *   min  0.5 sum (xs_i-1)^2 + 0.5 (xd_0^2 + xd_1^2)
+ *   s.t. xs_0 + xs_1 + xs_2 + xd_0 = 1     (c0, linear equality)
+ *        xs_0^2 + xd_1^2 <= 4              (c1, nonlinear inequality)
+ *        xs_1 - xd_1 = 0                   (c2, linear equality)
+ *        xs_2^2 + xs_1 = 1                 (c3, nonlinear equality)
+ *        xd_0 + xd_1 >= -5                 (c4, linear inequality)
+ * The constraints are declared with their actual types and, for comparison, all as nonlinear, and
+ * are evaluated with the row-subset callbacks and with the one-call callbacks.
+ */
+class MdsLinCons : public hiopInterfaceMDS
+{
+public:
+  MdsLinCons(bool declare_linear, bool one_call)
+    : declare_linear_(declare_linear),
+      one_call_(one_call),
+      num_lin_rows_evals_(0)
+  {
+  }
+  virtual ~MdsLinCons()
+  {
+  }
+
+  bool get_prob_sizes(size_type& n, size_type& m)
+  {
+    n = ns_+nd_;
+    m = m_;
+    return true;
+  }
+
+  bool get_vars_info(const size_type& n, double *xlow, double* xupp, NonlinearityType* type)
+  {
+    for(int i=0; i<n; i++) {
+      xlow[i] = -1e20;
+      xupp[i] = +1e20;
+      type[i] = hiopNonlinear;
+    }
+    return true;
+  }
+
+  bool get_cons_info(const size_type& m, double* clow, double* cupp, NonlinearityType* type)
+  {
+    assert(m==m_);
+    clow[0] = 1.;    cupp[0] = 1.;
+    clow[1] = -1e20; cupp[1] = 4.;
+    clow[2] = 0.;    cupp[2] = 0.;
+    clow[3] = 1.;    cupp[3] = 1.;
+    clow[4] = -5.;   cupp[4] = 1e20;
+    for(int i=0; i<m; i++) {
+      type[i] = hiopNonlinear;
+    }
+    if(declare_linear_) {
+      type[0] = type[2] = type[4] = hiopLinear;
+    }
+    return true;
+  }
+
+  bool get_sparse_dense_blocks_info(int& nx_sparse, int& nx_dense,
+                                    int& nnz_sparse_Jace, int& nnz_sparse_Jaci,
+                                    int& nnz_sparse_Hess_Lagr_SS, int& nnz_sparse_Hess_Lagr_SD)
+  {
+    nx_sparse = ns_;
+    nx_dense = nd_;
+    //c0, c2, c3
+    nnz_sparse_Jace = 3+1+2;
+    //c1, c4
+    nnz_sparse_Jaci = 1;
+    nnz_sparse_Hess_Lagr_SS = ns_;
+    nnz_sparse_Hess_Lagr_SD = 0;
+    return true;
+  }
+
+  bool eval_f(const size_type& n, const double* x, bool new_x, double& obj_value)
+  {
+    obj_value = 0.;
+    for(int i=0; i<ns_; i++) {
+      obj_value += 0.5*(x[i]-1.)*(x[i]-1.);
+    }
+    obj_value += 0.5*(x[ns_]*x[ns_] + x[ns_+1]*x[ns_+1]);
+    return true;
+  }
+
+  bool eval_grad_f(const size_type& n, const double* x, bool new_x, double* gradf)
+  {
+    for(int i=0; i<ns_; i++) {
+      gradf[i] = x[i]-1.;
+    }
+    gradf[ns_] = x[ns_];
+    gradf[ns_+1] = x[ns_+1];
+    return true;
+  }
+
+  bool eval_cons(const size_type& n,
+                 const size_type& m,
+                 const size_type& num_cons,
+                 const index_type* idx_cons,
+                 const double* x,
+                 bool new_x,
+                 double* cons)
+  {
+    if(one_call_) {
+      //the one-call overload below is used
+      return false;
+    }
+    double cons_all[m_];
+    eval_cons(n, m, x, new_x, cons_all);
+    for(int k=0; k<num_cons; k++) {
+      cons[k] = cons_all[idx_cons[k]];
+    }
+    return true;
+  }
+
+  bool eval_cons(const size_type& n, const size_type& m, const double* x, bool new_x, double* cons)
+  {
+    const double* xs = x;
+    const double* xd = x+ns_;
+    cons[0] = xs[0] + xs[1] + xs[2] + xd[0];
+    cons[1] = xs[0]*xs[0] + xd[1]*xd[1];
+    cons[2] = xs[1] - xd[1];
+    cons[3] = xs[2]*xs[2] + xs[1];
+    cons[4] = xd[0] + xd[1];
+    return true;
+  }
+
+  bool eval_Jac_cons(const size_type& n,
+                     const size_type& m,
+                     const size_type& num_cons,
+                     const index_type* idx_cons,
+                     const double* x,
+                     bool new_x,
+                     const size_type& nsparse,
+                     const size_type& ndense,
+                     const size_type& nnzJacS,
+                     index_type* iJacS,
+                     index_type* jJacS,
+                     double* MJacS,
+                     double* JacD)
+  {
+    if(one_call_) {
+      //the one-call overload below is used
+      return false;
+    }
+    //the rows 'idx_cons' of the Jacobian, with the row indexes relative to 'idx_cons'
+    int nnzit = 0;
+    for(int k=0; k<num_cons; k++) {
+      const int con_idx = idx_cons[k];
+      if(is_linear(con_idx)) {
+        num_lin_rows_evals_++;
+      }
+      for(int it=row_starts_[con_idx]; it<row_starts_[con_idx+1]; it++, nnzit++) {
+        assert(nnzit<nnzJacS);
+        if(iJacS!=nullptr && jJacS!=nullptr) {
+          iJacS[nnzit] = k;
+          jJacS[nnzit] = cols_[it];
+        }
+        if(MJacS!=nullptr) {
+          MJacS[nnzit] = jac_sparse_value(it, x);
+        }
+      }
+      if(JacD!=nullptr) {
+        jac_dense_row(con_idx, x, JacD+k*nd_);
+      }
+    }
+    assert(nnzit==nnzJacS);
+    return true;
+  }
+
+  bool eval_Jac_cons(const size_type& n,
+                     const size_type& m,
+                     const double* x,
+                     bool new_x,
+                     const size_type& nsparse,
+                     const size_type& ndense,
+                     const size_type& nnzJacS,
+                     index_type* iJacS,
+                     index_type* jJacS,
+                     double* MJacS,
+                     double* JacD)
+  {
+    assert(nnzJacS==row_starts_[m_]);
+    for(int con_idx=0; con_idx<m_; con_idx++) {
+      if(is_linear(con_idx)) {
+        num_lin_rows_evals_++;
+      }
+      for(int it=row_starts_[con_idx]; it<row_starts_[con_idx+1]; it++) {
+        if(iJacS!=nullptr && jJacS!=nullptr) {
+          iJacS[it] = con_idx;
+          jJacS[it] = cols_[it];
+        }
+        if(MJacS!=nullptr) {
+          MJacS[it] = jac_sparse_value(it, x);
+        }
+      }
+      if(JacD!=nullptr) {
+        jac_dense_row(con_idx, x, JacD+con_idx*nd_);
+      }
+    }
+    return true;
+  }
+
+  bool eval_Hess_Lagr(const size_type& n,
+                      const size_type& m,
+                      const double* x,
+                      bool new_x,
+                      const double& obj_factor,
+                      const double* lambda,
+                      bool new_lambda,
+                      const size_type& nsparse,
+                      const size_type& ndense,
+                      const size_type& nnzHSS,
+                      index_type* iHSS,
+                      index_type* jHSS,
+                      double* MHSS,
+                      double* HDD,
+                      size_type& nnzHSD,
+                      index_type* iHSD,
+                      index_type* jHSD,
+                      double* MHSD)
+  {
+    assert(nnzHSS==ns_);
+    if(iHSS!=nullptr && jHSS!=nullptr) {
+      for(int i=0; i<ns_; i++) {
+        iHSS[i] = jHSS[i] = i;
+      }
+    }
+    //the multipliers are in [eq; ineq] order: c0, c2, c3, c1, c4
+    if(MHSS!=nullptr) {
+      MHSS[0] = obj_factor + 2*lambda[3];
+      MHSS[1] = obj_factor;
+      MHSS[2] = obj_factor + 2*lambda[2];
+    }
+    if(HDD!=nullptr) {
+      HDD[0] = obj_factor;
+      HDD[1] = HDD[2] = 0.;
+      HDD[3] = obj_factor + 2*lambda[3];
+    }
+    return true;
+  }
+
+  bool get_starting_point(const size_type& n, double* x0)
+  {
+    for(int i=0; i<n; i++) {
+      x0[i] = 0.5;
+    }
+    return true;
+  }
+
+  /// Number of the Jacobian rows of the linear constraints c0, c2 and c4 evaluated so far
+  int num_lin_rows_evals() const { return num_lin_rows_evals_; }
+private:
+  static bool is_linear(int con_idx)
+  {
+    return 0==con_idx || 2==con_idx || 4==con_idx;
+  }
+
+  /// value of the it-th nonzero of the sparse block of the Jacobian, see cols_
+  static double jac_sparse_value(int it, const double* x)
+  {
+    switch(it) {
+    case 3: return 2*x[0];
+    case 6: return 2*x[2];
+    default: return 1.;
+    }
+  }
+
+  /// row 'con_idx' of the dense block of the Jacobian
+  void jac_dense_row(int con_idx, const double* x, double* row) const
+  {
+    const double* xd = x+ns_;
+    const double JacD_vals[] = {1., 0., 0., 2*xd[1], 0., -1., 0., 0., 1., 1.};
+    for(int j=0; j<nd_; j++) {
+      row[j] = JacD_vals[con_idx*nd_+j];
+    }
+  }
+
+  static const int ns_ = 3;
+  static const int nd_ = 2;
+  static const int m_ = 5;
+  /// sparse block of the Jacobian: the nonzeros of row i are in [row_starts_[i], row_starts_[i+1])
+  static const int row_starts_[m_+1];
+  static const int cols_[7];
+  bool declare_linear_;
+  bool one_call_;
+  int num_lin_rows_evals_;
+};
+
+const int MdsLinCons::row_starts_[] = {0, 3, 4, 5, 7, 7};
+const int MdsLinCons::cols_[] = {0, 1, 2, 0, 1, 1, 2};
+
+static void set_options(hiopNlpMDS& nlp)
+{
+  nlp.options->SetStringValue("Hessian", "analytical_exact");
+  nlp.options->SetStringValue("KKTLinsys", "xdycyd");
+  nlp.options->SetStringValue("compute_mode", "cpu");
+  nlp.options->SetIntegerValue("verbosity_level", 0);
+  nlp.options->SetNumericValue("tolerance", 1e-8);
+}
+
+static double solve(bool declare_linear, bool one_call, hiopSolveStatus& status, int& num_iter,
+                    int& num_lin_rows_evals)
+{
+  MdsLinCons prob(declare_linear, one_call);
+  hiopNlpMDS nlp(prob);
+  set_options(nlp);
+
+  hiopAlgFilterIPMNewton solver(&nlp);
+  status = solver.run();
+  num_iter = solver.getNumIterations();
+  num_lin_rows_evals = prob.num_lin_rows_evals();
+  return solver.getObjective();
+}
+
+static void usage(const char* exeName)
+{
+  printf("HiOp driver %s that checks the caching of the Jacobian rows of the linear constraints of MDS NLPs\n",
+         exeName);
+  printf("Usage: \n");
+  printf("  '$ %s -selfcheck'\n", exeName);
+  printf("Arguments:\n");
+  printf("  '-selfcheck': checks that the Jacobian rows of the linear constraints are evaluated once and "
+         "that the problem solves the same with and without declaring them linear. [optional]\n");
+}
+
+int main(int argc, char **argv)
+{
+#ifdef HIOP_USE_MPI
+  MPI_Init(&argc, &argv);
+  int comm_size;
+  int ierr = MPI_Comm_size(MPI_COMM_WORLD, &comm_size); assert(MPI_SUCCESS==ierr);
+  if(comm_size != 1) {
+    printf("[error] driver detected more than one rank but the driver should be run "
+           "in serial only; will exit\n");
+    MPI_Finalize();
+    return 1;
+  }
+#endif
+
+  bool self_check = false;
+  for(int i=1; i<argc; i++) {
+    if(std::string(argv[i]) == "-selfcheck") {
+      self_check = true;
+    } else {
+      usage(argv[0]);
+#ifdef HIOP_USE_MPI
+      MPI_Finalize();
+#endif
+      return 1;
+    }
+  }
+
+  int ret_code = 0;
+
+  //reference: all the constraints declared nonlinear and evaluated with the one-call callbacks
+  hiopSolveStatus status_ref;
+  int iter_ref, num_lin_rows_ref;
+  const double obj_ref = solve(false, true, status_ref, iter_ref, num_lin_rows_ref);
+  if(status_ref<0) {
+    printf("solver returned negative solve status %d\n", status_ref);
+    ret_code = -1;
+  }
+  for(bool one_call : {true, false}) {
+    for(bool declare_linear : {true, false}) {
+      hiopSolveStatus status;
+      int num_iter, num_lin_rows;
+      const double obj = solve(declare_linear, one_call, status, num_iter, num_lin_rows);
+      printf("linear constraints %s, %s callbacks: status %d, %d iterations, objective %18.12e, "
+             "%d evaluations of the Jacobian rows of the linear constraints\n",
+             declare_linear ? "declared" : "not declared", one_call ? "one-call" : "row-subset",
+             status, num_iter, obj, num_lin_rows);
+      if(status<0 || num_iter!=iter_ref || std::fabs(obj-obj_ref) > 1e-10*(1.+std::fabs(obj_ref))) {
+        printf("the solve differs from the one with all the constraints nonlinear (status %d, %d iterations, "
+               "objective %18.12e)\n", status_ref, iter_ref, obj_ref);
+        ret_code = -1;
+      }
+      //the rows of c0, c2 and c4 are evaluated once when they can be requested separately
+      if(declare_linear && !one_call && num_lin_rows!=3) {
+        printf("the Jacobian rows of the linear constraints were evaluated %d times instead of once\n",
+               num_lin_rows/3);
+        ret_code = -1;
+      }
+    }
+  }
+
+  if(0==ret_code && self_check) {
+    printf("selfcheck passed\n");
+  }
+
+#ifdef HIOP_USE_MPI
+  MPI_Finalize();
+#endif
+  return ret_code;
+}
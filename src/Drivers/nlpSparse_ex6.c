@@ -0,0 +1,194 @@
+#include <assert.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include "hiopInterface.h"
+#include <math.h>
+
+/* C version of Ex6 (with scal=1) used to test the C interface for sparse NLPs:
+ *  min   sum 1/4* { (x_{i}-1)^4 : i=1,...,n}
+ *  s.t.
+ *             4*x_1 + 2*x_2                     == 10
+ *        5 <= 2*x_1         + x_3
+ *        1 <= 2*x_1                 + 0.5*x_i   <= 2*n, for i=4,...,n
+ *        x_1 free
+ *        0.0 <= x_2
+ *        1.5 <= x_3 <= 10
+ *        x_i >=0.5, i=4,...,n
+ * The constraints are passed as linear. The problem is solved twice with the same problem object.
+ */
+typedef struct settings {
+  hiop_size_type n; hiop_size_type m;
+} settings;
+
+int get_starting_point(hiop_size_type n, double* x0, void* user_data_) {
+  settings* user_data = (settings*) user_data_;
+  for(int i=0; i<user_data->n; i=i+1) x0[i]=0.;
+  return 0;
+}
+
+int get_prob_sizes(hiop_size_type* n_, hiop_size_type* m_, void* user_data_) {
+  settings* user_data = (settings*) user_data_;
+  *n_ = user_data->n;
+  *m_ = user_data->m;
+  return 0;
+} 
+
+int get_vars_info(hiop_size_type n, double *xlow_, double* xupp_, hiop_nonlinearity_type* type,
+                  void* user_data_) {
+  //the types are left as set by HiOp, i.e., hiop_nonlinear
+  xlow_[0] = -1e20; xupp_[0] = 1e20;
+  xlow_[1] = 0.0;   xupp_[1] = 1e20;
+  xlow_[2] = 1.5;   xupp_[2] = 10.0;
+  for(int i=3; i<n; i=i+1) {
+    xlow_[i] = 0.5; xupp_[i] = 1e20;
+  }
+  return 0;
+}
+
+int get_cons_info(hiop_size_type m, double *clow_, double* cupp_, hiop_nonlinearity_type* type,
+                  void* user_data_) {
+  settings* user_data = (settings*) user_data_;
+  clow_[0] = 10.0; cupp_[0] = 10.0;
+  clow_[1] = 5.0;  cupp_[1] = 1e20;
+  for(int i=2; i<m; i=i+1) {
+    clow_[i] = 1.0; cupp_[i] = 2*user_data->n;
+  }
+  for(int i=0; i<m; i=i+1) type[i] = hiop_linear;
+  return 0;
+}
+
+int eval_f(hiop_size_type n, double* x, int new_x, double* obj, void* user_data_) {
+  *obj = 0.;
+  for(int i=0; i<n; i=i+1) *obj += 0.25*pow(x[i]-1., 4);
+  return 0;
+}
+
+int eval_grad_f(hiop_size_type n, double* x, int new_x, double* gradf, void* user_data_) {
+  for(int i=0; i<n; i=i+1) gradf[i] = pow(x[i]-1., 3);
+  return 0;
+}
+
+int eval_cons(hiop_size_type n, hiop_size_type m,
+              double* x, int new_x, 
+              double* cons, void* user_data_) {
+  assert(m==n-1);
+  cons[0] = 4*x[0] + 2*x[1];
+  cons[1] = 2*x[0] + x[2];
+  for(int i=3; i<n; i=i+1) cons[i-1] = 2*x[0] + 0.5*x[i];
+  return 0;
+}
+
+int get_sparse_blocks_info(hiop_size_type* nx,
+                           hiop_size_type* nnz_sparse_Jaceq, hiop_size_type* nnz_sparse_Jacineq,
+                           hiop_size_type* nnz_sparse_Hess_Lagr, void* user_data_) {
+  settings* user_data = (settings*) user_data_;
+  *nx = user_data->n;
+  *nnz_sparse_Jaceq = 2;
+  *nnz_sparse_Jacineq = 2 + 2*(user_data->n-3);
+  *nnz_sparse_Hess_Lagr = user_data->n;
+  return 0;
+}
+
+int eval_Jac_cons(hiop_size_type n, hiop_size_type m,
+                  double* x, int new_x,
+                  hiop_size_type nnzJacS, hiop_index_type* iJacS, hiop_index_type* jJacS, double* MJacS, 
+                  void* user_data_) {
+  assert(nnzJacS == 4 + 2*(n-3));
+  //the (i,j) indexes are requested only once
+  if(iJacS!=NULL && jJacS!=NULL) {
+    int nnzit=0;
+    iJacS[nnzit] = 0; jJacS[nnzit] = 0; nnzit=nnzit+1;
+    iJacS[nnzit] = 0; jJacS[nnzit] = 1; nnzit=nnzit+1;
+    iJacS[nnzit] = 1; jJacS[nnzit] = 0; nnzit=nnzit+1;
+    iJacS[nnzit] = 1; jJacS[nnzit] = 2; nnzit=nnzit+1;
+    for(int i=3; i<n; i=i+1) {
+      iJacS[nnzit] = i-1; jJacS[nnzit] = 0; nnzit=nnzit+1;
+      iJacS[nnzit] = i-1; jJacS[nnzit] = i; nnzit=nnzit+1;
+    }
+    assert(nnzit==nnzJacS);
+  }
+  //values are written directly in HiOp's array
+  if(MJacS!=NULL) {
+    int nnzit=0;
+    MJacS[nnzit++] = 4.;
+    MJacS[nnzit++] = 2.;
+    MJacS[nnzit++] = 2.;
+    MJacS[nnzit++] = 1.;
+    for(int i=3; i<n; i=i+1) {
+      MJacS[nnzit++] = 2.;
+      MJacS[nnzit++] = 0.5;
+    }
+    assert(nnzit==nnzJacS);
+  }
+  return 0;
+}
+
+int eval_Hess_Lagr(hiop_size_type n, hiop_size_type m,
+                   double* x, int new_x, double obj_factor,
+                   double* lambda, int new_lambda,
+                   hiop_size_type nnzHSS, hiop_index_type* iHSS, hiop_index_type* jHSS, double* MHSS,
+                   void* user_data_) {
+  //Note: lambda is not used since all the constraints are linear and, therefore, do 
+  //not contribute to the Hessian of the Lagrangian
+  assert(nnzHSS==n);
+  if(iHSS!=NULL && jHSS!=NULL) {
+    for(int i=0; i<n; i=i+1) iHSS[i] = jHSS[i] = i;
+  }
+  if(MHSS!=NULL) {
+    for(int i=0; i<n; i=i+1) MHSS[i] = obj_factor*3*pow(x[i]-1., 2);
+  }
+  return 0;
+}
+
+
+int main(int argc, char **argv) {
+#ifdef HIOP_USE_MPI
+  MPI_Init(&argc, &argv);
+  int comm_size;
+  int ierr = MPI_Comm_size(MPI_COMM_WORLD, &comm_size); assert(MPI_SUCCESS==ierr);
+  if(comm_size != 1) {
+    printf("[error] driver detected more than one rank but the driver should be run "
+	   "in serial only; will exit\n");
+    MPI_Finalize();
+    return 1;
+  }
+#endif
+
+  hiop_size_type n = 500;
+  settings user_data = {n, n-1};
+
+  cHiopSparseProblem problem;
+  problem.user_data = &user_data;
+  problem.get_starting_point = get_starting_point;
+  problem.get_prob_sizes = get_prob_sizes;  
+  problem.get_vars_info = get_vars_info;
+  problem.get_cons_info = get_cons_info;
+  problem.eval_f = eval_f;
+  problem.eval_grad_f = eval_grad_f;
+  problem.eval_cons = eval_cons;
+  problem.get_sparse_blocks_info = get_sparse_blocks_info;
+  problem.eval_Jac_cons = eval_Jac_cons;
+  problem.eval_Hess_Lagr = eval_Hess_Lagr;
+  problem.solution = (double*)malloc(n * sizeof(double));
+  for(int i=0; i<n; i++) problem.solution[i] = 0.0;
+  
+  int ret_code = 0;
+  hiop_createSparseProblem(&problem);
+  //the problem object is reused for the second solve
+  for(int k=0; k<2; k++) {
+    int status = hiop_solveSparseProblem(&problem);
+    if(status<0 || fabs(problem.obj_value-1.10351566513480e-01)>1e-6*(1+1.10351566513480e-01)) {
+      printf("objective mismatch for Ex6 sparse C interface problem with 500 variables in solve %d. "
+             "BTW, obj=%18.12e was returned by HiOp with status %d.\n", k, problem.obj_value, status);
+      ret_code = -1;
+    }
+  }
+  hiop_destroySparseProblem(&problem);
+  free(problem.solution);
+#ifdef HIOP_USE_MPI
+  MPI_Finalize();
+#endif
+  return ret_code;
+}
@@ -0,0 +1,534 @@
+#include "hiopInterface.hpp"
+#include "hiopNlpFormulation.hpp"
+#include "hiopAlgFilterIPM.hpp"
+#include "hiopMatrixSparse.hpp"
+#include "hiopFiniteDiffSparse.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cmath>
+#include <string>
+#include <vector>
+
+using namespace hiop;
+
+/**
+ * Driver for the finite-difference derivatives of the sparse NLPs. The problem is
+ *
+ *  min   sum 1/4*(x_i-1)^4 + 1/2 sum (x_i-x_{i+1})^2
+ *  s.t.  x_1^2 + x_2 + x_3 == 3
+ *        1 <= 2*x_1 + 0.5*x_i + 0.1*x_i^2 <= 2*n, for i=4,...,n
+ *        x_i >= 0.5
+ *
+ * whose Jacobian and (tridiagonal) Hessian have three colors for any n. The Jacobian and the Hessian 
+ * approximated by finite differences are compared with the analytical ones, with the constraints 
+ * evaluated in one call and separately for the equalities and inequalities. The approximation of patterns
+ * with duplicate nonzeros and the rejection of 'fd_jacobian=yes' with 'fd_hessian=yes' are also checked.
+ * When HiOp is built with
+ * sparse linear solvers, the problem is also solved with the analytical and the finite-difference 
+ * derivatives.
+ */
+class ExFiniteDiff : public hiopInterfaceSparse
+{
+public:
+  ExFiniteDiff(int n, bool one_call_cons)
+    : n_(n), m_(n-2), one_call_cons_(one_call_cons), num_eval_cons_(0)
+  {
+    assert(n>=4);
+  }
+  virtual ~ExFiniteDiff()
+  {
+  }
+
+  bool get_prob_sizes(size_type& n, size_type& m)
+  {
+    n = n_;
+    m = m_;
+    return true;
+  }
+
+  bool get_vars_info(const size_type& n, double *xlow, double* xupp, NonlinearityType* type)
+  {
+    for(int i=0; i<n; i++) {
+      xlow[i] = 0.5;
+      xupp[i] = 1e20;
+      type[i] = hiopNonlinear;
+    }
+    return true;
+  }
+
+  bool get_cons_info(const size_type& m, double* clow, double* cupp, NonlinearityType* type)
+  {
+    clow[0] = cupp[0] = 3.;
+    for(int k=1; k<m; k++) {
+      clow[k] = 1.;
+      cupp[k] = 2.*n_;
+    }
+    for(int k=0; k<m; k++) {
+      type[k] = hiopNonlinear;
+    }
+    return true;
+  }
+
+  bool get_sparse_blocks_info(size_type& nx,
+                              size_type& nnz_sparse_Jaceq,
+                              size_type& nnz_sparse_Jacineq,
+                              size_type& nnz_sparse_Hess_Lagr)
+  {
+    nx = n_;
+    nnz_sparse_Jaceq = 3;
+    nnz_sparse_Jacineq = 2*(m_-1);
+    nnz_sparse_Hess_Lagr = 2*n_-1;
+    return true;
+  }
+
+  bool eval_f(const size_type& n, const double* x, bool new_x, double& obj_value)
+  {
+    obj_value = 0.;
+    for(int i=0; i<n; i++) {
+      obj_value += 0.25*pow(x[i]-1., 4);
+    }
+    for(int i=0; i<n-1; i++) {
+      obj_value += 0.5*(x[i]-x[i+1])*(x[i]-x[i+1]);
+    }
+    return true;
+  }
+
+  bool eval_grad_f(const size_type& n, const double* x, bool new_x, double* gradf)
+  {
+    for(int i=0; i<n; i++) {
+      gradf[i] = pow(x[i]-1., 3);
+    }
+    for(int i=0; i<n-1; i++) {
+      gradf[i] += x[i]-x[i+1];
+      gradf[i+1] -= x[i]-x[i+1];
+    }
+    return true;
+  }
+
+  bool eval_cons(const size_type& n,
+                 const size_type& m,
+                 const size_type& num_cons,
+                 const index_type* idx_cons,
+                 const double* x,
+                 bool new_x,
+                 double* cons)
+  {
+    if(one_call_cons_) {
+      return false;
+    }
+    for(int it=0; it<num_cons; it++) {
+      cons[it] = con(idx_cons[it], x);
+    }
+    num_eval_cons_++;
+    return true;
+  }
+
+  bool eval_cons(const size_type& n, const size_type& m, const double* x, bool new_x, double* cons)
+  {
+    if(!one_call_cons_) {
+      return false;
+    }
+    for(int k=0; k<m; k++) {
+      cons[k] = con(k, x);
+    }
+    num_eval_cons_++;
+    return true;
+  }
+
+  bool eval_Jac_cons(const size_type& n,
+                     const size_type& m,
+                     const size_type& num_cons,
+                     const index_type* idx_cons,
+                     const double* x,
+                     bool new_x,
+                     const size_type& nnzJacS,
+                     index_type* iJacS,
+                     index_type* jJacS,
+                     double* MJacS)
+  {
+    if(one_call_cons_) {
+      return false;
+    }
+    int nnzit = 0;
+    for(int it=0; it<num_cons; it++) {
+      Jac_row(idx_cons[it], it, x, nnzit, iJacS, jJacS, MJacS);
+    }
+    assert(nnzit==nnzJacS);
+    return true;
+  }
+
+  bool eval_Jac_cons(const size_type& n,
+                     const size_type& m,
+                     const double* x,
+                     bool new_x,
+                     const size_type& nnzJacS,
+                     index_type* iJacS,
+                     index_type* jJacS,
+                     double* MJacS)
+  {
+    if(!one_call_cons_) {
+      return false;
+    }
+    int nnzit = 0;
+    for(int k=0; k<m; k++) {
+      Jac_row(k, k, x, nnzit, iJacS, jJacS, MJacS);
+    }
+    assert(nnzit==nnzJacS);
+    return true;
+  }
+
+  bool eval_Hess_Lagr(const size_type& n,
+                      const size_type& m,
+                      const double* x,
+                      bool new_x,
+                      const double& obj_factor,
+                      const double* lambda,
+                      bool new_lambda,
+                      const size_type& nnzHSS,
+                      index_type* iHSS,
+                      index_type* jHSS,
+                      double* MHSS)
+  {
+    assert(nnzHSS==2*n-1);
+    //diagonal first, then the upper off-diagonal
+    if(iHSS!=nullptr && jHSS!=nullptr) {
+      for(int i=0; i<n; i++) {
+        iHSS[i] = jHSS[i] = i;
+      }
+      for(int i=0; i<n-1; i++) {
+        iHSS[n+i] = i;
+        jHSS[n+i] = i+1;
+      }
+    }
+    if(MHSS!=nullptr) {
+      for(int i=0; i<n; i++) {
+        MHSS[i] = obj_factor*(3*pow(x[i]-1., 2) + (i>0 ? 1. : 0.) + (i<n-1 ? 1. : 0.));
+      }
+      for(int i=0; i<n-1; i++) {
+        MHSS[n+i] = -obj_factor;
+      }
+      MHSS[0] += 2.*lambda[0];
+      for(int k=1; k<m; k++) {
+        MHSS[k+2] += 0.2*lambda[k];
+      }
+    }
+    return true;
+  }
+
+  bool get_starting_point(const size_type& n, double* x0)
+  {
+    for(int i=0; i<n; i++) {
+      x0[i] = 1.;
+    }
+    return true;
+  }
+
+  inline int get_num_eval_cons() const { return num_eval_cons_; }
+private:
+  double con(int k, const double* x) const
+  {
+    if(0==k) {
+      return x[0]*x[0] + x[1] + x[2];
+    }
+    return 2*x[0] + 0.5*x[k+2] + 0.1*x[k+2]*x[k+2];
+  }
+
+  void Jac_row(int k, int row, const double* x, int& nnzit, index_type* iJacS, index_type* jJacS, double* MJacS)
+  {
+    const int cols0[] = {0, 1, 2};
+    const double vals0[] = {2*x[0], 1., 1.};
+    const int colsk[] = {0, k+2};
+    const double valsk[] = {2., 0.5+0.2*x[k+2]};
+    const int nz = 0==k ? 3 : 2;
+    for(int it=0; it<nz; it++, nnzit++) {
+      if(iJacS!=nullptr && jJacS!=nullptr) {
+        iJacS[nnzit] = row;
+        jJacS[nnzit] = 0==k ? cols0[it] : colsk[it];
+      }
+      if(MJacS!=nullptr) {
+        MJacS[nnzit] = 0==k ? vals0[it] : valsk[it];
+      }
+    }
+  }
+private:
+  int n_;
+  int m_;
+  bool one_call_cons_;
+  int num_eval_cons_;
+};
+
+/// Sparse derivatives at a fixed point; the Hessian is at fixed multipliers
+struct Derivatives
+{
+  std::vector<double> Jac_c;
+  std::vector<double> Jac_d;
+  std::vector<double> Hess;
+  int num_eval_cons;
+};
+
+static void set_options(hiopNlpSparse& nlp, const char* fd_jacobian, const char* fd_hessian)
+{
+  nlp.options->SetStringValue("fd_jacobian", fd_jacobian);
+  nlp.options->SetStringValue("fd_hessian", fd_hessian);
+  nlp.options->SetIntegerValue("fd_num_threads", 2);
+  nlp.options->SetStringValue("Hessian", "analytical_exact");
+  nlp.options->SetStringValue("duals_update_type", "linear");
+  nlp.options->SetStringValue("compute_mode", "cpu");
+  nlp.options->SetStringValue("KKTLinsys", "xdycyd");
+  nlp.options->SetIntegerValue("verbosity_level", 0);
+  nlp.options->SetNumericValue("mu0", 0.1);
+}
+
+static bool eval_derivatives(int n, bool one_call_cons, const char* fd_jacobian, const char* fd_hessian, 
+                             Derivatives& der)
+{
+  ExFiniteDiff problem(n, one_call_cons);
+  hiopNlpSparse nlp(problem);
+  set_options(nlp, fd_jacobian, fd_hessian);
+  if(!nlp.finalizeInitialization()) {
+    return false;
+  }
+
+  hiopVector* x = nlp.alloc_primal_vec();
+  double* x_arr = x->local_data();
+  for(int i=0; i<n; i++) {
+    x_arr[i] = 1.3 + 0.01*i;
+  }
+  hiopVector* lambda_eq = nlp.alloc_dual_eq_vec();
+  hiopVector* lambda_ineq = nlp.alloc_dual_ineq_vec();
+  lambda_eq->setToConstant(0.7);
+  lambda_ineq->setToConstant(-0.4);
+
+  hiopMatrix* Jac_c = nlp.alloc_Jac_c();
+  hiopMatrix* Jac_d = nlp.alloc_Jac_d();
+  hiopMatrix* Hess = nlp.alloc_Hess_Lagr();
+
+  bool bret = nlp.eval_Jac_c_d(*x, true, *Jac_c, *Jac_d) &&
+              nlp.eval_Hess_Lagr(*x, true, 1., *lambda_eq, *lambda_ineq, true, *Hess);
+  der.num_eval_cons = problem.get_num_eval_cons();
+
+  auto values = [](hiopMatrix* M) {
+    hiopMatrixSparse* Msp = dynamic_cast<hiopMatrixSparse*>(M);
+    return std::vector<double>(Msp->M(), Msp->M()+Msp->numberOfNonzeros());
+  };
+  der.Jac_c = values(Jac_c);
+  der.Jac_d = values(Jac_d);
+  der.Hess = values(Hess);
+
+  delete x;
+  delete lambda_eq;
+  delete lambda_ineq;
+  delete Jac_c;
+  delete Jac_d;
+  delete Hess;
+  return bret;
+}
+
+static bool compare(const std::vector<double>& fd, const std::vector<double>& exact, const char* name)
+{
+  double err = 0.;
+  for(size_t k=0; k<exact.size(); k++) {
+    err = std::max(err, std::fabs(fd[k]-exact[k])/(1.+std::fabs(exact[k])));
+  }
+  if(fd.size()!=exact.size() || err>1e-5) {
+    printf("%s: the finite-difference approximation differs from the analytical one (rel. error %.3e)\n", 
+           name, err);
+    return false;
+  }
+  return true;
+}
+
+static bool check_derivatives(int n, bool one_call_cons)
+{
+  const char* name = one_call_cons ? "one-call constraints" : "split constraints";
+  Derivatives exact, fd_jac, fd_hess;
+  if(!eval_derivatives(n, one_call_cons, "no", "no", exact) ||
+     !eval_derivatives(n, one_call_cons, "yes", "no", fd_jac) ||
+     !eval_derivatives(n, one_call_cons, "no", "yes", fd_hess)) {
+    printf("%s: the evaluation of the derivatives failed\n", name);
+    return false;
+  }
+  printf("%s: %d constraints evaluations for the finite-difference Jacobian with %d variables\n",
+         name, fd_jac.num_eval_cons, n);
+  bool bret = compare(fd_jac.Jac_c, exact.Jac_c, "Jacobian of the equalities") &&
+              compare(fd_jac.Jac_d, exact.Jac_d, "Jacobian of the inequalities") &&
+              compare(fd_hess.Hess, exact.Hess, "Hessian");
+  //the three colors of the Jacobian plus the unperturbed point, for the equalities and the inequalities
+  //when the constraints are split
+  if(fd_jac.num_eval_cons > (one_call_cons ? 4 : 8)) {
+    printf("%s: too many constraints evaluations (%d) for the finite-difference Jacobian\n",
+           name, fd_jac.num_eval_cons);
+    bret = false;
+  }
+  return bret;
+}
+
+/// the finite-difference Hessian needs the user's Jacobian for the curvature of the nonlinear constraints
+static bool check_fd_jac_and_hess_rejected(int n)
+{
+  ExFiniteDiff problem(n, true);
+  hiopNlpSparse nlp(problem);
+  set_options(nlp, "yes", "yes");
+  if(nlp.finalizeInitialization()) {
+    printf("'fd_jacobian=yes' and 'fd_hessian=yes' were accepted with nonlinear constraints\n");
+    return false;
+  }
+  //the solver should not run either
+  hiopAlgFilterIPMNewton solver(&nlp);
+  const hiopSolveStatus status = solver.run();
+  if(status != SolveInitializationError) {
+    printf("the solver ran with 'fd_jacobian=yes' and 'fd_hessian=yes' (status %d)\n", status);
+    return false;
+  }
+  return true;
+}
+
+/**
+ * Duplicate nonzeros are summed in the triplet format, hence the sum of the approximations of the duplicates
+ * should be the derivative. For the symmetric matrix, (0,1) and (1,0) are also duplicates.
+ */
+static bool check_duplicates()
+{
+  //f(x) = [x0*x1; x2^2+x0] with the Jacobian [x1 x0 0; 1 0 2*x2]
+  const index_type irow[] = {0, 0, 0, 1, 1, 1};
+  const index_type jcol[] = {0, 1, 0, 2, 0, 2};
+  auto f = [](const double* x, double* fx) {
+    fx[0] = x[0]*x[1];
+    fx[1] = x[2]*x[2] + x[0];
+    return true;
+  };
+  //g(x) = gradient of 0.5*x0^2 + x0*x1 + x2^2 with the Hessian [1 1 0; 1 0 0; 0 0 2]
+  const index_type irow_sym[] = {0, 0, 1, 2, 2};
+  const index_type jcol_sym[] = {0, 1, 0, 2, 2};
+  auto g = [](const double* x, double* gx) {
+    gx[0] = x[0] + x[1];
+    gx[1] = x[0];
+    gx[2] = 2*x[2];
+    return true;
+  };
+  const double x[] = {1.5, -2., 0.5};
+  const double Jac[2][3] = {{x[1], x[0], 0.}, {1., 0., 2*x[2]}};
+  const double Hess[3][3] = {{1., 1., 0.}, {1., 0., 0.}, {0., 0., 2.}};
+
+  hiopFiniteDiffSparse fd(2, 3, 6, irow, jcol, false, 1e-7, 1);
+  hiopFiniteDiffSparse fd_sym(3, 3, 5, irow_sym, jcol_sym, true, 1e-7, 1);
+  double M[6], M_sym[5];
+  if(!fd.eval(f, x, M) || !fd_sym.eval(g, x, M_sym)) {
+    printf("duplicate nonzeros: the finite-difference approximation failed\n");
+    return false;
+  }
+  //sums of the duplicates, with the symmetric nonzeros in the upper triangle
+  double sum[3][3] = {{0.}}, sum_sym[3][3] = {{0.}};
+  for(int k=0; k<6; k++) {
+    sum[irow[k]][jcol[k]] += M[k];
+  }
+  for(int k=0; k<5; k++) {
+    sum_sym[std::min(irow_sym[k], jcol_sym[k])][std::max(irow_sym[k], jcol_sym[k])] += M_sym[k];
+  }
+  double err = 0.;
+  for(int i=0; i<3; i++) {
+    for(int j=0; j<3; j++) {
+      if(i<2) {
+        err = std::max(err, std::fabs(sum[i][j]-Jac[i][j]));
+      }
+      if(i<=j) {
+        err = std::max(err, std::fabs(sum_sym[i][j]-Hess[i][j]));
+      }
+    }
+  }
+  if(err>1e-5) {
+    printf("duplicate nonzeros: the sums of the approximations differ from the derivatives (error %.3e)\n", err);
+    return false;
+  }
+  return true;
+}
+
+#ifdef HIOP_SPARSE
+static bool check_solve(int n)
+{
+  double obj[3];
+  const char* fd_jacobian[] = {"no", "yes", "no"};
+  const char* fd_hessian[] = {"no", "no", "yes"};
+  for(int it=0; it<3; it++) {
+    ExFiniteDiff problem(n, true);
+    hiopNlpSparse nlp(problem);
+    set_options(nlp, fd_jacobian[it], fd_hessian[it]);
+    hiopAlgFilterIPMNewton solver(&nlp);
+    hiopSolveStatus status = solver.run();
+    obj[it] = solver.getObjective();
+    printf("fd_jacobian=%s fd_hessian=%s: status %d, %d iterations, objective %18.12e\n",
+           fd_jacobian[it], fd_hessian[it], status, solver.getNumIterations(), obj[it]);
+    if(status<0 || std::fabs(obj[it]-obj[0]) > 1e-6*(1.+std::fabs(obj[0]))) {
+      return false;
+    }
+  }
+  return true;
+}
+#endif
+
+static void usage(const char* exeName)
+{
+  printf("HiOp driver %s that approximates the sparse derivatives by finite differences\n", exeName);
+  printf("Usage: \n");
+  printf("  '$ %s problem_size -selfcheck'\n", exeName);
+  printf("Arguments:\n");
+  printf("  'problem_size': number of decision variables [optional, default is 500]\n");
+  printf("  '-selfcheck': checks the finite-difference derivatives against the analytical ones. [optional]\n");
+}
+
+int main(int argc, char **argv)
+{
+#ifdef HIOP_USE_MPI
+  MPI_Init(&argc, &argv);
+  int comm_size;
+  int ierr = MPI_Comm_size(MPI_COMM_WORLD, &comm_size); assert(MPI_SUCCESS==ierr);
+  if(comm_size != 1) {
+    printf("[error] driver detected more than one rank but the driver should be run "
+           "in serial only; will exit\n");
+    MPI_Finalize();
+    return 1;
+  }
+#endif
+
+  int n = 500;
+  bool self_check = false;
+  int num_args = 0;
+  for(int i=1; i<argc; i++) {
+    if(std::string(argv[i]) == "-selfcheck") {
+      self_check = true;
+    } else if(num_args<1) {
+      n = std::atoi(argv[i]);
+      num_args++;
+    } else {
+      n = -1;
+    }
+  }
+  if(n<4) {
+    usage(argv[0]);
+#ifdef HIOP_USE_MPI
+    MPI_Finalize();
+#endif
+    return 1;
+  }
+
+  int ret_code = 0;
+  if(!check_derivatives(n, true) || !check_derivatives(n, false) ||
+     !check_fd_jac_and_hess_rejected(n) || !check_duplicates()) {
+    ret_code = -1;
+  }
+#ifdef HIOP_SPARSE
+  if(0==ret_code && !check_solve(n)) {
+    ret_code = -1;
+  }
+#endif
+
+  if(0==ret_code && self_check) {
+    printf("selfcheck passed\n");
+  }
+
+#ifdef HIOP_USE_MPI
+  MPI_Finalize();
+#endif
+  return ret_code;
+}
@@ -0,0 +1,189 @@
+#include "nlpSparse_ex6.hpp"
+#include "hiopNlpFormulation.hpp"
+#include "hiopAlgFilterIPM.hpp"
+
+#include <cstdlib>
+#include <cstdio>
+#include <cmath>
+#include <string>
+#include <vector>
+
+using namespace hiop;
+
+/**
+ * Driver for the LSQ-based initialization of the duals of the sparse NLPs. By default, the augmented
+ * system of the LSQ problem is factorized in the pattern of the KKT linear system, by the linear solver
+ * of the KKT (see hiopAlgFilterIPMNewton::prepare_duals_lsq_init). Ex6 is solved with this path and with
+ * the separate linear system of the duals updater, and the multipliers of the constraints at the first
+ * iteration, the number of iterations, and the objectives of the two solves are compared.
+ */
+class Ex6Lsq : public Ex6
+{
+public:
+  Ex6Lsq(int n)
+    : Ex6(n, 1.0)
+  {
+  }
+  virtual ~Ex6Lsq()
+  {
+  }
+
+  bool iterate_callback(int iter,
+                        double obj_value,
+                        double logbar_obj_value,
+                        int n,
+                        const double* x,
+                        const double* z_L,
+                        const double* z_U,
+                        int m_ineq,
+                        const double* s,
+                        int m,
+                        const double* g,
+                        const double* lambda,
+                        double inf_pr,
+                        double inf_du,
+                        double onenorm_pr_,
+                        double mu,
+                        double alpha_du,
+                        double alpha_pr,
+                        int ls_trials)
+  {
+    if(0==iter) {
+      lambda0_.assign(lambda, lambda+m);
+    }
+    return true;
+  }
+
+  /// multipliers of the constraints at the first iteration, i.e., the ones of the LSQ initialization
+  inline const std::vector<double>& get_lambda0() const { return lambda0_; }
+private:
+  std::vector<double> lambda0_;
+};
+
+/// Solver that computes the LSQ initial duals with the separate linear system of the duals updater
+class hiopAlgFilterIPMNewtonSeparateLsq : public hiopAlgFilterIPMNewton
+{
+public:
+  hiopAlgFilterIPMNewtonSeparateLsq(hiopNlpFormulation* nlp)
+    : hiopAlgFilterIPMNewton(nlp)
+  {
+  }
+protected:
+  void prepare_duals_lsq_init(hiopDualsLsqUpdate* updater, const hiopIterate& it_ini)
+  {
+  }
+};
+
+static void set_options(hiopNlpSparse& nlp)
+{
+  nlp.options->SetStringValue("Hessian", "analytical_exact");
+  nlp.options->SetStringValue("duals_update_type", "linear");
+  nlp.options->SetStringValue("duals_init", "lsq");
+  nlp.options->SetStringValue("compute_mode", "cpu");
+  nlp.options->SetStringValue("KKTLinsys", "xdycyd");
+  nlp.options->SetNumericValue("mu0", 0.1);
+  nlp.options->SetIntegerValue("verbosity_level", 0);
+}
+
+static bool check_lsq_duals(int n)
+{
+  Ex6Lsq problem_kkt(n), problem_sep(n);
+  hiopNlpSparse nlp_kkt(problem_kkt), nlp_sep(problem_sep);
+  set_options(nlp_kkt);
+  set_options(nlp_sep);
+  hiopAlgFilterIPMNewton solver_kkt(&nlp_kkt);
+  hiopAlgFilterIPMNewtonSeparateLsq solver_sep(&nlp_sep);
+  const hiopSolveStatus status_kkt = solver_kkt.run();
+  const hiopSolveStatus status_sep = solver_sep.run();
+  printf("LSQ duals in the KKT pattern: status %d, %d iterations, objective %18.12e\n",
+         status_kkt, solver_kkt.getNumIterations(), solver_kkt.getObjective());
+  printf("LSQ duals with a separate linear system: status %d, %d iterations, objective %18.12e\n",
+         status_sep, solver_sep.getNumIterations(), solver_sep.getObjective());
+  if(status_kkt<0 || status_sep<0) {
+    return false;
+  }
+
+  const std::vector<double>& lambda_kkt = problem_kkt.get_lambda0();
+  const std::vector<double>& lambda_sep = problem_sep.get_lambda0();
+  if(lambda_kkt.empty() || lambda_kkt.size()!=lambda_sep.size()) {
+    printf("the multipliers of the first iteration were not obtained\n");
+    return false;
+  }
+  double err = 0.;
+  for(size_t k=0; k<lambda_sep.size(); k++) {
+    err = std::max(err, std::fabs(lambda_kkt[k]-lambda_sep[k])/(1.+std::fabs(lambda_sep[k])));
+  }
+  if(err>1e-8) {
+    printf("the LSQ duals in the KKT pattern differ from the ones of the separate linear system "
+           "(rel. error %.3e)\n",
+           err);
+    return false;
+  }
+  const double obj_sep = solver_sep.getObjective();
+  if(solver_kkt.getNumIterations()!=solver_sep.getNumIterations() ||
+     std::fabs(solver_kkt.getObjective()-obj_sep) > 1e-8*(1.+std::fabs(obj_sep))) {
+    printf("the solves with the two LSQ initializations of the duals differ\n");
+    return false;
+  }
+  return true;
+}
+
+static void usage(const char* exeName)
+{
+  printf("HiOp driver %s that checks the LSQ initialization of the duals of the sparse NLPs\n", exeName);
+  printf("Usage: \n");
+  printf("  '$ %s problem_size -selfcheck'\n", exeName);
+  printf("Arguments:\n");
+  printf("  'problem_size': number of decision variables [optional, default is 500]\n");
+  printf("  '-selfcheck': checks that the two LSQ initializations give the same duals. [optional]\n");
+}
+
+int main(int argc, char **argv)
+{
+#ifdef HIOP_USE_MPI
+  MPI_Init(&argc, &argv);
+  int comm_size;
+  int ierr = MPI_Comm_size(MPI_COMM_WORLD, &comm_size); assert(MPI_SUCCESS==ierr);
+  if(comm_size != 1) {
+    printf("[error] driver detected more than one rank but the driver should be run "
+           "in serial only; will exit\n");
+    MPI_Finalize();
+    return 1;
+  }
+#endif
+
+  int n = 500;
+  bool self_check = false;
+  int num_args = 0;
+  for(int i=1; i<argc; i++) {
+    if(std::string(argv[i]) == "-selfcheck") {
+      self_check = true;
+    } else if(num_args<1) {
+      n = std::atoi(argv[i]);
+      num_args++;
+    } else {
+      n = -1;
+    }
+  }
+  if(n<4) {
+    usage(argv[0]);
+#ifdef HIOP_USE_MPI
+    MPI_Finalize();
+#endif
+    return 1;
+  }
+
+  int ret_code = 0;
+  if(!check_lsq_duals(n)) {
+    ret_code = -1;
+  }
+
+  if(0==ret_code && self_check) {
+    printf("selfcheck passed\n");
+  }
+
+#ifdef HIOP_USE_MPI
+  MPI_Finalize();
+#endif
+  return ret_code;
+}
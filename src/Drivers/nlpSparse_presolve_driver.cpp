@@ -0,0 +1,416 @@
+#include "hiopInterface.hpp"
+#include "hiopNlpFormulation.hpp"
+#include "hiopAlgFilterIPM.hpp"
+
+#include <cstdlib>
+#include <cstdio>
+#include <cmath>
+#include <string>
+#include <vector>
+
+using namespace hiop;
+
+/**
+ * Driver for the presolve of the linear constraints of the sparse NLPs. The problem is
+ *
+ *  min   1/2 sum (x_i-1)^2
+ *  s.t.  x_0 + x_1 + x_2 == 1                (c0)
+ *        1 <= 2 <= 3                         (c1, empty row)
+ *        2*x_3 >= 4                          (c2, singleton row)
+ *        x_4 + x_5 <= 1                      (c3)
+ *        2*x_4 + 2*x_5 <= 1.5                (c4, duplicate of c3)
+ *        x_0^2 + x_1^2 <= 10                 (c5, nonlinear)
+ *        x_i >= -10, excepting x_3, which has no bounds
+ *
+ * The presolve removes c1, c2 (which becomes the lower bound 2 of x_3), and c4 (which tightens c3).
+ * The multipliers returned to the user should be the ones of the NLP without presolve: the multiplier of
+ * c2 is recovered from the one of the lower bound of x_3, which the user did not set, and the one of c4
+ * from the one of c3. The postsolve of the multipliers is checked at a given primal-dual point and, when
+ * HiOp is built with sparse linear solvers, the problem is solved with and without presolve.
+ */
+class ExPresolve : public hiopInterfaceSparse
+{
+public:
+  ExPresolve(int n)
+    : n_(n), m_(6)
+  {
+    assert(n>=6);
+  }
+  virtual ~ExPresolve()
+  {
+  }
+
+  bool get_prob_sizes(size_type& n, size_type& m)
+  {
+    n = n_;
+    m = m_;
+    return true;
+  }
+
+  bool get_vars_info(const size_type& n, double *xlow, double* xupp, NonlinearityType* type)
+  {
+    for(int i=0; i<n; i++) {
+      xlow[i] = -10.;
+      xupp[i] = 1e20;
+      type[i] = hiopNonlinear;
+    }
+    xlow[3] = -1e20;
+    return true;
+  }
+
+  bool get_cons_info(const size_type& m, double* clow, double* cupp, NonlinearityType* type)
+  {
+    assert(m==m_);
+    clow[0] = 1.;    cupp[0] = 1.;
+    clow[1] = 1.;    cupp[1] = 3.;
+    clow[2] = 4.;    cupp[2] = 1e20;
+    clow[3] = -1e20; cupp[3] = 1.;
+    clow[4] = -1e20; cupp[4] = 1.5;
+    clow[5] = -1e20; cupp[5] = 10.;
+    for(int i=0; i<m; i++) {
+      type[i] = hiopLinear;
+    }
+    type[5] = hiopNonlinear;
+    return true;
+  }
+
+  bool get_sparse_blocks_info(size_type& nx,
+                              size_type& nnz_sparse_Jaceq,
+                              size_type& nnz_sparse_Jacineq,
+                              size_type& nnz_sparse_Hess_Lagr)
+  {
+    nx = n_;
+    nnz_sparse_Jaceq = 3;
+    nnz_sparse_Jacineq = 1+2+2+2;
+    nnz_sparse_Hess_Lagr = n_;
+    return true;
+  }
+
+  bool eval_f(const size_type& n, const double* x, bool new_x, double& obj_value)
+  {
+    obj_value = 0.;
+    for(int i=0; i<n; i++) {
+      obj_value += 0.5*(x[i]-1.)*(x[i]-1.);
+    }
+    return true;
+  }
+
+  bool eval_grad_f(const size_type& n, const double* x, bool new_x, double* gradf)
+  {
+    for(int i=0; i<n; i++) {
+      gradf[i] = x[i]-1.;
+    }
+    return true;
+  }
+
+  bool eval_cons(const size_type& n,
+                 const size_type& m,
+                 const size_type& num_cons,
+                 const index_type* idx_cons,
+                 const double* x,
+                 bool new_x,
+                 double* cons)
+  {
+    //the one-call overload below is used
+    return false;
+  }
+
+  bool eval_cons(const size_type& n, const size_type& m, const double* x, bool new_x, double* cons)
+  {
+    cons[0] = x[0] + x[1] + x[2];
+    cons[1] = 2.;
+    cons[2] = 2*x[3];
+    cons[3] = x[4] + x[5];
+    cons[4] = 2*x[4] + 2*x[5];
+    cons[5] = x[0]*x[0] + x[1]*x[1];
+    return true;
+  }
+
+  bool eval_Jac_cons(const size_type& n,
+                     const size_type& m,
+                     const size_type& num_cons,
+                     const index_type* idx_cons,
+                     const double* x,
+                     bool new_x,
+                     const size_type& nnzJacS,
+                     index_type* iJacS,
+                     index_type* jJacS,
+                     double* MJacS)
+  {
+    //the one-call overload below is used
+    return false;
+  }
+
+  bool eval_Jac_cons(const size_type& n,
+                     const size_type& m,
+                     const double* x,
+                     bool new_x,
+                     const size_type& nnzJacS,
+                     index_type* iJacS,
+                     index_type* jJacS,
+                     double* MJacS)
+  {
+    assert(nnzJacS==10);
+    const index_type rows[] = {0, 0, 0, 2, 3, 3, 4, 4, 5, 5};
+    const index_type cols[] = {0, 1, 2, 3, 4, 5, 4, 5, 0, 1};
+    if(iJacS!=nullptr && jJacS!=nullptr) {
+      for(int k=0; k<nnzJacS; k++) {
+        iJacS[k] = rows[k];
+        jJacS[k] = cols[k];
+      }
+    }
+    if(MJacS!=nullptr) {
+      const double vals[] = {1., 1., 1., 2., 1., 1., 2., 2., 2*x[0], 2*x[1]};
+      for(int k=0; k<nnzJacS; k++) {
+        MJacS[k] = vals[k];
+      }
+    }
+    return true;
+  }
+
+  bool eval_Hess_Lagr(const size_type& n,
+                      const size_type& m,
+                      const double* x,
+                      bool new_x,
+                      const double& obj_factor,
+                      const double* lambda,
+                      bool new_lambda,
+                      const size_type& nnzHSS,
+                      index_type* iHSS,
+                      index_type* jHSS,
+                      double* MHSS)
+  {
+    assert(nnzHSS==n);
+    if(iHSS!=nullptr && jHSS!=nullptr) {
+      for(int i=0; i<n; i++) {
+        iHSS[i] = jHSS[i] = i;
+      }
+    }
+    if(MHSS!=nullptr) {
+      for(int i=0; i<n; i++) {
+        MHSS[i] = obj_factor;
+      }
+      MHSS[0] += 2*lambda[5];
+      MHSS[1] += 2*lambda[5];
+    }
+    return true;
+  }
+
+  bool get_starting_point(const size_type& n, double* x0)
+  {
+    for(int i=0; i<n; i++) {
+      x0[i] = 0.;
+    }
+    return true;
+  }
+
+  void solution_callback(hiopSolveStatus status,
+                         size_type n,
+                         const double* x,
+                         const double* z_L,
+                         const double* z_U,
+                         size_type m,
+                         const double* g,
+                         const double* lambda,
+                         double obj_value)
+  {
+    sol_x.assign(x, x+n);
+    sol_zl.assign(z_L, z_L+n);
+    sol_zu.assign(z_U, z_U+n);
+    sol_lambda.assign(lambda, lambda+m);
+  }
+
+  /// the solution passed to 'solution_callback'
+  std::vector<double> sol_x, sol_zl, sol_zu, sol_lambda;
+private:
+  int n_;
+  int m_;
+};
+
+static void set_options(hiopNlpSparse& nlp, const char* presolve)
+{
+  nlp.options->SetStringValue("presolve", presolve);
+  nlp.options->SetStringValue("Hessian", "analytical_exact");
+  nlp.options->SetStringValue("duals_update_type", "linear");
+  nlp.options->SetStringValue("compute_mode", "cpu");
+  nlp.options->SetStringValue("KKTLinsys", "xdycyd");
+  nlp.options->SetIntegerValue("verbosity_level", 0);
+  nlp.options->SetNumericValue("tolerance", 1e-9);
+}
+
+/**
+ * Checks the constraints kept by the presolve and the multipliers returned to the user for given
+ * multipliers of the presolved problem: 0.8 for the lower bound of x_3 (set by c2) and 0.6 for c3,
+ * whose upper bound is set by c4.
+ */
+static bool check_postsolve(int n)
+{
+  ExPresolve problem(n);
+  hiopNlpSparse nlp(problem);
+  set_options(nlp, "yes");
+  if(!nlp.finalizeInitialization()) {
+    printf("the initialization of the presolved problem failed\n");
+    return false;
+  }
+  //c0 and c3, c5 are kept
+  if(nlp.m_eq()!=1 || nlp.m_ineq()!=2) {
+    printf("the presolved problem has %d equalities and %d inequalities instead of 1 and 2\n",
+           nlp.m_eq(), nlp.m_ineq());
+    return false;
+  }
+  //the bounds are relaxed by 'bound_relax_perturb'
+  if(std::fabs(nlp.get_xl().local_data_const()[3]-2.) > 1e-6) {
+    printf("the lower bound of x_3 is %g instead of 2 (set by the singleton row)\n",
+           nlp.get_xl().local_data_const()[3]);
+    return false;
+  }
+
+  hiopVector* x = nlp.alloc_primal_vec();
+  hiopVector* zl = nlp.alloc_primal_vec();
+  hiopVector* zu = nlp.alloc_primal_vec();
+  hiopVector* c = nlp.alloc_dual_eq_vec();
+  hiopVector* d = nlp.alloc_dual_ineq_vec();
+  hiopVector* yc = nlp.alloc_dual_eq_vec();
+  hiopVector* yd = nlp.alloc_dual_ineq_vec();
+  x->setToConstant(0.5);
+  zl->setToZero();
+  zu->setToZero();
+  zl->local_data()[3] = 0.8;
+  yc->setToConstant(0.1);
+  //the multipliers of c3 and c5
+  yd->local_data()[0] = 0.6;
+  yd->local_data()[1] = 0.;
+  bool bret = nlp.eval_c_d(*x, true, *c, *d);
+  nlp.user_callback_solution(Solve_Success, *x, *zl, *zu, *c, *d, *yc, *yd, 0.);
+  if(!bret) {
+    printf("the evaluation of the presolved constraints failed\n");
+  }
+
+  //c2 is 2*x_3 >= 4, hence its multiplier is -0.8/2; c4 is 2 times c3, hence its multiplier is 0.6/2
+  const double lambda_expected[] = {0.1, 0., -0.4, 0., 0.3, 0.};
+  for(int i=0; i<6 && bret; i++) {
+    if(std::fabs(problem.sol_lambda[i]-lambda_expected[i]) > 1e-14) {
+      printf("the multiplier of c%d returned to the user is %g instead of %g\n",
+             i, problem.sol_lambda[i], lambda_expected[i]);
+      bret = false;
+    }
+  }
+  //the user did not set the lower bound of x_3
+  if(bret && problem.sol_zl[3] != 0.) {
+    printf("the multiplier of the lower bound of x_3 returned to the user is %g instead of 0\n",
+           problem.sol_zl[3]);
+    bret = false;
+  }
+
+  delete x;
+  delete zl;
+  delete zu;
+  delete c;
+  delete d;
+  delete yc;
+  delete yd;
+  return bret;
+}
+
+#ifdef HIOP_SPARSE
+static bool check_solve(int n)
+{
+  std::vector<double> sol[2][4];
+  const char* presolve[] = {"no", "yes"};
+  for(int it=0; it<2; it++) {
+    ExPresolve problem(n);
+    hiopNlpSparse nlp(problem);
+    set_options(nlp, presolve[it]);
+    hiopAlgFilterIPMNewton solver(&nlp);
+    hiopSolveStatus status = solver.run();
+    printf("presolve=%s: status %d, %d iterations, objective %18.12e\n",
+           presolve[it], status, solver.getNumIterations(), solver.getObjective());
+    if(status<0) {
+      return false;
+    }
+    sol[it][0] = problem.sol_x;
+    sol[it][1] = problem.sol_zl;
+    sol[it][2] = problem.sol_zu;
+    sol[it][3] = problem.sol_lambda;
+  }
+  const char* names[] = {"primal solution", "multipliers of the lower bounds",
+                         "multipliers of the upper bounds", "multipliers of the constraints"};
+  for(int k=0; k<4; k++) {
+    double err = 0.;
+    for(size_t i=0; i<sol[0][k].size(); i++) {
+      err = std::max(err, std::fabs(sol[1][k][i]-sol[0][k][i])/(1.+std::fabs(sol[0][k][i])));
+    }
+    if(err>1e-6) {
+      printf("the %s with presolve differ from the ones without (rel. error %.3e)\n", names[k], err);
+      return false;
+    }
+  }
+  return true;
+}
+#endif
+
+static void usage(const char* exeName)
+{
+  printf("HiOp driver %s that presolves the linear constraints of a sparse NLP\n", exeName);
+  printf("Usage: \n");
+  printf("  '$ %s problem_size -selfcheck'\n", exeName);
+  printf("Arguments:\n");
+  printf("  'problem_size': number of decision variables, at least 6 [optional, default is 50]\n");
+  printf("  '-selfcheck': checks the presolved problem and that the solution returned to the user is the "
+         "one of the problem without presolve. [optional]\n");
+}
+
+int main(int argc, char **argv)
+{
+#ifdef HIOP_USE_MPI
+  MPI_Init(&argc, &argv);
+  int comm_size;
+  int ierr = MPI_Comm_size(MPI_COMM_WORLD, &comm_size); assert(MPI_SUCCESS==ierr);
+  if(comm_size != 1) {
+    printf("[error] driver detected more than one rank but the driver should be run "
+           "in serial only; will exit\n");
+    MPI_Finalize();
+    return 1;
+  }
+#endif
+
+  int n = 50;
+  bool self_check = false;
+  int num_args = 0;
+  for(int i=1; i<argc; i++) {
+    if(std::string(argv[i]) == "-selfcheck") {
+      self_check = true;
+    } else if(num_args<1) {
+      n = std::atoi(argv[i]);
+      num_args++;
+    } else {
+      n = -1;
+    }
+  }
+  if(n<6) {
+    usage(argv[0]);
+#ifdef HIOP_USE_MPI
+    MPI_Finalize();
+#endif
+    return 1;
+  }
+
+  int ret_code = 0;
+  if(!check_postsolve(n)) {
+    ret_code = -1;
+  }
+#ifdef HIOP_SPARSE
+  if(0==ret_code && !check_solve(n)) {
+    ret_code = -1;
+  }
+#endif
+
+  if(0==ret_code && self_check) {
+    printf("selfcheck passed\n");
+  }
+
+#ifdef HIOP_USE_MPI
+  MPI_Finalize();
+#endif
+  return ret_code;
+}
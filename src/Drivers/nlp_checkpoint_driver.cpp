@@ -0,0 +1,228 @@
+#include "nlpDenseCons_ex2.hpp"
+#include "nlpMDS_ex4.hpp"
+#include "hiopNlpFormulation.hpp"
+#include "hiopAlgFilterIPM.hpp"
+#include "hiopCheckpoint.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <string>
+
+using namespace hiop;
+
+/**
+ * Driver for the checkpoint/restart of the IPM solvers: a problem is solved without interruption, then 
+ * it is solved again with periodic checkpoints and stopped early by the iteration limit, which 
+ * mimics a solve that is killed, and finally it is resumed from the last checkpoint. The resumed solve 
+ * should reproduce the uninterrupted one, and a second run of the same solver should start from the
+ * initial point since the checkpoint is loaded by the first run only.
+ *
+ * Ex2 is solved with the quasi-Newton solver, also when running on multiple MPI ranks, and Ex4 with 
+ * the Newton solver (on one rank only).
+ */
+
+/// Records the first iteration reported to the iterate callback, which tells where a solve started
+template<class NLP>
+class FirstIterRecorder : public NLP
+{
+public:
+  using NLP::NLP;
+
+  bool iterate_callback(int iter, double obj_value, double logbar_obj_value, int n, const double* x,
+                        const double* z_L, const double* z_U, int m_ineq, const double* s, int m,
+                        const double* g, const double* lambda, double inf_pr, double inf_du,
+                        double onenorm_pr_, double mu, double alpha_du, double alpha_pr, int ls_trials)
+  {
+    if(first_iter<0) {
+      first_iter = iter;
+    }
+    return true;
+  }
+  int first_iter = -1;
+};
+
+struct SolveResult
+{
+  hiopSolveStatus status;
+  double obj_value;
+  int num_iter;
+  int first_iter;
+  /// first iteration of a second run of the resumed solver, which should not load the checkpoint again
+  int rerun_first_iter;
+};
+
+enum SolveMode
+{
+  Uninterrupted=0,
+  Interrupted,
+  Resumed
+};
+
+static void set_checkpoint_options(hiopOptions& options, SolveMode mode, const std::string& path)
+{
+  options.SetIntegerValue("verbosity_level", 0);
+  options.SetStringValue("checkpoint_file", path.c_str());
+  options.SetIntegerValue("checkpoint_save_N", 4);
+  if(Interrupted == mode) {
+    options.SetStringValue("checkpoint_save", "yes");
+    options.SetIntegerValue("max_iter", 10);
+  }
+  if(Resumed == mode) {
+    options.SetStringValue("checkpoint_load_on_start", "yes");
+  }
+}
+
+static SolveResult solve_ex2(int n, SolveMode mode, const std::string& path)
+{
+  FirstIterRecorder<Ex2> nlp_interface(n);
+  hiopNlpDenseConstraints nlp(nlp_interface);
+  set_checkpoint_options(*nlp.options, mode, path);
+
+  hiopAlgFilterIPMQuasiNewton solver(&nlp);
+  SolveResult res;
+  res.status = solver.run();
+  res.obj_value = solver.getObjective();
+  res.num_iter = solver.getNumIterations();
+  res.first_iter = nlp_interface.first_iter;
+  res.rerun_first_iter = -1;
+  if(Resumed == mode) {
+    nlp_interface.first_iter = -1;
+    solver.run();
+    res.rerun_first_iter = nlp_interface.first_iter;
+  }
+  return res;
+}
+
+static SolveResult solve_ex4(int n_sp, int n_de, SolveMode mode, const std::string& path)
+{
+  FirstIterRecorder<Ex4> nlp_interface(n_sp, n_de);
+  hiopNlpMDS nlp(nlp_interface);
+  nlp.options->SetStringValue("Hessian", "analytical_exact");
+  nlp.options->SetStringValue("KKTLinsys", "xdycyd");
+  nlp.options->SetStringValue("compute_mode", "cpu");
+  nlp.options->SetNumericValue("mu0", 1e-1);
+  set_checkpoint_options(*nlp.options, mode, path);
+
+  hiopAlgFilterIPMNewton solver(&nlp);
+  SolveResult res;
+  res.status = solver.run();
+  res.obj_value = solver.getObjective();
+  res.num_iter = solver.getNumIterations();
+  res.first_iter = nlp_interface.first_iter;
+  res.rerun_first_iter = -1;
+  if(Resumed == mode) {
+    nlp_interface.first_iter = -1;
+    solver.run();
+    res.rerun_first_iter = nlp_interface.first_iter;
+  }
+  return res;
+}
+
+static bool check(const char* name, const SolveResult& ref, const SolveResult& interrupted, const SolveResult& resumed)
+{
+  bool ok = true;
+  if(ref.status<0 || resumed.status<0) {
+    printf("%s: solver returned negative solve status: uninterrupted %d, resumed %d\n",
+           name, ref.status, resumed.status);
+    ok = false;
+  }
+  if(interrupted.status != Max_Iter_Exceeded) {
+    printf("%s: the interrupted solve was expected to stop at the iteration limit (status %d)\n",
+           name, interrupted.status);
+    ok = false;
+  }
+  if(resumed.first_iter != 8) {
+    printf("%s: the resumed solve started at iteration %d instead of the last checkpoint, iteration 8\n",
+           name, resumed.first_iter);
+    ok = false;
+  }
+  if(resumed.rerun_first_iter != 0) {
+    printf("%s: a second run of the resumed solver started at iteration %d instead of 0\n",
+           name, resumed.rerun_first_iter);
+    ok = false;
+  }
+  if(resumed.num_iter != ref.num_iter ||
+     std::fabs(resumed.obj_value-ref.obj_value) > 1e-8*(1.+std::fabs(ref.obj_value))) {
+    printf("%s: resumed solve (%d iterations, obj=%18.12e) differs from the uninterrupted solve "
+           "(%d iterations, obj=%18.12e)\n",
+           name, resumed.num_iter, resumed.obj_value, ref.num_iter, ref.obj_value);
+    ok = false;
+  }
+  return ok;
+}
+
+static void usage(const char* exeName)
+{
+  printf("HiOp driver %s that checks the checkpoint/restart of the solvers\n", exeName);
+  printf("Usage: \n");
+  printf("  '$ %s problem_size -selfcheck'\n", exeName);
+  printf("Arguments, excepting string '-selfcheck'\n");
+  printf("  'problem_size': # of variables of Ex2 and of sparse variables of Ex4 [default 500, optional]\n");
+  printf("  '-selfcheck': checks that the resumed solves reproduce the uninterrupted ones. [optional]\n");
+}
+
+int main(int argc, char **argv)
+{
+  int rank=0, num_ranks=1;
+#ifdef HIOP_USE_MPI
+  MPI_Init(&argc, &argv);
+  int ierr = MPI_Comm_rank(MPI_COMM_WORLD, &rank); assert(MPI_SUCCESS==ierr);
+  ierr = MPI_Comm_size(MPI_COMM_WORLD, &num_ranks); assert(MPI_SUCCESS==ierr);
+#endif
+
+  int n = 500;
+  bool self_check = false;
+  for(int i=1; i<argc; i++) {
+    if(std::string(argv[i]) == "-selfcheck") {
+      self_check = true;
+    } else if(i==1) {
+      n = std::atoi(argv[i]);
+    } else {
+      n = -1;
+    }
+  }
+  if(n<=0) {
+    if(rank==0) usage(argv[0]);
+#ifdef HIOP_USE_MPI
+    MPI_Finalize();
+#endif
+    return 1;
+  }
+
+  int ret_code = 0;
+  {
+    const std::string path = "hiop_chkpnt_ex2";
+    SolveResult ref = solve_ex2(n, Uninterrupted, path);
+    SolveResult interrupted = solve_ex2(n, Interrupted, path);
+    SolveResult resumed = solve_ex2(n, Resumed, path);
+    if(!check("Ex2 (quasi-Newton)", ref, interrupted, resumed)) {
+      ret_code = -1;
+    }
+    if(rank==0) {
+      printf("Ex2 (quasi-Newton): %d iterations uninterrupted, resumed at iteration 8\n", ref.num_iter);
+    }
+    remove(hiopCheckpointFile::rank_file_name(path, rank, num_ranks).c_str());
+  }
+
+  if(num_ranks==1) {
+    const std::string path = "hiop_chkpnt_ex4";
+    SolveResult ref = solve_ex4(n, n/4, Uninterrupted, path);
+    SolveResult interrupted = solve_ex4(n, n/4, Interrupted, path);
+    SolveResult resumed = solve_ex4(n, n/4, Resumed, path);
+    if(!check("Ex4 (Newton)", ref, interrupted, resumed)) {
+      ret_code = -1;
+    }
+    printf("Ex4 (Newton): %d iterations uninterrupted, resumed at iteration 8\n", ref.num_iter);
+    remove(path.c_str());
+  }
+
+  if(self_check && 0==ret_code && rank==0) {
+    printf("selfcheck passed\n");
+  }
+
+#ifdef HIOP_USE_MPI
+  MPI_Finalize();
+#endif
+  return ret_code;
+}
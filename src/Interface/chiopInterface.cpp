@@ -35,4 +35,43 @@ int hiop_destroyProblem(cHiopProblem *prob) {
   delete prob->hiopinterface;
   return 0;
 }
+
+int hiop_createSparseProblem(cHiopSparseProblem *prob) {
+  cppUserProblemSparse * cppproblem = new cppUserProblemSparse(prob);
+  hiopNlpSparse *nlp = new hiopNlpSparse(*cppproblem);
+  nlp->options->SetStringValue("duals_update_type", "linear");
+  nlp->options->SetStringValue("duals_init", "zero");
+
+  nlp->options->SetStringValue("Hessian", "analytical_exact");
+  nlp->options->SetStringValue("KKTLinsys", "xdycyd");
+  nlp->options->SetStringValue("compute_mode", "cpu");
+
+  nlp->options->SetIntegerValue("verbosity_level", 3);
+  nlp->options->SetNumericValue("mu0", 1e-1);
+  prob->refcppHiop = nlp;
+  prob->hiopinterface = cppproblem;
+  prob->refcppSolver = nullptr;
+  return 0;
+}
+
+int hiop_solveSparseProblem(cHiopSparseProblem *prob) {
+  if(nullptr == prob->refcppSolver) {
+    prob->refcppSolver = new hiopAlgFilterIPMNewton(prob->refcppHiop);
+  } else {
+    //the problem is solved again, possibly with different data provided by the callbacks
+    prob->refcppHiop->reload_problem_data();
+  }
+  hiopSolveStatus status = prob->refcppSolver->run();
+  prob->obj_value = prob->refcppSolver->getObjective();
+  prob->refcppSolver->getSolution(prob->solution);
+  return status;
+}
+
+int hiop_destroySparseProblem(cHiopSparseProblem *prob) {
+  delete prob->refcppSolver;
+  delete prob->refcppHiop;
+  delete prob->hiopinterface;
+  prob->refcppSolver = nullptr;
+  return 0;
+}
 } // extern C
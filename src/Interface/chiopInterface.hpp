@@ -5,7 +5,9 @@
 #include "hiopNlpFormulation.hpp"
 #include "hiopAlgFilterIPM.hpp"
 
-/** Light C interface that wraps around the mixed-dense nlp class in HiOp. Its initial motivation
+#include <vector>
+
+/** Light C interface that wraps around the mixed-dense and sparse nlp classes in HiOp. Its initial motivation
  * was to serve as an interface to Julia
  */
 
@@ -48,6 +50,44 @@ extern "C" {
       double* HDD,
       hiop_size_type nnzHSD, hiop_index_type* iHSD, hiop_index_type* jHSD, double* MHSD, void* user_data);
   } cHiopProblem;
+
+  // Nonlinearity type of the variables and constraints; same values as hiopInterfaceBase::NonlinearityType
+  typedef enum { hiop_linear=0, hiop_quadratic, hiop_nonlinear } hiop_nonlinearity_type;
+
+  class cppUserProblemSparse;
+  // C struct with HiOp function callbacks for sparse NLPs. See hiopInterface.h for the conventions.
+  typedef struct cHiopSparseProblem {
+    hiopNlpSparse *refcppHiop;
+    cppUserProblemSparse *hiopinterface;
+    // The solver is kept across the solves of the problem
+    hiopAlgFilterIPMNewton *refcppSolver;
+    void *user_data;
+    double *solution;
+    double obj_value;
+    int (*get_starting_point)(size_type n_, double* x0, void* user_data); 
+    int (*get_prob_sizes)(size_type* n_, size_type* m_, void* user_data); 
+    int (*get_vars_info)(size_type n, double *xlow_, double* xupp_, hiop_nonlinearity_type* type,
+      void* user_data);
+    int (*get_cons_info)(size_type m, double *clow_, double* cupp_, hiop_nonlinearity_type* type,
+      void* user_data);
+    int (*eval_f)(size_type n, double* x, int new_x, double* obj, void* user_data);
+    int (*eval_grad_f)(size_type n, double* x, int new_x, double* gradf, void* user_data);
+    int (*eval_cons)(size_type n, size_type m,
+      double* x, int new_x, 
+      double* cons, void* user_data);
+    int (*get_sparse_blocks_info)(hiop_size_type* nx,
+      hiop_size_type* nnz_sparse_Jaceq, hiop_size_type* nnz_sparse_Jacineq,
+      hiop_size_type* nnz_sparse_Hess_Lagr, void* user_data);
+    int (*eval_Jac_cons)(size_type n, size_type m,
+      double* x, int new_x,
+      hiop_size_type nnzJacS, hiop_index_type* iJacS, hiop_index_type* jJacS, double* MJacS, 
+      void *user_data);
+    int (*eval_Hess_Lagr)(size_type n, size_type m,
+      double* x, int new_x, double obj_factor,
+      double* lambda, int new_lambda,
+      hiop_size_type nnzHSS, hiop_index_type* iHSS, hiop_index_type* jHSS, double* MHSS, 
+      void* user_data);
+  } cHiopSparseProblem;
 }
 
 
@@ -163,10 +203,125 @@ private:
   cHiopProblem *cprob;
 };
 
+// The cpp object used in the C interface for sparse NLPs. The callbacks write directly in the arrays 
+// provided by HiOp and their return values (0 on success) are passed to HiOp.
+class cppUserProblemSparse : public hiopInterfaceSparse
+{
+  public:
+    cppUserProblemSparse(cHiopSparseProblem *cprob_)
+      : cprob(cprob_) 
+    {
+    }
+
+    virtual ~cppUserProblemSparse()
+    {
+    }
+    // HiOp callbacks calling the C wrappers
+    bool get_prob_sizes(size_type& n_, size_type& m_) 
+    {
+      return 0 == cprob->get_prob_sizes(&n_, &m_, cprob->user_data);
+    };
+    bool get_starting_point(const size_type& n, double *x0)
+    {
+      return 0 == cprob->get_starting_point(n, x0, cprob->user_data);
+    };
+    bool get_vars_info(const size_type& n, double *xlow_, double* xupp_, NonlinearityType* type)
+    {
+      return get_types(n, type, [&](hiop_nonlinearity_type* ctype) {
+        return cprob->get_vars_info(n, xlow_, xupp_, ctype, cprob->user_data);
+      });
+    };
+    bool get_cons_info(const size_type& m, double* clow, double* cupp, NonlinearityType* type)
+    {
+      return get_types(m, type, [&](hiop_nonlinearity_type* ctype) {
+        return cprob->get_cons_info(m, clow, cupp, ctype, cprob->user_data);
+      });
+    };
+    bool eval_f(const size_type& n, const double* x, bool new_x, double& obj_value)
+    {
+      return 0 == cprob->eval_f(n, (double *) x, new_x, &obj_value, cprob->user_data);
+    };
+    bool eval_grad_f(const size_type& n, const double* x, bool new_x, double* gradf)
+    {
+      return 0 == cprob->eval_grad_f(n, (double *) x, new_x, gradf, cprob->user_data);
+    };
+    bool eval_cons(const size_type& n, const size_type& m,
+      const size_type& num_cons, const hiop_index_type* idx_cons,  
+      const double* x, bool new_x, 
+      double* cons)
+    {
+      return false;
+    };
+    bool eval_cons(const size_type& n, const size_type& m, 
+      const double* x, bool new_x, double* cons)
+    {
+      return 0 == cprob->eval_cons(n, m, (double *) x, new_x, cons, cprob->user_data);
+    };
+    bool get_sparse_blocks_info(size_type& nx,
+      size_type& nnz_sparse_Jaceq, size_type& nnz_sparse_Jacineq,
+      size_type& nnz_sparse_Hess_Lagr)
+    {
+      return 0 == cprob->get_sparse_blocks_info(&nx, &nnz_sparse_Jaceq, &nnz_sparse_Jacineq,
+                                                &nnz_sparse_Hess_Lagr, cprob->user_data);
+    };
+    bool eval_Jac_cons(const size_type& n, const size_type& m,
+      const size_type& num_cons, const hiop_index_type* idx_cons,
+      const double* x, bool new_x,
+      const size_type& nnzJacS, hiop_index_type* iJacS, hiop_index_type* jJacS, double* MJacS)
+    {
+      return false;
+    };
+    bool eval_Jac_cons(const size_type& n, const size_type& m,
+      const double* x, bool new_x,
+      const size_type& nnzJacS, hiop_index_type* iJacS, hiop_index_type* jJacS, double* MJacS)
+    {
+      return 0 == cprob->eval_Jac_cons(n, m, (double *) x, new_x, nnzJacS, iJacS, jJacS, MJacS,
+                                       cprob->user_data);
+    };
+    bool eval_Hess_Lagr(const size_type& n, const size_type& m,
+      const double* x, bool new_x, const double& obj_factor,
+      const double* lambda, bool new_lambda,
+      const size_type& nnzHSS, hiop_index_type* iHSS, hiop_index_type* jHSS, double* MHSS)
+    {
+      return 0 == cprob->eval_Hess_Lagr(n, m, (double *) x, new_x, obj_factor,
+                                        (double *) lambda, new_lambda,
+                                        nnzHSS, iHSS, jHSS, MHSS,
+                                        cprob->user_data);
+    };
+private:
+  // Calls 'get_info' with the C types initialized to hiop_nonlinear and converts them to 'type'
+  template<class GetInfo>
+  bool get_types(const size_type& n, NonlinearityType* type, GetInfo get_info)
+  {
+    ctypes.assign(n, hiop_nonlinear);
+    if(0 != get_info(ctypes.data())) {
+      return false;
+    }
+    for(size_type i=0; i<n; ++i) {
+      assert(ctypes[i]>=hiop_linear && ctypes[i]<=hiop_nonlinear);
+      type[i] = static_cast<NonlinearityType>(ctypes[i]);
+    }
+    return true;
+  }
+private:
+  // Storing the C struct in the CPP object
+  cHiopSparseProblem *cprob;
+  // Buffer for the types of the variables and constraints
+  std::vector<hiop_nonlinearity_type> ctypes;
+};
+
 /** The 3 essential function calls to create and destroy a problem object in addition to solve a problem.
  * Some option setters will be added in the future.
  */
 extern "C" int hiop_createProblem(cHiopProblem *problem);
 extern "C" int hiop_solveProblem(cHiopProblem *problem);
 extern "C" int hiop_destroyProblem(cHiopProblem *problem);
+
+/** Same calls for sparse NLPs. The solver is created once and reused by the subsequent calls of 
+ * hiop_solveSparseProblem, which read again the problem data from the callbacks and return the
+ * solve status.
+ */
+extern "C" int hiop_createSparseProblem(cHiopSparseProblem *problem);
+extern "C" int hiop_solveSparseProblem(cHiopSparseProblem *problem);
+extern "C" int hiop_destroySparseProblem(cHiopSparseProblem *problem);
 #endif
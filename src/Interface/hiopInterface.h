@@ -39,3 +39,48 @@ typedef struct cHiopProblem {
 extern int hiop_createProblem(cHiopProblem *problem);
 extern int hiop_solveProblem(cHiopProblem *problem);
 extern int hiop_destroyProblem(cHiopProblem *problem);
+
+// Nonlinearity type of the variables and constraints; same values as hiopInterfaceBase::NonlinearityType
+typedef enum { hiop_linear=0, hiop_quadratic, hiop_nonlinear } hiop_nonlinearity_type;
+
+// C interface for sparse NLPs. The callbacks return 0 on success. The triplet arrays passed to 
+// eval_Jac_cons and eval_Hess_Lagr are owned by HiOp and should be written in place: the (i,j) indexes 
+// are requested only once (iJacS/jJacS and iHSS/jHSS are NULL afterwards), the values at each evaluation.
+// The type arrays passed to get_vars_info and get_cons_info are filled with hiop_nonlinear by HiOp and 
+// can be overwritten with linearity hints.
+typedef struct cHiopSparseProblem {
+  void *refcppHiop; // Pointer to the cpp nlp object
+  void *hiopinterface;
+  void *refcppSolver; // Pointer to the cpp solver object, kept across solves
+  void *user_data; 
+  double *solution;
+  double obj_value;
+  int (*get_starting_point)(hiop_size_type n_, double* x0, void* jprob); 
+  int (*get_prob_sizes)(hiop_size_type* n_, hiop_size_type* m_, void* jprob); 
+  int (*get_vars_info)(hiop_size_type n, double *xlow_, double* xupp_, hiop_nonlinearity_type* type,
+    void* jprob);
+  int (*get_cons_info)(hiop_size_type m, double *clow_, double* cupp_, hiop_nonlinearity_type* type,
+    void* jprob);
+  int (*eval_f)(hiop_size_type n, double* x, int new_x, double* obj, void* jprob);
+  int (*eval_grad_f)(hiop_size_type n, double* x, int new_x, double* gradf, void* jprob);
+  int (*eval_cons)(hiop_size_type n, hiop_size_type m,
+    double* x, int new_x, 
+    double* cons, void* jprob);
+  int (*get_sparse_blocks_info)(hiop_size_type* nx,
+    hiop_size_type* nnz_sparse_Jaceq, hiop_size_type* nnz_sparse_Jacineq,
+    hiop_size_type* nnz_sparse_Hess_Lagr, void* jprob);
+  int (*eval_Jac_cons)(hiop_size_type n, hiop_size_type m,
+    double* x, int new_x,
+    hiop_size_type nnzJacS, hiop_index_type* iJacS, hiop_index_type* jJacS, double* MJacS, 
+    void *jprob);
+  int (*eval_Hess_Lagr)(hiop_size_type n, hiop_size_type m,
+    double* x, int new_x, double obj_factor,
+    double* lambda, int new_lambda,
+    hiop_size_type nnzHSS, hiop_index_type* iHSS, hiop_index_type* jHSS, double* MHSS, 
+    void* jprob);
+} cHiopSparseProblem;
+// hiop_solveSparseProblem can be called repeatedly on the same problem; the problem data (sizes, bounds,
+// and types) is read again from the callbacks at each solve. Returns the solve status (0 on success).
+extern int hiop_createSparseProblem(cHiopSparseProblem *problem);
+extern int hiop_solveSparseProblem(cHiopSparseProblem *problem);
+extern int hiop_destroySparseProblem(cHiopSparseProblem *problem);
@@ -168,7 +168,11 @@ public:
    * @param[out] cupp array of upper bounds for constraints. A value of 1e20 or more means no upper 
    *                  bound is present (managed by Umpire)
    * @param[out] type array of indicating whether the constraint is linear, quadratic, or general
-   *                  nonlinear. Momentarily all bounds should be marked as nonlinear (allocated on host).
+   *                  nonlinear (allocated on host). The Jacobian rows of the constraints marked as linear
+   *                  are requested only once per solve when the row-subset `eval_Jac_cons` is provided;
+   *                  afterwards this callback is called with the rows of the nonlinear constraints only.
+   *                  For MDS and sparse NLPs, it should then give the nonzeros of these rows in the same
+   *                  order as when it is called with all the rows of the equalities or inequalities.
    */
   virtual bool get_cons_info(const size_type& m, double* clow, double* cupp, NonlinearityType* type)=0;
 
@@ -246,7 +250,11 @@ public:
     return false;
   }
   
-  /** Passes the communicator, defaults to MPI_COMM_WORLD (dummy for non-MPI builds)  */
+  /** Passes the communicator, defaults to MPI_COMM_WORLD (dummy for non-MPI builds). 
+   *
+   * @note NLPs solved concurrently by different threads of the same process should each pass a 
+   * distinct communicator (e.g., obtained with MPI_Comm_dup) since HiOp issues collectives on it.
+   */
   virtual bool get_MPI_comm(MPI_Comm& comm_out) { comm_out=MPI_COMM_WORLD; return true;}
   
 
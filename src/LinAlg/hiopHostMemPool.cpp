@@ -0,0 +1,264 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory (LLNL).
+// Written by Cosmin G. Petra, petra1@llnl.gov.
+// LLNL-CODE-742473. All rights reserved.
+//
+// This file is part of HiOp. For details, see https://github.com/LLNL/hiop. HiOp 
+// is released under the BSD 3-clause license (https://opensource.org/licenses/BSD-3-Clause). 
+// Please also read “Additional BSD Notice” below.
+//
+// Redistribution and use in source and binary forms, with or without modification, 
+// are permitted provided that the following conditions are met:
+// i. Redistributions of source code must retain the above copyright notice, this list 
+// of conditions and the disclaimer below.
+// ii. Redistributions in binary form must reproduce the above copyright notice, 
+// this list of conditions and the disclaimer (as noted below) in the documentation and/or 
+// other materials provided with the distribution.
+// iii. Neither the name of the LLNS/LLNL nor the names of its contributors may be used to 
+// endorse or promote products derived from this software without specific prior written 
+// permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY 
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES 
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT 
+// SHALL LAWRENCE LIVERMORE NATIONAL SECURITY, LLC, THE U.S. DEPARTMENT OF ENERGY OR 
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS 
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+// AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Additional BSD Notice
+// 1. This notice is required to be provided under our contract with the U.S. Department 
+// of Energy (DOE). This work was produced at Lawrence Livermore National Laboratory under 
+// Contract No. DE-AC52-07NA27344 with the DOE.
+// 2. Neither the United States Government nor Lawrence Livermore National Security, LLC 
+// nor any of their employees, makes any warranty, express or implied, or assumes any 
+// liability or responsibility for the accuracy, completeness, or usefulness of any 
+// information, apparatus, product, or process disclosed, or represents that its use would
+// not infringe privately-owned rights.
+// 3. Also, reference herein to any specific commercial products, process, or services by 
+// trade name, trademark, manufacturer or otherwise does not necessarily constitute or 
+// imply its endorsement, recommendation, or favoring by the United States Government or 
+// Lawrence Livermore National Security, LLC. The views and opinions of authors expressed 
+// herein do not necessarily state or reflect those of the United States Government or 
+// Lawrence Livermore National Security, LLC, and shall not be used for advertising or 
+// product endorsement purposes.
+
+/**
+ * @file hiopHostMemPool.cpp
+ *
+ */
+
+#include "hiopHostMemPool.hpp"
+
+#include <new>
+#include <sstream>
+#include <iomanip>
+#include <cassert>
+
+namespace hiop
+{
+
+namespace
+{
+/// header stored in front of each block; keeps the alignment of the memory returned by the system allocator
+struct alignas(16) BlockHeader
+{
+  /// pool the block was allocated from or nullptr if the block was allocated from the system
+  hiopHostMemPool* pool;
+  /// size class of the block or -1 if the block has exactly the requested size
+  long long size_class;
+};
+
+/// size of the blocks of the smallest size class
+const std::size_t min_class_bytes = 64;
+/// log2 of min_class_bytes
+const int min_class_log2 = 6;
+/// number of size classes per power of two
+const int classes_per_octave = 4;
+/// number of size classes covering all the possible sizes
+const int num_classes = (8*sizeof(std::size_t) - min_class_log2) * classes_per_octave + 1;
+
+/// the pool active on each thread
+thread_local hiopHostMemPool* active_pool = nullptr;
+}
+
+hiopHostMemPool::hiopHostMemPool(double max_cached_mb)
+  : free_lists_(num_classes),
+    class_bytes_(num_classes, 0),
+    cached_bytes_(0),
+    max_cached_bytes_(0),
+    num_outstanding_(0),
+    released_(false),
+    num_allocs_(0),
+    num_hits_(0)
+{
+  set_max_cached(max_cached_mb);
+}
+
+hiopHostMemPool::~hiopHostMemPool()
+{
+  assert(0 == cached_bytes_ && 0 == num_outstanding_);
+}
+
+hiopHostMemPool* hiopHostMemPool::active()
+{
+  return active_pool;
+}
+
+hiopHostMemPool* hiopHostMemPool::set_active(hiopHostMemPool* pool)
+{
+  hiopHostMemPool* prev = active_pool;
+  active_pool = pool;
+  return prev;
+}
+
+void* hiopHostMemPool::allocate_block(std::size_t bytes)
+{
+  if(active_pool) {
+    return active_pool->allocate(bytes);
+  }
+  BlockHeader* header = static_cast<BlockHeader*>(::operator new(sizeof(BlockHeader) + bytes));
+  header->pool = nullptr;
+  header->size_class = -1;
+  return header + 1;
+}
+
+void hiopHostMemPool::deallocate_block(void* p)
+{
+  if(nullptr == p) {
+    return;
+  }
+  BlockHeader* header = static_cast<BlockHeader*>(p) - 1;
+  if(header->pool) {
+    header->pool->deallocate(p, static_cast<int>(header->size_class));
+  } else {
+    ::operator delete(header);
+  }
+}
+
+int hiopHostMemPool::size_class(std::size_t bytes, std::size_t& class_bytes)
+{
+  if(bytes <= min_class_bytes) {
+    class_bytes = min_class_bytes;
+    return 0;
+  }
+  //find e such that 2^e < bytes <= 2^(e+1) and split (2^e, 2^(e+1)] in 'classes_per_octave' classes
+  int e = 0;
+  for(std::size_t v = bytes-1; v > 1; v >>= 1) {
+    e++;
+  }
+  const std::size_t base = static_cast<std::size_t>(1) << e;
+  const std::size_t step = base / classes_per_octave;
+  const std::size_t k = (bytes - base + step - 1) / step;
+  assert(k>=1 && k<=classes_per_octave);
+  class_bytes = base + k*step;
+  return (e-min_class_log2)*classes_per_octave + static_cast<int>(k);
+}
+
+void* hiopHostMemPool::allocate(std::size_t bytes)
+{
+  std::size_t alloc_bytes = bytes;
+  const int c = size_class(bytes, alloc_bytes);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    assert(!released_);
+    num_allocs_++;
+    num_outstanding_++;
+    std::vector<void*>& free_list = free_lists_[c];
+    if(!free_list.empty()) {
+      void* p = free_list.back();
+      free_list.pop_back();
+      cached_bytes_ -= alloc_bytes;
+      num_hits_++;
+      return p;
+    }
+    class_bytes_[c] = alloc_bytes;
+  }
+  
+  BlockHeader* header = static_cast<BlockHeader*>(::operator new(sizeof(BlockHeader) + alloc_bytes));
+  header->pool = this;
+  header->size_class = c;
+  return header + 1;
+}
+
+void hiopHostMemPool::deallocate(void* p, int c)
+{
+  assert(c >= 0 && c < num_classes);
+  bool destroy;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    assert(num_outstanding_ > 0);
+    num_outstanding_--;
+    if(!released_ && cached_bytes_ + class_bytes_[c] <= max_cached_bytes_) {
+      free_lists_[c].push_back(p);
+      cached_bytes_ += class_bytes_[c];
+      return;
+    }
+    destroy = released_ && 0 == num_outstanding_;
+  }
+  ::operator delete(static_cast<BlockHeader*>(p) - 1);
+  if(destroy) {
+    delete this;
+  }
+}
+
+void hiopHostMemPool::release()
+{
+  bool destroy;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    assert(!released_);
+    released_ = true;
+    trim(0);
+    destroy = 0 == num_outstanding_;
+  }
+  if(destroy) {
+    delete this;
+  }
+}
+
+void hiopHostMemPool::set_max_cached(double max_cached_mb)
+{
+  assert(max_cached_mb >= 0.);
+  std::lock_guard<std::mutex> lock(mutex_);
+  max_cached_bytes_ = static_cast<std::size_t>(max_cached_mb * 1024. * 1024.);
+  trim(max_cached_bytes_);
+}
+
+void hiopHostMemPool::trim(std::size_t max_bytes)
+{
+  //release from the largest classes first
+  for(int c=num_classes-1; c>=0 && cached_bytes_ > max_bytes; c--) {
+    std::vector<void*>& free_list = free_lists_[c];
+    while(!free_list.empty() && cached_bytes_ > max_bytes) {
+      ::operator delete(static_cast<BlockHeader*>(free_list.back()) - 1);
+      free_list.pop_back();
+      cached_bytes_ -= class_bytes_[c];
+    }
+  }
+}
+
+void hiopHostMemPool::reset_stats()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  num_allocs_ = 0;
+  num_hits_ = 0;
+}
+
+std::string hiopHostMemPool::get_summary() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  const double MB = 1024.*1024.;
+  std::stringstream ss;
+  ss << std::fixed << std::setprecision(3);
+  ss << "Host memory pool: " << num_allocs_ << " allocations   hit rate "
+     << std::setprecision(1) << (num_allocs_>0 ? 100.*num_hits_/num_allocs_ : 0.) << " percent   "
+     << std::setprecision(3) << "cached " << cached_bytes_/MB << " MB (max " << max_cached_bytes_/MB << " MB)"
+     << std::endl;
+  return ss.str();
+}
+
+} // end of namespace
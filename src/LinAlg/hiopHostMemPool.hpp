@@ -0,0 +1,179 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory (LLNL).
+// Written by Cosmin G. Petra, petra1@llnl.gov.
+// LLNL-CODE-742473. All rights reserved.
+//
+// This file is part of HiOp. For details, see https://github.com/LLNL/hiop. HiOp 
+// is released under the BSD 3-clause license (https://opensource.org/licenses/BSD-3-Clause). 
+// Please also read “Additional BSD Notice” below.
+//
+// Redistribution and use in source and binary forms, with or without modification, 
+// are permitted provided that the following conditions are met:
+// i. Redistributions of source code must retain the above copyright notice, this list 
+// of conditions and the disclaimer below.
+// ii. Redistributions in binary form must reproduce the above copyright notice, 
+// this list of conditions and the disclaimer (as noted below) in the documentation and/or 
+// other materials provided with the distribution.
+// iii. Neither the name of the LLNS/LLNL nor the names of its contributors may be used to 
+// endorse or promote products derived from this software without specific prior written 
+// permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY 
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES 
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT 
+// SHALL LAWRENCE LIVERMORE NATIONAL SECURITY, LLC, THE U.S. DEPARTMENT OF ENERGY OR 
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS 
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+// AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Additional BSD Notice
+// 1. This notice is required to be provided under our contract with the U.S. Department 
+// of Energy (DOE). This work was produced at Lawrence Livermore National Laboratory under 
+// Contract No. DE-AC52-07NA27344 with the DOE.
+// 2. Neither the United States Government nor Lawrence Livermore National Security, LLC 
+// nor any of their employees, makes any warranty, express or implied, or assumes any 
+// liability or responsibility for the accuracy, completeness, or usefulness of any 
+// information, apparatus, product, or process disclosed, or represents that its use would
+// not infringe privately-owned rights.
+// 3. Also, reference herein to any specific commercial products, process, or services by 
+// trade name, trademark, manufacturer or otherwise does not necessarily constitute or 
+// imply its endorsement, recommendation, or favoring by the United States Government or 
+// Lawrence Livermore National Security, LLC. The views and opinions of authors expressed 
+// herein do not necessarily state or reflect those of the United States Government or 
+// Lawrence Livermore National Security, LLC, and shall not be used for advertising or 
+// product endorsement purposes.
+
+/**
+ * @file hiopHostMemPool.hpp
+ *
+ * Pool allocator for the raw arrays allocated by LinearAlgebraFactory in the host (default) memory space.
+ */
+
+#ifndef HIOP_HOST_MEM_POOL
+#define HIOP_HOST_MEM_POOL
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <mutex>
+
+namespace hiop
+{
+
+/**
+ * @brief Pool of host memory blocks with size-class recycling.
+ *
+ * Each IPM solver for which the pool is enabled owns a pool, which is made active on the calling thread for
+ * the duration of the solver's constructor and of `run` (the feasibility restoration solver uses the pool of
+ * the solver it belongs to). The raw host arrays of `LinearAlgebraFactory` are obtained with `allocate_block`, 
+ * which serves them from the pool active on the calling thread or, when no pool is active, from the system 
+ * allocator without any locking.
+ *
+ * The requested sizes are rounded up to size classes (four classes per power of two, so that at most 25% of a 
+ * block is unused) and released blocks are kept in per-class free lists, from which later requests of the same
+ * class are served without calling the system allocator. The amount of memory kept in the free lists is capped;
+ * blocks released over the cap are returned to the system.
+ *
+ * Each block carries a small header storing the pool it was allocated from and its size class, so blocks are
+ * returned to their own pool regardless of the thread or of the pool active when they are released. The blocks
+ * of a pool can outlive the solver owning it: `release` returns the cached blocks to the system and the pool
+ * is destroyed once its last block is released.
+ */
+class hiopHostMemPool
+{
+public:
+  /// Creates a pool keeping at most `max_cached_mb` MB in the free lists
+  hiopHostMemPool(double max_cached_mb);
+
+  /// Returns the pool active on the calling thread or nullptr if none is active
+  static hiopHostMemPool* active();
+
+  /// Sets the pool active on the calling thread and returns the previously active pool
+  static hiopHostMemPool* set_active(hiopHostMemPool* pool);
+
+  /// Allocates a block of (at least) `bytes` bytes from the active pool or from the system if no pool is active
+  static void* allocate_block(std::size_t bytes);
+
+  /// Releases a block allocated with `allocate_block`
+  static void deallocate_block(void* p);
+
+  /**
+   * Releases the reference of the owner: the cached blocks are returned to the system and the pool is 
+   * destroyed once all of its blocks are released. The pool should not be used by the owner afterwards.
+   */
+  void release();
+
+  /// Sets the maximum amount of memory (in MB) kept in the free lists; the blocks over the cap are released
+  void set_max_cached(double max_cached_mb);
+
+  /// Resets the allocation statistics
+  void reset_stats();
+
+  /// Returns a report with the number of allocations, the hit rate, and the memory cached
+  std::string get_summary() const;
+
+private:
+  ~hiopHostMemPool();
+  hiopHostMemPool(const hiopHostMemPool&) = delete;
+  hiopHostMemPool& operator=(const hiopHostMemPool&) = delete;
+
+  /// Returns the size class of `bytes` and the size of the blocks of the class in `class_bytes`
+  static int size_class(std::size_t bytes, std::size_t& class_bytes);
+
+  /// Allocates a block of (at least) `bytes` bytes from the free lists or from the system
+  void* allocate(std::size_t bytes);
+
+  /// Returns the block `p` of size class `c` to the free lists or to the system
+  void deallocate(void* p, int c);
+
+  /// Releases cached blocks until the amount cached is at most `max_bytes`. The mutex should be locked.
+  void trim(std::size_t max_bytes);
+
+  /// free lists, one per size class
+  std::vector<std::vector<void*> > free_lists_;
+  /// size of the blocks of each size class
+  std::vector<std::size_t> class_bytes_;
+  
+  std::size_t cached_bytes_;
+  std::size_t max_cached_bytes_;
+
+  /// number of blocks of the pool not yet released
+  std::size_t num_outstanding_;
+  /// true after the owner released the pool
+  bool released_;
+
+  /// number of allocations since the last reset of the statistics
+  long long num_allocs_;
+  /// number of allocations served from the free lists
+  long long num_hits_;
+
+  /// blocks can be released by threads other than the one on which the pool is active
+  mutable std::mutex mutex_;
+};
+
+/**
+ * @brief Makes a pool (or none, for a nullptr) active on the calling thread for the lifetime of the object. 
+ * The previously active pool is restored on destruction.
+ */
+class hiopHostMemPoolActivation
+{
+public:
+  hiopHostMemPoolActivation(hiopHostMemPool* pool)
+    : prev_(hiopHostMemPool::set_active(pool))
+  {
+  }
+  ~hiopHostMemPoolActivation()
+  {
+    hiopHostMemPool::set_active(prev_);
+  }
+private:
+  hiopHostMemPoolActivation(const hiopHostMemPoolActivation&) = delete;
+  hiopHostMemPoolActivation& operator=(const hiopHostMemPoolActivation&) = delete;
+  hiopHostMemPool* prev_;
+};
+
+} // end of namespace
+#endif
@@ -76,6 +76,8 @@
 #include "hiopLinAlgFactory.hpp"
 
 #include "hiopCppStdUtils.hpp"
+#include "hiopMemoryTracker.hpp"
+#include "hiopHostMemPool.hpp"
 using namespace hiop;
 
 /**
@@ -202,23 +204,29 @@ hiopMatrixSparse* LinearAlgebraFactory::create_matrix_sym_sparse(const std::stri
 
 /**
  * @brief Static method to create a raw C array
+ *
+ * In the default memory space, the array is obtained from the host memory pool, which recycles the
+ * released arrays when enabled (see `hiopHostMemPool`).
  */
 double* LinearAlgebraFactory::create_raw_array(const std::string& mem_space, size_type n)
 {
   const std::string mem_space_upper = toupper(mem_space);
+  double* a;
   if(mem_space_upper == "DEFAULT") {
-    return new double[n];
+    a = static_cast<double*>(hiopHostMemPool::allocate_block(n*sizeof(double)));
   } else {
 #ifdef HIOP_USE_RAJA
     auto& resmgr = umpire::ResourceManager::getInstance();
     umpire::Allocator al  = resmgr.getAllocator(mem_space_upper);
-    return static_cast<double*>(al.allocate(n*sizeof(double)));
+    a = static_cast<double*>(al.allocate(n*sizeof(double)));
 #else
     assert(false && "requested memory space not available because Hiop was not"
            "built with RAJA support");
-    return new double[n];
+    a = static_cast<double*>(hiopHostMemPool::allocate_block(n*sizeof(double)));
 #endif
   }
+  hiopMemoryTracker::track_alloc(a, n*sizeof(double));
+  return a;
 }
 
 /**
@@ -226,14 +234,61 @@ double* LinearAlgebraFactory::create_raw_array(const std::string& mem_space, siz
  */
 void LinearAlgebraFactory::delete_raw_array(const std::string& mem_space, double* a)
 {
+  hiopMemoryTracker::track_free(a);
   const std::string mem_space_upper = toupper(mem_space);
   if(mem_space_upper == "DEFAULT") {
-    delete [] a;
+    hiopHostMemPool::deallocate_block(a);
   } else {
 #ifdef HIOP_USE_RAJA
     auto& resmgr = umpire::ResourceManager::getInstance();
     umpire::Allocator al  = resmgr.getAllocator(mem_space_upper);
     al.deallocate(a);
+#else
+    hiopHostMemPool::deallocate_block(a);
+#endif
+  }
+}
+
+/**
+ * @brief Static method to create a raw C array of indexes
+ */
+index_type* LinearAlgebraFactory::create_raw_array_int(const std::string& mem_space, size_type n)
+{
+  const std::string mem_space_upper = toupper(mem_space);
+  index_type* a;
+  if(mem_space_upper == "DEFAULT") {
+    a = static_cast<index_type*>(hiopHostMemPool::allocate_block(n*sizeof(index_type)));
+  } else {
+#ifdef HIOP_USE_RAJA
+    auto& resmgr = umpire::ResourceManager::getInstance();
+    umpire::Allocator al  = resmgr.getAllocator(mem_space_upper);
+    a = static_cast<index_type*>(al.allocate(n*sizeof(index_type)));
+#else
+    assert(false && "requested memory space not available because Hiop was not"
+           "built with RAJA support");
+    a = static_cast<index_type*>(hiopHostMemPool::allocate_block(n*sizeof(index_type)));
+#endif
+  }
+  hiopMemoryTracker::track_alloc(a, n*sizeof(index_type));
+  return a;
+}
+
+/**
+ * @brief Static method to delete a raw C array of indexes
+ */
+void LinearAlgebraFactory::delete_raw_array_int(const std::string& mem_space, index_type* a)
+{
+  hiopMemoryTracker::track_free(a);
+  const std::string mem_space_upper = toupper(mem_space);
+  if(mem_space_upper == "DEFAULT") {
+    hiopHostMemPool::deallocate_block(a);
+  } else {
+#ifdef HIOP_USE_RAJA
+    auto& resmgr = umpire::ResourceManager::getInstance();
+    umpire::Allocator al  = resmgr.getAllocator(mem_space_upper);
+    al.deallocate(a);
+#else
+    hiopHostMemPool::deallocate_block(a);
 #endif
   }
 }
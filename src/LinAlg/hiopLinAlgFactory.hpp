@@ -107,6 +107,9 @@ public:
   
   /**
    * @brief Static method to create a raw C array
+   *
+   * The allocation is recorded by the `hiopMemoryTracker` active on the calling thread, if any, for the
+   * currently active subsystem.
    */
   static double* create_raw_array(const std::string& mem_space, size_type n);
 
@@ -114,6 +117,19 @@ public:
    * @brief Static method to delete a raw C array
    */
   static void delete_raw_array(const std::string& mem_space, double* a);
+
+  /**
+   * @brief Static method to create a raw C array of indexes
+   *
+   * The allocation is recorded by the `hiopMemoryTracker` active on the calling thread, if any, for the
+   * currently active subsystem.
+   */
+  static index_type* create_raw_array_int(const std::string& mem_space, size_type n);
+
+  /**
+   * @brief Static method to delete a raw C array of indexes
+   */
+  static void delete_raw_array_int(const std::string& mem_space, index_type* a);
 };
 
 } // namespace hiop
@@ -58,6 +58,7 @@
 
 #include "hiopOptions.hpp"
 #include "hiopLinAlgFactory.hpp"
+#include "hiopMemoryTracker.hpp"
 
 namespace hiop {
   hiopLinSolver::hiopLinSolver()
@@ -73,6 +74,7 @@ namespace hiop {
   {
     nlp_ = nlp;
     perf_report_ = "on"==hiop::tolower(nlp_->options->GetString("time_kkt"));
+    hiopMemoryTrackerScope mem_scope(hiopMemoryTracker::LinSolver);
     M_ = LinearAlgebraFactory::create_matrix_dense(nlp_->options->GetString("mem_space"), n, n);
   }
 
@@ -100,6 +102,7 @@ namespace hiop {
     //we default to triplet matrix for now; derived classes using CSR matrices will not call
     //this constructor (will call the 1-parameter constructor below) so they avoid creating
     //the triplet matrix
+    hiopMemoryTrackerScope mem_scope(hiopMemoryTracker::LinSolver);
     M_ = new hiopMatrixSparseTriplet(n, n, nnz);
     nlp_ = nlp;
     perf_report_ = "on"==hiop::tolower(nlp->options->GetString("time_kkt"));
@@ -114,6 +117,7 @@ namespace hiop {
   
   hiopLinSolverNonSymSparse::hiopLinSolverNonSymSparse(int n, int nnz, hiopNlpFormulation* nlp)
   {
+    hiopMemoryTrackerScope mem_scope(hiopMemoryTracker::LinSolver);
     M_ = new hiopMatrixSparseTriplet(n, n, nnz);
     nlp_ = nlp;
     perf_report_ = "on"==hiop::tolower(nlp->options->GetString("time_kkt"));
@@ -50,120 +50,137 @@
 #define HIOP_LINSOLVER_LAPACK
 
 #include "hiopLinSolver.hpp"
+#include "hiopMemoryTracker.hpp"
+
+#include <algorithm>
+#include <cmath>
 
 namespace hiop {
 
-/** Wrapper for LAPACK's DSYTRF */
+/** Wrapper for LAPACK's DSYTRF 
+ *
+ * The blocked Bunch-Kaufman factorization is driven panel by panel (DLASYF/DSYTF2, exactly as done 
+ * internally by DSYTRF) so that the inertia is accumulated as the pivots become final. When an upper 
+ * bound on the number of negative eigenvalues is set (see set_max_neg_eig), the factorization stops as 
+ * soon as this bound is exceeded, since the (inertia-correcting) caller would discard it anyway. The 
+ * size of the workspace is queried only once.
+ */
 class hiopLinSolverIndefDenseLapack : public hiopLinSolverIndefDense
 {
 public:
   hiopLinSolverIndefDenseLapack(int n, hiopNlpFormulation* nlp)
-    : hiopLinSolverIndefDense(n, nlp)
+    : hiopLinSolverIndefDense(n, nlp),
+      nb_(-1),
+      max_neg_eig_(-1)
   {
-    ipiv = new int[n];
+    hiopMemoryTrackerScope mem_scope(hiopMemoryTracker::LinSolver);
+    ipiv = LinearAlgebraFactory::create_raw_array_int("DEFAULT", n);
     //a "legacy" hiopVector within in the CPU memory space is sufficient 
     dwork = LinearAlgebraFactory::create_vector("DEFAULT", 0);
   }
   virtual ~hiopLinSolverIndefDenseLapack()
   {
-    delete [] ipiv;
+    LinearAlgebraFactory::delete_raw_array_int("DEFAULT", ipiv);
     delete dwork;
   }
 
+  /** 
+   * Sets an upper bound on the number of negative eigenvalues; the factorization is stopped (and 
+   * matrixChanged returns a number of negative eigenvalues larger than the bound) as soon as more
+   * negative pivots are found. A negative value (default) disables the early stop.
+   *
+   * Warning: after an early stop the factors are incomplete and the matrix cannot be used in a solve.
+   */
+  void set_max_neg_eig(int max_neg_eig)
+  {
+    max_neg_eig_ = max_neg_eig;
+  }
+
   /** Triggers a refactorization of the matrix, if necessary. 
    * Overload from base class. */
   int matrixChanged()
   {
     assert(M_->n() == M_->m());
-    int N=M_->n(), lda = N, info;
+    int N=M_->n(), lda = N, info=0;
     if(N==0) return 0;
 
     nlp_->runStats.linsolv.tmFactTime.start();
     
-    double dwork_tmp;
     char uplo='L'; // M is upper in C++ so it's lower in fortran
 
     //
-    //query sizes
+    //query the (panel) block size once; the workspace is N x nb_
     //
-    int lwork=-1;
-    DSYTRF(&uplo, &N, M_->local_data(), &lda, ipiv, &dwork_tmp, &lwork, &info );
-    assert(info==0);
+    if(nb_<0) {
+      double dwork_tmp;
+      int lwork=-1;
+      DSYTRF(&uplo, &N, M_->local_data(), &lda, ipiv, &dwork_tmp, &lwork, &info );
+      assert(info==0);
+      nb_ = std::max(1, std::min(N, static_cast<int>(dwork_tmp)/N));
 
-    lwork=(int)dwork_tmp;
-    if(lwork != dwork->get_size()) {
+      hiopMemoryTrackerScope mem_scope(hiopMemoryTracker::LinSolver);
       delete dwork;
-      dwork = LinearAlgebraFactory::create_vector("DEFAULT", lwork);
+      dwork = LinearAlgebraFactory::create_vector("DEFAULT", N*nb_);
     }
 
-    bool rank_deficient=false;
-    //
-    // factorization
     //
-    DSYTRF(&uplo, &N, M_->local_data(), &lda, ipiv, dwork->local_data(), &lwork, &info );
-    if(info<0) {
-      nlp_->log->printf(hovError,
-		       "hiopLinSolverIndefDense error: %d argument to dsytrf has an illegal value.\n",
-		       -info);
-      return -1;
-    } else {
-      if(info>0) {
-	nlp_->log->printf(hovWarning,
-			 "hiopLinSolverIndefDense error: %d entry in the factorization's diagonal\n"
-			 "is exactly zero. Division by zero will occur if it a solve is attempted.\n",
-			 info);
-	//matrix is singular
-	return -1;
-      }
-    }
-    assert(info==0);
-    nlp_->runStats.linsolv.tmFactTime.stop();
-    
-    nlp_->runStats.linsolv.tmInertiaComp.start();
+    // factorization, panel by panel (same as the loop for uplo='L' in DSYTRF)
     //
-    // Compute the inertia. Only negative eigenvalues are returned.
-    // Code originally written by M. Schanenfor PIPS based on
-    // LINPACK's dsidi Fortran routine (http://www.netlib.org/linpack/dsidi.f)
-    // 04/08/2020 - petra: fixed the test for non-positive pivots (was only for negative pivots)
+    double* MM = M_->local_data();
+    int ldw = N;
     int negEigVal=0;
     int posEigVal=0;
     int nullEigVal=0;
-    double t=0;
-    double* MM = M_->local_data();
+    int k=0;
+    while(k<N) {
+      int n_rem = N-k, kb, iinfo;
+      if(nb_>1 && k<N-nb_) {
+        DLASYF(&uplo, &n_rem, &nb_, &kb, MM+k*N+k, &lda, ipiv+k, dwork->local_data(), &ldw, &iinfo);
+      } else {
+        DSYTF2(&uplo, &n_rem, MM+k*N+k, &lda, ipiv+k, &iinfo);
+        kb = n_rem;
+      }
+      if(iinfo<0) {
+        nlp_->runStats.linsolv.tmFactTime.stop();
+        nlp_->log->printf(hovError,
+                          "hiopLinSolverIndefDense error: %d argument to dsytrf has an illegal value.\n",
+                          -iinfo);
+        return -1;
+      }
+      if(info==0 && iinfo>0) info = iinfo+k;
 
-    for(int k=0; k<N; k++) {
-      //c       2 by 2 block
-      //c       use det (d  s)  =  (d/t * c - t) * t  ,  t = dabs(s)
-      //c               (s  c)
-      //c       to avoid underflow/overflow troubles.
-      //c       take two passes through scaling.  use  t  for flag.
-      double d = MM[k*N+k];
-      if(ipiv[k] <= 0) {
-	if(t==0) {
-	  assert(k+1<N);
-	  if(k+1<N) {
-	    t=fabs(MM[k*N+k+1]);
-	    d=(d/t) * MM[(k+1)*N+k+1]-t;
-	  }
-	} else {
-	  d=t;
-	  t=0.;
-	}
+      //adjust the pivots (to refer to the whole matrix)
+      for(int j=k; j<k+kb; j++) {
+        ipiv[j] = ipiv[j]>0 ? ipiv[j]+k : ipiv[j]-k;
       }
-      //printf("d = %22.14e \n", d);
-      //if(d<0) negEigVal++;
-      if(d < -1e-14) {
-	negEigVal++;
-      } else if(d < 1e-14) {
-	nullEigVal++;
-	//break;
-      } else {
-	posEigVal++;
+
+      nlp_->runStats.linsolv.tmInertiaComp.start();
+      count_inertia(k, k+kb, negEigVal, nullEigVal, posEigVal);
+      nlp_->runStats.linsolv.tmInertiaComp.stop();
+      k += kb;
+      
+      if(max_neg_eig_>=0 && negEigVal>max_neg_eig_ && k<N) {
+        nlp_->runStats.linsolv.tmFactTime.stop();
+        nlp_->log->printf(hovScalars,
+                          "hiopLinSolverIndefDense: factorization stopped after %d of %d columns: "
+                          "%d negative pivots found, at most %d expected.\n",
+                          k, N, negEigVal, max_neg_eig_);
+        return negEigVal;
       }
     }
-    //printf("(pos,null,neg)=(%d,%d,%d)\n", posEigVal, nullEigVal, negEigVal);
-    nlp_->runStats.linsolv.tmInertiaComp.stop();
+
+    if(info>0) {
+      nlp_->runStats.linsolv.tmFactTime.stop();
+      nlp_->log->printf(hovWarning,
+                        "hiopLinSolverIndefDense error: %d entry in the factorization's diagonal\n"
+                        "is exactly zero. Division by zero will occur if it a solve is attempted.\n",
+                        info);
+      //matrix is singular
+      return -1;
+    }
+    nlp_->runStats.linsolv.tmFactTime.stop();
     
+    //printf("(pos,null,neg)=(%d,%d,%d)\n", posEigVal, nullEigVal, negEigVal);
     if(nullEigVal>0) return -1;
     return negEigVal;
   }
@@ -192,12 +209,61 @@ public:
     return info==0;
   }
 
+protected:
+  /**
+   * Computes the inertia of the (factorized) D blocks in the columns [k_begin, k_end) and adds it to 
+   * 'neg', 'null', and 'pos'. The range should not split a 2x2 block.
+   *
+   * Code originally written by M. Schanen for PIPS based on
+   * LINPACK's dsidi Fortran routine (http://www.netlib.org/linpack/dsidi.f)
+   * 04/08/2020 - petra: fixed the test for non-positive pivots (was only for negative pivots)
+   */
+  void count_inertia(int k_begin, int k_end, int& negEigVal, int& nullEigVal, int& posEigVal) const
+  {
+    const int N=M_->n();
+    const double* MM = M_->local_data();
+    double t=0;
+    for(int k=k_begin; k<k_end; k++) {
+      //c       2 by 2 block
+      //c       use det (d  s)  =  (d/t * c - t) * t  ,  t = dabs(s)
+      //c               (s  c)
+      //c       to avoid underflow/overflow troubles.
+      //c       take two passes through scaling.  use  t  for flag.
+      double d = MM[k*N+k];
+      if(ipiv[k] <= 0) {
+	if(t==0) {
+	  assert(k+1<k_end);
+	  if(k+1<N) {
+	    t=fabs(MM[k*N+k+1]);
+	    d=(d/t) * MM[(k+1)*N+k+1]-t;
+	  }
+	} else {
+	  d=t;
+	  t=0.;
+	}
+      }
+      //printf("d = %22.14e \n", d);
+      //if(d<0) negEigVal++;
+      if(d < -1e-14) {
+	negEigVal++;
+      } else if(d < 1e-14) {
+	nullEigVal++;
+	//break;
+      } else {
+	posEigVal++;
+      }
+    }
+  }
 protected:
   int* ipiv;
   hiopVector* dwork;
+  /// block size of the panels (DLASYF); -1 before the workspace query
+  int nb_;
+  /// upper bound on the number of negative eigenvalues (negative when not used)
+  int max_neg_eig_;
 private:
   hiopLinSolverIndefDenseLapack()
-    : ipiv(NULL), dwork(NULL)
+    : ipiv(NULL), dwork(NULL), nb_(-1), max_neg_eig_(-1)
   {
     assert(false);
   }
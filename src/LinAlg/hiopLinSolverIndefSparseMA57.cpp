@@ -1,6 +1,7 @@
 #include "hiopLinSolverIndefSparseMA57.hpp"
 
 #include "hiop_blasdefs.hpp"
+#include "hiopMemoryTracker.hpp"
 
 namespace hiop
 {
@@ -51,6 +52,14 @@ namespace hiop
   }
   hiopLinSolverIndefSparseMA57::~hiopLinSolverIndefSparseMA57()
   {
+    hiopMemoryTracker::track_free(irowM_);
+    hiopMemoryTracker::track_free(jcolM_);
+    hiopMemoryTracker::track_free(ifact_);
+    hiopMemoryTracker::track_free(fact_);
+    hiopMemoryTracker::track_free(keep_);
+    hiopMemoryTracker::track_free(iwork_);
+    hiopMemoryTracker::track_free(dwork_);
+
     delete [] irowM_;
     delete [] jcolM_;
     delete [] ifact_;
@@ -93,6 +102,15 @@ namespace hiop
 
     lifact_ = (int) (ipessimism_ * info_[9]);
     ifact_  = new int[lifact_];
+
+    //account the work arrays and the factors to the linear solver
+    hiopMemoryTracker::track_alloc(irowM_, nnz_*sizeof(int), hiopMemoryTracker::LinSolver);
+    hiopMemoryTracker::track_alloc(jcolM_, nnz_*sizeof(int), hiopMemoryTracker::LinSolver);
+    hiopMemoryTracker::track_alloc(keep_, lkeep_*sizeof(int), hiopMemoryTracker::LinSolver);
+    hiopMemoryTracker::track_alloc(iwork_, 5*n_*sizeof(int), hiopMemoryTracker::LinSolver);
+    hiopMemoryTracker::track_alloc(dwork_, n_*sizeof(double), hiopMemoryTracker::LinSolver);
+    hiopMemoryTracker::track_alloc(fact_, lfact_*sizeof(double), hiopMemoryTracker::LinSolver);
+    hiopMemoryTracker::track_alloc(ifact_, lifact_*sizeof(int), hiopMemoryTracker::LinSolver);
   }
 
 
@@ -129,9 +147,11 @@ namespace hiop
                 ifact_, &info_[1], &intTemp, &lifact_,
                 info_ );
 
+          hiopMemoryTracker::track_free(fact_);
           delete [] fact_;
           fact_ = newfact;
           lfact_ = lnfact;
+          hiopMemoryTracker::track_alloc(fact_, lfact_*sizeof(double), hiopMemoryTracker::LinSolver);
           };
           break;
         case -4: {
@@ -143,9 +163,11 @@ namespace hiop
                 fact_, &lfact_, fact_, &lfact_,
                ifact_, &lifact_, nifact, &lnifact,
                info_ );
+          hiopMemoryTracker::track_free(ifact_);
           delete [] ifact_;
           ifact_ = nifact;
           lifact_ = lnifact;
+          hiopMemoryTracker::track_alloc(ifact_, lifact_*sizeof(int), hiopMemoryTracker::LinSolver);
           };
           break;
         case 4: {
@@ -50,6 +50,7 @@
 #define HIOP_MATRIX
 
 #include <cstdio>
+#include <cassert>
 #include "hiop_defs.hpp"
 
 namespace hiop
@@ -161,6 +162,28 @@ public:
 							     double alpha,
 							     hiopMatrixDense& W) const = 0;
 
+  /**
+   * @brief upper triangle of W = alpha*[this; X]*[this; X]^T, i.e., the Gram matrix of the rows of 'this'
+   * and 'X' stacked on top of each other.
+   *
+   * The three blocks this*this^T, this*X^T, and X*X^T are computed directly in W and only the upper
+   * triangle of W is updated since this will be eventually sent to LAPACK. 'this' and 'X' can be
+   * distributed, in which case the local products are summed across ranks in a single reduction.
+   *
+   * The functionality of this method is needed only for general (non-symmetric) matrices and, for this
+   * reason, only general matrices classes implement/need to implement this method.
+   *
+   * @pre 'this' and 'X' have the same number of columns and the same distribution
+   * @pre W.m() == W.n() == this->m()+X.m()
+   * @pre W is a local/non-distributed matrix
+   */
+  virtual void stackedGramToSymDenseMatrixUpperTriangle(double alpha,
+                                                        const hiopMatrix& X,
+                                                        hiopMatrixDense& W) const
+  {
+    assert(false && "not implemented for this matrix class");
+  }
+
   /**
    * @brief Copy 'n_rows' rows specified by 'rows_idxs' (array of size 'n_rows') from 'src' to 'this'
    * 
@@ -72,6 +72,11 @@ public:
 
   virtual void setToZero(){assert(false && "not implemented in base class");}
   virtual void setToConstant(double c){assert(false && "not implemented in base class");}
+  /**
+   * @brief sets the upper triangle (including the diagonal) of a square local matrix to zero; 
+   * the strictly lower triangle is not accessed.
+   */
+  virtual void setUpperTriangleToZero(){assert(false && "not implemented in base class");}
   virtual void copyFrom(const hiopMatrixDense& dm){assert(false && "not implemented in base class");}
   virtual void copyFrom(const double* buffer){assert(false && "not implemented in base class");}
 
@@ -53,14 +53,33 @@
 #include <cmath>
 #include <algorithm>
 #include <cassert>
+#include <vector>
 
 #include "hiop_blasdefs.hpp"
 
 #include "hiopVectorPar.hpp"
+#include "hiopLinAlgFactory.hpp"
 
 namespace hiop
 {
 
+#ifdef HIOP_USE_MPI
+/* Number of rows in the chunks in which a local product is computed when it is followed by a sum 
+ * reduction over the rows of the result. The reduction of a chunk is started (non-blocking) as soon 
+ * as the chunk is computed, so that it overlaps with the local work on the next chunks. At most 
+ * 'max_chunks' chunks are used and each reduces at least 'min_chunk_size' doubles, since smaller 
+ * messages are latency bound and do not benefit from pipelining.
+ */
+static int get_pipelined_chunk_rows(int num_rows, int row_size)
+{
+  const int max_chunks = 4;
+  const int min_chunk_size = 4096;
+  const int rows = (num_rows+max_chunks-1)/max_chunks;
+  const int min_rows = (min_chunk_size+row_size-1)/std::max(row_size, 1);
+  return std::max(1, std::max(rows, min_rows));
+}
+#endif
+
 hiopMatrixDenseRowMajor::hiopMatrixDenseRowMajor(const size_type& m, 
                                                  const size_type& glob_n, 
                                                  index_type* col_part/*=NULL*/, 
@@ -86,7 +105,7 @@ hiopMatrixDenseRowMajor::hiopMatrixDenseRowMajor(const size_type& m,
   assert(max_rows_>=m_local_ && "the requested extra allocation is smaller than the allocation needed by the matrix");
 
   M_=new double*[max_rows_==0?1:max_rows_];
-  M_[0] = max_rows_==0?NULL:new double[max_rows_*n_local_];
+  M_[0] = max_rows_==0?NULL:LinearAlgebraFactory::create_raw_array("DEFAULT", max_rows_*n_local_);
   for(int i=1; i<max_rows_; i++)
     M_[i]=M_[0]+i*n_local_;
 
@@ -100,7 +119,7 @@ hiopMatrixDenseRowMajor::~hiopMatrixDenseRowMajor()
 {
   if(buff_mxnlocal_) delete[] buff_mxnlocal_;
   if(M_) {
-    if(M_[0]) delete[] M_[0];
+    if(M_[0]) LinearAlgebraFactory::delete_raw_array("DEFAULT", M_[0]);
     delete[] M_;
   }
 }
@@ -116,7 +135,7 @@ hiopMatrixDenseRowMajor::hiopMatrixDenseRowMajor(const hiopMatrixDenseRowMajor&
   max_rows_ = dm.max_rows_;
   M_=new double*[max_rows_==0?1:max_rows_];
   //M[0] = m_local_==0?NULL:new double[m_local_*n_local_];
-  M_[0] = max_rows_==0?NULL:new double[max_rows_*n_local_];
+  M_[0] = max_rows_==0?NULL:LinearAlgebraFactory::create_raw_array("DEFAULT", max_rows_*n_local_);
   //for(int i=1; i<m_local_; i++)
   for(int i=1; i<max_rows_; i++)
     M_[i]=M_[0]+i*n_local_;
@@ -348,6 +367,15 @@ void hiopMatrixDenseRowMajor::setToConstant(double c)
   //memcpy has similar performance as dcopy_; both faster than a loop
 }
 
+void hiopMatrixDenseRowMajor::setUpperTriangleToZero()
+{
+  assert(n_local_==n_global_ && "Use only with local, non-distributed matrices");
+  assert(m_local_==n_local_);
+  for(int i=0; i<m_local_; i++) {
+    std::fill(M_[i]+i, M_[i]+n_local_, 0.0);
+  }
+}
+
 bool hiopMatrixDenseRowMajor::isfinite() const
 {
   for(int i=0; i<m_local_; i++)
@@ -421,33 +449,46 @@ timesVec(double beta, double* ya, double alpha, const double* xa) const
   char fortranTrans='T';
   int MM=m_local_, NN=n_local_, incx_y=1;
 
+  if(MM==0) return;
+
 #ifdef HIOP_USE_MPI
   //only add beta*y on one processor (rank 0)
   if(myrank_!=0) beta=0.0; 
 #endif
-  if( MM != 0 && NN != 0 ) {
-    // the arguments seem reversed but so is trans='T' 
-    // required since we keep the matrix row-wise, while the Fortran/BLAS expects them column-wise
-    DGEMV( &fortranTrans, &NN, &MM, &alpha, &M_[0][0], &NN, xa, &incx_y, &beta, ya, &incx_y );
-  } else {
-    if( MM != 0 ) {
+
+  // local product for the rows [row_start, row_start+num_rows) 
+  auto timesVec_rows = [&](int row_start, int num_rows) 
+  {
+    if(NN != 0) {
+      // the arguments seem reversed but so is trans='T' 
+      // required since we keep the matrix row-wise, while the Fortran/BLAS expects them column-wise
+      DGEMV( &fortranTrans, &NN, &num_rows, &alpha, M_[row_start], &NN, xa, &incx_y, &beta, ya+row_start, &incx_y );
+    } else {
       //y.scale( beta );
       if(beta != 1.) {
 	int one=1; 
-	DSCAL(&MM, &beta, ya, &one);
+	DSCAL(&num_rows, &beta, ya+row_start, &one);
       }
-    } else {
-      assert(MM==0);
-      return;
     }
-  }
+  };
+
 #ifdef HIOP_USE_MPI
-  //here m_local_ is > 0
-  double yglob[m_local_]; 
-  int ierr=MPI_Allreduce(ya, yglob, m_local_, MPI_DOUBLE, MPI_SUM, comm_); assert(MPI_SUCCESS==ierr);
-  memcpy(ya, yglob, m_local_*sizeof(double));
+  //the reduction of y is pipelined with the local products on row chunks
+  const int chunk_rows = get_pipelined_chunk_rows(MM, 1);
+  std::vector<MPI_Request> requests;
+  for(int row_start=0; row_start<MM; row_start+=chunk_rows) {
+    int num_rows = std::min(chunk_rows, MM-row_start);
+    timesVec_rows(row_start, num_rows);
+
+    MPI_Request req;
+    int ierr = MPI_Iallreduce(MPI_IN_PLACE, ya+row_start, num_rows, MPI_DOUBLE, MPI_SUM, comm_, &req);
+    assert(MPI_SUCCESS==ierr);
+    requests.push_back(req);
+  }
+  int ierr = MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE); assert(MPI_SUCCESS==ierr);
+#else
+  timesVec_rows(0, MM);
 #endif
-
 }
 
 /* y = beta * y + alpha * transpose(this) * x */
@@ -650,17 +691,99 @@ void hiopMatrixDenseRowMajor::timesMatTrans(double beta, hiopMatrix& W_, double
   if(W.m()==0) return;
   if(W.n()==0) return;
 
-  if(0==myrank_) timesMatTrans_local(beta,W_,alpha,X_);
-  else          timesMatTrans_local(0.,  W_,alpha,X_);
-
 #ifdef HIOP_USE_MPI
-  int n2Red=W.m()*W.n(); 
+  const auto& Xdm = dynamic_cast<const hiopMatrixDenseRowMajor&>(X_);
+  //only add beta*W on one processor (rank 0)
+  if(0!=myrank_) beta=0.;
+
+  //the rows of W are computed in chunks and the reduction of each chunk is started right away, so 
+  //that it overlaps with the local products on the next chunks
+  const int ldw=W.n();
+  const int chunk_rows = get_pipelined_chunk_rows(m_local_, ldw);
   double* WM=W.local_data();
-  double* Wglob= W.new_mxnlocal_buff(); 
-  int ierr = MPI_Allreduce(WM, Wglob, n2Red, MPI_DOUBLE, MPI_SUM, comm_); assert(ierr==MPI_SUCCESS);
-  memcpy(WM, Wglob, n2Red*sizeof(double));
+  std::vector<MPI_Request> requests;
+  for(int row_start=0; row_start<m_local_; row_start+=chunk_rows) {
+    int num_rows = std::min(chunk_rows, m_local_-row_start);
+    double* WM_chunk = WM+row_start*ldw;
+    if(n_local_==0) {
+      if(beta!=1.0) {
+        int one=1; int mn=num_rows*ldw;
+        DSCAL(&mn, &beta, WM_chunk, &one);
+      }
+    } else {
+      //same as in timesMatTrans_local, for the rows [row_start, row_start+num_rows) of 'this' and W
+      char transX='T', transM='N';
+      int ldx=n_local_, ldm=n_local_, ldw_f=ldw;
+      int M=Xdm.m(), N=num_rows, K=n_local_;
+      DGEMM(&transX, &transM, &M,&N,&K, &alpha,Xdm.local_data_const(),&ldx, M_[row_start],&ldm, &beta,WM_chunk,&ldw_f);
+    }
+    MPI_Request req;
+    int ierr = MPI_Iallreduce(MPI_IN_PLACE, WM_chunk, num_rows*ldw, MPI_DOUBLE, MPI_SUM, comm_, &req);
+    assert(ierr==MPI_SUCCESS);
+    requests.push_back(req);
+  }
+  int ierr = MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE); assert(ierr==MPI_SUCCESS);
+#else
+  timesMatTrans_local(beta,W_,alpha,X_);
+#endif
+}
+/* upper triangle of W = alpha*[this;X]*[this;X]^T
+ * -- this is m1xn, X is m2xn, W is (m1+m2)x(m1+m2)
+ *
+ * W is row-major, so its upper triangle is the lower triangle of the column-major W^T seen by BLAS.
+ * The blocks this*this^T and X*X^T are computed with DSYRK and this*X^T with DGEMM, all of them
+ * directly in W.
+ */
+void hiopMatrixDenseRowMajor::stackedGramToSymDenseMatrixUpperTriangle(double alpha,
+                                                                       const hiopMatrix& X_,
+                                                                       hiopMatrixDense& W_) const
+{
+  const auto& X = dynamic_cast<const hiopMatrixDenseRowMajor&>(X_);
+  auto& W = dynamic_cast<hiopMatrixDenseRowMajor&>(W_);
+  assert(W.n_local_==W.n_global_ && "not intended for the case when the result matrix is distributed.");
+  assert(X.n_local_==n_local_);
+  assert(W.m()==m_local_+X.m_local_);
+  assert(W.n()==W.m());
+  if(W.m()==0) return;
+
+  int m1 = m_local_, m2 = X.m_local_, K = n_local_, ldw = W.n();
+  int ld = std::max(1, (int)n_local_);
+  double beta = 0.;
+  double* WM = W.local_data();
+  char uplo='L', transS='T', transX='T', transM='N';
+  if(m1>0) {
+    DSYRK(&uplo, &transS, &m1, &K, &alpha, this->local_data_const(), &ld, &beta, WM, &ldw);
+  }
+  if(m2>0) {
+    DSYRK(&uplo, &transS, &m2, &K, &alpha, X.local_data_const(), &ld, &beta, WM+m1*ldw+m1, &ldw);
+  }
+  if(m1>0 && m2>0) {
+    DGEMM(&transX, &transM, &m2, &m1, &K, &alpha, X.local_data_const(), &ld, this->local_data_const(), &ld,
+          &beta, WM+m1, &ldw);
+  }
+
+#ifdef HIOP_USE_MPI
+  int nranks;
+  int ierr = MPI_Comm_size(comm_, &nranks); assert(ierr==MPI_SUCCESS);
+  if(nranks>1) {
+    //pack the upper triangle so that it is reduced with a single MPI_Allreduce
+    const int n = W.m();
+    double* buff = W.new_mxnlocal_buff();
+    int pos = 0;
+    for(int i=0; i<n; i++) {
+      memcpy(buff+pos, WM+i*ldw+i, (n-i)*sizeof(double));
+      pos += n-i;
+    }
+    ierr = MPI_Allreduce(MPI_IN_PLACE, buff, pos, MPI_DOUBLE, MPI_SUM, comm_); assert(ierr==MPI_SUCCESS);
+    pos = 0;
+    for(int i=0; i<n; i++) {
+      memcpy(WM+i*ldw+i, buff+pos, (n-i)*sizeof(double));
+      pos += n-i;
+    }
+  }
 #endif
 }
+
 void hiopMatrixDenseRowMajor::addDiagonal(const double& alpha, const hiopVector& d_)
 {
   const hiopVectorPar& d = dynamic_cast<const hiopVectorPar&>(d_);
@@ -748,13 +871,22 @@ transAddToSymDenseMatrixUpperTriangle(int row_start, int col_start,
   
   int n_W = W.n();
   double* WM = W.local_data();
-  for(int ir=0; ir<m_local_; ir++) {
-    const int jW = ir+col_start;
-    for(int jc=0; jc<n_local_; jc++) {
-      const int iW = jc+row_start;
-      assert(iW<=jW && "source entries need to map inside the upper triangular part of destination");
-      //WM[iW][jW] += alpha*this->M_[ir][jc];
-      WM[iW*n_W+jW] += alpha*this->M_[ir][jc];
+  //the transpose is done in square tiles so that both the (row-wise) reads from 'this' and the 
+  //(row-wise) writes into W stay in cache
+  const int tile = 64;
+  for(int ir0=0; ir0<m_local_; ir0+=tile) {
+    const int ir1 = std::min(ir0+tile, m_local_);
+    for(int jc0=0; jc0<n_local_; jc0+=tile) {
+      const int jc1 = std::min(jc0+tile, n_local_);
+      for(int jc=jc0; jc<jc1; jc++) {
+        const int iW = jc+row_start;
+        double* WMrow = WM+iW*n_W+col_start;
+        assert(iW<=ir0+col_start && "source entries need to map inside the upper triangular part of destination");
+        for(int ir=ir0; ir<ir1; ir++) {
+          //WM[iW][ir+col_start] += alpha*this->M_[ir][jc];
+          WMrow[ir] += alpha*this->M_[ir][jc];
+        }
+      }
     }
   }
 }
@@ -27,12 +27,15 @@ class hiopMatrixMDS : public hiopMatrix
 {
 public:
   hiopMatrixMDS(int rows, int cols_sparse, int cols_dense, int nnz_sparse, const std::string& mem_space)
+    : mem_space_(mem_space),
+      vec_ones_sp_(nullptr)
   {
     mSp = LinearAlgebraFactory::create_matrix_sparse(mem_space, rows, cols_sparse, nnz_sparse);
     mDe = LinearAlgebraFactory::create_matrix_dense(mem_space, rows, cols_dense);
   }
   virtual ~hiopMatrixMDS()
   {
+    delete vec_ones_sp_;
     delete mDe;
     delete mSp;
   }
@@ -166,6 +169,26 @@ public:
     assert(false && "not needed for general/nonsymmetric matrices.");
   }
 
+  /* upper triangle of W = alpha*[this; X]*[this; X]^T
+   *
+   * The dense blocks overwrite the upper triangle of W and the sparse blocks are then added to it
+   * using the M*D^{-1}*N^T kernels of the sparse matrix with D=1.
+   */
+  virtual void stackedGramToSymDenseMatrixUpperTriangle(double alpha, const hiopMatrix& X, hiopMatrixDense& W) const
+  {
+    const hiopMatrixMDS& X_mds = dynamic_cast<const hiopMatrixMDS&>(X);
+    assert(X_mds.n_sp()==n_sp());
+    mDe->stackedGramToSymDenseMatrixUpperTriangle(alpha, *X_mds.mDe, W);
+
+    if(nullptr==vec_ones_sp_) {
+      vec_ones_sp_ = LinearAlgebraFactory::create_vector(mem_space_, mSp->n());
+      vec_ones_sp_->setToConstant(1.0);
+    }
+    mSp->addMDinvMtransToDiagBlockOfSymDeMatUTri(0, alpha, *vec_ones_sp_, W);
+    mSp->addMDinvNtransToSymDeMatUTri(0, m(), alpha, *vec_ones_sp_, *X_mds.mSp, W);
+    X_mds.mSp->addMDinvMtransToDiagBlockOfSymDeMatUTri(m(), alpha, *vec_ones_sp_, W);
+  }
+
   virtual double max_abs_value()
   {
     return std::max(mSp->max_abs_value(), mDe->max_abs_value());
@@ -204,6 +227,7 @@ public:
   {
     hiopMatrixMDS* m = new hiopMatrixMDS();
     assert(m->mSp==NULL); assert(m->mDe==NULL); 
+    m->mem_space_ = mem_space_;
     m->mSp = mSp->alloc_clone();
     m->mDe = mDe->alloc_clone();
     assert(m->mSp!=NULL); assert(m->mDe!=NULL); 
@@ -213,6 +237,7 @@ public:
   {
     hiopMatrixMDS* m = new hiopMatrixMDS();
     assert(m->mSp==NULL); assert(m->mDe==NULL); 
+    m->mem_space_ = mem_space_;
     m->mSp = mSp->new_copy();
     m->mDe = mDe->new_copy();
     assert(m->mSp!=NULL); assert(m->mDe!=NULL); 
@@ -256,8 +281,11 @@ public:
 private:
   hiopMatrixSparse* mSp;
   hiopMatrixDense* mDe;
+  std::string mem_space_;
+  /// vector of ones used as the diagonal scaling of the sparse kernels, allocated on demand
+  mutable hiopVector* vec_ones_sp_;
 private:
-  hiopMatrixMDS() : mSp(NULL), mDe(NULL) {};
+  hiopMatrixMDS() : mSp(NULL), mDe(NULL), vec_ones_sp_(nullptr) {};
   hiopMatrixMDS(const hiopMatrixMDS&) {};
 };
 
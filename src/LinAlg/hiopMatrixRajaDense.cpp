@@ -568,6 +568,24 @@ void hiopMatrixRajaDense::setToZero()
   rm.memset(data_dev_, 0);
 }
 
+/**
+ * @brief Sets the upper triangle (including the diagonal) of this square matrix to zero.
+ */
+void hiopMatrixRajaDense::setUpperTriangleToZero()
+{
+  assert(n_local_==n_global_ && "Use only with local, non-distributed matrices");
+  assert(m_local_==n_local_);
+  int n_local = n_local_;
+  double* data = data_dev_;
+  RAJA::View<double, RAJA::Layout<2>> Mview(data, get_local_size_m(), get_local_size_n());
+  RAJA::forall<hiop_raja_exec>(RAJA::RangeSegment(0, m_local_),
+    RAJA_LAMBDA(RAJA::Index_type i)
+    {
+      for (int j = i; j < n_local; j++)
+        Mview(i, j) = 0.0;
+    });
+}
+
 /**
  * @brief Sets all the elements of this matrix to a constant.
  * @todo consider GPU BLAS for this (DCOPY)
@@ -1040,6 +1058,73 @@ void hiopMatrixRajaDense::timesMatTrans(
 #endif
 }
 
+/**
+ * @brief Upper triangle of W = alpha*[this; X]*[this; X]^T, computed directly in W
+ *
+ * Each (upper triangular) entry of W is the dot product of two rows of the stacked matrix
+ * [this; X]. In the distributed case, the upper triangle of W is packed on the host and
+ * reduced with a single MPI_Allreduce.
+ */
+void hiopMatrixRajaDense::stackedGramToSymDenseMatrixUpperTriangle(double alpha,
+                                                                   const hiopMatrix& Xmat,
+                                                                   hiopMatrixDense& Wmat) const
+{
+  const auto& X = dynamic_cast<const hiopMatrixRajaDense&>(Xmat);
+  auto& W = dynamic_cast<hiopMatrixRajaDense&>(Wmat);
+  assert(W.n_local_==W.n_global_ && "not intended for the case when the result matrix is distributed.");
+  assert(X.n_local_==n_local_);
+  assert(W.m()==m_local_+X.m_local_);
+  assert(W.n()==W.m());
+  if(W.m()==0)
+    return;
+
+  RAJA::View<double, RAJA::Layout<2>> Mview(data_dev_,   m_local_,   n_local_);
+  RAJA::View<double, RAJA::Layout<2>> Xview(X.data_dev_, X.m_local_, X.n_local_);
+  RAJA::View<double, RAJA::Layout<2>> Wview(W.data_dev_, W.m_local_, W.n_local_);
+  RAJA::RangeSegment row_range(0, W.m_local_);
+  RAJA::RangeSegment col_range(0, W.n_local_);
+
+  const auto m1 = m_local_;
+  const auto Mn = n_local_;
+  RAJA::kernel<matrix_exec>(RAJA::make_tuple(col_range, row_range),
+    RAJA_LAMBDA(int col, int row)
+    {
+      if(col < row)
+        return;
+      double dot = 0;
+      for (int k = 0; k < Mn; k++) {
+        const double a = row < m1 ? Mview(row, k) : Xview(row - m1, k);
+        const double b = col < m1 ? Mview(col, k) : Xview(col - m1, k);
+        dot += a * b;
+      }
+      Wview(row, col) = alpha * dot;
+    });
+
+#ifdef HIOP_USE_MPI
+  int nranks;
+  int ierr = MPI_Comm_size(comm_, &nranks); assert(ierr==MPI_SUCCESS);
+  if(nranks > 1) {
+    const int n = W.m();
+    const int ldw = W.n();
+    W.copyFromDev();
+    double* Wdata_host = W.data_host_;
+    double* buff = W.new_mxnlocal_host_buff();
+    int pos = 0;
+    for(int i = 0; i < n; i++) {
+      memcpy(buff + pos, Wdata_host + i*ldw + i, (n-i) * sizeof(double));
+      pos += n - i;
+    }
+    ierr = MPI_Allreduce(MPI_IN_PLACE, buff, pos, MPI_DOUBLE, MPI_SUM, comm_); assert(ierr==MPI_SUCCESS);
+    pos = 0;
+    for(int i = 0; i < n; i++) {
+      memcpy(Wdata_host + i*ldw + i, buff + pos, (n-i) * sizeof(double));
+      pos += n - i;
+    }
+    W.copyToDev();
+  }
+#endif
+}
+
 /**
  * @brief Adds the values of a vector to the diagonal of this matrix.
  * 
@@ -93,6 +93,7 @@ public:
 
   virtual void setToZero();
   virtual void setToConstant(double c);
+  virtual void setUpperTriangleToZero();
   virtual void copyFrom(const hiopMatrixDense& dm);
   virtual void copyFrom(const double* buffer);
   virtual void copy_to(double* buffer);
@@ -193,6 +194,18 @@ public:
   virtual void addUpperTriangleToSymDenseMatrixUpperTriangle(int diag_start, 
 							     double alpha, hiopMatrixDense& W) const;
 
+  /**
+   * @brief upper triangle of W = alpha*[this; X]*[this; X]^T, computed directly in W.
+   *
+   * 'this' and 'X' can be distributed, in which case the upper triangle of W is reduced with a single
+   * MPI_Allreduce.
+   *
+   * @pre W.m() == W.n() == this->m()+X.m()
+   */
+  virtual void stackedGramToSymDenseMatrixUpperTriangle(double alpha,
+                                                        const hiopMatrix& X,
+                                                        hiopMatrixDense& W) const;
+
   virtual double max_abs_value();
 
   virtual void row_max_abs_value(hiopVector &ret_vec);
@@ -54,6 +54,7 @@
 
 #include "hiopMatrixSparseCSRSeq.hpp"
 #include "hiopVectorPar.hpp"
+#include "hiopLinAlgFactory.hpp"
 
 #include "hiop_blasdefs.hpp"
 
@@ -112,9 +113,9 @@ void hiopMatrixSparseCSRSeq::alloc()
   assert(jcolind_ == nullptr);
   assert(values_ == nullptr);
 
-  irowptr_ = new index_type[nrows_+1];
-  jcolind_ = new index_type[nnz_];
-  values_ = new double[nnz_];
+  irowptr_ = LinearAlgebraFactory::create_raw_array_int("DEFAULT", nrows_+1);
+  jcolind_ = LinearAlgebraFactory::create_raw_array_int("DEFAULT", nnz_);
+  values_ = LinearAlgebraFactory::create_raw_array("DEFAULT", nnz_);
 
   assert(buf_col_ == nullptr);
   //buf_col_ remains null since it is allocated on demand
@@ -127,9 +128,9 @@ void hiopMatrixSparseCSRSeq::dealloc()
 {
   delete[] row_starts_;
   delete[] buf_col_;
-  delete[] irowptr_;
-  delete[] jcolind_;
-  delete[] values_;
+  LinearAlgebraFactory::delete_raw_array_int("DEFAULT", irowptr_);
+  LinearAlgebraFactory::delete_raw_array_int("DEFAULT", jcolind_);
+  LinearAlgebraFactory::delete_raw_array("DEFAULT", values_);
   row_starts_ = nullptr;
   buf_col_ = nullptr;
   irowptr_ = nullptr;
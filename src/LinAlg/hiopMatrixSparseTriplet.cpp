@@ -1,5 +1,6 @@
 #include "hiopMatrixSparseTriplet.hpp"
 #include "hiopVectorPar.hpp"
+#include "hiopLinAlgFactory.hpp"
 
 #include "hiop_blasdefs.hpp"
 
@@ -20,23 +21,25 @@ namespace hiop
 hiopMatrixSparseTriplet::hiopMatrixSparseTriplet(int rows, int cols, int nnz)
   : hiopMatrixSparse(rows, cols, nnz)
   , row_starts_(NULL)
+  , col_starts_(NULL)
 {
   if(rows==0 || cols==0) {
     assert(nnz_==0 && "number of nonzeros must be zero when any of the dimensions are 0");
     nnz_ = 0;
   }
 
-  iRow_ = new  int[nnz_];
-  jCol_ = new int[nnz_];
-  values_ = new double[nnz_];
+  iRow_ = LinearAlgebraFactory::create_raw_array_int("DEFAULT", nnz_);
+  jCol_ = LinearAlgebraFactory::create_raw_array_int("DEFAULT", nnz_);
+  values_ = LinearAlgebraFactory::create_raw_array("DEFAULT", nnz_);
 }
 
 hiopMatrixSparseTriplet::~hiopMatrixSparseTriplet()
 {
-  delete [] iRow_;
-  delete [] jCol_;
-  delete [] values_;
+  LinearAlgebraFactory::delete_raw_array_int("DEFAULT", iRow_);
+  LinearAlgebraFactory::delete_raw_array_int("DEFAULT", jCol_);
+  LinearAlgebraFactory::delete_raw_array("DEFAULT", values_);
   delete row_starts_;
+  delete col_starts_;
 }
 
 void hiopMatrixSparseTriplet::setToZero()
@@ -386,6 +389,14 @@ bool hiopMatrixSparseTriplet::checkIndexesAreOrdered() const
 }
 #endif
 
+/*
+ * diag block of W += alpha * M * D^{-1} * transpose(M), where M=this
+ *
+ * Row i of the product is accumulated as the sum over the nonzeros (i,c) of M of M(i,c)/D(c) times 
+ * the column c of M^T (only rows j>=i of it, i.e., the upper triangle), using the precomputed 
+ * column-wise pattern of M. Each row of W is updated by a single thread and the updates of a row
+ * touch only that row of W.
+ */
 void hiopMatrixSparseTriplet::
 addMDinvMtransToDiagBlockOfSymDeMatUTri(int rowAndCol_dest_start,
                                         const double& alpha,
@@ -402,46 +413,37 @@ addMDinvMtransToDiagBlockOfSymDeMatUTri(int rowAndCol_dest_start,
 
   if(row_starts_==NULL) row_starts_ = allocAndBuildRowStarts();
   assert(row_starts_);
-
-  double acc;
-
-  for(int i=0; i<this->nrows_; i++) {
-    //j==i
-    acc = 0.;
-    for(index_type k=row_starts_->idx_start_[i]; k<row_starts_->idx_start_[i+1]; k++)
-      acc += this->values_[k] / DM[this->jCol_[k]] * this->values_[k];
-    //WM[i+row_dest_start][i+col_dest_start] += alpha*acc;
-    WM[(i+row_dest_start)*m_W+i+col_dest_start] += alpha*acc;
-
-    //j>i
-    for(int j=i+1; j<this->nrows_; j++) {
-      //dest[i,j] = weigthed_dotprod(this_row_i,this_row_j)
-      acc = 0.;
-
-      index_type ki=row_starts_->idx_start_[i], kj=row_starts_->idx_start_[j];
-      while(ki<row_starts_->idx_start_[i+1] && kj<row_starts_->idx_start_[j+1]) {
-        assert(ki<this->nnz_);
-        assert(kj<this->nnz_);
-        if(this->jCol_[ki] == this->jCol_[kj]) {
-          acc += this->values_[ki] / DM[this->jCol_[ki]] * this->values_[kj];
-          ki++;
-          kj++;
-        } else {
-          if(this->jCol_[ki]<this->jCol_[kj]) ki++;
-          else                              kj++;
-        }
-      } //end of loop over ki and kj
-      
-      //WM[i+row_dest_start][j+col_dest_start] += alpha*acc;
-      WM[(i+row_dest_start)*m_W + j+col_dest_start] += alpha*acc;
-    } //end j
+  if(col_starts_==NULL) col_starts_ = allocAndBuildColStarts();
+  assert(col_starts_);
+
+  const index_type* row_start = row_starts_->idx_start_;
+  const index_type* col_start = col_starts_->idx_start_;
+  const index_type* col_row_idx = col_starts_->row_idx_;
+  const index_type* col_nz_idx = col_starts_->nz_idx_;
+
+#pragma omp parallel for schedule(dynamic, 16) if(n>=128)
+  for(int i=0; i<n; i++) {
+    //WM[i+row_dest_start][col_dest_start+j] for j>=i
+    double* WMrow = WM + (i+row_dest_start)*m_W + col_dest_start;
+    for(index_type ki=row_start[i]; ki<row_start[i+1]; ki++) {
+      const index_type c = this->jCol_[ki];
+      const double aval = alpha * this->values_[ki] / DM[c];
+
+      //rows of column c are sorted; skip the ones in the strictly lower triangle
+      const index_type* it = std::lower_bound(col_row_idx+col_start[c], col_row_idx+col_start[c+1], i);
+      for(index_type kj=it-col_row_idx; kj<col_start[c+1]; kj++) {
+        WMrow[col_row_idx[kj]] += aval * this->values_[col_nz_idx[kj]];
+      }
+    }
   } // end i
-
 }
 
 /*
  * block of W += alpha * M1 * D^{-1} * transpose(M2), where M1=this
  *  Sizes: M1 is (m1 x nx);  D is vector of len nx, M2 is  (m2, nx)
+ *
+ * Same row-wise scheme as addMDinvMtransToDiagBlockOfSymDeMatUTri, with the precomputed column-wise
+ * pattern of M2.
  */
 void hiopMatrixSparseTriplet::
 addMDinvNtransToSymDeMatUTri(int row_dest_start, int col_dest_start,
@@ -470,57 +472,33 @@ addMDinvNtransToSymDeMatUTri(int row_dest_start, int col_dest_start,
   if(M1.row_starts_==NULL) M1.row_starts_ = M1.allocAndBuildRowStarts();
   assert(M1.row_starts_);
 
-  if(M2.row_starts_==NULL) M2.row_starts_ = M2.allocAndBuildRowStarts();
-  assert(M2.row_starts_);
+  if(M2.col_starts_==NULL) M2.col_starts_ = M2.allocAndBuildColStarts();
+  assert(M2.col_starts_);
 
-  double acc;
+  const index_type* row_start = M1.row_starts_->idx_start_;
+  const index_type* col_start = M2.col_starts_->idx_start_;
+  const index_type* col_row_idx = M2.col_starts_->row_idx_;
+  const index_type* col_nz_idx = M2.col_starts_->nz_idx_;
 
-  // only parallelize these two outter loops
-  //
-  // sort amount of work per thread/exe unit
-  // assign in order of most-> least work to better
-  // distribute workload
-  //
-  // These are multiplied many times, but sparsity pattern
-  // remains the same. We can do some preprocessing to save on
-  // thread execution time
-  //
-  // compressed row/col patterns?
+#pragma omp parallel for schedule(dynamic, 16) if(m1>=128)
   for(int i=0; i<m1; i++) {
-    // j>=i
-    for(int j=0; j<m2; j++) {
-
-      // dest[i,j] = weigthed_dotprod(M1_row_i,M2_row_j)
-      acc = 0.;
-      index_type ki=M1.row_starts_->idx_start_[i];
-      index_type kj=M2.row_starts_->idx_start_[j];
-
-      while(ki<M1.row_starts_->idx_start_[i+1] && kj<M2.row_starts_->idx_start_[j+1]) {
-        assert(ki<M1.nnz_);
-        assert(kj<M2.nnz_);
-
-        if(M1.jCol_[ki] == M2.jCol_[kj]) {
-
-          acc += M1.values_[ki] / DM[this->jCol_[ki]] * M2.values_[kj];
-          ki++;
-          kj++;
-        } else {
-          if(M1.jCol_[ki]<M2.jCol_[kj]) ki++;
-          else                      kj++;
-        }
-      } //end of loop over ki and kj
+    double* WMrow = WM + (i+row_dest_start)*m_W + col_dest_start;
+    for(index_type ki=row_start[i]; ki<row_start[i+1]; ki++) {
+      const index_type c = M1.jCol_[ki];
+      const double aval = alpha * M1.values_[ki] / DM[c];
 
+      for(index_type kj=col_start[c]; kj<col_start[c+1]; kj++) {
+        const index_type j = col_row_idx[kj];
 #ifdef HIOP_DEEPCHECKS
-      if(i+row_dest_start > j+col_dest_start)
-        printf("[warning] lower triangular element updated in addMDinvNtransToSymDeMatUTri\n");
+        if(i+row_dest_start > j+col_dest_start)
+          printf("[warning] lower triangular element updated in addMDinvNtransToSymDeMatUTri\n");
 #endif
-      assert(i+row_dest_start <= j+col_dest_start);
-      //WM[i+row_dest_start][j+col_dest_start] += alpha*acc;
-      WM[(i+row_dest_start)*m_W + j+col_dest_start] += alpha*acc;
-
-    } //end j
+        assert(i+row_dest_start <= j+col_dest_start);
+        //WM[i+row_dest_start][j+col_dest_start] += alpha*M1(i,c)/D(c)*M2(j,c);
+        WMrow[j] += aval * M2.values_[col_nz_idx[kj]];
+      }
+    }
   } // end i
-
 }
 
 
@@ -558,6 +536,40 @@ hiopMatrixSparseTriplet::allocAndBuildRowStarts() const
   return rsi;
 }
 
+// assumes triplets are ordered (by rows), hence the row indexes within each column are sorted
+hiopMatrixSparseTriplet::ColStartsInfo*
+hiopMatrixSparseTriplet::allocAndBuildColStarts() const
+{
+  assert(ncols_>=0);
+
+  ColStartsInfo* csi = new ColStartsInfo(ncols_, nnz_); assert(csi);
+
+  //count the nonzeros in each column
+  for(index_type j=0; j<=ncols_; j++) {
+    csi->idx_start_[j] = 0;
+  }
+  for(index_type k=0; k<nnz_; k++) {
+    assert(jCol_[k]>=0 && jCol_[k]<ncols_);
+    csi->idx_start_[jCol_[k]+1]++;
+  }
+  for(index_type j=0; j<ncols_; j++) {
+    csi->idx_start_[j+1] += csi->idx_start_[j];
+  }
+  assert(csi->idx_start_[ncols_] == nnz_);
+
+  //place the nonzeros; 'next' is the next free position in each column
+  std::vector<index_type> next(csi->idx_start_, csi->idx_start_+ncols_);
+  for(index_type k=0; k<nnz_; k++) {
+    const index_type pos = next[jCol_[k]]++;
+#ifdef HIOP_DEEPCHECKS
+    assert((k==0 || iRow_[k-1]<=iRow_[k]) && "row indexes are not sorted");
+#endif
+    csi->row_idx_[pos] = iRow_[k];
+    csi->nz_idx_[pos] = k;
+  }
+  return csi;
+}
+
 void hiopMatrixSparseTriplet::copyRowsFrom(const hiopMatrix& src_gen,
                                            const index_type* rows_idxs,
                                            size_type n_rows)
@@ -305,8 +305,34 @@ protected:
     }
   };
   mutable RowStartsInfo* row_starts_;
+
+  /* Column-wise (transposed) view of the sparsity pattern: for each column, the (sorted) row indexes 
+   * of its nonzeros and the positions of these nonzeros in the triplet arrays. Built once and used as
+   * the precomputed pattern of the products M*D^{-1}*N^T.
+   */
+  struct ColStartsInfo
+  {
+    index_type *idx_start_; //size num_cols+1
+    index_type *row_idx_;   //size nnz
+    index_type *nz_idx_;    //size nnz
+    size_type num_cols_;
+    ColStartsInfo(size_type n_cols, size_type nnz)
+      : idx_start_(new index_type[n_cols+1]),
+        row_idx_(new index_type[nnz]),
+        nz_idx_(new index_type[nnz]),
+        num_cols_(n_cols)
+    {}
+    virtual ~ColStartsInfo()
+    {
+      delete[] idx_start_;
+      delete[] row_idx_;
+      delete[] nz_idx_;
+    }
+  };
+  mutable ColStartsInfo* col_starts_;
 protected:
   RowStartsInfo* allocAndBuildRowStarts() const;
+  ColStartsInfo* allocAndBuildColStarts() const;
 private:
   hiopMatrixSparseTriplet()
     : hiopMatrixSparse(0, 0, 0), iRow_(NULL), jCol_(NULL), values_(NULL)
@@ -54,6 +54,7 @@
  */
 
 #include "hiopVectorIntSeq.hpp"
+#include "hiopLinAlgFactory.hpp"
 #include <cstring> //for memcpy
 
 namespace hiop
@@ -61,12 +62,12 @@ namespace hiop
 
 hiopVectorIntSeq::hiopVectorIntSeq(size_type sz) : hiopVectorInt(sz)
 {
-  buf_ = new index_type[sz_];
+  buf_ = LinearAlgebraFactory::create_raw_array_int("DEFAULT", sz_);
 }
 
 hiopVectorIntSeq::~hiopVectorIntSeq()
 {
-  delete[] buf_;
+  LinearAlgebraFactory::delete_raw_array_int("DEFAULT", buf_);
 }
 
 void hiopVectorIntSeq::copy_from(const index_type* v_local)
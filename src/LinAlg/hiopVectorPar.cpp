@@ -47,6 +47,7 @@
 
 #include "hiopVectorPar.hpp"
 #include "hiopVectorIntSeq.hpp"
+#include "hiopLinAlgFactory.hpp"
 
 #include <cmath>
 #include <cstring> //for memcpy
@@ -84,7 +85,7 @@ hiopVectorPar::hiopVectorPar(const size_type& glob_n, index_type* col_part/*=NUL
   }   
   n_local_=glob_iu_-glob_il_;
 
-  data_ = new double[n_local_];
+  data_ = LinearAlgebraFactory::create_raw_array("DEFAULT", n_local_);
 }
 
 /// internal use only: allocates data_
@@ -95,12 +96,12 @@ hiopVectorPar::hiopVectorPar(const hiopVectorPar& v)
   glob_il_ = v.glob_il_;
   glob_iu_ = v.glob_iu_;
   comm_ = v.comm_;
-  data_ = new double[n_local_];  
+  data_ = LinearAlgebraFactory::create_raw_array("DEFAULT", n_local_);
 }
   
 hiopVectorPar::~hiopVectorPar()
 {
-  delete[] data_;
+  LinearAlgebraFactory::delete_raw_array("DEFAULT", data_);
   data_ = nullptr;
 }
 
@@ -256,8 +257,9 @@ void hiopVectorPar::copyToStartingAt_w_pattern(hiopVector& v_,
 /* copy 'c' and `d` into `this`, according to the map 'c_map` and `d_map`, respectively.
 *  e.g., this[c_map[i]] = c[i];
 *
-*  @pre the size of `this` = the size of `c` + the size of `d`.
-*  @pre `c_map` \Union `d_map` = {0, ..., size_of_this_vec-1}
+*  @pre the size of `this` >= the size of `c` + the size of `d`.
+*  @pre `c_map` \Union `d_map` is a subset of {0, ..., size_of_this_vec-1}; the other entries of `this`
+*  are not accessed
 */
 void hiopVectorPar::copy_from_two_vec_w_pattern(const hiopVector& c, 
                                                 const hiopVectorInt& c_map, 
@@ -271,7 +273,7 @@ void hiopVectorPar::copy_from_two_vec_w_pattern(const hiopVector& c,
   assert( c_size == c_map.size() );
   const int d_size = d.get_size();
   assert( d_size == d_map.size() );
-  assert( c_size + d_size == n_local_);
+  assert( c_size + d_size <= n_local_);
 
   //concatanate multipliers -> copy into whole lambda array 
   for(int i=0; i<c_size; ++i) {
@@ -284,8 +286,9 @@ void hiopVectorPar::copy_from_two_vec_w_pattern(const hiopVector& c,
 
 /* split `this` to `c` and `d`, according to the map 'c_map` and `d_map`, respectively.
 *
-*  @pre the size of `this` = the size of `c` + the size of `d`.
-*  @pre `c_map` \Union `d_map` = {0, ..., size_of_this_vec-1}
+*  @pre the size of `this` >= the size of `c` + the size of `d`.
+*  @pre `c_map` \Union `d_map` is a subset of {0, ..., size_of_this_vec-1}; the other entries of `this`
+*  are not accessed
 */
 void hiopVectorPar::copy_to_two_vec_w_pattern(hiopVector& c, 
                                               const hiopVectorInt& c_map, 
@@ -299,7 +302,7 @@ void hiopVectorPar::copy_to_two_vec_w_pattern(hiopVector& c,
   assert( c_size == c_map.size() );
   const int d_size = d.get_size();
   assert( d_size == d_map.size() );
-  assert( c_size + d_size == n_local_);
+  assert( c_size + d_size <= n_local_);
 
   //concatanate multipliers -> copy into whole lambda array 
   for(int i=0; i<c_size; ++i) {
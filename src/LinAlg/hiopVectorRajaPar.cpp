@@ -550,8 +550,9 @@ void hiopVectorRajaPar::copyToStartingAt_w_pattern(hiopVector& vec, int start_in
 /* copy 'c' and `d` into `this`, according to the map 'c_map` and `d_map`, respectively.
 *  e.g., this[c_map[i]] = c[i];
 *
-*  @pre the size of `this` = the size of `c` + the size of `d`.
-*  @pre `c_map` \Union `d_map` = {0, ..., size_of_this_vec-1}
+*  @pre the size of `this` >= the size of `c` + the size of `d`.
+*  @pre `c_map` \Union `d_map` is a subset of {0, ..., size_of_this_vec-1}; the other entries of `this`
+*  are not accessed
 */
 void hiopVectorRajaPar::copy_from_two_vec_w_pattern(const hiopVector& c,
                                                     const hiopVectorInt& c_map,
@@ -567,8 +568,8 @@ void hiopVectorRajaPar::copy_from_two_vec_w_pattern(const hiopVector& c,
   size_type n2_local = v2.n_local_;
 
 #ifdef HIOP_DEEPCHECKS
-  assert(n1_local + n2_local == n_local_);
-  assert(n_local_ == ix1.size() + ix2.size());
+  assert(n1_local + n2_local <= n_local_);
+  assert(ix1.size() + ix2.size() <= n_local_);
 #endif
   double*   dd = data_dev_;
   double*  vd1 = v1.data_dev_;
@@ -601,8 +602,9 @@ void hiopVectorRajaPar::copy_from_two_vec_w_pattern(const hiopVector& c,
 
 /* split `this` to `c` and `d`, according to the map 'c_map` and `d_map`, respectively.
 *
-*  @pre the size of `this` = the size of `c` + the size of `d`.
-*  @pre `c_map` \Union `d_map` = {0, ..., size_of_this_vec-1}
+*  @pre the size of `this` >= the size of `c` + the size of `d`.
+*  @pre `c_map` \Union `d_map` is a subset of {0, ..., size_of_this_vec-1}; the other entries of `this`
+*  are not accessed
 */
 void hiopVectorRajaPar::copy_to_two_vec_w_pattern(hiopVector& c,
                                                   const hiopVectorInt& c_map,
@@ -618,8 +620,8 @@ void hiopVectorRajaPar::copy_to_two_vec_w_pattern(hiopVector& c,
   size_type n2_local = v2.n_local_;
 
 #ifdef HIOP_DEEPCHECKS
-  assert(n1_local + n2_local == n_local_);
-  assert(n_local_ == ix1.size() + ix2.size());
+  assert(n1_local + n2_local <= n_local_);
+  assert(ix1.size() + ix2.size() <= n_local_);
 #endif
   double*   dd = data_dev_;
   double*  vd1 = v1.data_dev_;
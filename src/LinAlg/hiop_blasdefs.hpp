@@ -13,11 +13,14 @@
 #define DGEMV   FC_GLOBAL(dgemv, DGEMV)
 #define ZGEMV   FC_GLOBAL(zgemv, ZGEMV)
 #define DGEMM   FC_GLOBAL(dgemm, DGEMM)
+#define DSYRK   FC_GLOBAL(dsyrk, DSYRK)
 #define DTRSM   FC_GLOBAL(dtrsm, DTRSM)
 #define DPOTRF  FC_GLOBAL(dpotrf, DPOTRF)
 #define DPOTRS  FC_GLOBAL(dpotrs, DPOTRS)
 #define DSYTRF  FC_GLOBAL(dsytrf, DSYTRF)
 #define DSYTRS  FC_GLOBAL(dsytrs, DSYTRS)
+#define DLASYF  FC_GLOBAL(dlasyf, DLASYF)
+#define DSYTF2  FC_GLOBAL(dsytf2, DSYTF2)
 #define DLANGE  FC_GLOBAL(dlange, DLANGE)
 #define ZLANGE  FC_GLOBAL(zlange, ZLANGE)
 #define DPOSVX  FC_GLOBAL(dposvx, DPOSVC)
@@ -56,6 +59,13 @@ extern "C" void   DGEMM(char* transA, char* transB, int* m, int* n, int* k,
 			 double* b, int* ldb,
 			 double* beta, double* C, int*ldc);
 
+/* C := alpha*A*A**T + beta*C,   or   C := alpha*A**T*A + beta*C,
+ * where C is an n by n symmetric matrix (only the triangle specified by UPLO is referenced and 
+ * updated) and A is an n by k matrix in the first case and a k by n matrix in the second case.
+ */
+extern "C" void   DSYRK(char* uplo, char* trans, int* n, int* k,
+			 double* alpha, double* a, int* lda,
+			 double* beta, double* C, int* ldc);
 
 /* op( A )*X = alpha*B,   or   X*op( A ) = alpha*B,
  * where alpha is a scalar, X and B are m by n matrices, A is a unit, or
@@ -100,6 +110,14 @@ extern "C" void   DPOTRS(char* uplo, int* N, int* NRHS,
  */
 extern "C" void DSYTRF( char* UPLO, int* N, double* A, int* LDA, int* IPIV, double* WORK, int* LWORK, int* INFO );
 
+/* DLASYF computes a partial factorization of a real symmetric matrix A using the Bunch-Kaufman 
+ * diagonal pivoting method; it factorizes KB (at most NB) columns and is the panel kernel of DSYTRF. 
+ * DSYTF2 is the unblocked (Level 2 BLAS) version of DSYTRF.
+ */
+extern "C" void DLASYF( char* UPLO, int* N, int* NB, int* KB, double* A, int* LDA, int* IPIV, 
+                        double* W, int* LDW, int* INFO );
+extern "C" void DSYTF2( char* UPLO, int* N, double* A, int* LDA, int* IPIV, int* INFO );
+
 /* DSYTRS solves a system of linear equations A*X = B with a real
  *  symmetric matrix A using the factorization A = U*D*U**T or
  *  A = L*D*L**T computed by DSYTRF.
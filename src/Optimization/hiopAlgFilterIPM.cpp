@@ -63,6 +63,8 @@
 #include "hiopFRProb.hpp"
 
 #include "hiopCppStdUtils.hpp"
+#include "hiopMemoryTracker.hpp"
+#include "hiopHostMemPool.hpp"
 
 #include <cmath>
 #include <cstring>
@@ -78,15 +80,53 @@ hiopAlgFilterIPMBase::hiopAlgFilterIPMBase(hiopNlpFormulation* nlp_in, const boo
    d_soc(nullptr),
    soc_dir(nullptr),
    within_FR_{within_FR},
-   onenorm_pr_curr_{0.0}
+   onenorm_pr_curr_{0.0},
+   warm_start_state_{nullptr},
+   warm_start_mu_{-1.},
+   fr_context_{nullptr},
+   checkpoint_load_done_{false},
+   mem_tracking_{false},
+   mem_pool_{nullptr}
 {
   nlp = nlp_in;
+  update_memory_settings();
+  MemoryScope mem_scope(*this);
   //force completion of the nlp's initialization
-  nlp->finalizeInitialization();
+  hiopMemoryTrackerScope mem_subsystem_scope(hiopMemoryTracker::Nlp);
+  if(!nlp->finalizeInitialization()) {
+    //run() initializes the nlp again and returns SolveInitializationError if it still fails
+    nlp->log->printf(hovError, "The initialization of the NLP failed.\n");
+  }
+}
+
+void hiopAlgFilterIPMBase::update_memory_settings()
+{
+  if(within_FR_) {
+    return;
+  }
+  const double budget = nlp->options->GetNumeric("memory_budget");
+  mem_tracking_ = budget > 0. || nlp->options->GetString("memory_tracking") == "yes";
+  mem_tracker_.set_budget(budget);
+
+  if(nlp->options->GetString("mem_space_pool") == "yes") {
+    const double max_cached = nlp->options->GetNumeric("mem_space_pool_max_cached");
+    if(nullptr == mem_pool_) {
+      mem_pool_ = new hiopHostMemPool(max_cached);
+    } else {
+      mem_pool_->set_max_cached(max_cached);
+    }
+  } else if(mem_pool_) {
+    mem_pool_->release();
+    mem_pool_ = nullptr;
+  }
 }
 
 void hiopAlgFilterIPMBase::dealloc_alg_objects()
 {
+  //the FR problem refers to the iterate and to the derivatives of this solver
+  delete fr_context_;
+  fr_context_ = nullptr;
+
   delete it_curr;
   delete it_trial;
   delete dir;
@@ -120,10 +160,15 @@ void hiopAlgFilterIPMBase::dealloc_alg_objects()
 hiopAlgFilterIPMBase::~hiopAlgFilterIPMBase()
 {
   dealloc_alg_objects();
+  //the blocks still in use, e.g., by the NLP, are returned to the system when released
+  if(mem_pool_) {
+    mem_pool_->release();
+  }
 }
 
 void hiopAlgFilterIPMBase::alloc_alg_objects()
 {
+  hiopMemoryTrackerScope mem_scope(hiopMemoryTracker::Iterates);
   it_curr = new hiopIterate(nlp);
   it_trial = it_curr->alloc_clone();
   dir = it_curr->alloc_clone();
@@ -142,8 +187,11 @@ void hiopAlgFilterIPMBase::alloc_alg_objects()
   _d = nlp->alloc_dual_ineq_vec();
 
   _grad_f = nlp->alloc_primal_vec();
-  _Jac_c = nlp->alloc_Jac_c();
-  _Jac_d = nlp->alloc_Jac_d();
+  {
+    hiopMemoryTrackerScope mem_scope_deriv(hiopMemoryTracker::Derivatives);
+    _Jac_c = nlp->alloc_Jac_c();
+    _Jac_d = nlp->alloc_Jac_d();
+  }
 
   _f_nlp_trial = 0.;
   _f_log_trial = 0.;
@@ -151,10 +199,13 @@ void hiopAlgFilterIPMBase::alloc_alg_objects()
   _d_trial = nlp->alloc_dual_ineq_vec();
 
   _grad_f_trial = nlp->alloc_primal_vec();
-  _Jac_c_trial = nlp->alloc_Jac_c();
-  _Jac_d_trial = nlp->alloc_Jac_d();
+  {
+    hiopMemoryTrackerScope mem_scope_deriv(hiopMemoryTracker::Derivatives);
+    _Jac_c_trial = nlp->alloc_Jac_c();
+    _Jac_d_trial = nlp->alloc_Jac_d();
 
-  _Hess_Lagr = nlp->alloc_Hess_Lagr();
+    _Hess_Lagr = nlp->alloc_Hess_Lagr();
+  }
 
   resid = new hiopResidual(nlp);
   resid_trial = new hiopResidual(nlp);
@@ -263,6 +314,18 @@ void hiopAlgFilterIPMBase::resetSolverStatus()
   n_accep_iters_ = 0;
   solver_status_ = NlpSolve_IncompleteInit;
   filter.clear();
+
+  //the FR problem is created again in each run since the options of the NLP may have changed
+  delete fr_context_;
+  fr_context_ = nullptr;
+
+  //the memory high-water marks and pool statistics cover the whole solve, including the feasibility restoration
+  if(!within_FR_) {
+    mem_tracker_.reset_peaks();
+    if(mem_pool_) {
+      mem_pool_->reset_stats();
+    }
+  }
 }
 
 int hiopAlgFilterIPMBase::startingProcedure(hiopIterate& it_ini,
@@ -277,6 +340,18 @@ int hiopAlgFilterIPMBase::startingProcedure(hiopIterate& it_ini,
   bool slacks_avail = false;
   bool warmstart_avail = false;
   bool ret_bool = false;
+
+  warm_start_mu_ = -1.;
+  if(nullptr != warm_start_state_) {
+    const hiopIterate& it_ws = warm_start_state_->get_it();
+    if(it_ws.get_x()->get_size() == it_ini.get_x()->get_size() &&
+       it_ws.get_yc()->get_size() == it_ini.get_yc()->get_size() &&
+       it_ws.get_yd()->get_size() == it_ini.get_yd()->get_size()) {
+      return startingProcedureFromState(it_ini, f, c, d, gradf, Jac_c, Jac_d);
+    }
+    nlp->log->printf(hovWarning,
+                     "the sizes of the warm start state do not match the NLP; the state will be ignored\n");
+  }
   
   if(nlp->options->GetString("warm_start")=="yes") {
     ret_bool = nlp->get_starting_point(*it_ini.get_x(),
@@ -377,6 +452,7 @@ int hiopAlgFilterIPMBase::startingProcedure(hiopIterate& it_ini,
         updater = nlp->alloc_duals_lsq_updater();
         deleteUpdater = true;
       }
+      prepare_duals_lsq_init(updater, it_ini);
 
       //this will update yc and yd in it_ini
       updater->compute_initial_duals_eq(it_ini, gradf, Jac_c, Jac_d);
@@ -405,6 +481,286 @@ int hiopAlgFilterIPMBase::startingProcedure(hiopIterate& it_ini,
   return true;
 }
 
+int hiopAlgFilterIPMBase::startingProcedureFromState(hiopIterate& it_ini,
+                                                     double &f,
+                                                     hiopVector& c,
+                                                     hiopVector& d,
+                                                     hiopVector& gradf,
+                                                     hiopMatrix& Jac_c,
+                                                     hiopMatrix& Jac_d)
+{
+  it_ini.copyFrom(warm_start_state_->get_it());
+
+  if(!this->evalNlp_noHess(it_ini, f, c, d, gradf, Jac_c, Jac_d)) {
+    nlp->log->printf(hovError, "Failure in evaluating user provided NLP functions.");
+    assert(false);
+    return false;
+  }
+  nlp->apply_scaling(c, d, gradf, Jac_c, Jac_d);
+
+  nlp->runStats.tmSolverInternal.start();
+  nlp->runStats.tmStartingPoint.start();
+
+  //the bounds may have changed: the primals are pushed inside the bounds by an amount much smaller
+  //than for a cold start since the point is expected to be close to the solution
+  const double bound_push = nlp->options->GetNumeric("warm_start_bound_push");
+  it_ini.projectPrimalsXIntoBounds(bound_push, bound_push);
+  it_ini.projectPrimalsDIntoBounds(bound_push, bound_push);
+  it_ini.determineSlacks();
+
+  const double mult_push = nlp->options->GetNumeric("warm_start_mult_bound_push");
+  it_ini.get_zl()->component_max(mult_push);
+  it_ini.get_zl()->selectPattern(nlp->get_ixl());
+  it_ini.get_zu()->component_max(mult_push);
+  it_ini.get_zu()->selectPattern(nlp->get_ixu());
+  it_ini.get_vl()->component_max(mult_push);
+  it_ini.get_vl()->selectPattern(nlp->get_idl());
+  it_ini.get_vu()->component_max(mult_push);
+  it_ini.get_vu()->selectPattern(nlp->get_idu());
+
+  nlp->runStats.tmStartingPoint.stop();
+  nlp->runStats.tmSolverInternal.stop();
+
+  if(!this->evalNlp_noHess(it_ini, f, c, d, gradf, Jac_c, Jac_d)) {
+    nlp->log->printf(hovError, "Failure in evaluating user provided NLP functions.");
+    assert(false);
+    return false;
+  }
+
+  nlp->runStats.tmSolverInternal.start();
+  nlp->runStats.tmStartingPoint.start();
+
+  //the barrier parameter is reset to the average complementarity of the warm start point; this is
+  //at least the final barrier parameter of the previous solve and at most the cold start value
+  const size_type n_complem = nlp->n_complem();
+  double mu_ws = warm_start_state_->get_mu();
+  if(n_complem > 0) {
+    const double complem = it_ini.get_sxl()->dotProductWith(*it_ini.get_zl()) +
+                           it_ini.get_sxu()->dotProductWith(*it_ini.get_zu()) +
+                           it_ini.get_sdl()->dotProductWith(*it_ini.get_vl()) +
+                           it_ini.get_sdu()->dotProductWith(*it_ini.get_vu());
+    mu_ws = std::max(mu_ws, complem/n_complem);
+  }
+  warm_start_mu_ = std::min(mu_ws, mu0);
+  nlp->log->printf(hovSummary, "Warm starting from a previous solver state with mu=%g\n", warm_start_mu_);
+
+  if(!this->evalNlp_HessOnly(it_ini, *_Hess_Lagr)) {
+    assert(false);
+    return false;
+  }
+
+  nlp->log->write("Using initial point:", it_ini, hovIteration);
+  nlp->runStats.tmStartingPoint.stop();
+  nlp->runStats.tmSolverInternal.stop();
+
+  solver_status_ = NlpSolve_SolveNotCalled;
+
+  return true;
+}
+
+hiopAlgFilterIPMState* hiopAlgFilterIPMBase::save_state() const
+{
+  return new hiopAlgFilterIPMState(*it_curr, _mu);
+}
+
+bool hiopAlgFilterIPMBase::save_state_to_file(const std::string& path)
+{
+  int rank = 0, num_ranks = 1;
+#ifdef HIOP_USE_MPI
+  rank = nlp->get_rank();
+  num_ranks = nlp->get_num_ranks();
+#endif
+  hiopCheckpointFile file(hiopCheckpointFile::rank_file_name(path, rank, num_ranks),
+                          hiopCheckpointFile::Write);
+
+  file.write_marker("hiop_checkpoint");
+  file.write_scalar(num_ranks);
+  file.write_scalar(rank);
+  const size_type sizes[3] = {nlp->n(), nlp->m_eq(), nlp->m_ineq()};
+  for(auto size : sizes) {
+    file.write_scalar(size);
+  }
+
+  file.write_scalar(iter_num);
+  file.write_scalar(n_accep_iters_);
+  const double scalars[] = {_mu, _tau, theta_max, theta_min, kappa_mu, theta_mu,
+                            _err_nlp_optim0, _err_nlp_feas0, _err_nlp_complem0};
+  file.write_array(scalars, sizeof(scalars)/sizeof(double));
+
+  const hiopRunStats& stats = nlp->runStats;
+  const int counters[] = {stats.nEvalObj, stats.nEvalGrad_f, stats.nEvalCons_eq, stats.nEvalCons_ineq,
+                          stats.nEvalJac_con_eq, stats.nEvalJac_con_ineq, stats.nEvalHessL};
+  for(auto counter : counters) {
+    file.write_scalar(counter);
+  }
+
+  filter.save_state(file);
+  it_curr->save_state(file);
+  save_alg_state(file);
+  file.write_marker("end");
+
+  //the previous checkpoint is replaced only when all the ranks wrote their files
+  int ok = file.close() ? 1 : 0;
+#ifdef HIOP_USE_MPI
+  int ok_loc = ok;
+  int ierr = MPI_Allreduce(&ok_loc, &ok, 1, MPI_INT, MPI_MIN, nlp->get_comm()); assert(MPI_SUCCESS==ierr);
+#endif
+  ok = file.commit(ok==1) ? 1 : 0;
+#ifdef HIOP_USE_MPI
+  ok_loc = ok;
+  ierr = MPI_Allreduce(&ok_loc, &ok, 1, MPI_INT, MPI_MIN, nlp->get_comm()); assert(MPI_SUCCESS==ierr);
+#endif
+  return ok==1;
+}
+
+bool hiopAlgFilterIPMBase::load_state_from_file(const std::string& path)
+{
+  int rank = 0, num_ranks = 1;
+#ifdef HIOP_USE_MPI
+  rank = nlp->get_rank();
+  num_ranks = nlp->get_num_ranks();
+#endif
+  hiopCheckpointFile file(hiopCheckpointFile::rank_file_name(path, rank, num_ranks),
+                          hiopCheckpointFile::Read);
+
+  file.read_marker("hiop_checkpoint");
+  int num_ranks_file = -1, rank_file = -1;
+  file.read_scalar(num_ranks_file);
+  file.read_scalar(rank_file);
+  size_type sizes_file[3] = {-1, -1, -1};
+  for(auto& size : sizes_file) {
+    file.read_scalar(size);
+  }
+  //a mismatch is not returned right away since the ranks agree on the outcome below
+  bool same_problem = true;
+  if(file.good() &&
+     (num_ranks_file!=num_ranks || rank_file!=rank ||
+      sizes_file[0]!=nlp->n() || sizes_file[1]!=nlp->m_eq() || sizes_file[2]!=nlp->m_ineq())) {
+    nlp->log->printf(hovError,
+                     "checkpoint '%s' was written for a different problem or number of ranks: "
+                     "ranks %d n %d m_eq %d m_ineq %d\n",
+                     path.c_str(), num_ranks_file, sizes_file[0], sizes_file[1], sizes_file[2]);
+    same_problem = false;
+  }
+
+  if(same_problem) {
+    file.read_scalar(iter_num);
+    file.read_scalar(n_accep_iters_);
+    double scalars[9];
+    file.read_array(scalars, 9);
+    if(file.good()) {
+      _mu = scalars[0];
+      _tau = scalars[1];
+      theta_max = scalars[2];
+      theta_min = scalars[3];
+      kappa_mu = scalars[4];
+      theta_mu = scalars[5];
+      _err_nlp_optim0 = scalars[6];
+      _err_nlp_feas0 = scalars[7];
+      _err_nlp_complem0 = scalars[8];
+    }
+
+    hiopRunStats& stats = nlp->runStats;
+    for(int* counter : {&stats.nEvalObj, &stats.nEvalGrad_f, &stats.nEvalCons_eq, &stats.nEvalCons_ineq,
+                        &stats.nEvalJac_con_eq, &stats.nEvalJac_con_ineq, &stats.nEvalHessL}) {
+      file.read_scalar(*counter);
+    }
+    stats.nIter = iter_num;
+
+    filter.load_state(file);
+    it_curr->load_state(file);
+    load_alg_state(file);
+    file.read_marker("end");
+  }
+
+  int ok = (file.close() && same_problem) ? 1 : 0;
+#ifdef HIOP_USE_MPI
+  int ok_loc = ok;
+  int ierr = MPI_Allreduce(&ok_loc, &ok, 1, MPI_INT, MPI_MIN, nlp->get_comm()); assert(MPI_SUCCESS==ierr);
+  if(ok==1) {
+    //the files of the ranks should come from the same checkpoint
+    int iter_min = iter_num, iter_max = iter_num;
+    ierr = MPI_Allreduce(&iter_num, &iter_min, 1, MPI_INT, MPI_MIN, nlp->get_comm()); assert(MPI_SUCCESS==ierr);
+    ierr = MPI_Allreduce(&iter_num, &iter_max, 1, MPI_INT, MPI_MAX, nlp->get_comm()); assert(MPI_SUCCESS==ierr);
+    if(iter_min != iter_max) {
+      nlp->log->printf(hovError,
+                       "checkpoint '%s' mixes the files of different iterations: from %d to %d\n",
+                       path.c_str(), iter_min, iter_max);
+      ok = 0;
+    }
+  }
+#endif
+  return ok==1;
+}
+
+void hiopAlgFilterIPMBase::checkpoint_if_due()
+{
+  //the restoration problem is not checkpointed; the checkpoints of the outer solve are used instead
+  if(within_FR_ || nlp->options->GetString("checkpoint_save") != "yes") {
+    return;
+  }
+  const int every_N = nlp->options->GetInteger("checkpoint_save_N");
+  if(iter_num<=0 || iter_num%every_N != 0) {
+    return;
+  }
+  const std::string path = nlp->options->GetString("checkpoint_file");
+  nlp->runStats.tmSolverInternal.start();
+  if(save_state_to_file(path)) {
+    nlp->log->printf(hovSummary, "Iter[%d] checkpoint saved to '%s'\n", iter_num, path.c_str());
+  } else {
+    nlp->log->printf(hovWarning, "Iter[%d] failed to save checkpoint to '%s'\n", iter_num, path.c_str());
+  }
+  nlp->runStats.tmSolverInternal.stop();
+}
+
+bool hiopAlgFilterIPMBase::resume_from_checkpoint()
+{
+  if(within_FR_ || checkpoint_load_done_ || nlp->options->GetString("checkpoint_load_on_start") != "yes") {
+    return true;
+  }
+  //the checkpoint is loaded by the first run only; the subsequent runs (e.g., re-solves) start as usual
+  checkpoint_load_done_ = true;
+  const std::string path = nlp->options->GetString("checkpoint_file");
+
+  int rank = 0, num_ranks = 1;
+#ifdef HIOP_USE_MPI
+  rank = nlp->get_rank();
+  num_ranks = nlp->get_num_ranks();
+#endif
+  //a missing checkpoint is not an error: this is the first start of a job that is restarted on failure
+  FILE* f = fopen(hiopCheckpointFile::rank_file_name(path, rank, num_ranks).c_str(), "rb");
+  int found = (nullptr != f) ? 1 : 0;
+  if(f) {
+    fclose(f);
+  }
+#ifdef HIOP_USE_MPI
+  int found_loc = found;
+  int ierr = MPI_Allreduce(&found_loc, &found, 1, MPI_INT, MPI_MIN, nlp->get_comm()); assert(MPI_SUCCESS==ierr);
+#endif
+  if(!found) {
+    nlp->log->printf(hovWarning,
+                     "checkpoint '%s' not found; the solver starts from the initial point\n",
+                     path.c_str());
+    return true;
+  }
+
+  if(!load_state_from_file(path)) {
+    nlp->log->printf(hovError, "failed to load checkpoint '%s'\n", path.c_str());
+    return false;
+  }
+  nlp->log->printf(hovSummary, "Resuming from checkpoint '%s' at iteration %d (mu=%g)\n",
+                   path.c_str(), iter_num, _mu);
+
+  if(!this->evalNlp_noHess(*it_curr, _f_nlp, *_c, *_d, *_grad_f, *_Jac_c, *_Jac_d) ||
+     !this->evalNlp_HessOnly(*it_curr, *_Hess_Lagr)) {
+    nlp->log->printf(hovError, "Failure in evaluating user provided NLP functions.");
+    return false;
+  }
+  logbar->updateWithNlpInfo(*it_curr, _mu, _f_nlp, *_c, *_d, *_grad_f, *_Jac_c, *_Jac_d);
+  resid->update(*it_curr, _f_nlp, *_c, *_d, *_grad_f, *_Jac_c, *_Jac_d, *logbar);
+  return true;
+}
+
 bool hiopAlgFilterIPMBase::evalNlp(hiopIterate& iter,
                                    double &f,
                                    hiopVector& c,
@@ -777,6 +1133,18 @@ int hiopAlgFilterIPMBase::getNumIterations() const
 bool hiopAlgFilterIPMBase::
 checkTermination(const double& err_nlp, const int& iter_num, hiopSolveStatus& status)
 {
+  //the tracker of this solver or, for the FR solver, the one of the solver it belongs to
+  const hiopMemoryTracker* mem_tracker = hiopMemoryTracker::active();
+  if(mem_tracker) {
+    int exceeded = mem_tracker->budget_exceeded() ? 1 : 0;
+#ifdef HIOP_USE_MPI
+    //the ranks allocate different amounts of memory but should stop at the same iteration
+    int exceeded_loc = exceeded;
+    int ierr = MPI_Allreduce(&exceeded_loc, &exceeded, 1, MPI_INT, MPI_MAX, nlp->get_comm());
+    assert(MPI_SUCCESS==ierr);
+#endif
+    if(exceeded) { solver_status_ = Memory_Alloc_Problem; return true; }
+  }
   if(err_nlp<=eps_tol)   { solver_status_ = Solve_Success;     return true; }
   if(iter_num>=max_n_it) { solver_status_ = Max_Iter_Exceeded; return true; }
 
@@ -799,7 +1167,14 @@ checkTermination(const double& err_nlp, const int& iter_num, hiopSolveStatus& st
 /***** Termination message *****/
 void hiopAlgFilterIPMBase::displayTerminationMsg()
 {
-  std::string strStatsReport = nlp->runStats.get_summary() + nlp->runStats.kkt.get_summary_total();
+  std::string strStatsReport = nlp->runStats.get_summary() +
+    nlp->runStats.kkt.get_summary_total();
+  if(mem_tracking_) {
+    strStatsReport += mem_tracker_.get_summary();
+  }
+  if(mem_pool_) {
+    strStatsReport += mem_pool_->get_summary();
+  }
   switch(solver_status_) {
   case Solve_Success:
     {
@@ -857,6 +1232,13 @@ void hiopAlgFilterIPMBase::displayTerminationMsg()
                        strStatsReport.c_str());
       break;
     }
+  case Memory_Alloc_Problem:
+    {
+      nlp->log->printf(hovSummary,
+                       "Memory budget (option 'memory_budget') exceeded.\n%s\n",
+                       strStatsReport.c_str());
+      break;
+    }
   case Err_Step_Computation:
   {
       nlp->log->printf(hovSummary,
@@ -873,6 +1255,34 @@ void hiopAlgFilterIPMBase::displayTerminationMsg()
       break;
     }
   };
+  nlp->log->flush();
+}
+
+void hiopAlgFilterIPMBase::outputIterationRecord(int lsStatus, int lsNum, int use_soc, int use_fr)
+{
+  char stepType[2];
+  if(lsStatus==-1) strcpy(stepType, "-");
+  else if(lsStatus==1) strcpy(stepType, "s");
+  else if(lsStatus==2) strcpy(stepType, "h");
+  else if(lsStatus==3) strcpy(stepType, "f");
+  else strcpy(stepType, "?");
+
+  if(use_soc && lsStatus >= 1 && lsStatus <= 3) {
+    stepType[0] = (char) ::toupper(stepType[0]);
+  }
+  if(use_fr) {
+    strcpy(stepType, "R");
+  }
+  if(lsStatus==-1) {
+    lsNum = 0;
+  }
+
+  nlp->log->printf_record(hovSummary,
+                          "iteration",
+                          "iter=%d objective=%.7e inf_pr=%.3e inf_du=%.3e lg_mu=%.2f alpha_du=%.3e alpha_pr=%.3e "
+                          "ls_trials=%d ls_type=%s",
+                          iter_num, _f_nlp/nlp->get_obj_scale(), _err_nlp_feas, _err_nlp_optim,
+                          log10(_mu), _alpha_dual, _alpha_primal, lsNum, stepType);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -882,6 +1292,7 @@ hiopAlgFilterIPMQuasiNewton::hiopAlgFilterIPMQuasiNewton(hiopNlpDenseConstraints
                                                          const bool within_FR)
   : hiopAlgFilterIPMBase(nlp_in, within_FR)
 {
+  MemoryScope mem_scope(*this);
   nlpdc = nlp_in;
   reload_options();
 
@@ -903,11 +1314,28 @@ hiopAlgFilterIPMQuasiNewton::~hiopAlgFilterIPMQuasiNewton()
 {
 }
 
+void hiopAlgFilterIPMQuasiNewton::save_alg_state(hiopCheckpointFile& file) const
+{
+  dynamic_cast<const hiopHessianLowRank*>(_Hess_Lagr)->save_state(file);
+}
+
+bool hiopAlgFilterIPMQuasiNewton::load_alg_state(hiopCheckpointFile& file)
+{
+  return dynamic_cast<hiopHessianLowRank*>(_Hess_Lagr)->load_state(file);
+}
+
 hiopSolveStatus hiopAlgFilterIPMQuasiNewton::run()
 {
+  update_memory_settings();
+  MemoryScope mem_scope(*this);
+
   //hiopNlpFormulation nlp may need an update since user may have changed options and
   //reruning with the same hiopAlgFilterIPMQuasiNewton instance
-  nlp->finalizeInitialization();
+  if(!nlp->finalizeInitialization()) {
+    nlp->log->printf(hovError, "The initialization of the NLP failed.\n");
+    solver_status_ = SolveInitializationError;
+    return SolveInitializationError;
+  }
   //also reload options
   reload_options();
 
@@ -943,7 +1371,7 @@ hiopSolveStatus hiopAlgFilterIPMQuasiNewton::run()
   nlp->runStats.tmOptimizTotal.start();
 
   startingProcedure(*it_curr, _f_nlp, *_c, *_d, *_grad_f, *_Jac_c, *_Jac_d); //this also evaluates the nlp
-  _mu=mu0;
+  _mu = warm_start_mu_>0. ? warm_start_mu_ : mu0;
 
   //update log bar
   logbar->updateWithNlpInfo(*it_curr, _mu, _f_nlp, *_c, *_d, *_grad_f, *_Jac_c, *_Jac_d);
@@ -958,11 +1386,21 @@ hiopSolveStatus hiopAlgFilterIPMQuasiNewton::run()
   theta_max = theta_max_fact_*fmax(1.0,resid->get_theta());
   theta_min = theta_min_fact_*fmax(1.0,resid->get_theta());
 
-  hiopKKTLinSysLowRank* kkt=new hiopKKTLinSysLowRank(nlp);
+  _err_nlp_optim0=-1.; _err_nlp_feas0=-1.; _err_nlp_complem0=-1;
 
-  _alpha_primal = _alpha_dual = 0;
+  if(!resume_from_checkpoint()) {
+    solver_status_ = SolveInitializationError;
+    nlp->runStats.tmOptimizTotal.stop();
+    return SolveInitializationError;
+  }
 
-  _err_nlp_optim0=-1.; _err_nlp_feas0=-1.; _err_nlp_complem0=-1;
+  hiopKKTLinSysLowRank* kkt;
+  {
+    hiopMemoryTrackerScope mem_scope(hiopMemoryTracker::KKT);
+    kkt = new hiopKKTLinSysLowRank(nlp);
+  }
+
+  _alpha_primal = _alpha_dual = 0;
 
   // --- Algorithm status 'algStatus ----
   //-1 couldn't solve the problem (most likely because small search step. Restauration phase likely needed)
@@ -1043,6 +1481,8 @@ hiopSolveStatus hiopAlgFilterIPMQuasiNewton::run()
     }
     if(NlpSolve_Pending!=solver_status_) break; //failure of the line search or user stopped.
 
+    checkpoint_if_due();
+
     /************************************************
      * update mu and other parameters
      ************************************************/
@@ -1086,9 +1526,12 @@ hiopSolveStatus hiopAlgFilterIPMQuasiNewton::run()
      * Search direction calculation
      ***************************************************/
     //first update the Hessian and kkt system
-    Hess->update(*it_curr,*_grad_f,*_Jac_c,*_Jac_d);
-    kkt->update(it_curr, _grad_f, Jac_c, Jac_d, Hess);
-    bret = kkt->computeDirections(resid,dir); assert(bret==true);
+    {
+      hiopMemoryTrackerScope mem_scope(hiopMemoryTracker::KKT);
+      Hess->update(*it_curr,*_grad_f,*_Jac_c,*_Jac_d);
+      kkt->update(it_curr, _grad_f, Jac_c, Jac_d, Hess);
+      bret = kkt->computeDirections(resid,dir); assert(bret==true);
+    }
 
     nlp->log->printf(hovIteration, "Iter[%d] full search direction -------------\n", iter_num);
     nlp->log->write("", *dir, hovIteration);
@@ -1316,6 +1759,10 @@ hiopSolveStatus hiopAlgFilterIPMQuasiNewton::run()
 
 void hiopAlgFilterIPMQuasiNewton::outputIteration(int lsStatus, int lsNum, int use_soc, int use_fr)
 {
+  if(nlp->log->is_keyvalue_format()) {
+    outputIterationRecord(lsStatus, lsNum, use_soc, use_fr);
+    return;
+  }
   if(iter_num/10*10==iter_num)
     nlp->log->printf(hovSummary, "iter    objective     inf_pr     inf_du   lg(mu)  alpha_du   alpha_pr linesrch\n");
 
@@ -1350,11 +1797,15 @@ void hiopAlgFilterIPMQuasiNewton::outputIteration(int lsStatus, int lsNum, int u
  *****************************************************************************************************/
 hiopAlgFilterIPMNewton::hiopAlgFilterIPMNewton(hiopNlpFormulation* nlp_in, const bool within_FR)
   : hiopAlgFilterIPMBase(nlp_in, within_FR),
-    fact_acceptor_{nullptr}
+    fact_acceptor_{nullptr},
+    kkt_reused_{nullptr},
+    reuse_kkt_{false}
 {
+  MemoryScope mem_scope(*this);
   reload_options();
 
   alloc_alg_objects();
+  nlp->get_transformations_key(transformations_key_);
 
   //parameter based initialization
   if(duals_update_type==0) {
@@ -1370,9 +1821,64 @@ hiopAlgFilterIPMNewton::hiopAlgFilterIPMNewton(hiopNlpFormulation* nlp_in, const
 
 hiopAlgFilterIPMNewton::~hiopAlgFilterIPMNewton()
 {
+  delete kkt_reused_;
   delete fact_acceptor_;
 }
 
+void hiopAlgFilterIPMNewton::save_alg_state(hiopCheckpointFile& file) const
+{
+  pd_perturb_.save_state(file);
+}
+
+void hiopAlgFilterIPMNewton::prepare_duals_lsq_init(hiopDualsLsqUpdate* updater, const hiopIterate& it_ini)
+{
+#ifdef HIOP_SPARSE
+  auto* updater_sp = dynamic_cast<hiopDualsLsqUpdateLinsysAugSparse*>(updater);
+  if(nullptr == updater_sp) {
+    return;
+  }
+  if(nullptr == kkt_reused_) {
+    kkt_reused_ = decideAndCreateLinearSystem(nlp);
+  }
+  auto* kkt_sp = dynamic_cast<hiopKKTLinSysCompressedSparseXDYcYd*>(kkt_reused_);
+  if(nullptr == kkt_sp) {
+    return;
+  }
+  //the pattern of the Hessian is part of the pattern of the KKT matrix
+  auto* nlp_sp = dynamic_cast<hiopNlpSparse*>(nlp);
+  assert(nlp_sp);
+  if(!nlp_sp->eval_Hess_Lagr_structure(*it_ini.get_x(), *_Hess_Lagr)) {
+    nlp->log->printf(hovWarning, "Failure in evaluating the sparsity pattern of the Hessian; the LSQ "
+                     "initialization of the duals will use its own linear solver.\n");
+    return;
+  }
+  updater_sp->set_kkt_for_ini_duals(kkt_sp, _Hess_Lagr);
+#endif
+}
+
+bool hiopAlgFilterIPMNewton::load_alg_state(hiopCheckpointFile& file)
+{
+  return pd_perturb_.load_state(file);
+}
+
+hiopAlgFilterIPMState* hiopAlgFilterIPMNewton::save_state() const
+{
+  hiopAlgFilterIPMState* state = hiopAlgFilterIPMBase::save_state();
+  double delta_wx, delta_wd, delta_cc, delta_cd;
+  pd_perturb_.get_last_perturbations(delta_wx, delta_wd, delta_cc, delta_cd);
+  state->set_perturbations(delta_wx, delta_wd, delta_cc, delta_cd);
+  return state;
+}
+
+void hiopAlgFilterIPMNewton::set_reuse_kkt(bool reuse_kkt)
+{
+  reuse_kkt_ = reuse_kkt;
+  if(!reuse_kkt_) {
+    delete kkt_reused_;
+    kkt_reused_ = nullptr;
+  }
+}
+
 void hiopAlgFilterIPMNewton::reload_options()
 {
   auto hess_opt_val = nlp->options->GetString("Hessian");
@@ -1408,6 +1914,7 @@ void hiopAlgFilterIPMNewton::reload_options()
 
 hiopKKTLinSys* hiopAlgFilterIPMNewton::decideAndCreateLinearSystem(hiopNlpFormulation* nlp)
 {
+  hiopMemoryTrackerScope mem_scope(hiopMemoryTracker::KKT);
   //hiopNlpMDS* nlpMDS = nullptr;
   hiopNlpMDS* nlpMDS = dynamic_cast<hiopNlpMDS*>(nlp);
 
@@ -1464,6 +1971,7 @@ hiopAlgFilterIPMNewton::switch_to_safer_KKT(hiopKKTLinSys* kkt_curr,
                                             double& kappa_mu,
                                             bool& switched)
 {
+  hiopMemoryTrackerScope mem_scope(hiopMemoryTracker::KKT);
 #ifdef HIOP_SPARSE
   if(linsol_safe_mode_on) {
     //attempt switching only when running under "condensed" KKT formulation 
@@ -1515,6 +2023,7 @@ hiopAlgFilterIPMNewton::switch_to_fast_KKT(hiopKKTLinSys* kkt_curr,
                                            bool& switched)
 
 {
+  hiopMemoryTrackerScope mem_scope(hiopMemoryTracker::KKT);
   assert("speculative"==hiop::tolower(nlp->options->GetString("linsol_mode")));
 #ifdef HIOP_SPARSE
   auto* kkt = dynamic_cast<hiopKKTLinSysCondensedSparse*>(kkt_curr);
@@ -1606,19 +2115,37 @@ decideAndCreateFactAcceptor(hiopPDPerturbation* p, hiopNlpFormulation* nlp, hiop
 
 hiopSolveStatus hiopAlgFilterIPMNewton::run()
 {
+  update_memory_settings();
+  MemoryScope mem_scope(*this);
+
   //hiopNlpFormulation nlp may need an update since user may have changed options and
   //reruning with the same hiopAlgFilterIPMNewton instance
-  nlp->finalizeInitialization();
+  if(!nlp->finalizeInitialization()) {
+    nlp->log->printf(hovError, "The initialization of the NLP failed.\n");
+    solver_status_ = SolveInitializationError;
+    return SolveInitializationError;
+  }
 
   //also reload options
   reload_options();
 
-  //if nlp changed internally, we need to reinitialize `this`
+  //if nlp changed internally, we need to reinitialize `this`; this is also the case when other variables
+  //are fixed or other constraints are removed by the presolve, which changes the sparsity patterns of the
+  //derivatives and of the KKT without changing the sizes, e.g., for the instances solved by hiopBatchSolver
+  std::vector<index_type> transformations_key;
+  nlp->get_transformations_key(transformations_key);
   if(it_curr->get_x()->get_size()!=nlp->n() ||
      //Jac_c->get_local_size_n()!=nlpdc->n_local()) { <- this is prone to racing conditions
-     _Jac_c->n()!=nlp->n()) {
+     _Jac_c->n()!=nlp->n() ||
+     _Jac_c->m()!=nlp->m_eq() ||
+     _Jac_d->m()!=nlp->m_ineq() ||
+     transformations_key != transformations_key_) {
     //size of the nlp changed internally ->  reInitializeNlpObjects();
     reInitializeNlpObjects();
+    //the KKT kept from the previous run was built for the old NLP
+    delete kkt_reused_;
+    kkt_reused_ = nullptr;
+    transformations_key_.swap(transformations_key);
   }
   resetSolverStatus();
 
@@ -1628,6 +2155,11 @@ hiopSolveStatus hiopAlgFilterIPMNewton::run()
   if(!pd_perturb_.initialize(nlp)) {
     return SolveInitializationError;
   }
+  if(nullptr != warm_start_state_) {
+    double delta_wx, delta_wd, delta_cc, delta_cd;
+    warm_start_state_->get_perturbations(delta_wx, delta_wd, delta_cc, delta_cd);
+    pd_perturb_.set_last_perturbations(delta_wx, delta_wd, delta_cc, delta_cd);
+  }
 
   //todo: have this as option maybe
   //number of safe mode iteration to run once linsol mode is switched to on
@@ -1650,7 +2182,7 @@ hiopSolveStatus hiopAlgFilterIPMNewton::run()
   nlp->runStats.tmOptimizTotal.start();
 
   startingProcedure(*it_curr, _f_nlp, *_c, *_d, *_grad_f, *_Jac_c, *_Jac_d); //this also evaluates the nlp
-  _mu=mu0;
+  _mu = warm_start_mu_>0. ? warm_start_mu_ : mu0;
 
   //update log bar
   logbar->updateWithNlpInfo(*it_curr, _mu, _f_nlp, *_c, *_d, *_grad_f, *_Jac_c, *_Jac_d);
@@ -1666,7 +2198,19 @@ hiopSolveStatus hiopAlgFilterIPMNewton::run()
   theta_max = theta_max_fact_*fmax(1.0,resid->get_theta());
   theta_min = theta_min_fact_*fmax(1.0,resid->get_theta());
 
-  hiopKKTLinSys* kkt = decideAndCreateLinearSystem(nlp);
+  _err_nlp_optim0=-1.; _err_nlp_feas0=-1.; _err_nlp_complem0=-1;
+
+  if(!resume_from_checkpoint()) {
+    solver_status_ = SolveInitializationError;
+    nlp->runStats.tmOptimizTotal.stop();
+    return SolveInitializationError;
+  }
+
+  hiopKKTLinSys* kkt = kkt_reused_;
+  kkt_reused_ = nullptr;
+  if(nullptr == kkt) {
+    kkt = decideAndCreateLinearSystem(nlp);
+  }
   assert(kkt != NULL);
   kkt->set_PD_perturb_calc(&pd_perturb_);
   kkt->set_logbar_mu(_mu);
@@ -1680,8 +2224,6 @@ hiopSolveStatus hiopAlgFilterIPMNewton::run()
   
   _alpha_primal = _alpha_dual = 0;
 
-  _err_nlp_optim0=-1.; _err_nlp_feas0=-1.; _err_nlp_complem0=-1;
-
   // --- Algorithm status `algStatus` ----
   //-1 couldn't solve the problem (most likely because small search step. Restauration phase likely needed)
   // 0 stopped due to tolerances, including acceptable tolerance, or relative tolerance
@@ -1767,6 +2309,8 @@ hiopSolveStatus hiopAlgFilterIPMNewton::run()
     }
     if(NlpSolve_Pending!=solver_status_) break; //failure of the line search or user stopped.
 
+    checkpoint_if_due();
+
     /************************************************
      * update mu and other parameters
      ************************************************/
@@ -1878,7 +2422,12 @@ hiopSolveStatus hiopAlgFilterIPMNewton::run()
       //
       //update the Hessian and kkt system; usually a matrix factorization occurs
       //
-      if(!kkt->update(it_curr, _grad_f, _Jac_c, _Jac_d, _Hess_Lagr)) {
+      bool kkt_updated;
+      {
+        hiopMemoryTrackerScope mem_scope(hiopMemoryTracker::KKT);
+        kkt_updated = kkt->update(it_curr, _grad_f, _Jac_c, _Jac_d, _Hess_Lagr);
+      }
+      if(!kkt_updated) {
         if(linsol_safe_mode_on) {
           nlp->log->write("Unrecoverable error in step computation (factorization) [1]. Will exit here.",
                           hovError);
@@ -2240,13 +2789,21 @@ hiopSolveStatus hiopAlgFilterIPMNewton::run()
                               *it_curr->get_yc(),
                               *it_curr->get_yd(),
                               _f_nlp);
-  delete kkt;
+  if(reuse_kkt_) {
+    kkt_reused_ = kkt;
+  } else {
+    delete kkt;
+  }
 
   return solver_status_;
 }
 
 void hiopAlgFilterIPMNewton::outputIteration(int lsStatus, int lsNum, int use_soc, int use_fr)
 {
+  if(nlp->log->is_keyvalue_format()) {
+    outputIterationRecord(lsStatus, lsNum, use_soc, use_fr);
+    return;
+  }
   if(iter_num/10*10==iter_num)
     nlp->log->printf(hovSummary, "iter    objective     inf_pr     inf_du   lg(mu)  alpha_du   alpha_pr linesrch\n");
 
@@ -2478,39 +3035,19 @@ bool hiopAlgFilterIPMBase::apply_feasibility_restoration(hiopKKTLinSys* kkt)
       return true;
     }
   
-    // continue robust FR
-    hiopNlpMDS* nlpMDS = dynamic_cast<hiopNlpMDS*>(nlp);
-    if (nlpMDS == nullptr) {
-      hiopNlpSparse* nlpSp = dynamic_cast<hiopNlpSparse*>(nlp);
-      if(NULL == nlpSp)
-      {
-        // this is dense linear system. This is the default case.
-        assert(0 && "feasibility problem hasn't support dense system yet.");
-      } else {
-        // this is Sparse linear system
-        hiopFRProbSparse nlp_fr_interface(*this);
-        hiopNlpSparse nlpFR(nlp_fr_interface, nlp->options->GetString("options_file_fr_prob").c_str());
-        fr_solved = solve_feasibility_restoration(kkt, nlpFR);
-        if(fr_solved) {
-          nlp->log->printf(hovScalars, "FR problem provides sufficient reduction in primal feasibility!\n");
-          // FR succeeds, update it_trial->x and it_trial->d to the next search point
-          it_trial->get_x()->copyFrom(nlp_fr_interface.get_fr_sol_x());
-          it_trial->get_d()->copyFrom(nlp_fr_interface.get_fr_sol_d());
-          reset_var_from_fr_sol(kkt, reset_dual = true);
-        } 
-      }
+    // continue robust FR: the FR problem and its solver are created on the first entry and reused afterwards
+    if(nullptr == fr_context_) {
+      fr_context_ = new hiopFRContext(*this);
     } else {
-      // this is MDS system
-      hiopFRProbMDS nlp_fr_interface(*this);
-      hiopNlpMDS nlpFR(nlp_fr_interface, nlp->options->GetString("options_file_fr_prob").c_str());
-      fr_solved =  solve_feasibility_restoration(kkt, nlpFR);
-      if(fr_solved) {
-        nlp->log->printf(hovScalars, "FR problem provides sufficient reduction in primal feasibility!\n");
-        // FR succeeds, update it_trial->x and it_trial->d to the next search point
-        it_trial->get_x()->copyFrom(nlp_fr_interface.get_fr_sol_x());
-        it_trial->get_d()->copyFrom(nlp_fr_interface.get_fr_sol_d());
-        reset_var_from_fr_sol(kkt, reset_dual = true);
-      }
+      fr_context_->update_reference_point();
+    }
+    fr_solved = solve_feasibility_restoration(kkt, *fr_context_);
+    if(fr_solved) {
+      nlp->log->printf(hovScalars, "FR problem provides sufficient reduction in primal feasibility!\n");
+      // FR succeeds, update it_trial->x and it_trial->d to the next search point
+      it_trial->get_x()->copyFrom(fr_context_->get_fr_sol_x());
+      it_trial->get_d()->copyFrom(fr_context_->get_fr_sol_d());
+      reset_var_from_fr_sol(kkt, reset_dual = true);
     }
   } else {
     // FR problem inside a FR problem, see equation (33)
@@ -2539,18 +3076,10 @@ bool hiopAlgFilterIPMBase::apply_feasibility_restoration(hiopKKTLinSys* kkt)
   return fr_solved;
 }
 
-bool hiopAlgFilterIPMBase::solve_feasibility_restoration(hiopKKTLinSys* kkt, hiopNlpFormulation& nlpFR)
+bool hiopAlgFilterIPMBase::solve_feasibility_restoration(hiopKKTLinSys* kkt, hiopFRContext& fr_context)
 {
-  nlpFR.options->SetStringValue("Hessian", "analytical_exact");
-  nlpFR.options->SetStringValue("duals_update_type", "linear");
-  nlpFR.options->SetStringValue("duals_init", "zero");
-  nlpFR.options->SetStringValue("compute_mode", nlp->options->GetString("compute_mode").c_str());
-  nlpFR.options->SetStringValue("mem_space", nlp->options->GetString("mem_space").c_str());
-  nlpFR.options->SetStringValue("KKTLinsys", "xdycyd");
-  nlpFR.options->SetIntegerValue("verbosity_level", 0);
-  nlpFR.options->SetStringValue("warm_start", "yes");
-  nlpFR.options->SetNumericValue("bound_relax_perturb", 0.0);
-  nlpFR.options->SetStringValue("scaling_type", "none");
+  //the remaining options of the FR problem are set by the FR context before its solver is created
+  hiopNlpFormulation& nlpFR = fr_context.get_nlp();
 
   // set mu0 to be the maximun of the current barrier parameter mu and norm_inf(|c|)*/
   double theta_ref = resid->getInfeasInfNorm(); //at current point, i.e., reference point
@@ -2558,8 +3087,9 @@ bool hiopAlgFilterIPMBase::solve_feasibility_restoration(hiopKKTLinSys* kkt, hio
 
   nlpFR.options->SetNumericValue("mu0", mu_FR);
 
-  hiopAlgFilterIPMNewton solver(&nlpFR, true);  // solver fr problem
-  hiopSolveStatus FR_status = solver.run();
+  //the output of the FR solver goes to the same stream
+  nlp->log->flush();
+  hiopSolveStatus FR_status = fr_context.get_solver().run();  // solver fr problem
 
   if(FR_status == User_Stopped) {
     // FR succeeds
@@ -2728,6 +3258,7 @@ bool hiopAlgFilterIPMNewton::compute_search_direction(hiopKKTLinSys* kkt,
                                                       const bool linsol_forcequick,
                                                       const int iter_num)
 {
+  hiopMemoryTrackerScope mem_scope(hiopMemoryTracker::KKT);
   //
   // solve for search directions
   //
@@ -2767,6 +3298,7 @@ bool hiopAlgFilterIPMNewton::compute_search_direction_inertia_free(hiopKKTLinSys
                                                                    const bool linsol_forcequick,
                                                                    const int iter_num)
 {
+  hiopMemoryTrackerScope mem_scope(hiopMemoryTracker::KKT);
   size_type num_refact = 0;
   const size_t max_refactorization = 10;
 
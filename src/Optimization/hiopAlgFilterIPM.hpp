@@ -66,12 +66,67 @@
 #include "hiopDualsUpdater.hpp"
 #include "hiopPDPerturbation.hpp"
 #include "hiopFactAcceptor.hpp"
+#include "hiopCheckpoint.hpp"
+#include "hiopMemoryTracker.hpp"
+#include "hiopHostMemPool.hpp"
 
 #include "hiopTimer.hpp"
 
 namespace hiop
 {
 
+class hiopFRContext;
+
+/**
+ * Snapshot of the state of the filter IPM solver at the end of a solve, to be used for warm 
+ * starting subsequent solves of perturbed instances of the NLP (for example, in rolling-horizon
+ * or parametric re-solves). It contains the primal-dual iterate (including the slacks of the 
+ * bounds) in the internal space of the solver, the final log-barrier parameter, and the last 
+ * primal-dual perturbations (regularizations) of the KKT linear system.
+ *
+ * The filter is not part of the state since its entries refer to the data of the previous 
+ * instance. The KKT linear system, including the symbolic factorization of the sparse linear 
+ * solvers, can be kept between solves with hiopAlgFilterIPMNewton::set_reuse_kkt.
+ */
+class hiopAlgFilterIPMState
+{
+public:
+  hiopAlgFilterIPMState(const hiopIterate& it, double mu)
+    : it_(it.new_copy()),
+      mu_(mu),
+      delta_wx_(0.), delta_wd_(0.), delta_cc_(0.), delta_cd_(0.)
+  {
+  }
+  ~hiopAlgFilterIPMState()
+  {
+    delete it_;
+  }
+  inline const hiopIterate& get_it() const { return *it_; }
+  inline double get_mu() const { return mu_; }
+
+  inline void set_perturbations(double delta_wx, double delta_wd, double delta_cc, double delta_cd)
+  {
+    delta_wx_ = delta_wx;
+    delta_wd_ = delta_wd;
+    delta_cc_ = delta_cc;
+    delta_cd_ = delta_cd;
+  }
+  inline void get_perturbations(double& delta_wx, double& delta_wd, double& delta_cc, double& delta_cd) const
+  {
+    delta_wx = delta_wx_;
+    delta_wd = delta_wd_;
+    delta_cc = delta_cc_;
+    delta_cd = delta_cd_;
+  }
+private:
+  hiopIterate* it_;
+  double mu_;
+  double delta_wx_, delta_wd_, delta_cc_, delta_cd_;
+private:
+  hiopAlgFilterIPMState(const hiopAlgFilterIPMState&) = delete;
+  hiopAlgFilterIPMState& operator=(const hiopAlgFilterIPMState&) = delete;
+};
+
 class hiopAlgFilterIPMBase {
 public:
   hiopAlgFilterIPMBase(hiopNlpFormulation* nlp_, const bool within_FR = false);
@@ -88,6 +143,14 @@ public:
                                 hiopVector& grad_,
                                 hiopMatrix& Jac_c,
                                 hiopMatrix& Jac_d);
+  /** computes the starting primal-dual point from the warm start state */
+  virtual int startingProcedureFromState(hiopIterate& it_ini,
+                                         double &f,
+                                         hiopVector& c_,
+                                         hiopVector& d_,
+                                         hiopVector& grad_,
+                                         hiopMatrix& Jac_c,
+                                         hiopMatrix& Jac_d);
   /* returns the objective value; valid only after 'run' method has been called */
   double getObjective() const;
   /* returns the primal vector x; valid only after 'run' method has been called */
@@ -119,6 +182,48 @@ public:
   }
   inline void set_alpha_primal(const double alpha_primal) { _alpha_primal = alpha_primal; }
 
+  /**
+   * Returns a snapshot of the state of the solver at the end of the last call of run(). The 
+   * caller is responsible for deleting the returned object.
+   */
+  virtual hiopAlgFilterIPMState* save_state() const;
+
+  /**
+   * Instructs the subsequent calls of run() to start from @p state instead of the regular 
+   * initialization (user's starting point, projection into bounds, LSQ duals). The state can be
+   * obtained from this or from another solver for an NLP with the same sizes. The primal 
+   * variables and the duals of the bounds are pushed inside the (possibly changed) bounds 
+   * based on the options 'warm_start_bound_push' and 'warm_start_mult_bound_push', and the 
+   * log-barrier parameter is reset to the average complementarity of the resulting point, 
+   * safeguarded by the final barrier parameter of the state and by 'mu0'.
+   *
+   * The state is not owned by the solver and should be valid until the calls of run() finish.
+   * Pass nullptr to return to the regular initialization.
+   */
+  void set_warm_start_state(const hiopAlgFilterIPMState* state) { warm_start_state_ = state; }
+
+  /**
+   * Writes a checkpoint of the current state of the algorithm to the file @p path (one file per MPI 
+   * rank when running on multiple ranks, see hiopCheckpointFile). The checkpoint contains the iterate,
+   * the barrier parameters, the filter, the run statistics counters, and the state specific to the 
+   * algorithm (the perturbations of the KKT system for the Newton solver and the memory of the 
+   * quasi-Newton Hessian). Returns false if any of the ranks failed to write its file.
+   *
+   * During run() the checkpoints are written periodically based on the options 'checkpoint_save', 
+   * 'checkpoint_save_N', and 'checkpoint_file'.
+   */
+  bool save_state_to_file(const std::string& path);
+
+  /**
+   * Reads a checkpoint written by save_state_to_file. The NLP should be the same and the solver should 
+   * run on the same number of MPI ranks. Returns false if the checkpoint could not be read, in which case
+   * the state of the algorithm is undefined if the checkpoint was only partially read.
+   *
+   * The first run() resumes from the checkpoint 'checkpoint_file' when the option 'checkpoint_load_on_start' 
+   * is 'yes'; a missing checkpoint is reported and the solve starts from the usual starting point.
+   */
+  bool load_state_from_file(const std::string& path);
+
 protected:
   bool evalNlp(hiopIterate& iter,
                double &f,
@@ -201,15 +306,37 @@ protected:
   /// @brief do feasibility restoration
   virtual bool apply_feasibility_restoration(hiopKKTLinSys* kkt);
   virtual bool solve_soft_feasibility_restoration(hiopKKTLinSys* kkt);
-  virtual bool solve_feasibility_restoration(hiopKKTLinSys* kkt, hiopNlpFormulation& nlpFR);
+  virtual bool solve_feasibility_restoration(hiopKKTLinSys* kkt, hiopFRContext& fr_context);
   virtual bool reset_var_from_fr_sol(hiopKKTLinSys* kkt, bool reset_dual = false);
 
   virtual void outputIteration(int lsStatus, int lsNum, int use_soc = 0, int use_fr = 0) = 0;
+  /// @brief outputs the iteration as a key/value record, used when 'log_format' is 'keyvalue'
+  void outputIterationRecord(int lsStatus, int lsNum, int use_soc, int use_fr);
 
   //returns whether the algorithm should stop and set an appropriate solve status
   bool checkTermination(const double& _err_nlp, const int& iter_num, hiopSolveStatus& status);
   void displayTerminationMsg();
 
+  /**
+   * Called by startingProcedure before the LSQ-based initialization of the duals, so that specialized 
+   * algorithms can let 'updater' use linear algebra objects they own; nothing in the base class.
+   */
+  virtual void prepare_duals_lsq_init(hiopDualsLsqUpdate* updater, const hiopIterate& it_ini) {}
+
+  /// Writes/reads the part of the checkpoint specific to the algorithm; nothing in the base class
+  virtual void save_alg_state(hiopCheckpointFile& file) const {}
+  virtual bool load_alg_state(hiopCheckpointFile& file) { return file.good(); }
+
+  /// Writes a checkpoint if checkpointing is on and the current iteration is due for one
+  void checkpoint_if_due();
+
+  /**
+   * Loads the checkpoint when 'checkpoint_load_on_start' is on and reevaluates the NLP, the log-barrier 
+   * problem, and the residuals at the loaded iterate. Returns false only if the checkpoint exists but 
+   * could not be loaded.
+   */
+  bool resume_from_checkpoint();
+
   void resetSolverStatus();
   virtual void reInitializeNlpObjects();
   virtual void reload_options();
@@ -271,6 +398,10 @@ protected:
   double theta_max_fact_;
   double theta_min_fact_;
 
+  /* State to warm start from (not owned) and the barrier parameter computed for it */
+  const hiopAlgFilterIPMState* warm_start_state_;
+  double warm_start_mu_;
+
   /*** Algorithm's parameters ***/
   double mu0;           //intial mu
   double kappa_mu;      //linear decrease factor in mu
@@ -305,6 +436,46 @@ protected:
   
   /* Flag to tell if this is a FR problem */
   bool within_FR_;
+
+  /* FR problem and its solver, created on the first entry into the restoration phase of a run */
+  hiopFRContext* fr_context_;
+
+  /* Whether the checkpoint 'checkpoint_file' was already loaded (or found missing) by a previous run */
+  bool checkpoint_load_done_;
+
+protected:
+  /**
+   * Updates the memory tracking and the host memory pool of this solver from the options 'memory_tracking',
+   * 'memory_budget', 'mem_space_pool', and 'mem_space_pool_max_cached'. The FR solver uses the tracker and
+   * the pool of the solver it belongs to and has none of its own.
+   */
+  void update_memory_settings();
+
+  /**
+   * Makes the memory tracker and the host memory pool of the solver active on the calling thread for the
+   * lifetime of the object. For the FR solver, the ones already active are kept.
+   */
+  class MemoryScope
+  {
+  public:
+    MemoryScope(hiopAlgFilterIPMBase& alg)
+      : tracker_activation_(alg.within_FR_ ?
+                            hiopMemoryTracker::active() :
+                            (alg.mem_tracking_ ? &alg.mem_tracker_ : nullptr)),
+        pool_activation_(alg.within_FR_ ? hiopHostMemPool::active() : alg.mem_pool_)
+    {
+    }
+  private:
+    hiopMemoryTrackerActivation tracker_activation_;
+    hiopHostMemPoolActivation pool_activation_;
+  };
+
+  /* Memory accounting of this solver; active only if 'mem_tracking_' is true */
+  hiopMemoryTracker mem_tracker_;
+  bool mem_tracking_;
+
+  /* Host memory pool of this solver, nullptr if the pool is disabled */
+  hiopHostMemPool* mem_pool_;
 };
 
 class hiopAlgFilterIPMQuasiNewton : public hiopAlgFilterIPMBase
@@ -316,6 +487,10 @@ public:
   virtual hiopSolveStatus run();
 private:
   virtual void outputIteration(int lsStatus, int lsNum, int use_soc = 0, int use_fr = 0);
+
+  /// The memory of the quasi-Newton Hessian is part of the checkpoints
+  virtual void save_alg_state(hiopCheckpointFile& file) const;
+  virtual bool load_alg_state(hiopCheckpointFile& file);
 private:
   hiopNlpDenseConstraints* nlpdc;
 private:
@@ -336,9 +511,31 @@ public:
 
   virtual hiopSolveStatus run();
 
+  /**
+   * When set to true, the KKT linear system (and its linear solver) created by run() is kept and 
+   * used again by subsequent calls of run(), as long as the sizes of the NLP do not change. This 
+   * avoids repeating the allocations and the symbolic analysis of the linear solver when NLPs 
+   * with the same structure are solved one after the other. Default is false.
+   */
+  void set_reuse_kkt(bool reuse_kkt);
+
+  /// Also saves the last primal-dual perturbations of the KKT linear system
+  virtual hiopAlgFilterIPMState* save_state() const;
+
 protected:
   virtual void outputIteration(int lsStatus, int lsNum, int use_soc = 0, int use_fr = 0);
 
+  /// The state of the primal-dual perturbations is part of the checkpoints
+  virtual void save_alg_state(hiopCheckpointFile& file) const;
+  virtual bool load_alg_state(hiopCheckpointFile& file);
+
+  /**
+   * Creates the KKT linear system ahead of the main loop and, when it is of the sparse XDYcYd type, lets
+   * the sparse LSQ updater factorize the augmented system of the initial duals in the pattern of the KKT,
+   * with the KKT's linear solver; the KKT is then used by run() as if it was kept from a previous run.
+   */
+  virtual void prepare_duals_lsq_init(hiopDualsLsqUpdate* updater, const hiopIterate& it_ini);
+
   /// @brief Decides and creates the KKT linear system based on user options and NLP formulation.
   virtual hiopKKTLinSys* decideAndCreateLinearSystem(hiopNlpFormulation* nlp);
 
@@ -393,6 +590,12 @@ protected:
 protected:
   hiopPDPerturbation pd_perturb_;
   hiopFactAcceptor* fact_acceptor_;
+
+  /// KKT linear system kept from the previous run() when reuse_kkt_ is true
+  hiopKKTLinSys* kkt_reused_;
+  /// transformations (fixed variables and presolve) of the NLP for which the algorithm objects are allocated
+  std::vector<index_type> transformations_key_;
+  bool reuse_kkt_;
 private:
   hiopAlgFilterIPMNewton() : hiopAlgFilterIPMBase(NULL) {};
   hiopAlgFilterIPMNewton(const hiopAlgFilterIPMNewton& ) : hiopAlgFilterIPMBase(NULL){};
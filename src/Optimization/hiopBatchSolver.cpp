@@ -0,0 +1,641 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory (LLNL).
+// LLNL-CODE-742473. All rights reserved.
+//
+// This file is part of HiOp. For details, see https://github.com/LLNL/hiop. HiOp
+// is released under the BSD 3-clause license (https://opensource.org/licenses/BSD-3-Clause).
+// Please also read ~SAdditional BSD Notice~T below.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// i. Redistributions of source code must retain the above copyright notice, this list
+// of conditions and the disclaimer below.
+// ii. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the disclaimer (as noted below) in the documentation and/or
+// other materials provided with the distribution.
+// iii. Neither the name of the LLNS/LLNL nor the names of its contributors may be used to
+// endorse or promote products derived from this software without specific prior written
+// permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+// SHALL LAWRENCE LIVERMORE NATIONAL SECURITY, LLC, THE U.S. DEPARTMENT OF ENERGY OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+// AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Additional BSD Notice
+// 1. This notice is required to be provided under our contract with the U.S. Department
+// of Energy (DOE). This work was produced at Lawrence Livermore National Laboratory under
+// Contract No. DE-AC52-07NA27344 with the DOE.
+// 2. Neither the United States Government nor Lawrence Livermore National Security, LLC
+// nor any of their employees, makes any warranty, express or implied, or assumes any
+// liability or responsibility for the accuracy, completeness, or usefulness of any
+// information, apparatus, product, or process disclosed, or represents that its use would
+// not infringe privately-owned rights.
+// 3. Also, reference herein to any specific commercial products, process, or services by
+// trade name, trademark, manufacturer or otherwise does not necessarily constitute or
+// imply its endorsement, recommendation, or favoring by the United States Government or
+// Lawrence Livermore National Security, LLC. The views and opinions of authors expressed
+// herein do not necessarily state or reflect those of the United States Government or
+// Lawrence Livermore National Security, LLC, and shall not be used for advertising or
+// product endorsement purposes.
+//
+
+/**
+ * @file hiopBatchSolver.cpp
+ *
+ */
+
+#include "hiopBatchSolver.hpp"
+#include "hiopNlpFormulation.hpp"
+#include "hiopAlgFilterIPM.hpp"
+#include "hiopOptions.hpp"
+#include "hiopLogger.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <thread>
+
+namespace hiop
+{
+
+/**
+ * Interface that forwards all the calls to an instance of the batch. The instance can be changed
+ * between solves, so that the NLP formulation built on top of the proxy can be reused.
+ */
+template<class INTERFACE>
+class hiopBatchProxy : public INTERFACE
+{
+public:
+  hiopBatchProxy(INTERFACE* instance, MPI_Comm comm)
+    : instance_(instance), comm_(comm)
+  {
+  }
+  virtual ~hiopBatchProxy()
+  {
+  }
+
+  void set_instance(INTERFACE* instance) { instance_ = instance; }
+
+  bool get_prob_sizes(size_type& n, size_type& m)
+  {
+    return instance_->get_prob_sizes(n, m);
+  }
+  bool get_vars_info(const size_type& n, double *xlow, double* xupp, hiopInterfaceBase::NonlinearityType* type)
+  {
+    return instance_->get_vars_info(n, xlow, xupp, type);
+  }
+  bool get_cons_info(const size_type& m, double* clow, double* cupp, hiopInterfaceBase::NonlinearityType* type)
+  {
+    return instance_->get_cons_info(m, clow, cupp, type);
+  }
+  bool eval_f(const size_type& n, const double* x, bool new_x, double& obj_value)
+  {
+    return instance_->eval_f(n, x, new_x, obj_value);
+  }
+  bool eval_grad_f(const size_type& n, const double* x, bool new_x, double* gradf)
+  {
+    return instance_->eval_grad_f(n, x, new_x, gradf);
+  }
+  bool eval_cons(const size_type& n,
+                 const size_type& m,
+                 const size_type& num_cons,
+                 const index_type* idx_cons,
+                 const double* x,
+                 bool new_x,
+                 double* cons)
+  {
+    return instance_->eval_cons(n, m, num_cons, idx_cons, x, new_x, cons);
+  }
+  bool eval_cons(const size_type& n, const size_type& m, const double* x, bool new_x, double* cons)
+  {
+    return instance_->eval_cons(n, m, x, new_x, cons);
+  }
+  bool get_MPI_comm(MPI_Comm& comm_out)
+  {
+    comm_out = comm_;
+    return true;
+  }
+  bool get_starting_point(const size_type&n, double* x0)
+  {
+    return instance_->get_starting_point(n, x0);
+  }
+  bool get_starting_point(const size_type& n,
+                          const size_type& m,
+                          double* x0,
+                          bool& duals_avail,
+                          double* z_bndL0, 
+                          double* z_bndU0,
+                          double* lambda0,
+                          bool& slacks_avail,
+                          double* ineq_slack)
+  {
+    return instance_->get_starting_point(n, m, x0, duals_avail, z_bndL0, z_bndU0, lambda0, slacks_avail, ineq_slack);
+  }
+  bool get_starting_point(const size_type& n,
+                          const size_type& m,
+                          double* x0,
+                          double* z_bndL0, 
+                          double* z_bndU0,
+                          double* lambda0,
+                          double* ineq_slack,
+                          double* vl0,
+                          double* vu0)
+  {
+    return instance_->get_starting_point(n, m, x0, z_bndL0, z_bndU0, lambda0, ineq_slack, vl0, vu0);
+  }
+  void solution_callback(hiopSolveStatus status,
+                         size_type n,
+                         const double* x,
+                         const double* z_L,
+                         const double* z_U,
+                         size_type m,
+                         const double* g,
+                         const double* lambda,
+                         double obj_value)
+  {
+    instance_->solution_callback(status, n, x, z_L, z_U, m, g, lambda, obj_value);
+  }
+  bool iterate_callback(int iter,
+                        double obj_value,
+                        double logbar_obj_value,
+                        int n,
+                        const double* x,
+                        const double* z_L,
+                        const double* z_U,
+                        int m_ineq,
+                        const double* s,
+                        int m,
+                        const double* g,
+                        const double* lambda,
+                        double inf_pr,
+                        double inf_du,
+                        double onenorm_pr_,
+                        double mu,
+                        double alpha_du,
+                        double alpha_pr,
+                        int ls_trials)
+  {
+    return instance_->iterate_callback(iter, obj_value, logbar_obj_value, n, x, z_L, z_U, m_ineq, s, m, g,
+                                       lambda, inf_pr, inf_du, onenorm_pr_, mu, alpha_du, alpha_pr, ls_trials);
+  }
+  bool force_update_x(const int n, double* x)
+  {
+    return instance_->force_update_x(n, x);
+  }
+protected:
+  INTERFACE* instance_;
+  MPI_Comm comm_;
+};
+
+class hiopBatchProxyMDS : public hiopBatchProxy<hiopInterfaceMDS>
+{
+public:
+  hiopBatchProxyMDS(hiopInterfaceMDS* instance, MPI_Comm comm)
+    : hiopBatchProxy<hiopInterfaceMDS>(instance, comm)
+  {
+  }
+  virtual ~hiopBatchProxyMDS()
+  {
+  }
+
+  bool get_sparse_dense_blocks_info(int& nx_sparse,
+                                    int& nx_dense,
+                                    int& nnz_sparse_Jaceq,
+                                    int& nnz_sparse_Jacineq,
+                                    int& nnz_sparse_Hess_Lagr_SS,
+                                    int& nnz_sparse_Hess_Lagr_SD)
+  {
+    return instance_->get_sparse_dense_blocks_info(nx_sparse, nx_dense, nnz_sparse_Jaceq, nnz_sparse_Jacineq,
+                                                   nnz_sparse_Hess_Lagr_SS, nnz_sparse_Hess_Lagr_SD);
+  }
+  bool eval_Jac_cons(const size_type& n,
+                     const size_type& m,
+                     const size_type& num_cons,
+                     const index_type* idx_cons,
+                     const double* x,
+                     bool new_x,
+                     const size_type& nsparse,
+                     const size_type& ndense,
+                     const size_type& nnzJacS,
+                     index_type* iJacS,
+                     index_type* jJacS,
+                     double* MJacS,
+                     double* JacD)
+  {
+    return instance_->eval_Jac_cons(n, m, num_cons, idx_cons, x, new_x, nsparse, ndense,
+                                    nnzJacS, iJacS, jJacS, MJacS, JacD);
+  }
+  bool eval_Jac_cons(const size_type& n,
+                     const size_type& m,
+                     const double* x,
+                     bool new_x,
+                     const size_type& nsparse,
+                     const size_type& ndense,
+                     const size_type& nnzJacS,
+                     index_type* iJacS,
+                     index_type* jJacS,
+                     double* MJacS,
+                     double* JacD)
+  {
+    return instance_->eval_Jac_cons(n, m, x, new_x, nsparse, ndense, nnzJacS, iJacS, jJacS, MJacS, JacD);
+  }
+  bool eval_Hess_Lagr(const size_type& n,
+                      const size_type& m,
+                      const double* x,
+                      bool new_x,
+                      const double& obj_factor,
+                      const double* lambda,
+                      bool new_lambda,
+                      const size_type& nsparse,
+                      const size_type& ndense,
+                      const size_type& nnzHSS,
+                      index_type* iHSS,
+                      index_type* jHSS,
+                      double* MHSS,
+                      double* HDD,
+                      size_type& nnzHSD,
+                      index_type* iHSD,
+                      index_type* jHSD,
+                      double* MHSD)
+  {
+    return instance_->eval_Hess_Lagr(n, m, x, new_x, obj_factor, lambda, new_lambda, nsparse, ndense,
+                                     nnzHSS, iHSS, jHSS, MHSS, HDD, nnzHSD, iHSD, jHSD, MHSD);
+  }
+};
+
+class hiopBatchProxySparse : public hiopBatchProxy<hiopInterfaceSparse>
+{
+public:
+  hiopBatchProxySparse(hiopInterfaceSparse* instance, MPI_Comm comm)
+    : hiopBatchProxy<hiopInterfaceSparse>(instance, comm)
+  {
+  }
+  virtual ~hiopBatchProxySparse()
+  {
+  }
+
+  bool get_sparse_blocks_info(size_type& nx,
+                              size_type& nnz_sparse_Jaceq,
+                              size_type& nnz_sparse_Jacineq,
+                              size_type& nnz_sparse_Hess_Lagr)
+  {
+    return instance_->get_sparse_blocks_info(nx, nnz_sparse_Jaceq, nnz_sparse_Jacineq, nnz_sparse_Hess_Lagr);
+  }
+  bool eval_Jac_cons(const size_type& n,
+                     const size_type& m,
+                     const size_type& num_cons,
+                     const index_type* idx_cons,
+                     const double* x,
+                     bool new_x,
+                     const size_type& nnzJacS,
+                     index_type* iJacS,
+                     index_type* jJacS,
+                     double* MJacS)
+  {
+    return instance_->eval_Jac_cons(n, m, num_cons, idx_cons, x, new_x, nnzJacS, iJacS, jJacS, MJacS);
+  }
+  bool eval_Jac_cons(const size_type& n,
+                     const size_type& m,
+                     const double* x,
+                     bool new_x,
+                     const size_type& nnzJacS,
+                     index_type* iJacS,
+                     index_type* jJacS,
+                     double* MJacS)
+  {
+    return instance_->eval_Jac_cons(n, m, x, new_x, nnzJacS, iJacS, jJacS, MJacS);
+  }
+  bool eval_Hess_Lagr(const size_type& n,
+                      const size_type& m,
+                      const double* x,
+                      bool new_x,
+                      const double& obj_factor,
+                      const double* lambda,
+                      bool new_lambda,
+                      const size_type& nnzHSS,
+                      index_type* iHSS,
+                      index_type* jHSS,
+                      double* MHSS)
+  {
+    return instance_->eval_Hess_Lagr(n, m, x, new_x, obj_factor, lambda, new_lambda, nnzHSS, iHSS, jHSS, MHSS);
+  }
+};
+
+/**
+ * A worker owns a proxy interface, the NLP formulation built on top of it and the solver. All these
+ * objects are reused for the instances the worker solves.
+ */
+class hiopBatchSolverWorker
+{
+public:
+  hiopBatchSolverWorker(hiopBatchSolver& batch, index_type first_instance, MPI_Comm comm)
+    : batch_(batch),
+      proxy_mds_(nullptr),
+      proxy_sparse_(nullptr)
+  {
+    if(batch_.interface_type_ == hiopBatchSolver::MDS) {
+      auto* instance = static_cast<hiopInterfaceMDS*>(batch_.instances_[first_instance]);
+      proxy_mds_ = new hiopBatchProxyMDS(instance, comm);
+      nlp_ = new hiopNlpMDS(*proxy_mds_);
+    } else {
+      auto* instance = static_cast<hiopInterfaceSparse*>(batch_.instances_[first_instance]);
+      proxy_sparse_ = new hiopBatchProxySparse(instance, comm);
+      nlp_ = new hiopNlpSparse(*proxy_sparse_);
+    }
+    nlp_->options->copy_from(*batch_.options);
+    solver_ = new hiopAlgFilterIPMNewton(nlp_);
+    solver_->set_reuse_kkt(true);
+  }
+
+  ~hiopBatchSolverWorker()
+  {
+    delete solver_;
+    delete nlp_;
+    delete proxy_sparse_;
+    delete proxy_mds_;
+  }
+
+  void solve(index_type i)
+  {
+    if(proxy_mds_) {
+      proxy_mds_->set_instance(static_cast<hiopInterfaceMDS*>(batch_.instances_[i]));
+    } else {
+      proxy_sparse_->set_instance(static_cast<hiopInterfaceSparse*>(batch_.instances_[i]));
+    }
+    //only the data of the instance is read again; the NLP and solver objects are kept
+    nlp_->reload_problem_data();
+
+    batch_.status_[i] = solver_->run();
+    batch_.obj_value_[i] = solver_->getObjective();
+    batch_.num_iter_[i] = solver_->getNumIterations();
+  }
+
+  hiopLogger* log() { return nlp_->log; }
+private:
+  hiopBatchSolver& batch_;
+  hiopBatchProxyMDS* proxy_mds_;
+  hiopBatchProxySparse* proxy_sparse_;
+  hiopNlpFormulation* nlp_;
+  hiopAlgFilterIPMNewton* solver_;
+};
+
+hiopBatchSolver::hiopBatchSolver(const std::vector<hiopInterfaceMDS*>& instances, const char* options_file)
+  : interface_type_(MDS),
+    instances_(instances.begin(), instances.end()),
+    num_threads_(1),
+    status_(instances.size(), NlpSolve_SolveNotCalled),
+    obj_value_(instances.size(), 0.),
+    num_iter_(instances.size(), 0)
+{
+  options = new hiopOptionsNLP(options_file);
+}
+
+hiopBatchSolver::hiopBatchSolver(const std::vector<hiopInterfaceSparse*>& instances, const char* options_file)
+  : interface_type_(Sparse),
+    instances_(instances.begin(), instances.end()),
+    num_threads_(1),
+    status_(instances.size(), NlpSolve_SolveNotCalled),
+    obj_value_(instances.size(), 0.),
+    num_iter_(instances.size(), 0)
+{
+  options = new hiopOptionsNLP(options_file);
+}
+
+hiopBatchSolver::~hiopBatchSolver()
+{
+  delete options;
+}
+
+void hiopBatchSolver::set_num_threads(int num_threads)
+{
+  assert(num_threads>0);
+  num_threads_ = std::max(1, num_threads);
+}
+
+bool hiopBatchSolver::compute_signature(index_type i, std::vector<index_type>& signature)
+{
+  hiopInterfaceBase* instance = instances_[i];
+  signature.clear();
+
+  size_type n, m;
+  if(!instance->get_prob_sizes(n, m)) {
+    return false;
+  }
+  signature.push_back(n);
+  signature.push_back(m);
+
+  std::vector<double> xl(n), xu(n);
+  std::vector<hiopInterfaceBase::NonlinearityType> vars_type(n);
+  if(!instance->get_vars_info(n, xl.data(), xu.data(), vars_type.data())) {
+    return false;
+  }
+  std::vector<double> clow(m), cupp(m);
+  std::vector<hiopInterfaceBase::NonlinearityType> cons_type(m);
+  if(!instance->get_cons_info(m, clow.data(), cupp.data(), cons_type.data())) {
+    return false;
+  }
+  //the split of the constraints into equalities and inequalities determines the sizes of the Jacobians
+  for(index_type k=0; k<m; k++) {
+    signature.push_back(clow[k]==cupp[k] ? 1 : 0);
+  }
+
+  //the sparsity patterns are used by the symbolic analysis of the KKT linear system and by the matrices
+  //of the solver, which are reused across the instances; they are obtained at a point within the bounds
+  //and then compared
+  std::vector<double> x(n);
+  for(index_type k=0; k<n; k++) {
+    x[k] = std::max(xl[k], std::min(xu[k], 0.));
+  }
+  std::vector<double> lambda(m, 0.);
+
+  if(interface_type_ == MDS) {
+    auto* mds = static_cast<hiopInterfaceMDS*>(instance);
+    int nx_sparse, nx_dense, nnz_Jaceq, nnz_Jacineq, nnz_HSS, nnz_HSD;
+    if(!mds->get_sparse_dense_blocks_info(nx_sparse, nx_dense, nnz_Jaceq, nnz_Jacineq, nnz_HSS, nnz_HSD)) {
+      return false;
+    }
+    signature.insert(signature.end(), {nx_sparse, nx_dense, nnz_Jaceq, nnz_Jacineq, nnz_HSS, nnz_HSD});
+
+    //the sparse blocks of the Jacobians are obtained as hiopNlpMDS does, i.e., for the equalities and
+    //for the inequalities separately, or with the one-call Jacobian when the former is not implemented
+    std::vector<index_type> idx_eq, idx_ineq;
+    for(index_type k=0; k<m; k++) {
+      if(clow[k]==cupp[k]) {
+        idx_eq.push_back(k);
+      } else {
+        idx_ineq.push_back(k);
+      }
+    }
+    const size_type nnz_max = std::max(nnz_Jaceq+nnz_Jacineq, nnz_HSS);
+    std::vector<index_type> irow(nnz_max), jcol(nnz_max);
+    std::vector<double> vals(nnz_max);
+    std::vector<double> dense(std::max(m, nx_dense)*static_cast<size_t>(nx_dense));
+    const size_type num_cons_eq = idx_eq.size();
+    const size_type num_cons_ineq = idx_ineq.size();
+    bool bret = (0==num_cons_eq ||
+                 mds->eval_Jac_cons(n, m, num_cons_eq, idx_eq.data(), x.data(), true,
+                                    nx_sparse, nx_dense, nnz_Jaceq, irow.data(), jcol.data(), vals.data(),
+                                    dense.data())) &&
+                (0==num_cons_ineq ||
+                 mds->eval_Jac_cons(n, m, num_cons_ineq, idx_ineq.data(), x.data(), true,
+                                    nx_sparse, nx_dense, nnz_Jacineq,
+                                    irow.data()+nnz_Jaceq, jcol.data()+nnz_Jaceq, vals.data()+nnz_Jaceq,
+                                    dense.data()));
+    if(!bret) {
+      if(!mds->eval_Jac_cons(n, m, x.data(), true, nx_sparse, nx_dense, nnz_Jaceq+nnz_Jacineq,
+                             irow.data(), jcol.data(), vals.data(), dense.data())) {
+        return false;
+      }
+    }
+    signature.insert(signature.end(), irow.begin(), irow.begin()+nnz_Jaceq+nnz_Jacineq);
+    signature.insert(signature.end(), jcol.begin(), jcol.begin()+nnz_Jaceq+nnz_Jacineq);
+
+    size_type nnz_HSD_eval = 0;
+    if(!mds->eval_Hess_Lagr(n, m, x.data(), false, 1.0, lambda.data(), true,
+                            nx_sparse, nx_dense, nnz_HSS, irow.data(), jcol.data(), vals.data(),
+                            dense.data(), nnz_HSD_eval, nullptr, nullptr, nullptr)) {
+      return false;
+    }
+    signature.insert(signature.end(), irow.begin(), irow.begin()+nnz_HSS);
+    signature.insert(signature.end(), jcol.begin(), jcol.begin()+nnz_HSS);
+    return true;
+  }
+
+  auto* sp = static_cast<hiopInterfaceSparse*>(instance);
+  size_type nx, nnz_Jaceq, nnz_Jacineq, nnz_Hess;
+  if(!sp->get_sparse_blocks_info(nx, nnz_Jaceq, nnz_Jacineq, nnz_Hess)) {
+    return false;
+  }
+  signature.insert(signature.end(), {nx, nnz_Jaceq, nnz_Jacineq, nnz_Hess});
+
+  const size_type nnz_Jac = nnz_Jaceq + nnz_Jacineq;
+  std::vector<index_type> irow(std::max(nnz_Jac, nnz_Hess)), jcol(irow.size());
+  std::vector<double> vals(irow.size());
+  if(!sp->eval_Jac_cons(n, m, x.data(), true, nnz_Jac, irow.data(), jcol.data(), vals.data())) {
+    std::vector<index_type> idx_cons(m);
+    for(index_type k=0; k<m; k++) {
+      idx_cons[k] = k;
+    }
+    if(!sp->eval_Jac_cons(n, m, m, idx_cons.data(), x.data(), true,
+                          nnz_Jac, irow.data(), jcol.data(), vals.data())) {
+      return false;
+    }
+  }
+  signature.insert(signature.end(), irow.begin(), irow.begin()+nnz_Jac);
+  signature.insert(signature.end(), jcol.begin(), jcol.begin()+nnz_Jac);
+
+  if(!sp->eval_Hess_Lagr(n, m, x.data(), false, 1.0, lambda.data(), true,
+                         nnz_Hess, irow.data(), jcol.data(), vals.data())) {
+    return false;
+  }
+  signature.insert(signature.end(), irow.begin(), irow.begin()+nnz_Hess);
+  signature.insert(signature.end(), jcol.begin(), jcol.begin()+nnz_Hess);
+  return true;
+}
+
+hiopSolveStatus hiopBatchSolver::run()
+{
+  const size_type num_inst = num_instances();
+  std::vector<index_type> to_solve;
+  std::vector<index_type> signature_ref, signature;
+  for(index_type i=0; i<num_inst; i++) {
+    if(!compute_signature(i, signature)) {
+      status_[i] = Error_In_User_Function;
+      continue;
+    }
+    if(to_solve.empty()) {
+      signature_ref.swap(signature);
+    } else if(signature != signature_ref) {
+      status_[i] = Invalid_Problem_Definition;
+      continue;
+    }
+    to_solve.push_back(i);
+  }
+
+  if(!to_solve.empty()) {
+    solve_instances(to_solve, std::min(num_threads_, static_cast<int>(to_solve.size())));
+  }
+
+  for(index_type i=0; i<num_inst; i++) {
+    if(status_[i]!=Solve_Success && status_[i]!=Solve_Success_RelTol && status_[i]!=Solve_Acceptable_Level) {
+      return status_[i];
+    }
+  }
+  return Solve_Success;
+}
+
+void hiopBatchSolver::solve_instances(const std::vector<index_type>& to_solve, int num_workers)
+{
+  assert(num_workers>=1);
+  bool num_workers_reduced = false;
+#ifdef HIOP_USE_MPI
+  int ierr, initialized;
+  ierr = MPI_Initialized(&initialized); assert(MPI_SUCCESS==ierr);
+  if(!initialized) {
+    int provided;
+    ierr = MPI_Init_thread(NULL, NULL, MPI_THREAD_MULTIPLE, &provided); assert(MPI_SUCCESS==ierr);
+  }
+  if(num_workers>1) {
+    int thread_level;
+    ierr = MPI_Query_thread(&thread_level); assert(MPI_SUCCESS==ierr);
+    if(thread_level<MPI_THREAD_MULTIPLE) {
+      num_workers = 1;
+      num_workers_reduced = true;
+    }
+  }
+  std::vector<MPI_Comm> comms(num_workers);
+  for(auto& comm : comms) {
+    ierr = MPI_Comm_dup(MPI_COMM_SELF, &comm); assert(MPI_SUCCESS==ierr);
+  }
+#else
+  std::vector<MPI_Comm> comms(num_workers, MPI_COMM_SELF);
+#endif
+
+  //the workers are created sequentially, each starting with the first instance to be solved
+  std::vector<hiopBatchSolverWorker*> workers(num_workers);
+  for(int w=0; w<num_workers; w++) {
+    workers[w] = new hiopBatchSolverWorker(*this, to_solve[0], comms[w]);
+  }
+  if(num_workers_reduced) {
+    workers[0]->log()->printf(hovWarning,
+                              "MPI does not provide MPI_THREAD_MULTIPLE; the batch is solved by one thread.\n");
+  }
+
+  //the instances are dispatched dynamically since their solve times can differ significantly
+  std::atomic<size_type> next(0);
+  auto work = [&](hiopBatchSolverWorker* worker) {
+    for(size_type k=next++; k<static_cast<size_type>(to_solve.size()); k=next++) {
+      worker->solve(to_solve[k]);
+    }
+  };
+
+  if(1==num_workers) {
+    work(workers[0]);
+  } else {
+    std::vector<std::thread> threads;
+    for(int w=0; w<num_workers; w++) {
+      threads.emplace_back(work, workers[w]);
+    }
+    for(auto& thread : threads) {
+      thread.join();
+    }
+  }
+
+  for(auto* worker : workers) {
+    delete worker;
+  }
+#ifdef HIOP_USE_MPI
+  for(auto& comm : comms) {
+    ierr = MPI_Comm_free(&comm); assert(MPI_SUCCESS==ierr);
+  }
+#endif
+}
+
+} // end of namespace
@@ -0,0 +1,152 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory (LLNL).
+// LLNL-CODE-742473. All rights reserved.
+//
+// This file is part of HiOp. For details, see https://github.com/LLNL/hiop. HiOp
+// is released under the BSD 3-clause license (https://opensource.org/licenses/BSD-3-Clause).
+// Please also read ~SAdditional BSD Notice~T below.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+// i. Redistributions of source code must retain the above copyright notice, this list
+// of conditions and the disclaimer below.
+// ii. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the disclaimer (as noted below) in the documentation and/or
+// other materials provided with the distribution.
+// iii. Neither the name of the LLNS/LLNL nor the names of its contributors may be used to
+// endorse or promote products derived from this software without specific prior written
+// permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+// SHALL LAWRENCE LIVERMORE NATIONAL SECURITY, LLC, THE U.S. DEPARTMENT OF ENERGY OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+// AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Additional BSD Notice
+// 1. This notice is required to be provided under our contract with the U.S. Department
+// of Energy (DOE). This work was produced at Lawrence Livermore National Laboratory under
+// Contract No. DE-AC52-07NA27344 with the DOE.
+// 2. Neither the United States Government nor Lawrence Livermore National Security, LLC
+// nor any of their employees, makes any warranty, express or implied, or assumes any
+// liability or responsibility for the accuracy, completeness, or usefulness of any
+// information, apparatus, product, or process disclosed, or represents that its use would
+// not infringe privately-owned rights.
+// 3. Also, reference herein to any specific commercial products, process, or services by
+// trade name, trademark, manufacturer or otherwise does not necessarily constitute or
+// imply its endorsement, recommendation, or favoring by the United States Government or
+// Lawrence Livermore National Security, LLC. The views and opinions of authors expressed
+// herein do not necessarily state or reflect those of the United States Government or
+// Lawrence Livermore National Security, LLC, and shall not be used for advertising or
+// product endorsement purposes.
+//
+
+/**
+ * @file hiopBatchSolver.hpp
+ *
+ * Solver for batches of NLPs that share the same structure.
+ *
+ */
+
+#ifndef HIOP_BATCH_SOLVER
+#define HIOP_BATCH_SOLVER
+
+#include "hiopInterface.hpp"
+
+#include <vector>
+
+namespace hiop
+{
+
+class hiopOptionsNLP;
+class hiopBatchSolverWorker;
+
+/**
+ * Solves a batch of instances of an NLP that differ only in data (bounds, coefficients, etc.)
+ * and have the same structure: sizes, split of the constraints into equalities and inequalities,
+ * and, for the sparse interface, sparsity patterns of the derivatives.
+ *
+ * The instances are solved by a number of workers, each of which owns one NLP formulation and one
+ * Newton filter IPM solver that are reused for all the instances the worker solves. Hence the 
+ * structure-dependent setup (allocation of the NLP and algorithm objects, option processing, KKT 
+ * linear system, and the symbolic analysis of the sparse linear solver) is done once per worker 
+ * and not once per instance. Only the problem data (bounds and constraints types) is read again
+ * for each instance. 
+ *
+ * The workers can run concurrently in threads (see set_num_threads). Each worker uses its own 
+ * duplicate of MPI_COMM_SELF, hence the instances are expected to be serial (not distributed).
+ * Multithreaded runs require MPI_THREAD_MULTIPLE; the batch falls back to one worker otherwise.
+ *
+ * The instances are checked against the structure of the first one before any solve; those that 
+ * do not match are not solved and have the status Invalid_Problem_Definition. The solution of each
+ * instance is passed to the instance's solution_callback, as for regular solves.
+ */
+class hiopBatchSolver
+{
+public:
+  /** 
+   * Creates a batch solver for instances provided via the mixed dense-sparse interface. 
+   * The options are loaded from @p options_file (or the default options file).
+   */
+  hiopBatchSolver(const std::vector<hiopInterfaceMDS*>& instances, const char* options_file = nullptr);
+
+  /** Creates a batch solver for instances provided via the sparse interface. */
+  hiopBatchSolver(const std::vector<hiopInterfaceSparse*>& instances, const char* options_file = nullptr);
+
+  virtual ~hiopBatchSolver();
+
+  /** Number of threads that solve instances concurrently (default 1). */
+  void set_num_threads(int num_threads);
+
+  /**
+   * Solves all the instances. Returns Solve_Success if all the instances were solved successfully,
+   * otherwise the status of the first instance that was not.
+   */
+  hiopSolveStatus run();
+
+  inline size_type num_instances() const { return static_cast<size_type>(instances_.size()); }
+  inline hiopSolveStatus get_status(index_type i) const { return status_[i]; }
+  inline double get_objective(index_type i) const { return obj_value_[i]; }
+  inline int get_num_iterations(index_type i) const { return num_iter_[i]; }
+
+  /** 
+   * Options used by the solves of all the instances. They can be changed by the user before 
+   * calling run().
+   */
+  hiopOptionsNLP* options;
+
+private:
+  friend class hiopBatchSolverWorker;
+
+  /**
+   * Computes the structure signature of the @p i-th instance: sizes, number of nonzeros, split of
+   * the constraints, and sparsity patterns of the (sparse blocks of the) derivatives. The variables
+   * fixed and the constraints removed by the presolve can differ among the instances; the solver of a
+   * worker reallocates its algorithm objects and its KKT linear system when they change.
+   */
+  bool compute_signature(index_type i, std::vector<index_type>& signature);
+
+  /// Solves the instances whose indexes are in @p to_solve, using @p num_workers workers
+  void solve_instances(const std::vector<index_type>& to_solve, int num_workers);
+
+private:
+  enum InterfaceType { MDS=0, Sparse };
+  InterfaceType interface_type_;
+  std::vector<hiopInterfaceBase*> instances_;
+  int num_threads_;
+
+  std::vector<hiopSolveStatus> status_;
+  std::vector<double> obj_value_;
+  std::vector<int> num_iter_;
+private:
+  hiopBatchSolver(const hiopBatchSolver&) = delete;
+  hiopBatchSolver& operator=(const hiopBatchSolver&) = delete;
+};
+
+} // end of namespace
+#endif
@@ -55,6 +55,7 @@
  
 #include "hiopDualsUpdater.hpp"
 #include "hiopLinAlgFactory.hpp"
+#include "hiopKKTLinSysSparse.hpp"
 
 #include "hiopLinSolverIndefDenseLapack.hpp"
 #include "hiopLinSolverIndefDenseMagma.hpp"
@@ -147,25 +148,8 @@ bool hiopDualsLsqUpdate::go(const hiopIterate& iter,
 }
 
 hiopDualsLsqUpdateLinsysRedDense::hiopDualsLsqUpdateLinsysRedDense(hiopNlpFormulation* nlp)
-  : hiopDualsLsqUpdate(nlp),
-    mexme_(nullptr),
-    mexmi_(nullptr),
-    mixmi_(nullptr),
-    mxm_(nullptr)
+  : hiopDualsLsqUpdate(nlp)
 {
-  mexme_ = LinearAlgebraFactory::create_matrix_dense(nlp_->options->GetString("mem_space"),
-                                                     nlp_->m_eq(),
-                                                     nlp_->m_eq());
-  mexmi_ = LinearAlgebraFactory::create_matrix_dense(nlp_->options->GetString("mem_space"),
-                                                     nlp_->m_eq(),
-                                                     nlp_->m_ineq());
-  mixmi_ = LinearAlgebraFactory::create_matrix_dense(nlp_->options->GetString("mem_space"),
-                                                     nlp_->m_ineq(),
-                                                     nlp_->m_ineq());
-  mxm_ = LinearAlgebraFactory::create_matrix_dense(nlp_->options->GetString("mem_space"),
-                                                   nlp_->m(),
-                                                   nlp_->m());
-  
   rhs_ = LinearAlgebraFactory::create_vector(nlp_->options->GetString("mem_space"),
                                              nlp_->m());
   
@@ -180,10 +164,6 @@ hiopDualsLsqUpdateLinsysRedDense::hiopDualsLsqUpdateLinsysRedDense(hiopNlpFormul
 
 hiopDualsLsqUpdateLinsysRedDense::~hiopDualsLsqUpdateLinsysRedDense()
 {
-  delete mexme_;
-  delete mexmi_;
-  delete mixmi_;
-  delete mxm_;
 #ifdef HIOP_DEEPCHECKS
   delete M_copy_;
   delete rhs_copy_;
@@ -240,20 +220,11 @@ bool hiopDualsLsqUpdateLinsysRedDense::do_lsq_update(hiopIterate& iter,
 {
   hiopMatrixDense* M = get_lsq_sysmatrix();
   assert(M);
-  hiopMatrixDense* mexme = dynamic_cast<hiopMatrixDense*>(mexme_);
-  hiopMatrixDense* mexmi = dynamic_cast<hiopMatrixDense*>(mexmi_);
-  hiopMatrixDense* mixmi = dynamic_cast<hiopMatrixDense*>(mixmi_);
 
-  //compute terms in M: Jc * Jc^T, J_c * J_d^T, and J_d * J_d^T
-  //! streamline the communication (use mxm as a global buffer for the MPI_Allreduce)
-  jac_c.timesMatTrans(0.0, *mexme, 1.0, jac_c);
-  jac_c.timesMatTrans(0.0, *mexmi, 1.0, jac_d);
-  jac_d.timesMatTrans(0.0, *mixmi, 1.0, jac_d);
-  mixmi->addDiagonal(1.0);
-
-  M->copyBlockFromMatrix(0,0,*mexme);
-  M->copyBlockFromMatrix(0, nlp_->m_eq(), *mexmi);
-  M->copyBlockFromMatrix(nlp_->m_eq(),nlp_->m_eq(), *mixmi);
+  //compute the upper triangle of M = [Jc; Jd] * [Jc; Jd]^T, i.e., of the blocks Jc * Jc^T, J_c * J_d^T,
+  //and J_d * J_d^T, directly in M and with a single reduction in the distributed case
+  jac_c.stackedGramToSymDenseMatrixUpperTriangle(1.0, jac_d, *M);
+  M->addSubDiagonal(nlp_->m_eq(), nlp_->m_ineq(), 1.0);
 
 #ifdef HIOP_DEEPCHECKS
   if(M_copy_ == nullptr) {
@@ -263,6 +234,8 @@ bool hiopDualsLsqUpdateLinsysRedDense::do_lsq_update(hiopIterate& iter,
   hiopMatrixDense* M_copy = dynamic_cast<hiopMatrixDense*>(M_copy_);
   assert(M_copy);
   M_copy->copyFrom(*get_lsq_sysmatrix());
+  M_copy->overwriteLowerTriangleWithUpper();
+  //check the fused product against J_d * J_c^T computed separately
   jac_d.timesMatTrans(0.0, *mixme, 1.0, jac_c);
   M_copy->copyBlockFromMatrix(nlp_->m_eq(), 0, *mixme);
   M_copy->assertSymmetry(1e-12);
@@ -330,7 +303,9 @@ bool hiopDualsLsqUpdateLinsysRedDense::do_lsq_update(hiopIterate& iter,
 
 hiopDualsLsqUpdateLinsysAugSparse::hiopDualsLsqUpdateLinsysAugSparse(hiopNlpFormulation* nlp)
   : hiopDualsLsqUpdate(nlp),
-    lin_sys_(nullptr)
+    lin_sys_(nullptr),
+    kkt_ini_duals_(nullptr),
+    hess_ini_duals_(nullptr)
 {
 #ifndef HIOP_SPARSE
   assert(0 && "should not reach here!");
@@ -510,65 +485,84 @@ bool hiopDualsLsqUpdateLinsysAugSparse::do_lsq_update(hiopIterate& iter,
 
   int nnz = nx + nd + Jac_cSp.numberOfNonzeros() + Jac_dSp.numberOfNonzeros() + nd + (nx + nd + neq + nineq);
 
-  t.reset();
-  t.start();
-
-  assert(lin_sys_ && "Linear system was not instantiated.");
-  if(nullptr == lin_sys_) {
-    return false;
-  }
-  hiopLinSolverSymSparse* linSys = dynamic_cast<hiopLinSolverSymSparse*> (lin_sys_);
-  assert(linSys);
+  hiopLinSolverSymSparse* linSys = nullptr;
+  if(nullptr != kkt_ini_duals_) {
+    // initial duals: the augmented system is factorized in the pattern of the KKT linear system, by
+    // the linear solver of the KKT, which does the symbolic analysis once for both systems
+    t.reset();
+    t.start();
+#ifdef HIOP_SPARSE
+    linSys = kkt_ini_duals_->factorize_lsq_duals_matrix(jac_c, jac_d, *hess_ini_duals_);
+#endif
+    t.stop();
+    ss_log << "   update and factor linsys (KKT pattern) " << t.getElapsedTime() << " sec\n";
 
-  t.stop();
-  ss_log << std::fixed << std::setprecision(4) << t.getElapsedTime() << " sec\n";
+    kkt_ini_duals_ = nullptr;
+    hess_ini_duals_ = nullptr;
+    if(nullptr == linSys) {
+      return false;
+    }
+  } else {
+    t.reset();
+    t.start();
 
-  t.reset();
-  t.start();
-  hiopMatrixSparse& Msys = *(linSys->sysMatrix());
-  // update linSys system matrix
-  {
-    Msys.setToZero();
-
-    // copy Jac and Hes to the full iterate matrix
-    size_type dest_nnz_st{0};
-    Msys.copyDiagMatrixToSubblock(1., 0, 0, dest_nnz_st, nx+nd);
-    dest_nnz_st += nx+nd;
-    Msys.copyRowsBlockFrom(Jac_cSp, 0,   neq,    nx+nd,      dest_nnz_st);
-    dest_nnz_st += Jac_cSp.numberOfNonzeros();
-    Msys.copyRowsBlockFrom(Jac_dSp, 0,   nineq,  nx+nd+neq,  dest_nnz_st);
-    dest_nnz_st += Jac_dSp.numberOfNonzeros();
-
-    // minus identity matrix for slack variables
-    Msys.copyDiagMatrixToSubblock(-1., nx+nd+neq, nx, dest_nnz_st, nineq);
-    dest_nnz_st += nineq;
-
-    //add 0.0 to diagonal block linSys starting at (0,0)
-    Msys.setSubDiagonalTo(0, nx+nd+neq+nineq, 0.0, dest_nnz_st);
-    dest_nnz_st += nx+nd+neq+nineq;
+    assert(lin_sys_ && "Linear system was not instantiated.");
+    if(nullptr == lin_sys_) {
+      return false;
+    }
+    linSys = dynamic_cast<hiopLinSolverSymSparse*> (lin_sys_);
+    assert(linSys);
+
+    t.stop();
+    ss_log << std::fixed << std::setprecision(4) << t.getElapsedTime() << " sec\n";
+
+    t.reset();
+    t.start();
+    hiopMatrixSparse& Msys = *(linSys->sysMatrix());
+    // update linSys system matrix
+    {
+      Msys.setToZero();
+
+      // copy Jac and Hes to the full iterate matrix
+      size_type dest_nnz_st{0};
+      Msys.copyDiagMatrixToSubblock(1., 0, 0, dest_nnz_st, nx+nd);
+      dest_nnz_st += nx+nd;
+      Msys.copyRowsBlockFrom(Jac_cSp, 0,   neq,    nx+nd,      dest_nnz_st);
+      dest_nnz_st += Jac_cSp.numberOfNonzeros();
+      Msys.copyRowsBlockFrom(Jac_dSp, 0,   nineq,  nx+nd+neq,  dest_nnz_st);
+      dest_nnz_st += Jac_dSp.numberOfNonzeros();
+
+      // minus identity matrix for slack variables
+      Msys.copyDiagMatrixToSubblock(-1., nx+nd+neq, nx, dest_nnz_st, nineq);
+      dest_nnz_st += nineq;
+
+      //add 0.0 to diagonal block linSys starting at (0,0)
+      Msys.setSubDiagonalTo(0, nx+nd+neq+nineq, 0.0, dest_nnz_st);
+      dest_nnz_st += nx+nd+neq+nineq;
           
-    /* we've just done
-    *
-    * [    I    0     Jc^T  Jd^T  ] [ dx]   [ rx_tilde ]
-    * [    0    I     0     -I    ] [ dd]   [ rd_tilde ]
-    * [    Jc   0     0     0     ] [dyc] = [   ryc    ]
-    * [    Jd   -I    0     0     ] [dyd]   [   ryd    ]
-    */
-    nlp_->log->write("LSQ Dual Updater --- KKT_SPARSE_XDYcYd linsys:", Msys, hovMatrices);
-  }
-  t.stop();
-  ss_log << "   update linsys " << t.getElapsedTime() << " sec\n";
-
-  t.reset();
-  t.start();
-  int ret_val = linSys->matrixChanged();
-  t.stop();
-  ss_log << "   factor linsys " << t.getElapsedTime() << " sec\n";
+      /* we've just done
+      *
+      * [    I    0     Jc^T  Jd^T  ] [ dx]   [ rx_tilde ]
+      * [    0    I     0     -I    ] [ dd]   [ rd_tilde ]
+      * [    Jc   0     0     0     ] [dyc] = [   ryc    ]
+      * [    Jd   -I    0     0     ] [dyd]   [   ryd    ]
+      */
+      nlp_->log->write("LSQ Dual Updater --- KKT_SPARSE_XDYcYd linsys:", Msys, hovMatrices);
+    }
+    t.stop();
+    ss_log << "   update linsys " << t.getElapsedTime() << " sec\n";
+
+    t.reset();
+    t.start();
+    int ret_val = linSys->matrixChanged();
+    t.stop();
+    ss_log << "   factor linsys " << t.getElapsedTime() << " sec\n";
   
-  if(ret_val<0) {
-    nlp_->log->printf(hovError, "dual lsq update: error %d in the factorization.\n", ret_val);
-    return false;
-  } 
+    if(ret_val<0) {
+      nlp_->log->printf(hovError, "dual lsq update: error %d in the factorization.\n", ret_val);
+      return false;
+    } 
+  }
 
   t.reset();
   t.start();
@@ -592,7 +586,7 @@ bool hiopDualsLsqUpdateLinsysAugSparse::do_lsq_update(hiopIterate& iter,
   rhs_->copyFromStarting(nx+nd+neq, *rhsd_);
 
   //solve for this rhs_
-  bool linsol_ok = lin_sys_->solve(*rhs_);
+  bool linsol_ok = linSys->solve(*rhs_);
 
   if(!linsol_ok) {
     nlp_->log->printf(hovWarning, "dual lsq update: error in the solution process (sparse).\n");
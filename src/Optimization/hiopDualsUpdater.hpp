@@ -65,6 +65,8 @@
 namespace hiop
 {
 
+class hiopKKTLinSysCompressedSparseXDYcYd;
+
 class hiopDualsUpdater
 {
 public:
@@ -277,7 +279,6 @@ protected:
    */
   virtual bool solve_with_factors(hiopVector& r) = 0;
 private:
-  hiopMatrix *mexme_, *mexmi_, *mixmi_, *mxm_;
 #ifdef HIOP_DEEPCHECKS
   hiopMatrix* M_copy_;
   hiopVector *rhs_copy_;
@@ -359,6 +360,21 @@ class hiopDualsLsqUpdateLinsysAugSparse : public hiopDualsLsqUpdate
 public:
   hiopDualsLsqUpdateLinsysAugSparse(hiopNlpFormulation* nlp);
   virtual ~hiopDualsLsqUpdateLinsysAugSparse();
+
+  /**
+   * Instructs the next computation of the initial duals to build and factorize the augmented system
+   * in the pattern of the KKT linear system 'kkt', with the (structure of the) Hessian 'hess' as a
+   * zero block, instead of using an own linear solver. The symbolic analysis of the linear solver of
+   * the KKT is then done only once, by this computation, and is reused by the IPM iterations.
+   *
+   * Applies to one computation of the initial duals only; the LSQ-based updates of the duals during
+   * the iterations use the own linear solver since they would otherwise overwrite the factors of the KKT.
+   */
+  void set_kkt_for_ini_duals(hiopKKTLinSysCompressedSparseXDYcYd* kkt, const hiopMatrix* hess)
+  {
+    kkt_ini_duals_ = kkt;
+    hess_ini_duals_ = hess;
+  }
 private:
   virtual bool do_lsq_update(hiopIterate& iter,
                              const hiopVector& grad_f,
@@ -371,6 +387,10 @@ private:
                                        const hiopMatrix& jac_c,
                                        const hiopMatrix& jac_d)
   {
+    if(nullptr != kkt_ini_duals_) {
+      //the linear solver of the KKT will be used
+      return true;
+    }
     return instantiate_linear_solver("duals_init_linear_solver_sparse", iter, grad_f, jac_c, jac_d);
   }
   
@@ -391,6 +411,11 @@ private:
                                  const hiopMatrix& jac_d);
 private:
   hiopLinSolver* lin_sys_;
+
+  /// KKT linear system (not owned) used for the next computation of the initial duals, if not null
+  hiopKKTLinSysCompressedSparseXDYcYd* kkt_ini_duals_;
+  /// Hessian (not owned) providing the structure of the Hessian block of the KKT linear system above
+  const hiopMatrix* hess_ini_duals_;
 };
 
   
@@ -86,12 +86,7 @@ hiopFRProbSparse::hiopFRProbSparse(hiopAlgFilterIPMBase& solver_base)
   ni_st_ = pi_st_ + m_ineq_;
 
   x_ref_ = solver_base.get_it_curr()->get_x();
-
-  // build vector VR
-  DR_ = x_ref_->new_copy();
-  DR_->component_abs();
-  DR_->invert();
-  DR_->component_min(1.0);
+  DR_ = x_ref_->alloc_clone();
 
   wrk_x_ = x_ref_->alloc_clone();
   wrk_c_ = LinearAlgebraFactory::create_vector(nlp_base_->options->GetString("mem_space"), m_eq_);
@@ -122,10 +117,23 @@ hiopFRProbSparse::hiopFRProbSparse(hiopAlgFilterIPMBase& solver_base)
                                                             n_,
                                                             nnz_Hess_Lag_);
   
+  update_reference_point();
+}
+
+void hiopFRProbSparse::update_reference_point()
+{
+  x_ref_ = solver_base_.get_it_curr()->get_x();
+
+  // build vector VR
+  DR_->copyFrom(*x_ref_);
+  DR_->component_abs();
+  DR_->invert();
+  DR_->component_min(1.0);
+
   // set mu0 to be the maximun of the current barrier parameter mu and norm_inf(|c|)*/
   theta_ref_ = solver_base_.get_resid()->get_theta(); //at current point, i.e., reference point
   nrmInf_feas_ref_ = solver_base_.get_resid()->get_nrmInf_bar_feasib();
-  mu_ = solver_base.get_mu();
+  mu_ = solver_base_.get_mu();
   mu_ = std::max(mu_, nrmInf_feas_ref_);
 
   zeta_ = std::sqrt(mu_);
@@ -702,12 +710,7 @@ hiopFRProbMDS::hiopFRProbMDS(hiopAlgFilterIPMBase& solver_base)
   x_de_st_ = ni_st_ + m_ineq_;
 
   x_ref_ = solver_base.get_it_curr()->get_x();
-
-  // build vector VR
-  DR_ = x_ref_->new_copy();
-  DR_->component_abs();
-  DR_->invert();
-  DR_->component_min(1.0);
+  DR_ = x_ref_->alloc_clone();
 
   wrk_x_ = x_ref_->alloc_clone();
   wrk_c_ = LinearAlgebraFactory::create_vector(nlp_base_->options->GetString("mem_space"), m_eq_);
@@ -737,10 +740,23 @@ hiopFRProbMDS::hiopFRProbMDS(hiopAlgFilterIPMBase& solver_base)
   Jac_cd_ = new hiopMatrixMDS(m_, n_sp_, n_de_, nnz_sp_Jac_c_+nnz_sp_Jac_d_, nlp_base_->options->GetString("mem_space"));
   Hess_cd_ = new hiopMatrixSymBlockDiagMDS(n_sp_, n_de_, nnz_sp_Hess_Lagr_SS_, nlp_base_->options->GetString("mem_space"));
 
+  update_reference_point();
+}
+
+void hiopFRProbMDS::update_reference_point()
+{
+  x_ref_ = solver_base_.get_it_curr()->get_x();
+
+  // build vector VR
+  DR_->copyFrom(*x_ref_);
+  DR_->component_abs();
+  DR_->invert();
+  DR_->component_min(1.0);
+
   // set mu0 to be the maximun of the current barrier parameter mu and norm_inf(|c|)*/
   theta_ref_ = solver_base_.get_resid()->get_theta(); //at current point, i.e., reference point
   nrmInf_feas_ref_ = solver_base_.get_resid()->get_nrmInf_bar_feasib();
-  mu_ = solver_base.get_mu();
+  mu_ = solver_base_.get_mu();
   mu_ = std::max(mu_, nrmInf_feas_ref_);
 
   zeta_ = std::sqrt(mu_);
@@ -1338,9 +1354,72 @@ bool hiopFRProbMDS::eval_Hess_Lagr(const size_type& n,
   return true;
 }
 
+/*
+*  Feasibility restoration context
+*/
+hiopFRContext::hiopFRContext(hiopAlgFilterIPMBase& solver_base)
+  : prob_sparse_(nullptr),
+    prob_mds_(nullptr),
+    nlp_(nullptr),
+    solver_(nullptr)
+{
+  hiopNlpFormulation* nlp_base = solver_base.get_nlp();
+  const std::string options_file = nlp_base->options->GetString("options_file_fr_prob");
+  if(nullptr != dynamic_cast<hiopNlpMDS*>(nlp_base)) {
+    prob_mds_ = new hiopFRProbMDS(solver_base);
+    nlp_ = new hiopNlpMDS(*prob_mds_, options_file.c_str());
+  } else if(nullptr != dynamic_cast<hiopNlpSparse*>(nlp_base)) {
+    prob_sparse_ = new hiopFRProbSparse(solver_base);
+    nlp_ = new hiopNlpSparse(*prob_sparse_, options_file.c_str());
+  } else {
+    // this is dense linear system. This is the default case.
+    assert(0 && "feasibility problem hasn't support dense system yet.");
+  }
+  if(nlp_) {
+    //these options are used by the initialization of the FR problem, which is done by the constructor of
+    //the solver, hence they are set before it
+    nlp_->options->SetStringValue("Hessian", "analytical_exact");
+    nlp_->options->SetStringValue("duals_update_type", "linear");
+    nlp_->options->SetStringValue("duals_init", "zero");
+    nlp_->options->SetStringValue("compute_mode", nlp_base->options->GetString("compute_mode").c_str());
+    nlp_->options->SetStringValue("mem_space", nlp_base->options->GetString("mem_space").c_str());
+    nlp_->options->SetStringValue("KKTLinsys", "xdycyd");
+    nlp_->options->SetIntegerValue("verbosity_level", 0);
+    nlp_->options->SetStringValue("warm_start", "yes");
+    nlp_->options->SetNumericValue("bound_relax_perturb", 0.0);
+    nlp_->options->SetStringValue("scaling_type", "none");
+
+    solver_ = new hiopAlgFilterIPMNewton(nlp_, true);
+    solver_->set_reuse_kkt(true);
+  }
+}
 
+hiopFRContext::~hiopFRContext()
+{
+  //the solver and the formulation use the FR problem, hence they are deleted first
+  delete solver_;
+  delete nlp_;
+  delete prob_sparse_;
+  delete prob_mds_;
+}
 
+void hiopFRContext::update_reference_point()
+{
+  if(prob_mds_) {
+    prob_mds_->update_reference_point();
+  } else if(prob_sparse_) {
+    prob_sparse_->update_reference_point();
+  }
+}
 
+const hiopVector& hiopFRContext::get_fr_sol_x() const
+{
+  return prob_mds_ ? prob_mds_->get_fr_sol_x() : prob_sparse_->get_fr_sol_x();
+}
 
+const hiopVector& hiopFRContext::get_fr_sol_d() const
+{
+  return prob_mds_ ? prob_mds_->get_fr_sol_d() : prob_sparse_->get_fr_sol_d();
+}
 
 };
@@ -171,6 +171,13 @@ public:
   virtual const hiopVector& get_fr_sol_x ()  const { return *last_x_; }
   virtual const hiopVector& get_fr_sol_d ()  const { return *last_d_; }
 
+  /**
+   * Sets the reference point of the FR problem to the current iterate of the base solver and updates
+   * the parameters that depend on it (scaling of the proximity term, `mu`, `zeta`, and `rho`). Called
+   * by the constructor and on each subsequent entry into the restoration phase.
+   */
+  void update_reference_point();
+
 private:
   size_type n_;
   size_type m_;
@@ -340,6 +347,13 @@ public:
   virtual const hiopVector& get_fr_sol_x ()  const { return *last_x_; }
   virtual const hiopVector& get_fr_sol_d ()  const { return *last_d_; }
 
+  /**
+   * Sets the reference point of the FR problem to the current iterate of the base solver and updates
+   * the parameters that depend on it (scaling of the proximity term, `mu`, `zeta`, and `rho`). Called
+   * by the constructor and on each subsequent entry into the restoration phase.
+   */
+  void update_reference_point();
+
 private:
   size_type n_;
   size_type n_sp_;
@@ -396,7 +410,39 @@ private:
   int x_de_st_; // the 1st index of x_de in the full primal space
 };
 
+/** Feasibility restoration (FR) context owned by the solver of the original problem.
+ *
+ * The FR problem, its NLP formulation (which reads the options file 'options_file_fr_prob'), and
+ * the solver of the FR problem are created on the first entry into the restoration phase. The sizes 
+ * and the sparsity of the FR problem are given by the original problem, hence the subsequent entries
+ * only move the reference point of the FR problem and rerun the same solver, which keeps its KKT 
+ * linear system and the symbolic factorization of its linear solver between the runs.
+ */
+class hiopFRContext
+{
+public:
+  /// Creates the FR problem for the NLP solved by @p solver_base, which should be sparse or MDS
+  hiopFRContext(hiopAlgFilterIPMBase& solver_base);
+  ~hiopFRContext();
 
+  /// Sets the reference point of the FR problem to the current iterate of the base solver
+  void update_reference_point();
+
+  inline hiopNlpFormulation& get_nlp() { return *nlp_; }
+  inline hiopAlgFilterIPMNewton& get_solver() { return *solver_; }
+
+  const hiopVector& get_fr_sol_x() const;
+  const hiopVector& get_fr_sol_d() const;
+private:
+  /// only one of the two FR problems is created, depending on the formulation of the original NLP
+  hiopFRProbSparse* prob_sparse_;
+  hiopFRProbMDS* prob_mds_;
+  hiopNlpFormulation* nlp_;
+  hiopAlgFilterIPMNewton* solver_;
+private:
+  hiopFRContext(const hiopFRContext&) = delete;
+  hiopFRContext& operator=(const hiopFRContext&) = delete;
+};
 
 } //end of namespace
 #endif
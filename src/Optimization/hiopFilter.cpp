@@ -47,6 +47,9 @@
 // product endorsement purposes.
 
 #include "hiopFilter.hpp"
+#include "hiopCheckpoint.hpp"
+
+#include <vector>
 
 using namespace std;
 
@@ -82,5 +85,40 @@ void hiopFilter::print(FILE* file, const char* msg) const
   fprintf(file, "\n");
 }
 
+void hiopFilter::save_state(hiopCheckpointFile& file) const
+{
+  file.write_marker("filter");
+  //the entries are stored as (theta, phi) pairs in the order of the list
+  vector<double> buf;
+  buf.reserve(2*entries.size());
+  for(auto& fe : entries) {
+    buf.push_back(fe.theta);
+    buf.push_back(fe.phi);
+  }
+  const int num_entries = entries.size();
+  file.write_scalar(num_entries);
+  file.write_array(buf.data(), buf.size());
+}
+
+bool hiopFilter::load_state(hiopCheckpointFile& file)
+{
+  file.read_marker("filter");
+  int num_entries = -1;
+  file.read_scalar(num_entries);
+  if(!file.good() || num_entries<0) {
+    return false;
+  }
+  vector<double> buf(2*num_entries);
+  file.read_array(buf.data(), buf.size());
+  if(!file.good()) {
+    return false;
+  }
+  entries.clear();
+  for(int i=0; i<num_entries; i++) {
+    entries.push_back(FilterEntry(buf[2*i], buf[2*i+1]));
+  }
+  return true;
+}
+
   
 };
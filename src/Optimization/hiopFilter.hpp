@@ -56,6 +56,8 @@
 namespace hiop
 {
 
+class hiopCheckpointFile;
+
 class hiopFilter
 {
 public:
@@ -74,6 +76,12 @@ public:
   
   bool contains(const double& theta, const double& phi) const;
 
+  /** Writes the entries of the filter to a checkpoint. */
+  void save_state(hiopCheckpointFile& file) const;
+  /** Replaces the entries of the filter with the ones from a checkpoint. */
+  bool load_state(hiopCheckpointFile& file);
+
+
   void print(FILE* file, const char* msg) const;
 private:
   struct FilterEntry { 
@@ -0,0 +1,309 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory (LLNL).
+// Written by Cosmin G. Petra, petra1@llnl.gov.
+// LLNL-CODE-742473. All rights reserved.
+//
+// This file is part of HiOp. For details, see https://github.com/LLNL/hiop. HiOp 
+// is released under the BSD 3-clause license (https://opensource.org/licenses/BSD-3-Clause). 
+// Please also read “Additional BSD Notice” below.
+//
+// Redistribution and use in source and binary forms, with or without modification, 
+// are permitted provided that the following conditions are met:
+// i. Redistributions of source code must retain the above copyright notice, this list 
+// of conditions and the disclaimer below.
+// ii. Redistributions in binary form must reproduce the above copyright notice, 
+// this list of conditions and the disclaimer (as noted below) in the documentation and/or 
+// other materials provided with the distribution.
+// iii. Neither the name of the LLNS/LLNL nor the names of its contributors may be used to 
+// endorse or promote products derived from this software without specific prior written 
+// permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY 
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES 
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT 
+// SHALL LAWRENCE LIVERMORE NATIONAL SECURITY, LLC, THE U.S. DEPARTMENT OF ENERGY OR 
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS 
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+// AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Additional BSD Notice
+// 1. This notice is required to be provided under our contract with the U.S. Department 
+// of Energy (DOE). This work was produced at Lawrence Livermore National Laboratory under 
+// Contract No. DE-AC52-07NA27344 with the DOE.
+// 2. Neither the United States Government nor Lawrence Livermore National Security, LLC 
+// nor any of their employees, makes any warranty, express or implied, or assumes any 
+// liability or responsibility for the accuracy, completeness, or usefulness of any 
+// information, apparatus, product, or process disclosed, or represents that its use would
+// not infringe privately-owned rights.
+// 3. Also, reference herein to any specific commercial products, process, or services by 
+// trade name, trademark, manufacturer or otherwise does not necessarily constitute or 
+// imply its endorsement, recommendation, or favoring by the United States Government or 
+// Lawrence Livermore National Security, LLC. The views and opinions of authors expressed 
+// herein do not necessarily state or reflect those of the United States Government or 
+// Lawrence Livermore National Security, LLC, and shall not be used for advertising or 
+// product endorsement purposes.
+
+
+/**
+ * @file hiopFiniteDiffSparse.cpp
+ *
+ * Finite-difference approximation of sparse derivatives based on a coloring of their sparsity pattern.
+ */
+
+#include "hiopFiniteDiffSparse.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <numeric>
+#include <thread>
+#include <utility>
+
+namespace hiop
+{
+
+hiopFiniteDiffSparse::hiopFiniteDiffSparse(size_type m,
+                                           size_type n,
+                                           size_type nnz,
+                                           const index_type* irow,
+                                           const index_type* jcol,
+                                           bool symmetric,
+                                           double rel_step,
+                                           int num_threads)
+  : m_(m),
+    n_(n),
+    nnz_(nnz),
+    symmetric_(symmetric),
+    rel_step_(rel_step),
+    num_threads_(std::max(1, num_threads)),
+    num_colors_(0)
+{
+  assert(!symmetric || m==n);
+  assert(rel_step>0.);
+
+  //the duplicate nonzeros, which for symmetric matrices include (i,j) and (j,i), are approximated in their
+  //first occurrence and are zero in the others, such that their sum is the derivative
+  std::vector<bool> dupl(nnz, false);
+  {
+    auto key = [&](index_type k) {
+      if(symmetric) {
+        return std::make_pair(std::min(irow[k], jcol[k]), std::max(irow[k], jcol[k]));
+      }
+      return std::make_pair(irow[k], jcol[k]);
+    };
+    std::vector<index_type> perm(nnz);
+    std::iota(perm.begin(), perm.end(), 0);
+    std::stable_sort(perm.begin(), perm.end(), [&](index_type k1, index_type k2) { return key(k1)<key(k2); });
+    for(index_type it=1; it<nnz; it++) {
+      if(key(perm[it])==key(perm[it-1])) {
+        dupl[perm[it]] = true;
+      }
+    }
+  }
+
+  //rows of the columns and columns of the rows of the full pattern, in compressed format
+  std::vector<index_type> rows_start(n+1, 0), cols_start(m+1, 0);
+  for(index_type k=0; k<nnz; k++) {
+    assert(irow[k]>=0 && irow[k]<m);
+    assert(jcol[k]>=0 && jcol[k]<n);
+    if(dupl[k]) {
+      continue;
+    }
+    rows_start[jcol[k]+1]++;
+    cols_start[irow[k]+1]++;
+    if(symmetric && irow[k]!=jcol[k]) {
+      rows_start[irow[k]+1]++;
+      cols_start[jcol[k]+1]++;
+    }
+  }
+  for(index_type j=0; j<n; j++) {
+    rows_start[j+1] += rows_start[j];
+  }
+  for(index_type i=0; i<m; i++) {
+    cols_start[i+1] += cols_start[i];
+  }
+  std::vector<index_type> rows(rows_start[n]), cols(cols_start[m]);
+  {
+    std::vector<index_type> rows_it(rows_start.begin(), rows_start.end()-1);
+    std::vector<index_type> cols_it(cols_start.begin(), cols_start.end()-1);
+    for(index_type k=0; k<nnz; k++) {
+      if(dupl[k]) {
+        continue;
+      }
+      rows[rows_it[jcol[k]]++] = irow[k];
+      cols[cols_it[irow[k]]++] = jcol[k];
+      if(symmetric && irow[k]!=jcol[k]) {
+        rows[rows_it[irow[k]]++] = jcol[k];
+        cols[cols_it[jcol[k]]++] = irow[k];
+      }
+    }
+  }
+
+  //greedy coloring: a column gets the smallest color not used by the columns sharing a row with it;
+  //the columns without nonzeros are not colored since they do not need to be perturbed
+  std::vector<index_type> color(n, -1);
+  std::vector<index_type> forbidden; //forbidden[c]==j when color c is used by a neighbor of column j
+  for(index_type j=0; j<n; j++) {
+    if(rows_start[j]==rows_start[j+1]) {
+      continue;
+    }
+    for(index_type itr=rows_start[j]; itr<rows_start[j+1]; itr++) {
+      const index_type i = rows[itr];
+      for(index_type itc=cols_start[i]; itc<cols_start[i+1]; itc++) {
+        const index_type c = color[cols[itc]];
+        if(c>=0) {
+          forbidden[c] = j;
+        }
+      }
+    }
+    index_type c = 0;
+    while(c<num_colors_ && forbidden[c]==j) {
+      c++;
+    }
+    if(c==num_colors_) {
+      num_colors_++;
+      forbidden.push_back(-1);
+    }
+    color[j] = c;
+  }
+
+  //columns of each color
+  col_start_.assign(num_colors_+1, 0);
+  for(index_type j=0; j<n; j++) {
+    if(color[j]>=0) {
+      col_start_[color[j]+1]++;
+    }
+  }
+  for(index_type c=0; c<num_colors_; c++) {
+    col_start_[c+1] += col_start_[c];
+  }
+  cols_.resize(col_start_[num_colors_]);
+  {
+    std::vector<index_type> it(col_start_.begin(), col_start_.end()-1);
+    for(index_type j=0; j<n; j++) {
+      if(color[j]>=0) {
+        cols_[it[color[j]]++] = j;
+      }
+    }
+  }
+
+  //values read in the pass of each color: nonzero (i,j) is read from row i in the pass of the color of
+  //column j and, for symmetric matrices, also from row j in the pass of the color of column i
+  vals_start_.assign(num_colors_+1, 0);
+  for(index_type k=0; k<nnz; k++) {
+    if(dupl[k]) {
+      continue;
+    }
+    vals_start_[color[jcol[k]]+1]++;
+    if(symmetric && irow[k]!=jcol[k]) {
+      vals_start_[color[irow[k]]+1]++;
+    }
+  }
+  for(index_type c=0; c<num_colors_; c++) {
+    vals_start_[c+1] += vals_start_[c];
+  }
+  const size_type num_reads = vals_start_[num_colors_];
+  read_row_.resize(num_reads);
+  read_col_.resize(num_reads);
+  read_nz_.resize(num_reads);
+  read_weight_.resize(num_reads);
+  {
+    std::vector<index_type> it(vals_start_.begin(), vals_start_.end()-1);
+    for(index_type k=0; k<nnz; k++) {
+      if(dupl[k]) {
+        continue;
+      }
+      const bool offdiag_sym = symmetric && irow[k]!=jcol[k];
+      const double weight = offdiag_sym ? 0.5 : 1.;
+      index_type r = it[color[jcol[k]]]++;
+      read_row_[r] = irow[k];
+      read_col_[r] = jcol[k];
+      read_nz_[r] = k;
+      read_weight_[r] = weight;
+      if(offdiag_sym) {
+        r = it[color[irow[k]]]++;
+        read_row_[r] = jcol[k];
+        read_col_[r] = irow[k];
+        read_nz_[r] = k;
+        read_weight_[r] = weight;
+      }
+    }
+  }
+  vals_.resize(num_reads);
+  steps_.resize(n);
+  f0_.resize(m);
+}
+
+hiopFiniteDiffSparse::~hiopFiniteDiffSparse()
+{
+}
+
+bool hiopFiniteDiffSparse::eval_color(const EvalFunc& f,
+                                      const double* x,
+                                      index_type c,
+                                      double* x_pert,
+                                      double* f_pert)
+{
+  for(index_type it=col_start_[c]; it<col_start_[c+1]; it++) {
+    x_pert[cols_[it]] += steps_[cols_[it]];
+  }
+  const bool bret = f(x_pert, f_pert);
+  for(index_type it=col_start_[c]; it<col_start_[c+1]; it++) {
+    x_pert[cols_[it]] = x[cols_[it]];
+  }
+  for(index_type r=vals_start_[c]; r<vals_start_[c+1]; r++) {
+    vals_[r] = f_pert[read_row_[r]];
+  }
+  return bret;
+}
+
+bool hiopFiniteDiffSparse::eval(const EvalFunc& f, const double* x, double* M)
+{
+  for(index_type j=0; j<n_; j++) {
+    //the step is made exactly representable 
+    const double x_pert = x[j] + rel_step_*std::max(1., std::fabs(x[j]));
+    steps_[j] = x_pert - x[j];
+  }
+
+  //the colors are dispatched dynamically to the threads, each with its own buffers
+  std::atomic<index_type> next(0);
+  std::atomic<bool> bret(true);
+  auto work = [&]() {
+    std::vector<double> x_pert(x, x+n_);
+    std::vector<double> f_pert(m_);
+    for(index_type c=next++; c<num_colors_; c=next++) {
+      if(!eval_color(f, x, c, x_pert.data(), f_pert.data())) {
+        bret = false;
+      }
+    }
+  };
+  const int num_threads = std::min(num_threads_, static_cast<int>(num_colors_));
+  if(num_threads<=1) {
+    work();
+  } else {
+    std::vector<std::thread> threads;
+    for(int t=0; t<num_threads; t++) {
+      threads.emplace_back(work);
+    }
+    for(auto& thread : threads) {
+      thread.join();
+    }
+  }
+
+  //f is evaluated at the unperturbed point last, so that the user's evaluations end at 'x'
+  if(!bret || !f(x, f0_.data())) {
+    return false;
+  }
+
+  std::fill(M, M+nnz_, 0.);
+  for(index_type r=0; r<static_cast<index_type>(vals_.size()); r++) {
+    M[read_nz_[r]] += read_weight_[r] * (vals_[r]-f0_[read_row_[r]]) / steps_[read_col_[r]];
+  }
+  return true;
+}
+
+} // end of namespace
@@ -0,0 +1,147 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory (LLNL).
+// Written by Cosmin G. Petra, petra1@llnl.gov.
+// LLNL-CODE-742473. All rights reserved.
+//
+// This file is part of HiOp. For details, see https://github.com/LLNL/hiop. HiOp 
+// is released under the BSD 3-clause license (https://opensource.org/licenses/BSD-3-Clause). 
+// Please also read “Additional BSD Notice” below.
+//
+// Redistribution and use in source and binary forms, with or without modification, 
+// are permitted provided that the following conditions are met:
+// i. Redistributions of source code must retain the above copyright notice, this list 
+// of conditions and the disclaimer below.
+// ii. Redistributions in binary form must reproduce the above copyright notice, 
+// this list of conditions and the disclaimer (as noted below) in the documentation and/or 
+// other materials provided with the distribution.
+// iii. Neither the name of the LLNS/LLNL nor the names of its contributors may be used to 
+// endorse or promote products derived from this software without specific prior written 
+// permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY 
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES 
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT 
+// SHALL LAWRENCE LIVERMORE NATIONAL SECURITY, LLC, THE U.S. DEPARTMENT OF ENERGY OR 
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS 
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+// AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Additional BSD Notice
+// 1. This notice is required to be provided under our contract with the U.S. Department 
+// of Energy (DOE). This work was produced at Lawrence Livermore National Laboratory under 
+// Contract No. DE-AC52-07NA27344 with the DOE.
+// 2. Neither the United States Government nor Lawrence Livermore National Security, LLC 
+// nor any of their employees, makes any warranty, express or implied, or assumes any 
+// liability or responsibility for the accuracy, completeness, or usefulness of any 
+// information, apparatus, product, or process disclosed, or represents that its use would
+// not infringe privately-owned rights.
+// 3. Also, reference herein to any specific commercial products, process, or services by 
+// trade name, trademark, manufacturer or otherwise does not necessarily constitute or 
+// imply its endorsement, recommendation, or favoring by the United States Government or 
+// Lawrence Livermore National Security, LLC. The views and opinions of authors expressed 
+// herein do not necessarily state or reflect those of the United States Government or 
+// Lawrence Livermore National Security, LLC, and shall not be used for advertising or 
+// product endorsement purposes.
+
+
+/**
+ * @file hiopFiniteDiffSparse.hpp
+ *
+ * Finite-difference approximation of sparse derivatives based on a coloring of their sparsity pattern.
+ */
+
+#ifndef HIOP_FINITE_DIFF_SPARSE
+#define HIOP_FINITE_DIFF_SPARSE
+
+#include "hiop_types.h"
+
+#include <functional>
+#include <vector>
+
+namespace hiop
+{
+
+/**
+ * @brief Approximates the nonzeros of a sparse m x n matrix of derivatives, such as the Jacobian of the
+ * constraints or the Hessian of the Lagrangian (the Jacobian of the gradient), by forward differences
+ * of the function f:R^n->R^m being differentiated.
+ *
+ * The columns of the sparsity pattern are colored once, at construction, such that the columns of the 
+ * same color do not have nonzeros in the same row. The columns of one color are perturbed together in
+ * one evaluation of f, from which all their nonzeros are recovered. Hence an approximation costs one 
+ * evaluation of f per color plus one at the unperturbed point, and not n+1 evaluations. The colors are
+ * independent and can be evaluated by multiple threads, in which case f should be thread safe.
+ *
+ * For symmetric matrices only the nonzeros of one triangle are given; the coloring is done on the full
+ * pattern and the two approximations of the off-diagonal nonzeros (from the row and from the column)
+ * are averaged. Duplicate nonzeros, which are summed in the triplet format, are approximated in their 
+ * first occurrence and set to zero in the others.
+ */
+class hiopFiniteDiffSparse
+{
+public:
+  /// Evaluates f at 'x' in 'f'; returns false on failure
+  typedef std::function<bool(const double* x, double* f)> EvalFunc;
+
+  /**
+   * Colors the columns of the pattern given by the 'nnz' triplets (irow, jcol) of a 'm' x 'n' matrix.
+   * The perturbation of x_j is rel_step*max(1,|x_j|).
+   */
+  hiopFiniteDiffSparse(size_type m,
+                       size_type n,
+                       size_type nnz,
+                       const index_type* irow,
+                       const index_type* jcol,
+                       bool symmetric,
+                       double rel_step,
+                       int num_threads);
+  virtual ~hiopFiniteDiffSparse();
+
+  /**
+   * Approximates in 'M' the nonzeros, in the order of the triplets given at construction, of the 
+   * derivatives of 'f' at 'x'. The last evaluation of f is done at 'x'. Returns false if f fails.
+   */
+  bool eval(const EvalFunc& f, const double* x, double* M);
+
+  /// number of colors, i.e., number of perturbed evaluations of f per approximation
+  inline size_type num_colors() const { return num_colors_; }
+private:
+  /// evaluates f at 'x' perturbed along the columns of color 'c' and records the perturbed values 
+  bool eval_color(const EvalFunc& f, const double* x, index_type c, double* x_pert, double* f_pert);
+private:
+  size_type m_;
+  size_type n_;
+  size_type nnz_;
+  bool symmetric_;
+  double rel_step_;
+  int num_threads_;
+  size_type num_colors_;
+  
+  /// columns of each color in compressed format: the columns of color c are cols_[col_start_[c]...]
+  std::vector<index_type> col_start_;
+  std::vector<index_type> cols_;
+
+  /**
+   * Values of f read in the pass of each color in compressed format: the pass of color c reads the
+   * entries vals_start_[c] to vals_start_[c+1]-1, in which read_row_ is the row of f, read_col_ is the
+   * perturbed column, read_nz_ is the nonzero approximated and read_weight_ is the weight of the 
+   * approximation (1/2 for the off-diagonal nonzeros of symmetric matrices, 1 otherwise)
+   */
+  std::vector<index_type> vals_start_;
+  std::vector<index_type> read_row_;
+  std::vector<index_type> read_col_;
+  std::vector<index_type> read_nz_;
+  std::vector<double> read_weight_;
+
+  /// values of f read in the perturbed evaluations, and the perturbations
+  std::vector<double> vals_;
+  std::vector<double> steps_;
+  std::vector<double> f0_;
+};
+
+} // end of namespace
+
+#endif
@@ -47,7 +47,9 @@
 // product endorsement purposes.
 
 #include "hiopHessianLowRank.hpp"
+#include "hiopCheckpoint.hpp"
 #include "hiopLinAlgFactory.hpp"
+#include "hiopMemoryTracker.hpp"
 #include "hiopVectorPar.hpp"
 
 #include "hiop_blasdefs.hpp"
@@ -76,8 +78,9 @@ namespace hiop
 {
 
 hiopHessianLowRank::hiopHessianLowRank(hiopNlpDenseConstraints* nlp_, int max_mem_len)
-  : l_max(max_mem_len), l_curr(-1), sigma(1.), sigma0(1.), nlp(nlp_), matrixChanged(false)
+  : l_max(max_mem_len), l_curr(-1), l_oldest(0), sigma(1.), sigma0(1.), nlp(nlp_), matrixChanged(false)
 {
+  hiopMemoryTrackerScope mem_scope(hiopMemoryTracker::QuasiNewton);
   DhInv = dynamic_cast<hiopVectorPar*>(nlp->alloc_primal_vec());
   St = nlp->alloc_multivector_primal(0,l_max);
   Yt = St->alloc_clone(); //faster than nlp->alloc_multivector_primal(...);
@@ -91,10 +94,10 @@ hiopHessianLowRank::hiopHessianLowRank(hiopNlpDenseConstraints* nlp_, int max_me
 
   //internal buffers for memory pool (none of them should be in n)
 #ifdef HIOP_USE_MPI
-  _buff_kxk    = new double[nlp->m() * nlp->m()];
-  _buff_2lxk   = new double[nlp->m() * 2*l_max];
-  _buff1_lxlx3 = new double[3*l_max*l_max];
-  _buff2_lxlx3 = new double[3*l_max*l_max];
+  _buff_kxk    = LinearAlgebraFactory::create_raw_array("DEFAULT", nlp->m() * nlp->m());
+  _buff_2lxk   = LinearAlgebraFactory::create_raw_array("DEFAULT", nlp->m() * 2*l_max);
+  _buff1_lxlx3 = LinearAlgebraFactory::create_raw_array("DEFAULT", 3*l_max*l_max);
+  _buff2_lxlx3 = LinearAlgebraFactory::create_raw_array("DEFAULT", 3*l_max*l_max);
 #else
    //not needed in non-MPI mode
   _buff_kxk  = NULL;
@@ -104,7 +107,7 @@ hiopHessianLowRank::hiopHessianLowRank(hiopNlpDenseConstraints* nlp_, int max_me
 
   //auxiliary objects/buffers
   _S1=_Y1=NULL;
-  _lxl_mat1=_kxl_mat1=_kx2l_mat1=NULL;
+  _lxl_mat1=_kxl_mat1=_kx2l_mat1=_kxn_mat1=NULL;
   _l_vec1 = _l_vec2 = _2l_vec1 = NULL;
   _n_vec1 = DhInv->alloc_clone();
   _n_vec2 = DhInv->alloc_clone();
@@ -139,6 +142,12 @@ hiopHessianLowRank::hiopHessianLowRank(hiopNlpDenseConstraints* nlp_, int max_me
 #ifdef HIOP_DEEPCHECKS
   _Dx   = DhInv->alloc_clone();
   _Vmat = V->alloc_clone();
+
+  _N_mat = LinearAlgebraFactory::create_matrix_dense("DEFAULT", 0, 0);
+  _N_ipiv_vec = NULL;
+  _N_work_vec = LinearAlgebraFactory::create_vector("DEFAULT", 0);
+  _N_rhs = _N_rhs_s = _N_rhs_y = NULL;
+  _N_changed = true;
 #endif
 
 }  
@@ -157,6 +166,13 @@ hiopHessianLowRank::~hiopHessianLowRank()
   if(V)  delete V;
 #ifdef HIOP_DEEPCHECKS
   delete _Vmat;
+
+  delete _N_mat;
+  delete[] _N_ipiv_vec;
+  delete _N_work_vec;
+  delete _N_rhs;
+  delete _N_rhs_s;
+  delete _N_rhs_y;
 #endif
 
 
@@ -165,16 +181,17 @@ hiopHessianLowRank::~hiopHessianLowRank()
   if(_Jac_c_prev) delete _Jac_c_prev;
   if(_Jac_d_prev) delete _Jac_d_prev;
 
-  if(_buff_kxk)    delete[] _buff_kxk;
-  if(_buff_2lxk)   delete[] _buff_2lxk;
-  if(_buff1_lxlx3) delete[] _buff1_lxlx3;
-  if(_buff2_lxlx3) delete[] _buff2_lxlx3;
+  if(_buff_kxk)    LinearAlgebraFactory::delete_raw_array("DEFAULT", _buff_kxk);
+  if(_buff_2lxk)   LinearAlgebraFactory::delete_raw_array("DEFAULT", _buff_2lxk);
+  if(_buff1_lxlx3) LinearAlgebraFactory::delete_raw_array("DEFAULT", _buff1_lxlx3);
+  if(_buff2_lxlx3) LinearAlgebraFactory::delete_raw_array("DEFAULT", _buff2_lxlx3);
 
   if(_S1) delete _S1;
   if(_Y1) delete _Y1;
   if(_lxl_mat1)    delete _lxl_mat1;
   if(_kxl_mat1)    delete _kxl_mat1; 
   if(_kx2l_mat1)   delete _kx2l_mat1;
+  if(_kxn_mat1)    delete _kxn_mat1;
 
   if(_l_vec1) delete _l_vec1;
   if(_l_vec2) delete _l_vec2;
@@ -200,6 +217,92 @@ bool hiopHessianLowRank::updateLogBarrierDiagonal(const hiopVector& Dx)
   return true;
 }
 
+void hiopHessianLowRank::save_state(hiopCheckpointFile& file) const
+{
+  file.write_marker("quasi_newton");
+  file.write_scalar(l_max);
+  file.write_scalar(l_curr);
+  file.write_scalar(l_oldest);
+  file.write_scalar(sigma);
+  if(l_curr>=0) {
+    _it_prev->save_state(file);
+    file.write_vector(*_grad_f_prev);
+    file.write_array(_Jac_c_prev->local_data_const(),
+                     _Jac_c_prev->get_local_size_m()*_Jac_c_prev->get_local_size_n());
+    file.write_array(_Jac_d_prev->local_data_const(),
+                     _Jac_d_prev->get_local_size_m()*_Jac_d_prev->get_local_size_n());
+  }
+  //the secant pairs are stored row by row, the local parts of each row being contiguous
+  const int l = St->m();
+  const size_type n_local = St->get_local_size_n();
+  file.write_scalar(l);
+  for(int i=0; i<l; i++) {
+    file.write_array(St->local_data_const()+i*n_local, n_local);
+    file.write_array(Yt->local_data_const()+i*n_local, n_local);
+  }
+  file.write_array(L->local_data_const(), l*l);
+  file.write_vector(*D);
+}
+
+bool hiopHessianLowRank::load_state(hiopCheckpointFile& file)
+{
+  file.read_marker("quasi_newton");
+  int l_max_file = -1;
+  file.read_scalar(l_max_file);
+  if(!file.good() || l_max_file!=l_max) {
+    nlp->log->printf(hovError,
+                     "hiopHessianLowRank: checkpoint has quasi-Newton memory length %d, expected %d\n",
+                     l_max_file, l_max);
+    return false;
+  }
+  file.read_scalar(l_curr);
+  file.read_scalar(l_oldest);
+  file.read_scalar(sigma);
+  if(l_curr>=0) {
+    if(NULL==_it_prev)     _it_prev     = new hiopIterate(nlp);
+    if(NULL==_grad_f_prev) _grad_f_prev = nlp->alloc_primal_vec();
+    if(NULL==_Jac_c_prev)  _Jac_c_prev  = nlp->alloc_Jac_c();
+    if(NULL==_Jac_d_prev)  _Jac_d_prev  = nlp->alloc_Jac_d();
+    _it_prev->load_state(file);
+    file.read_vector(*_grad_f_prev);
+    file.read_array(_Jac_c_prev->local_data(),
+                    _Jac_c_prev->get_local_size_m()*_Jac_c_prev->get_local_size_n());
+    file.read_array(_Jac_d_prev->local_data(),
+                    _Jac_d_prev->get_local_size_m()*_Jac_d_prev->get_local_size_n());
+  }
+  int l = -1;
+  file.read_scalar(l);
+  if(!file.good() || l<0 || l>l_max) {
+    return false;
+  }
+
+  //rebuild S and Y with l rows
+  delete St;
+  delete Yt;
+  St = nlp->alloc_multivector_primal(0, l_max);
+  Yt = St->alloc_clone();
+  hiopVector& row = new_n_vec1(St->n());
+  for(int i=0; i<l; i++) {
+    file.read_vector(row);
+    St->appendRow(row);
+    file.read_vector(row);
+    Yt->appendRow(row);
+  }
+
+  delete L;
+  delete D;
+  L = LinearAlgebraFactory::create_matrix_dense("DEFAULT", l, l);
+  D = LinearAlgebraFactory::create_vector("DEFAULT", l);
+  file.read_array(L->local_data(), l*l);
+  file.read_vector(*D);
+
+  matrixChanged = true;
+#ifdef HIOP_DEEPCHECKS
+  _N_changed = true;
+#endif
+  return file.good();
+}
+
 #ifdef HIOP_DEEPCHECKS
 void hiopHessianLowRank::print(FILE* f, hiopOutVerbosity v, const char* msg) const
 {
@@ -230,6 +333,7 @@ void hiopHessianLowRank::print(FILE* f, hiopOutVerbosity v, const char* msg) con
 bool hiopHessianLowRank::update(const hiopIterate& it_curr, const hiopVector& grad_f_curr_,
 				const hiopMatrix& Jac_c_curr_, const hiopMatrix& Jac_d_curr_)
 {
+  hiopMemoryTrackerScope mem_scope(hiopMemoryTracker::QuasiNewton);
   nlp->runStats.tmSolverInternal.start();
 
   const hiopVectorPar&   grad_f_curr= dynamic_cast<const hiopVectorPar&>(grad_f_curr_);
@@ -282,13 +386,12 @@ bool hiopHessianLowRank::update(const hiopIterate& it_curr, const hiopVector& gr
 	    growD(l_curr, l_max, sTy);
 	    l_curr++;
 	  } else {
-	    //shift
-	    St->shiftRows(-1);
-	    Yt->shiftRows(-1);
-	    St->replaceRow(l_max-1, s_new);
-	    Yt->replaceRow(l_max-1, y_new);
-	    updateL(YTs,sTy);
-	    updateD(sTy);
+	    //overwrite the oldest pair, which becomes the newest
+	    St->replaceRow(l_oldest, s_new);
+	    Yt->replaceRow(l_oldest, y_new);
+	    updateL(YTs, l_oldest);
+	    updateD(sTy, l_oldest);
+	    l_oldest = (l_oldest+1) % l_max;
 	    l_curr=l_max;
 	  }
 	} //end of l_max>0
@@ -329,6 +432,9 @@ bool hiopHessianLowRank::update(const hiopIterate& it_curr, const hiopVector& gr
       nlp->log->printf(hovLinAlgScalars, "hiopHessianLowRank: ||s_new||=%12.6e too small... skipping the Hessian update\n", s_infnorm);
     }
 
+#ifdef HIOP_DEEPCHECKS
+    _N_changed = true;
+#endif
     //save this stuff for next update
     _it_prev->copyFrom(it_curr);  _grad_f_prev->copyFrom(grad_f_curr); 
     _Jac_c_prev->copyFrom(Jac_c_curr); _Jac_d_prev->copyFrom(Jac_d_curr);
@@ -362,6 +468,7 @@ bool hiopHessianLowRank::update(const hiopIterate& it_curr, const hiopVector& gr
  */
 void hiopHessianLowRank::updateInternalBFGSRepresentation()
 {
+  hiopMemoryTrackerScope mem_scope(hiopMemoryTracker::QuasiNewton);
   size_type n=St->n(), l=St->m();
 
   //grow L,D, andV if needed
@@ -522,7 +629,10 @@ symMatTimesInverseTimesMatTrans(double beta, hiopMatrixDense& W,
     symmMatTimesDiagTimesMatTrans_local(beta,W,alpha,X,*DhInv);
   else
     symmMatTimesDiagTimesMatTrans_local(0.0, W,alpha,X,*DhInv);
-  //W will be MPI_All_reduced later
+  //the reduction of W is started now and overlaps with the computation of S1 and Y1 below
+  MPI_Request req_W;
+  int ierr = MPI_Iallreduce(W.local_data(), _buff_kxk, k*k, MPI_DOUBLE, MPI_SUM, nlp->get_comm(), &req_W);
+  assert(ierr==MPI_SUCCESS);
 #else
   symmMatTimesDiagTimesMatTrans_local(beta,W,alpha,X,*DhInv);
 #endif
@@ -538,9 +648,8 @@ symMatTimesInverseTimesMatTrans(double beta, hiopMatrixDense& W,
   S2Y2.copyBlockFromMatrix(0,0,S1);
   S2Y2.copyBlockFromMatrix(0,l,Y1);
 #ifdef HIOP_USE_MPI
-  int ierr;
   ierr = MPI_Allreduce(S2Y2.local_data(), _buff_2lxk, 2*l*k, MPI_DOUBLE, MPI_SUM, nlp->get_comm()); assert(ierr==MPI_SUCCESS);
-  ierr = MPI_Allreduce(W.local_data(),    _buff_kxk,  k*k,   MPI_DOUBLE, MPI_SUM, nlp->get_comm()); assert(ierr==MPI_SUCCESS);
+  ierr = MPI_Wait(&req_W, MPI_STATUS_IGNORE); assert(ierr==MPI_SUCCESS);
   S2Y2.copyFrom(_buff_2lxk);
   W.copyFrom(_buff_kxk);
   //also copy S1 and Y1
@@ -584,6 +693,7 @@ symMatTimesInverseTimesMatTrans(double beta, hiopMatrixDense& W,
 
 void hiopHessianLowRank::factorizeV()
 {
+  hiopMemoryTrackerScope mem_scope(hiopMemoryTracker::QuasiNewton);
   int N=V->n(), lda=N, info;
   if(N==0) return;
 
@@ -764,47 +874,33 @@ void hiopHessianLowRank::growD(const int& lmem_curr, const int& lmem_max, const
 /* L_{ij} = s_{i-1}^T y_{j-1}, if i>j, otherwise zero. Here i,j = 0,1,...,l_curr-1
  * L_new = lift and shift L to the left; replace last row with [Yts;0]
  */
-void hiopHessianLowRank::updateL(const hiopVector& YTs, const double& sTy)
+/* The new pair overwrites the oldest pair in row 'row_new' of St and Yt. Since the new pair is the newest,
+ * row 'row_new' of L becomes Y^T*s_new (YTs is computed before Yt is updated) and column 'row_new' is zero.
+ */
+void hiopHessianLowRank::updateL(const hiopVector& YTs, const int& row_new)
 {
   int l=YTs.get_size();
   assert(l==L->m());
   assert(l==L->n());
+  assert(row_new>=0 && row_new<l);
 #ifdef HIOP_DEEPCHECKS
   assert(l_curr==l);
   assert(l_curr==l_max);
 #endif
-  const int lm1=l-1;
   double* L_mat=L->local_data();
   const double* yts_vec=YTs.local_data_const();
-  for(int i=1; i<lm1; i++) {
-    for(int j=0; j<i; j++) {
-      //L_mat[i][j] = L_mat[i+1][j+1];
-      L_mat[i*l+j] = L_mat[(i+1)*l+j+1];
-    }
+  for(int j=0; j<l; j++) {
+    //L_mat[row_new][j] = y_j'*s_new and L_mat[j][row_new]=0
+    L_mat[row_new*l+j] = yts_vec[j];
+    L_mat[j*l+row_new] = 0.0;
   }
-      
-
-  //is this really needed?
-  //for(int i=0; i<lm1; i++)
-  //  L_mat[i][lm1]=0.0;
-
-  //first entry in YTs corresponds to y_to_be_discarded_since_it_is_the_oldest'* s_new and is discarded
-  for(int j=0; j<lm1; j++) {
-    //L_mat[lm1][j]=yts_vec[j+1];
-    L_mat[lm1*l+j]=yts_vec[j+1];
-    
-  }
-
-  //L_mat[lm1][lm1]=0.0;
-  L_mat[lm1*l+lm1]=0.0;
+  //the entry corresponding to the discarded pair is also zero
+  L_mat[row_new*l+row_new]=0.0;
 }
-void hiopHessianLowRank::updateD(const double& sTy)
+void hiopHessianLowRank::updateD(const double& sTy, const int& row_new)
 {
-  int l=D->get_size();
-  double* D_vec = D->local_data();
-  for(int i=0; i<l-1; i++)
-    D_vec[i]=D_vec[i+1];
-  D_vec[l-1]=sTy;
+  assert(row_new>=0 && row_new<D->get_size());
+  D->local_data()[row_new]=sTy;
 }
 
 
@@ -858,6 +954,20 @@ hiopMatrixDense& hiopHessianLowRank::new_kx2l_mat1(int k, int l)
   
   return *_kx2l_mat1;
 }
+hiopMatrixDense& hiopHessianLowRank::new_kxn_mat1(int k, int n)
+{
+  if(NULL!=_kxn_mat1) {
+    if(k==_kxn_mat1->m() && n==_kxn_mat1->n()) {
+      return *_kxn_mat1;
+    } else {
+      delete _kxn_mat1;
+      _kxn_mat1=NULL;
+    }
+  }
+  _kxn_mat1 = LinearAlgebraFactory::create_matrix_dense("DEFAULT", k, n);
+
+  return *_kxn_mat1;
+}
 hiopMatrixDense& hiopHessianLowRank::new_kxl_mat1(int k, int l)
 {
   if(_kxl_mat1!=NULL) {
@@ -906,11 +1016,13 @@ hiopMatrixDense& hiopHessianLowRank::new_Y1(const hiopMatrixDense& X, const hiop
 void hiopHessianLowRank::timesVecCmn(double beta, hiopVector& y, double alpha, const hiopVector& x, bool addLogTerm) 
 {
   size_type n=St->n();
-  assert(l_curr==St->m());
+  int l=St->m();
+  assert(l_curr==l);
   assert(y.get_size()==n);
   assert(St->get_local_size_n() == Yt->get_local_size_n());
 
-  //we have B+=B-B*s*B*s'/(s'*B*s)+yy'/(y'*s)
+  //we use the compact representation B = B0 - [B0*S Y]*N^{-1}*[S'*B0]
+  //                                                           [ Y'  ]
   //B0 is sigma*I. There is an additional diagonal log-barrier term _Dx
 
   bool print=true;
@@ -927,66 +1039,108 @@ void hiopHessianLowRank::timesVecCmn(double beta, hiopVector& y, double alpha, c
     nlp->log->write("y_in=", y, hovMatrices);
   }
 
-  hiopVectorPar *yk=dynamic_cast<hiopVectorPar*>(nlp->alloc_primal_vec());
-  hiopVectorPar *sk=dynamic_cast<hiopVectorPar*>(nlp->alloc_primal_vec());
-  //allocate and compute a_k and b_k
-  vector<hiopVector*> a(l_curr), b(l_curr);
-  int n_local = Yt->get_local_size_n();
-  for(int k=0; k<l_curr; k++) {
-    //bk=yk/sqrt(yk'*sk)
-    yk->copyFrom(Yt->local_data() + k*n_local);
-    sk->copyFrom(St->local_data() + k*n_local);
-    double skTyk=yk->dotProductWith(*sk);
-    assert(skTyk>0);
-    b[k]=dynamic_cast<hiopVectorPar*>(nlp->alloc_primal_vec());
-    b[k]->copyFrom(*yk);
-    b[k]->scale(1/sqrt(skTyk));
-
-    a[k]=dynamic_cast<hiopVectorPar*>(nlp->alloc_primal_vec());
-
-    //compute ak by an inner loop
-    a[k]->copyFrom(*sk);
-    a[k]->scale(sigma);
-
-    for(int i=0; i<k; i++) {
-      double biTsk = b[i]->dotProductWith(*sk);
-      a[k]->axpy(+biTsk, *b[i]);
-      double aiTsk = a[i]->dotProductWith(*sk);
-      a[k]->axpy(-aiTsk, *a[i]);
-    }
-    double skTak = a[k]->dotProductWith(*sk);
-    a[k]->scale(1/sqrt(skTak));
-  }
-
-  //now we have B= B_0 + sum{ bk bk' - ak ak' : k=0,1,...,l_curr-1} 
-  //compute the product with x
-  //y = beta*y+alpha*(B0+Dx)*x + alpha* sum { bk'x bk - ak'x ak : k=0,1,...,l_curr-1}
+  //y = beta*y+alpha*(B0+Dx)*x
   y.scale(beta);
   if(addLogTerm) 
     y.axzpy(alpha,x,*_Dx);
 
   y.axpy(alpha*sigma, x); 
 
-  for(int k=0; k<l_curr; k++) {
-    double bkTx = b[k]->dotProductWith(x);
-    double akTx = a[k]->dotProductWith(x);
-    
-    y.axpy( alpha*bkTx, *b[k]);
-    y.axpy(-alpha*akTx, *a[k]);
+  if(l>0) {
+    if(_N_changed) factorizeN();
+
+    //[rhs_s; rhs_y] = [S'*B0*x; Y'*x]
+    St->timesVec(0.0, *_N_rhs_s, sigma, x);
+    Yt->timesVec(0.0, *_N_rhs_y, 1.0, x);
+    _N_rhs->copyFromStarting(0, *_N_rhs_s);
+    _N_rhs->copyFromStarting(l, *_N_rhs_y);
+
+    int N=2*l, lda=N, one=1, info;
+    char uplo='L';
+    DSYTRS(&uplo, &N, &one, _N_mat->local_data(), &lda, _N_ipiv_vec, _N_rhs->local_data(), &N, &info);
+    if(info<0) nlp->log->printf(hovError, "hiopHessianLowRank::timesVec error: %d argument to dsytrs has an illegal value\n", -info);
+    assert(info==0);
+    _N_rhs->copyToStarting(0, *_N_rhs_s);
+    _N_rhs->copyToStarting(l, *_N_rhs_y);
+
+    //y = y - alpha*(B0*S*rhs_s + Y*rhs_y)
+    St->transTimesVec(1.0, y, -alpha*sigma, *_N_rhs_s);
+    Yt->transTimesVec(1.0, y, -alpha, *_N_rhs_y);
   }
 
   if(print) {
     nlp->log->write("y_out=", y, hovMatrices);
   }
+}
+
+/* Computes and factorizes the middle matrix N=[S'*B0*S  L] of the compact representation.
+ *                                            [  L'    -D]
+ * Only S'*S is computed in n; the buffers are (re)allocated only when l changes. */
+void hiopHessianLowRank::factorizeN()
+{
+  hiopMemoryTrackerScope mem_scope(hiopMemoryTracker::QuasiNewton);
+  size_type n=St->n();
+  int l=St->m();
+  assert(L->m()==l);
+  assert(D->get_size()==l);
+
+  if(_N_mat->m()!=2*l) {
+    delete _N_mat;
+    _N_mat = LinearAlgebraFactory::create_matrix_dense("DEFAULT", 2*l, 2*l);
+    delete[] _N_ipiv_vec;
+    _N_ipiv_vec = new int[2*l];
+    delete _N_rhs;
+    delete _N_rhs_s;
+    delete _N_rhs_y;
+    _N_rhs = LinearAlgebraFactory::create_vector("DEFAULT", 2*l);
+    _N_rhs_s = LinearAlgebraFactory::create_vector("DEFAULT", l);
+    _N_rhs_y = LinearAlgebraFactory::create_vector("DEFAULT", l);
+  }
+
+  //S'*S
+  hiopMatrixDense& StS = new_lxl_mat1(l);
+  hiopVector& ones = new_n_vec1(n);
+  ones.setToConstant(1.0);
+  symmMatTimesDiagTimesMatTrans_local(0.0, StS, 1.0, *St, ones);
+#ifdef HIOP_USE_MPI
+  int ierr = MPI_Allreduce(StS.local_data(), _buff1_lxlx3, l*l, MPI_DOUBLE, MPI_SUM, nlp->get_comm());
+  assert(ierr==MPI_SUCCESS);
+  StS.copyFrom(_buff1_lxlx3);
+#endif
 
-  for(vector<hiopVector*>::iterator it=a.begin(); it!=a.end(); ++it) 
-    delete *it;
-  for(vector<hiopVector*>::iterator it=b.begin(); it!=b.end(); ++it) 
-    delete *it;
+  //N is symmetric; LAPACK uses its lower triangle in Fortran, that is, the upper triangle in C++
+  double* N_mat=_N_mat->local_data();
+  const double* StS_mat=StS.local_data_const();
+  const double* L_mat=L->local_data_const();
+  const double* D_vec=D->local_data_const();
+  for(int i=0; i<l; i++) {
+    for(int j=0; j<l; j++) {
+      N_mat[i*2*l+j] = sigma*StS_mat[i*l+j];
+      N_mat[i*2*l+l+j] = L_mat[i*l+j];
+      N_mat[(l+i)*2*l+j] = L_mat[j*l+i];
+      N_mat[(l+i)*2*l+l+j] = 0.;
+    }
+    N_mat[(l+i)*2*l+l+i] = -D_vec[i];
+  }
 
-  delete yk;
-  delete sk;
+  int N=2*l, lda=N, info;
+  char uplo='L';
+  int lwork=-1;
+  double work_tmp;
+  DSYTRF(&uplo, &N, N_mat, &lda, _N_ipiv_vec, &work_tmp, &lwork, &info);
+  assert(info==0);
+  lwork=(int)work_tmp;
+  if(lwork != _N_work_vec->get_size()) {
+    delete _N_work_vec;
+    _N_work_vec = LinearAlgebraFactory::create_vector("DEFAULT", lwork);
+  }
+  DSYTRF(&uplo, &N, N_mat, &lda, _N_ipiv_vec, _N_work_vec->local_data(), &lwork, &info);
+  if(info!=0) 
+    nlp->log->printf(hovError, "hiopHessianLowRank::factorizeN error: dsytrf returned %d\n", info);
+  assert(info==0);
+  _N_changed=false;
 }
+
 void hiopHessianLowRank::timesVec_noLogBarrierTerm(double beta, hiopVector& y, double alpha, const hiopVector&x)
 {
   this->timesVecCmn(beta, y, alpha, x, false);
@@ -1006,15 +1160,20 @@ void hiopHessianLowRank::timesVec(double beta, hiopVector& y, double alpha, cons
 /* symmetric multiplication W = beta*W + alpha*X*Diag*X^T 
  * W is kxk local, X is kxn distributed and Diag is n, distributed
  * The ops are perform locally. The reduce is done separately/externally to decrease comm
+ *
+ * The product is computed with DSYRK on column panels of the scaled copy X*|Diag|^{1/2}, which computes 
+ * only one triangle of W and uses half of the flops of a DGEMM. The panels (kept in _kxn_mat1) have 
+ * at most 'panel_width' columns, so that the extra memory does not grow with n. The positive and negative 
+ * entries of Diag are accumulated by separate DSYRK calls; the triangle is mirrored at the end.
  */
 void hiopHessianLowRank::
 symmMatTimesDiagTimesMatTrans_local(double beta, hiopMatrixDense& W,
 				    double alpha, const hiopMatrixDense& X,
 				    const hiopVector& d)
 {
-  size_type k=W.m();
+  int k=W.m();
   size_type n=X.n();
-  size_t n_local=X.get_local_size_n();
+  int n_local=X.get_local_size_n();
 
   assert(X.m()==k);
     
@@ -1023,26 +1182,57 @@ symmMatTimesDiagTimesMatTrans_local(double beta, hiopMatrixDense& W,
   assert(d.get_size()==n);
   assert(d.get_local_size()==n_local);
 #endif
-  
-  //#define chunk 512; //!opt
-  const double *xi, *xj;
-  double acc;
+  if(0==k) return;
+
   double *Wdata=W.local_data();
   const double *Xdata=X.local_data_const();
   const double* dd=d.local_data_const();
-  for(int i=0; i<k; i++) {
-    //xi=Xdata[i];
-    xi=Xdata+i*n_local;
-    for(size_t j=i; j<k; j++) {
-      //xj=Xdata[j];
-      xj=Xdata+j*n_local;
-      //compute W[i,j] = sum {X[i,p]*d[p]*X[j,p] : p=1,...,n_local}
-      acc=0.0;
-      for(size_t p=0; p<n_local; p++)
-	acc += xi[p]*dd[p]*xj[p];
 
-      //Wdata[i][j]=Wdata[j][i]=beta*Wdata[i][j]+alpha*acc;
-      Wdata[i*k+j] = Wdata[j*k+i] = beta*Wdata[i*k+j]+alpha*acc;
+  const int panel_width = 512;
+  int nb = std::max(1, std::min(panel_width, n_local));
+  hiopMatrixDense& Xs = new_kxn_mat1(k, nb);
+  double* Xsdata = Xs.local_data();
+
+  //W is row-major, hence the upper triangle in column-major (as seen by BLAS) is the lower triangle of W
+  char uplo='U', trans='T';
+  double beta_syrk=beta;
+  bool updated=false;
+  for(int p0=0; p0<n_local; p0+=nb) {
+    int ncols = std::min(nb, n_local-p0);
+    bool has_pos=false, has_neg=false;
+    for(int p=p0; p<p0+ncols; p++) {
+      if(dd[p]>0.)      has_pos=true;
+      else if(dd[p]<0.) has_neg=true;
+    }
+
+    for(int sign=1; sign>=-1; sign-=2) {
+      if((sign>0 && !has_pos) || (sign<0 && !has_neg)) continue;
+
+      //Xs = X(:,p0:p0+ncols)*sqrt(sign*Diag) on the entries of Diag with the sign 'sign', zero otherwise
+      for(int i=0; i<k; i++) {
+        const double* xi = Xdata+i*n_local+p0;
+        double* xsi = Xsdata+i*nb;
+        for(int p=0; p<ncols; p++) {
+          xsi[p] = sign*dd[p0+p]>0. ? xi[p]*std::sqrt(sign*dd[p0+p]) : 0.;
+        }
+      }
+      double alpha_syrk = sign*alpha;
+      DSYRK(&uplo, &trans, &k, &ncols, &alpha_syrk, Xsdata, &nb, &beta_syrk, Wdata, &k);
+      beta_syrk=1.;
+      updated=true;
+    }
+  }
+  if(!updated) {
+    //Diag is zero (or empty): W=beta*W
+    int zero_cols=0;
+    double zero=0.;
+    DSYRK(&uplo, &trans, &k, &zero_cols, &zero, Xsdata, &nb, &beta_syrk, Wdata, &k);
+  }
+
+  //mirror the computed (lower) triangle of W into the upper triangle
+  for(int i=0; i<k; i++) {
+    for(int j=i+1; j<k; j++) {
+      Wdata[i*k+j] = Wdata[j*k+i];
     }
   }
 }
@@ -57,6 +57,8 @@
 namespace hiop
 {
 
+class hiopCheckpointFile;
+
 /* Class for storing and solving with the low-rank Hessian 
  *
  * Stores the Hessian wrt x as Hk=Dk+Bk, where 
@@ -101,6 +103,11 @@ public:
   /* updates the logBar diagonal term from the representation */
   virtual bool updateLogBarrierDiagonal(const hiopVector& Dx);
 
+  /* checkpointing of the memory of the secant approximation, i.e., the secant pairs, the compact
+   * representation, and the iterate and derivatives saved for the next update */
+  void save_state(hiopCheckpointFile& file) const;
+  bool load_state(hiopCheckpointFile& file);
+
   /* solves this*x=res */
   virtual void solve(const hiopVector& rhs, hiopVector& x);
   /* W = beta*W + alpha*X*inverse(this)*X^T (a more efficient version of solve)
@@ -110,8 +117,8 @@ public:
 					       double alpha, const hiopMatrixDense& X);
 #ifdef HIOP_DEEPCHECKS
   /* computes the product of the Hessian with a vector: y=beta*y+alpha*H*x.
-   * The function is supposed to use the underlying ***recursive*** definition of the 
-   * quasi-Newton Hessian and is used for checking/testing/error calculation.
+   * The function uses the compact representation of the quasi-Newton Hessian with a cached
+   * factorization of the middle 2lx2l matrix and is used for checking/testing/error calculation.
    */
   virtual void timesVec(double beta, hiopVector& y, double alpha, const hiopVector&x);
 
@@ -126,6 +133,7 @@ public:
 protected:
   int l_max; //max memory size
   int l_curr; //number of pairs currently stored
+  int l_oldest; //row of St and Yt holding the oldest pair once the memory is full
   double sigma; //initial scaling factor of identity
   double sigma0; //default scaling factor of identity
   int sigma_update_strategy;
@@ -143,6 +151,10 @@ private:
   // more exactly Bk=B0-[B0*St' Yt']*[St*B0*St'  L]*[St*B0]
   //                                 [  L'      -D] [Yt   ]                   
   hiopMatrixDense *St,*Yt; //we store the transpose to easily access columns in S and T
+  // Once the memory is full, St and Yt are used as circular buffers: the new pair overwrites the oldest one 
+  // and no rows are shifted. L and D are kept in the same (storage) order of the pairs, which is a symmetric
+  // permutation of the chronological order and leaves Bk unchanged; namely, L(i,j)=s_i'*y_j when pair i is
+  // newer than pair j and zero otherwise.
   hiopMatrixDense *L;     //lower triangular from the compact representation
   hiopVector* D;       //diag 
   //these are matrices from the representation of the inverse
@@ -153,8 +165,8 @@ private:
 #endif
   void growL(const int& lmem_curr, const int& lmem_max, const hiopVector& YTs);
   void growD(const int& l_curr, const int& l_max, const double& sTy);
-  void updateL(const hiopVector& STy, const double& sTy);
-  void updateD(const double& sTy);
+  void updateL(const hiopVector& YTs, const int& row_new);
+  void updateD(const double& sTy, const int& row_new);
   //also stored are the iterate, gradient obj, and Jacobians at the previous optimization iteration
   hiopIterate *_it_prev;
   hiopVector *_grad_f_prev;
@@ -168,7 +180,7 @@ private:
   double* _buff_2lxk; // size = 2 x q-Newton mem size x num_constraints
   double *_buff1_lxlx3, *_buff2_lxlx3;
   //auxiliary objects
-  hiopMatrixDense *_S1, *_Y1, *_lxl_mat1, *_kx2l_mat1, *_kxl_mat1; //preallocated matrices 
+  hiopMatrixDense *_S1, *_Y1, *_lxl_mat1, *_kx2l_mat1, *_kxl_mat1, *_kxn_mat1; //preallocated matrices 
   //holds X*D*S
   hiopMatrixDense& new_S1(const hiopMatrixDense& X, const hiopMatrixDense& St);
   //holds X*D*Y
@@ -176,6 +188,8 @@ private:
   hiopMatrixDense& new_lxl_mat1 (int l);
   hiopMatrixDense& new_kxl_mat1 (int k, int l);
   hiopMatrixDense& new_kx2l_mat1(int k, int l);
+  //holds a column panel of the scaled X used by symmMatTimesDiagTimesMatTrans_local
+  hiopMatrixDense& new_kxn_mat1(int k, int n);
   
   hiopVector *_l_vec1, *_l_vec2, *_n_vec1, *_n_vec2, *_2l_vec1;
   hiopVector& new_l_vec1(int l);
@@ -204,10 +218,10 @@ private:
   }
 private:
   //utilities
-  /* symmetric multiplication W = beta*W + alpha*X*Diag*X^T */
-  static void symmMatTimesDiagTimesMatTrans_local(double beta, hiopMatrixDense& W_,
-					   double alpha, const hiopMatrixDense& X_,
-					   const hiopVector& d);
+  /* symmetric multiplication W = beta*W + alpha*X*Diag*X^T (DSYRK-based) */
+  void symmMatTimesDiagTimesMatTrans_local(double beta, hiopMatrixDense& W_,
+                                           double alpha, const hiopMatrixDense& X_,
+                                           const hiopVector& d);
   /* W=S*Diag*X^T */
   static void matTimesDiagTimesMatTrans_local(hiopMatrixDense& W, const hiopMatrixDense& S, 
 					      const hiopVector& d, const hiopMatrixDense& X);
@@ -215,6 +229,16 @@ private:
   hiopVector *_V_work_vec;
   int _V_ipiv_size; int* _V_ipiv_vec;
   void factorizeV();
+#ifdef HIOP_DEEPCHECKS
+  /* members related to the middle matrix N=[S'*B0*S  L] of the compact representation, used by timesVec
+   *                                        [  L'    -D]
+   * N is factorized once per update of the secant pairs; the buffers are allocated when l changes. */
+  hiopMatrixDense* _N_mat;
+  int* _N_ipiv_vec;
+  hiopVector *_N_work_vec, *_N_rhs, *_N_rhs_s, *_N_rhs_y;
+  bool _N_changed;
+  void factorizeN();
+#endif
   void solveWithV(hiopVector& rhs_s, hiopVector& rhs_y);
   void solveWithV(hiopMatrixDense& rhs);
 private:
@@ -47,6 +47,7 @@
 // product endorsement purposes.
 
 #include "hiopIterate.hpp"
+#include "hiopCheckpoint.hpp"
 
 #include <cmath>
 #include <cassert>
@@ -134,6 +135,23 @@ void  hiopIterate::copyFrom(const hiopIterate& src)
   vu->copyFrom(*src.vu);
 }
 
+void hiopIterate::save_state(hiopCheckpointFile& file) const
+{
+  file.write_marker("iterate");
+  for(const hiopVector* v : {x, d, yc, yd, sxl, sxu, sdl, sdu, zl, zu, vl, vu}) {
+    file.write_vector(*v);
+  }
+}
+
+bool hiopIterate::load_state(hiopCheckpointFile& file)
+{
+  file.read_marker("iterate");
+  for(hiopVector* v : {x, d, yc, yd, sxl, sxu, sdl, sdu, zl, zu, vl, vu}) {
+    file.read_vector(*v);
+  }
+  return file.good();
+}
+
 void hiopIterate::print(FILE* f, const char* msg/*=NULL*/) const
 {
   if(NULL==msg) fprintf(f, "hiopIterate:\n");
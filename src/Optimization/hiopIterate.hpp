@@ -55,6 +55,8 @@
 namespace hiop
 {
 
+class hiopCheckpointFile;
+
 class hiopIterate
 {
 public:
@@ -141,6 +143,10 @@ public:
   hiopIterate* new_copy() const;
   void copyFrom(const hiopIterate& src);
 
+  /* checkpointing: the local parts of all the components are written/read */
+  void save_state(hiopCheckpointFile& file) const;
+  bool load_state(hiopCheckpointFile& file);
+
   /* accessors */
   inline hiopVector* get_x()   const {return x;}
   inline hiopVector* get_d()   const {return d;}
@@ -0,0 +1,215 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory (LLNL).
+// Written by Cosmin G. Petra, petra1@llnl.gov.
+// LLNL-CODE-742473. All rights reserved.
+//
+// This file is part of HiOp. For details, see https://github.com/LLNL/hiop. HiOp 
+// is released under the BSD 3-clause license (https://opensource.org/licenses/BSD-3-Clause). 
+// Please also read “Additional BSD Notice” below.
+//
+// Redistribution and use in source and binary forms, with or without modification, 
+// are permitted provided that the following conditions are met:
+// i. Redistributions of source code must retain the above copyright notice, this list 
+// of conditions and the disclaimer below.
+// ii. Redistributions in binary form must reproduce the above copyright notice, 
+// this list of conditions and the disclaimer (as noted below) in the documentation and/or 
+// other materials provided with the distribution.
+// iii. Neither the name of the LLNS/LLNL nor the names of its contributors may be used to 
+// endorse or promote products derived from this software without specific prior written 
+// permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY 
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES 
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT 
+// SHALL LAWRENCE LIVERMORE NATIONAL SECURITY, LLC, THE U.S. DEPARTMENT OF ENERGY OR 
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS 
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+// AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Additional BSD Notice
+// 1. This notice is required to be provided under our contract with the U.S. Department 
+// of Energy (DOE). This work was produced at Lawrence Livermore National Laboratory under 
+// Contract No. DE-AC52-07NA27344 with the DOE.
+// 2. Neither the United States Government nor Lawrence Livermore National Security, LLC 
+// nor any of their employees, makes any warranty, express or implied, or assumes any 
+// liability or responsibility for the accuracy, completeness, or usefulness of any 
+// information, apparatus, product, or process disclosed, or represents that its use would
+// not infringe privately-owned rights.
+// 3. Also, reference herein to any specific commercial products, process, or services by 
+// trade name, trademark, manufacturer or otherwise does not necessarily constitute or 
+// imply its endorsement, recommendation, or favoring by the United States Government or 
+// Lawrence Livermore National Security, LLC. The views and opinions of authors expressed 
+// herein do not necessarily state or reflect those of the United States Government or 
+// Lawrence Livermore National Security, LLC, and shall not be used for advertising or 
+// product endorsement purposes.
+
+
+/**
+ * @file hiopKKTEquilibration.cpp
+ *
+ * Symmetric equilibration of the KKT linear systems.
+ */
+
+#include "hiopKKTEquilibration.hpp"
+#include "hiopLinAlgFactory.hpp"
+#include "hiopMatrixDense.hpp"
+#include "hiopMatrixSparse.hpp"
+
+#include <cmath>
+
+namespace hiop
+{
+
+/// maximum number of Ruiz iterations in one (re)computation of the scaling
+static const int max_ruiz_iter = 10;
+/// the Ruiz iterations stop when the infinity norms of the rows are within this tolerance of one
+static const double ruiz_tol = 0.1;
+
+hiopKKTEquilibration::hiopKKTEquilibration(hiopNlpFormulation* nlp, const double& drift)
+  : nlp_(nlp),
+    D_(nullptr),
+    row_max_(nullptr),
+    drift_(drift)
+{
+  assert(drift_>1.);
+}
+
+hiopKKTEquilibration::~hiopKKTEquilibration()
+{
+  delete D_;
+  delete row_max_;
+}
+
+void hiopKKTEquilibration::setup(size_type n)
+{
+  if(nullptr==D_ || D_->get_size()!=n) {
+    delete D_;
+    delete row_max_;
+    D_ = LinearAlgebraFactory::create_vector("DEFAULT", n);
+    row_max_ = LinearAlgebraFactory::create_vector("DEFAULT", n);
+    D_->setToConstant(1.);
+  }
+}
+
+void hiopKKTEquilibration::row_max_abs(const hiopMatrixDense& M)
+{
+  const size_type n = M.n();
+  const double* MM = M.local_data_const();
+  const double* d = D_->local_data_const();
+  double* rmax = row_max_->local_data();
+  row_max_->setToZero();
+  for(index_type i=0; i<n; ++i) {
+    const double* Mi = MM + i*n;
+    double rmax_i = rmax[i];
+    for(index_type j=i; j<n; ++j) {
+      const double aij = fabs(d[i]*Mi[j]*d[j]);
+      rmax_i = fmax(rmax_i, aij);
+      rmax[j] = fmax(rmax[j], aij);
+    }
+    rmax[i] = rmax_i;
+  }
+}
+
+void hiopKKTEquilibration::row_max_abs(const hiopMatrixSparse& M)
+{
+  const index_type* irow = M.i_row();
+  const index_type* jcol = M.j_col();
+  const double* values = M.M();
+  const double* d = D_->local_data_const();
+  double* rmax = row_max_->local_data();
+  row_max_->setToZero();
+  for(index_type k=0; k<M.numberOfNonzeros(); ++k) {
+    const index_type i = irow[k];
+    const index_type j = jcol[k];
+    const double aij = fabs(d[i]*values[k]*d[j]);
+    rmax[i] = fmax(rmax[i], aij);
+    rmax[j] = fmax(rmax[j], aij);
+  }
+}
+
+bool hiopKKTEquilibration::ruiz_step(const double& tol)
+{
+  const size_type n = D_->get_size();
+  const double* rmax = row_max_->local_data_const();
+  bool within_tol = true;
+  for(index_type i=0; i<n && within_tol; ++i) {
+    //empty rows are ignored
+    if(rmax[i]>0. && (rmax[i]>tol || rmax[i]<1./tol)) {
+      within_tol = false;
+    }
+  }
+  if(within_tol) {
+    return true;
+  }
+  double* d = D_->local_data();
+  for(index_type i=0; i<n; ++i) {
+    if(rmax[i]>0.) {
+      d[i] /= sqrt(rmax[i]);
+    }
+  }
+  return false;
+}
+
+template<class MatType>
+void hiopKKTEquilibration::equilibrate_impl(MatType& M)
+{
+  assert(M.m()==M.n());
+  setup(M.n());
+
+  //the cached scaling is kept as long as the rows of D*M*D are within a factor 'drift_' of one
+  row_max_abs(M);
+  if(!ruiz_step(drift_)) {
+    int it = 1;
+    for(; it<max_ruiz_iter; ++it) {
+      row_max_abs(M);
+      if(ruiz_step(1.+ruiz_tol)) {
+        break;
+      }
+    }
+    nlp_->runStats.kkt.nEquilUpdates++;
+    nlp_->log->printf(hovScalars,
+                      "KKT equilibration: scaling updated in %d Ruiz iterations (scaling in [%.3e, %.3e])\n",
+                      it,
+                      D_->min(),
+                      D_->infnorm());
+  }
+}
+
+void hiopKKTEquilibration::equilibrate(hiopMatrixDense& M)
+{
+  equilibrate_impl(M);
+
+  const size_type n = M.n();
+  double* MM = M.local_data();
+  const double* d = D_->local_data_const();
+  for(index_type i=0; i<n; ++i) {
+    double* Mi = MM + i*n;
+    for(index_type j=i; j<n; ++j) {
+      Mi[j] *= d[i]*d[j];
+    }
+  }
+}
+
+void hiopKKTEquilibration::equilibrate(hiopMatrixSparse& M)
+{
+  equilibrate_impl(M);
+
+  const index_type* irow = M.i_row();
+  const index_type* jcol = M.j_col();
+  double* values = M.M();
+  const double* d = D_->local_data_const();
+  for(index_type k=0; k<M.numberOfNonzeros(); ++k) {
+    values[k] *= d[irow[k]]*d[jcol[k]];
+  }
+}
+
+void hiopKKTEquilibration::apply(hiopVector& x) const
+{
+  assert(D_ && x.get_size()==D_->get_size());
+  x.componentMult(*D_);
+}
+
+} // end of namespace
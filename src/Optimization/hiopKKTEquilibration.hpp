@@ -0,0 +1,123 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory (LLNL).
+// Written by Cosmin G. Petra, petra1@llnl.gov.
+// LLNL-CODE-742473. All rights reserved.
+//
+// This file is part of HiOp. For details, see https://github.com/LLNL/hiop. HiOp 
+// is released under the BSD 3-clause license (https://opensource.org/licenses/BSD-3-Clause). 
+// Please also read “Additional BSD Notice” below.
+//
+// Redistribution and use in source and binary forms, with or without modification, 
+// are permitted provided that the following conditions are met:
+// i. Redistributions of source code must retain the above copyright notice, this list 
+// of conditions and the disclaimer below.
+// ii. Redistributions in binary form must reproduce the above copyright notice, 
+// this list of conditions and the disclaimer (as noted below) in the documentation and/or 
+// other materials provided with the distribution.
+// iii. Neither the name of the LLNS/LLNL nor the names of its contributors may be used to 
+// endorse or promote products derived from this software without specific prior written 
+// permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY 
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES 
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT 
+// SHALL LAWRENCE LIVERMORE NATIONAL SECURITY, LLC, THE U.S. DEPARTMENT OF ENERGY OR 
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS 
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+// AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Additional BSD Notice
+// 1. This notice is required to be provided under our contract with the U.S. Department 
+// of Energy (DOE). This work was produced at Lawrence Livermore National Laboratory under 
+// Contract No. DE-AC52-07NA27344 with the DOE.
+// 2. Neither the United States Government nor Lawrence Livermore National Security, LLC 
+// nor any of their employees, makes any warranty, express or implied, or assumes any 
+// liability or responsibility for the accuracy, completeness, or usefulness of any 
+// information, apparatus, product, or process disclosed, or represents that its use would
+// not infringe privately-owned rights.
+// 3. Also, reference herein to any specific commercial products, process, or services by 
+// trade name, trademark, manufacturer or otherwise does not necessarily constitute or 
+// imply its endorsement, recommendation, or favoring by the United States Government or 
+// Lawrence Livermore National Security, LLC. The views and opinions of authors expressed 
+// herein do not necessarily state or reflect those of the United States Government or 
+// Lawrence Livermore National Security, LLC, and shall not be used for advertising or 
+// product endorsement purposes.
+
+
+/**
+ * @file hiopKKTEquilibration.hpp
+ *
+ * Symmetric equilibration of the KKT linear systems.
+ */
+
+#ifndef HIOP_KKT_EQUILIBRATION
+#define HIOP_KKT_EQUILIBRATION
+
+#include "hiopNlpFormulation.hpp"
+
+namespace hiop
+{
+
+class hiopVector;
+class hiopMatrixDense;
+class hiopMatrixSparse;
+
+/**
+ * @brief Symmetric (Ruiz) equilibration of the (symmetric, indefinite) KKT matrix K, which is replaced 
+ * by D*K*D, where D is a positive diagonal scaling chosen such that the rows (and columns) of D*K*D 
+ * have infinity norm close to one. The linear system K*x=b is then solved as (D*K*D)*y=D*b and x=D*y.
+ * Since D*K*D is congruent to K, the inertia is not changed.
+ *
+ * Computing D takes a few passes over the matrix, hence D is cached and reused for the subsequent 
+ * matrices, for example, for the refactorizations of the inertia correction and for the next 
+ * iterations. A new matrix only takes one pass to check whether the rows of D*K*D remain within 
+ * a factor 'drift' of one; if not, the Ruiz iterations are resumed from the cached D. The number of 
+ * updates of D is recorded in the KKT run statistics.
+ *
+ * Only one triangle of K is referenced: the upper triangle of a (row-major) dense matrix or the 
+ * nonzeros in the triplet format of a sparse matrix. The matrices and the vectors should be in the
+ * host memory.
+ */
+class hiopKKTEquilibration
+{
+public:
+  hiopKKTEquilibration(hiopNlpFormulation* nlp, const double& drift);
+  virtual ~hiopKKTEquilibration();
+
+  /// Replaces the dense symmetric matrix 'M' (only the upper triangle is referenced) by D*M*D
+  void equilibrate(hiopMatrixDense& M);
+
+  /// Replaces the sparse symmetric matrix 'M' (the triplets of one triangle) by D*M*D
+  void equilibrate(hiopMatrixSparse& M);
+
+  /// x = D*x, used for the right-hand side before the solve and for the solution after the solve
+  void apply(hiopVector& x) const;
+private:
+  /// infinity norms of the rows of D*M*D in 'row_max_'
+  void row_max_abs(const hiopMatrixDense& M);
+  void row_max_abs(const hiopMatrixSparse& M);
+
+  /**
+   * Updates D based on the infinity norms in 'row_max_' and returns true if the rows were already within
+   * the tolerance 'tol' of one, in which case D is not changed.
+   */
+  bool ruiz_step(const double& tol);
+
+  /// allocates D (set to identity) when the size of the matrix changes
+  void setup(size_type n);
+
+  template<class MatType> void equilibrate_impl(MatType& M);
+private:
+  hiopNlpFormulation* nlp_;
+  /// the diagonal scaling D and the infinity norms of the rows of D*M*D
+  hiopVector* D_;
+  hiopVector* row_max_;
+  double drift_;
+};
+
+} // end of namespace
+
+#endif
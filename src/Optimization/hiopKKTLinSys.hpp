@@ -55,6 +55,7 @@
 #include "hiopPDPerturbation.hpp"
 #include "hiopLinSolver.hpp"
 #include "hiopFactAcceptor.hpp"
+#include "hiopKKTEquilibration.hpp"
 #include "hiopKrylovSolver.hpp"
 
 #include "hiopCppStdUtils.hpp"
@@ -253,15 +254,20 @@ public:
       rx_tilde_(nullptr),
       Dd_(nullptr),
       x_wrk_(nullptr),
-      d_wrk_(nullptr)
+      d_wrk_(nullptr),
+      equil_(nullptr)
   {
     Dx_ = nlp->alloc_primal_vec();
     assert(Dx_ != nullptr);
     rx_tilde_  = Dx_->alloc_clone();
     Dd_ = nlp->alloc_dual_ineq_vec();  
+    if(nlp->options->GetString("kkt_equilibration") == "ruiz") {
+      equil_ = new hiopKKTEquilibration(nlp, nlp->options->GetNumeric("kkt_equilibration_drift"));
+    }
   }
   virtual ~hiopKKTLinSysCompressed()
   {
+    delete equil_;
     delete Dx_;
     delete rx_tilde_;
     delete Dd_;
@@ -290,6 +296,11 @@ protected:
   hiopVector* rx_tilde_;
   hiopVector* x_wrk_;
   hiopVector* d_wrk_;
+  /**
+   * Symmetric equilibration of the compressed KKT matrix, used by the subclasses that form the matrix 
+   * explicitly; nullptr when the option 'kkt_equilibration' is 'none'
+   */
+  hiopKKTEquilibration* equil_;
 };
 
 /* Provides the functionality for reducing the KKT linear system to the
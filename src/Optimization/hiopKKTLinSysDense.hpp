@@ -93,7 +93,9 @@ public:
     assert(nx==Hess_->n()); assert(nx==Jac_c_->n()); assert(nx==Jac_d_->n());
     int neq = Jac_c_->m(), nineq = Jac_d_->m();
     
+    bool is_first_build = false;
     if(NULL==linSys_) {
+      is_first_build = true;
       int n=Jac_c_->m() + Jac_d_->m() + Hess_->m();
 
       if(nlp_->options->GetString("compute_mode")=="hybrid" ||
@@ -125,7 +127,13 @@ public:
     //
     nlp_->runStats.kkt.tmUpdateLinsys.start();
     
-    Msys.setToZero();
+    //only the upper triangle is assembled and referenced by the factorization; the strictly lower 
+    //triangle is zeroed once, when the system matrix is created
+    if(is_first_build) {
+      Msys.setToZero();
+    } else {
+      Msys.setUpperTriangleToZero();
+    }
       
     int alpha = 1.;
     Hess_->addUpperTriangleToSymDenseMatrixUpperTriangle(0, alpha, Msys);
@@ -153,6 +161,10 @@ public:
     //Msys.addSubDiagonal(nx+nineq+neq, nineq, -delta_cd);
     Msys.addSubDiagonal(nx, neq+nineq, -delta_cd);
 
+    if(equil_) {
+      equil_->equilibrate(Msys);
+    }
+
     nlp_->log->write("KKT Linsys:", Msys, hovMatrices);
 
     //write matrix to file if requested
@@ -166,6 +178,20 @@ public:
     return true;
   }
 
+  /**
+   * With inertia correction, a factorization with more negative eigenvalues than the number of 
+   * constraints is discarded, hence the Lapack solver is allowed to stop such a factorization early.
+   */
+  virtual int factorizeWithCurvCheck()
+  {
+    auto* linSys = dynamic_cast<hiopLinSolverIndefDenseLapack*>(linSys_);
+    if(linSys) {
+      const bool is_ic = nullptr!=dynamic_cast<hiopFactAcceptorIC*>(fact_acceptor_);
+      linSys->set_max_neg_eig(is_ic ? Jac_c_->m()+Jac_d_->m() : -1);
+    }
+    return hiopKKTLinSysCompressedXYcYd::factorizeWithCurvCheck();
+  }
+
   virtual bool solveCompressed(hiopVector& rx, hiopVector& ryc, hiopVector& ryd,
                                hiopVector& dx, hiopVector& dyc, hiopVector& dyd)
   {
@@ -185,6 +211,10 @@ public:
     ryc.copyToStarting(*rhsXYcYd, nx);
     ryd.copyToStarting(*rhsXYcYd, nx+nyc);
 
+    if(equil_) {
+      equil_->apply(*rhsXYcYd);
+    }
+
     if(write_linsys_counter>=0) csr_writer.writeRhsToFile(*rhsXYcYd, write_linsys_counter);
 
     //! todo: iterative refinement
@@ -194,6 +224,10 @@ public:
 
     if(false==sol_ok) return false;
 
+    if(equil_) {
+      equil_->apply(*rhsXYcYd);
+    }
+
     rhsXYcYd->copyToStarting(0,      dx);
     rhsXYcYd->copyToStarting(nx,     dyc);
     rhsXYcYd->copyToStarting(nx+nyc, dyd);
@@ -255,7 +289,9 @@ public:
     int neq = Jac_c_->m(), nineq = Jac_d_->m();
     assert(nx==Hess_->n()); assert(nx==Jac_c_->n()); assert(nx==Jac_d_->n());
  
+    bool is_first_build = false;
     if(NULL==linSys_) {
+      is_first_build = true;
       int n=nx+neq+2*nineq;
 
       if(nlp_->options->GetString("compute_mode")=="hybrid" ||
@@ -279,7 +315,13 @@ public:
     //
     // update linSys system matrix, including IC perturbations
     //
-    Msys.setToZero();
+    //only the upper triangle is assembled and referenced by the factorization; the strictly lower 
+    //triangle is zeroed once, when the system matrix is created
+    if(is_first_build) {
+      Msys.setToZero();
+    } else {
+      Msys.setUpperTriangleToZero();
+    }
   
     const int alpha = 1.;
     Hess_->addUpperTriangleToSymDenseMatrixUpperTriangle(0, alpha, Msys);
@@ -311,6 +353,10 @@ public:
     //Msys.addSubDiagonal(nx+nineq+neq, nineq, -delta_cd);
     Msys.addSubDiagonal(nx+nineq, neq+nineq, -delta_cd);
 
+    if(equil_) {
+      equil_->equilibrate(Msys);
+    }
+
     nlp_->log->write("KKT Linsys:", Msys, hovMatrices);
 
     //write matrix to file if requested
@@ -325,6 +371,20 @@ public:
     return true;
   }
 
+  /**
+   * With inertia correction, a factorization with more negative eigenvalues than the number of 
+   * constraints is discarded, hence the Lapack solver is allowed to stop such a factorization early.
+   */
+  virtual int factorizeWithCurvCheck()
+  {
+    auto* linSys = dynamic_cast<hiopLinSolverIndefDenseLapack*>(linSys_);
+    if(linSys) {
+      const bool is_ic = nullptr!=dynamic_cast<hiopFactAcceptorIC*>(fact_acceptor_);
+      linSys->set_max_neg_eig(is_ic ? Jac_c_->m()+Jac_d_->m() : -1);
+    }
+    return hiopKKTLinSysCompressedXDYcYd::factorizeWithCurvCheck();
+  }
+
   virtual bool solveCompressed(hiopVector& rx, hiopVector& rd, hiopVector& ryc, hiopVector& ryd,
                                hiopVector& dx, hiopVector& dd, hiopVector& dyc, hiopVector& dyd)
   {
@@ -346,6 +406,10 @@ public:
     ryc.copyToStarting(*rhsXDYcYd, nx+nyd);
     ryd.copyToStarting(*rhsXDYcYd, nx+nyd+nyc);
 
+    if(equil_) {
+      equil_->apply(*rhsXDYcYd);
+    }
+
     if(write_linsys_counter>=0) csr_writer.writeRhsToFile(*rhsXDYcYd, write_linsys_counter);
 
     bool sol_ok = linSys->solve(*rhsXDYcYd);
@@ -354,6 +418,10 @@ public:
 
     if(false==sol_ok) return false;
 
+    if(equil_) {
+      equil_->apply(*rhsXDYcYd);
+    }
+
     rhsXDYcYd->copyToStarting(0,          dx);
     rhsXDYcYd->copyToStarting(nx,         dd);
     rhsXDYcYd->copyToStarting(nx+nyd,     dyc);
@@ -77,18 +77,28 @@ namespace hiop
   {
     int nxs = HessMDS_->n_sp(), nxd = HessMDS_->n_de(), nx = HessMDS_->n();
     int neq = Jac_cMDS_->m(), nineq = Jac_dMDS_->m();
+
+    // One can compute the number of negative eigenvalues of the whole MDS or XYcYd
+    // linear system using Haynsworth inertia additivity formula, namely,
+    // count the negative eigenvalues of the sparse Hessian block.
+    int n_neg_eig_Hxs  = Hxs_->numOfElemsLessThan(-1e-14);
+    int n_zero_eig_Hxs = Hxs_->numOfElemsAbsLessThan(1e-14);
+
+    // With inertia correction, a factorization of the "dense" (reduced) KKT with more than
+    // neq+nineq-n_neg_eig_Hxs negative eigenvalues is discarded, hence the Lapack solver is 
+    // allowed to stop it early
+    auto* linSys = dynamic_cast<hiopLinSolverIndefDenseLapack*>(linSys_);
+    if(linSys) {
+      const bool is_ic = nullptr!=dynamic_cast<hiopFactAcceptorIC*>(fact_acceptor_);
+      linSys->set_max_neg_eig(is_ic && 0==n_zero_eig_Hxs ? std::max(0, neq+nineq-n_neg_eig_Hxs) : -1);
+    }
+
     //factorization
     int n_neg_eig = hiopKKTLinSysCurvCheck::factorizeWithCurvCheck();
 
     int n_neg_eig_11 = 0;
     if(n_neg_eig>=0) {
       // 'n_neg_eig' is the number of negative eigenvalues of the "dense" (reduced) KKT
-      //
-      // One can compute the number of negative eigenvalues of the whole MDS or XYcYd
-      // linear system using Haynsworth inertia additivity formula, namely,
-      // count the negative eigenvalues of the sparse Hessian block.
-      int n_neg_eig_Hxs  = Hxs_->numOfElemsLessThan(-1e-14);
-      int n_zero_eig_Hxs = Hxs_->numOfElemsAbsLessThan(1e-14);
       n_neg_eig_11 += n_neg_eig_Hxs;
       if (n_zero_eig_Hxs > 0)
       {  
@@ -283,6 +293,10 @@ namespace hiop
     alpha=-1.;
     Msys.addSubDiagonal(alpha, nxd+neq, *Dd_inv_);
     Msys.addSubDiagonal(nxd+neq, nineq, -delta_cd);
+
+    if(equil_) {
+      equil_->equilibrate(Msys);
+    }
 	
     nlp_->log->write("KKT_MDS_XYcYd linsys:", Msys, hovMatrices);
       
@@ -351,6 +365,10 @@ namespace hiop
     //ths[nxde+nyc:nxde+nyc+nyd-1] = ryd
     ryd.copyToStarting(*rhs_, nxde+nyc);
 
+    if(equil_) {
+      equil_->apply(*rhs_);
+    }
+
     if(write_linsys_counter_>=0) {
       csr_writer_.writeRhsToFile(*rhs_, write_linsys_counter_);
     }
@@ -375,6 +393,10 @@ namespace hiop
 
     nlp_->runStats.kkt.tmSolveRhsManip.start();
 
+    if(equil_) {
+      equil_->apply(*rhs_);
+    }
+
     // unpack 
     rhs_->startingAtCopyToStartingAt(0,        dx,  nxsp, nxde);
     rhs_->startingAtCopyToStartingAt(nxde,     dyc, 0);   
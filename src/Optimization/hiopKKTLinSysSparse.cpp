@@ -62,6 +62,8 @@
 #endif
 #endif
 
+#include <algorithm>
+
 namespace hiop
 {
 
@@ -169,6 +171,9 @@ namespace hiop
 
       Msys->copySubDiagonalFrom(nx+neq, nineq, *Dd_inv_, dest_nnz_st, -1); dest_nnz_st += nineq;
 
+      if(equil_) {
+        equil_->equilibrate(*Msys);
+      }
 
       nlp_->log->write("KKT_SPARSE_XYcYd linsys:", *Msys, hovMatrices);
       nlp_->runStats.kkt.tmUpdateLinsys.stop();
@@ -215,6 +220,10 @@ namespace hiop
     ryc.copyToStarting(*rhs_, nx);
     ryd.copyToStarting(*rhs_, nx+nyc);
 
+    if(equil_) {
+      equil_->apply(*rhs_);
+    }
+
     if(write_linsys_counter_>=0) {
       csr_writer_.writeRhsToFile(*rhs_, write_linsys_counter_);
     }
@@ -240,6 +249,10 @@ namespace hiop
 
     nlp_->runStats.kkt.tmSolveRhsManip.start();
 
+    if(equil_) {
+      equil_->apply(*rhs_);
+    }
+
     //
     // unpack
     //
@@ -419,17 +432,7 @@ namespace hiop
       Msys->setToZero();
 
       // copy Jac and Hes to the full iterate matrix
-      size_type dest_nnz_st{0};
-      Msys->copyRowsBlockFrom(*HessSp_,  0,   nx,     0,          dest_nnz_st);
-      dest_nnz_st += HessSp_->numberOfNonzeros();
-      Msys->copyRowsBlockFrom(*Jac_cSp_, 0,   neq,    nx+nd,      dest_nnz_st);
-      dest_nnz_st += Jac_cSp_->numberOfNonzeros();
-      Msys->copyRowsBlockFrom(*Jac_dSp_, 0,   nineq,  nx+nd+neq,  dest_nnz_st);
-      dest_nnz_st += Jac_dSp_->numberOfNonzeros();
-
-      // minus identity matrix for slack variables
-      Msys->copyDiagMatrixToSubblock(-1., nx+nd+neq, nx, dest_nnz_st, nineq);
-      dest_nnz_st += nineq;
+      size_type dest_nnz_st = copy_offdiag_blocks_to_linsys(*Msys, *HessSp_, *Jac_cSp_, *Jac_dSp_);
 
       //build the diagonal Hx = Dx + delta_wx
       if(NULL == Hx_) {
@@ -469,6 +472,10 @@ namespace hiop
       * [    Jc             0        -delta_cc  0       ] [dyc] = [   ryc    ]
       * [    Jd            -I           0    -delta_cd  ] [dyd]   [   ryd    ]
       */
+      if(equil_) {
+        equil_->equilibrate(*Msys);
+      }
+
       nlp_->log->write("KKT_SPARSE_XDYcYd linsys:", *Msys, hovMatrices);
       nlp_->runStats.kkt.tmUpdateLinsys.stop();
     }
@@ -484,6 +491,70 @@ namespace hiop
     return true;
   }
 
+  size_type hiopKKTLinSysCompressedSparseXDYcYd::
+  copy_offdiag_blocks_to_linsys(hiopMatrixSparse& Msys,
+                                const hiopMatrixSparse& Hess,
+                                const hiopMatrixSparse& Jac_c,
+                                const hiopMatrixSparse& Jac_d)
+  {
+    size_type nx = Hess.n(), nd=Jac_d.m(), neq=Jac_c.m(), nineq=Jac_d.m();
+    size_type dest_nnz_st{0};
+    Msys.copyRowsBlockFrom(Hess,  0,   nx,     0,          dest_nnz_st);
+    dest_nnz_st += Hess.numberOfNonzeros();
+    Msys.copyRowsBlockFrom(Jac_c, 0,   neq,    nx+nd,      dest_nnz_st);
+    dest_nnz_st += Jac_c.numberOfNonzeros();
+    Msys.copyRowsBlockFrom(Jac_d, 0,   nineq,  nx+nd+neq,  dest_nnz_st);
+    dest_nnz_st += Jac_d.numberOfNonzeros();
+
+    // minus identity matrix for slack variables
+    Msys.copyDiagMatrixToSubblock(-1., nx+nd+neq, nx, dest_nnz_st, nineq);
+    dest_nnz_st += nineq;
+    return dest_nnz_st;
+  }
+
+  hiopLinSolverSymSparse* hiopKKTLinSysCompressedSparseXDYcYd::
+  factorize_lsq_duals_matrix(const hiopMatrix& Jac_c, const hiopMatrix& Jac_d, const hiopMatrix& Hess)
+  {
+    const auto* HessSp = dynamic_cast<const hiopMatrixSymSparseTriplet*>(&Hess);
+    const auto* Jac_cSp = dynamic_cast<const hiopMatrixSparseTriplet*>(&Jac_c);
+    const auto* Jac_dSp = dynamic_cast<const hiopMatrixSparseTriplet*>(&Jac_d);
+    if(!HessSp || !Jac_cSp || !Jac_dSp) { assert(false); return nullptr; }
+
+    size_type nx = HessSp->n(), nd=Jac_dSp->m(), neq=Jac_cSp->m(), nineq=Jac_dSp->m();
+    int nnz = HessSp->numberOfNonzeros() + Jac_cSp->numberOfNonzeros() + Jac_dSp->numberOfNonzeros() + nd + nx + nd + neq + nineq;
+
+    // the same linear solver (and sizes) as the ones 'build_kkt_matrix' will use
+    linSys_ = determineAndCreateLinsys(nx, neq, nineq, nnz);
+
+    auto* linSys = dynamic_cast<hiopLinSolverSymSparse*> (linSys_);
+    assert(linSys);
+
+    auto* Msys = dynamic_cast<hiopMatrixSparseTriplet*>(linSys->sysMatrix());
+    assert(Msys);
+
+    Msys->setToZero();
+    size_type dest_nnz_st = copy_offdiag_blocks_to_linsys(*Msys, *HessSp, *Jac_cSp, *Jac_dSp);
+
+    // the Hessian block stays in the pattern, but does not contribute to the LSQ system
+    std::fill(Msys->M(), Msys->M()+HessSp->numberOfNonzeros(), 0.);
+
+    // identity for the x and d blocks, zero diagonal for the yc and yd blocks
+    Msys->setSubDiagonalTo(0, nx+nd, 1.0, dest_nnz_st);
+    dest_nnz_st += nx+nd;
+    Msys->setSubDiagonalTo(nx+nd, neq+nineq, 0.0, dest_nnz_st);
+    dest_nnz_st += neq+nineq;
+    assert(dest_nnz_st == nnz);
+
+    nlp_->log->write("LSQ Dual Updater --- KKT_SPARSE_XDYcYd linsys:", *Msys, hovMatrices);
+
+    int ret_val = linSys->matrixChanged();
+    if(ret_val<0) {
+      nlp_->log->printf(hovError, "dual lsq update: error %d in the factorization.\n", ret_val);
+      return nullptr;
+    }
+    return linSys;
+  }
+
   bool hiopKKTLinSysCompressedSparseXDYcYd::
   solveCompressed(hiopVector& rx, hiopVector& rd, hiopVector& ryc, hiopVector& ryd,
                   hiopVector& dx, hiopVector& dd, hiopVector& dyc, hiopVector& dyd)
@@ -516,6 +587,10 @@ namespace hiop
     ryc.copyToStarting(*rhs_, nx+nd);
     ryd.copyToStarting(*rhs_, nx+nd+nyc);
 
+    if(equil_) {
+      equil_->apply(*rhs_);
+    }
+
     if(write_linsys_counter_>=0) {
       csr_writer_.writeRhsToFile(*rhs_, write_linsys_counter_);
     }
@@ -541,6 +616,10 @@ namespace hiop
 
     nlp_->runStats.kkt.tmSolveRhsManip.start();
 
+    if(equil_) {
+      equil_->apply(*rhs_);
+    }
+
     //
     // unpack
     //
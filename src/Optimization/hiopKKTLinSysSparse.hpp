@@ -147,7 +147,31 @@ public:
   virtual bool solveCompressed(hiopVector& rx, hiopVector& rd, hiopVector& ryc, hiopVector& ryd,
                                hiopVector& dx, hiopVector& dd, hiopVector& dyc, hiopVector& dyd);
 
+  /**
+   * Builds and factorizes the augmented system of the LSQ-based initialization of the duals
+   *   [    I    0     Jc^T  Jd^T  ]
+   *   [    0    I     0     -I    ]
+   *   [    Jc   0     0     0     ]
+   *   [    Jd   -I    0     0     ]
+   * in the pattern of the KKT matrix, i.e., with the Hessian block present but with zero values. The
+   * linear solver of the KKT, its assembly, and its symbolic analysis are hence shared by the two systems.
+   * 
+   * Returns the linear solver holding the factors, or nullptr if the factorization failed.
+   */
+  hiopLinSolverSymSparse* factorize_lsq_duals_matrix(const hiopMatrix& Jac_c,
+                                                      const hiopMatrix& Jac_d,
+                                                      const hiopMatrix& Hess);
+
 protected:
+  /**
+   * Copies the Hessian, the Jacobians, and the -I block of the slacks into 'Msys' and returns the number
+   * of nonzeros copied, which is where the diagonal blocks of the system start.
+   */
+  size_type copy_offdiag_blocks_to_linsys(hiopMatrixSparse& Msys,
+                                          const hiopMatrixSparse& Hess,
+                                          const hiopMatrixSparse& Jac_c,
+                                          const hiopMatrixSparse& Jac_d);
+
   hiopVector *rhs_; //[rx_tilde, rd_tilde, ryc, ryd]
 
   //
@@ -64,6 +64,8 @@
 
 #include <stdlib.h>     /* exit, EXIT_FAILURE */
 #include <cassert>
+#include <mutex>
+#include <algorithm>
 
 #ifdef HIOP_USE_RAJA
 #include "hiopRajaUmpireUtils.hpp"
@@ -82,19 +84,27 @@ hiopNlpFormulation::hiopNlpFormulation(hiopInterfaceBase& interface_, const char
 {
   strFixedVars_ = ""; //uninitialized
   dFixedVarsTol_ = -1.; //uninitialized
+  strPresolve_ = ""; //uninitialized
   bool bret;
 #ifdef HIOP_USE_MPI
   bret = interface_base.get_MPI_comm(comm_); assert(bret);
 
   int nret;
-  //MPI may not be initialized: this occurs when a serial driver call HiOp built with MPI support on
-  int initialized;
-  nret = MPI_Initialized( &initialized );
-  if(!initialized) {
-    mpi_init_called=true;
-    nret = MPI_Init(NULL,NULL);
-    assert(MPI_SUCCESS==nret);
-  } 
+  //MPI may not be initialized: this occurs when a serial driver call HiOp built with MPI support on.
+  //The check-and-init is serialized so that NLPs constructed concurrently by several threads do not
+  //race on it; when HiOp initializes MPI it asks for full thread support for the same reason.
+  {
+    static std::mutex mpi_init_mutex;
+    std::lock_guard<std::mutex> lock(mpi_init_mutex);
+    int initialized;
+    nret = MPI_Initialized( &initialized );
+    if(!initialized) {
+      mpi_init_called=true;
+      int provided;
+      nret = MPI_Init_thread(NULL, NULL, MPI_THREAD_MULTIPLE, &provided);
+      assert(MPI_SUCCESS==nret);
+    }
+  }
   
   nret=MPI_Comm_rank(comm_, &rank_); assert(MPI_SUCCESS==nret);
   nret=MPI_Comm_size(comm_, &num_ranks_); assert(MPI_SUCCESS==nret);
@@ -110,6 +120,20 @@ hiopNlpFormulation::hiopNlpFormulation(hiopInterfaceBase& interface_, const char
 
   options->SetLog(log);
 
+#ifdef HIOP_USE_MPI
+  {
+    //concurrent solves from threads other than the main one need MPI_THREAD_MULTIPLE
+    int is_main_thread, thread_level;
+    nret = MPI_Is_thread_main(&is_main_thread); assert(MPI_SUCCESS==nret);
+    nret = MPI_Query_thread(&thread_level); assert(MPI_SUCCESS==nret);
+    if(!is_main_thread && thread_level<MPI_THREAD_MULTIPLE) {
+      log->printf(hovWarning,
+                  "NLP created on a non-main thread but MPI does not provide MPI_THREAD_MULTIPLE; "
+                  "concurrent solves are not safe\n");
+    }
+  }
+#endif
+
   runStats = hiopRunStats(comm_);
 
   /* NLP members intialization */
@@ -126,6 +150,7 @@ hiopNlpFormulation::hiopNlpFormulation(hiopInterfaceBase& interface_, const char
   cons_ineq_type_ = nullptr;
   cons_eq_mapping_= nullptr;
   cons_ineq_mapping_= nullptr;
+  n_cons_lin_ = 0;
   idl_ = nullptr;
   idu_ = nullptr;
 #ifdef HIOP_USE_MPI
@@ -135,8 +160,12 @@ hiopNlpFormulation::hiopNlpFormulation(hiopInterfaceBase& interface_, const char
   cons_body_ = nullptr;
   cons_Jac_ =  nullptr;
   cons_lambdas_ = nullptr;
+  zl_user_ = nullptr;
+  zu_user_ = nullptr;
   nlp_scaling_ = nullptr;
   relax_bounds_ = nullptr;
+  fixed_vars_remover_ = nullptr;
+  presolver_ = nullptr;
 }
 
 hiopNlpFormulation::~hiopNlpFormulation()
@@ -174,11 +203,16 @@ hiopNlpFormulation::~hiopNlpFormulation()
   delete cons_body_;
   delete cons_Jac_;
   delete cons_lambdas_;
+  delete zl_user_;
+  delete zu_user_;
   /// nlp_scaling_ and relax_bounds_ are deleted inside nlp_transformations_
 }
 
 bool hiopNlpFormulation::finalizeInitialization()
 {
+  //the user may have changed the output options
+  log->reload_options();
+
   //check if there was a change in the user options that requires reinitialization of 'this'
   bool doinit = false; 
   if(strFixedVars_ != options->GetString("fixed_var")) {
@@ -188,6 +222,9 @@ bool hiopNlpFormulation::finalizeInitialization()
   if(dFixedVarsTol_ != fixedVarTol) {
     doinit=true;
   }
+  if(strPresolve_ != options->GetString("presolve")) {
+    doinit=true;
+  }
 
   //more checks whether we should reinitialize go here (for example change in the rescaling option)
   
@@ -204,6 +241,8 @@ bool hiopNlpFormulation::finalizeInitialization()
   ////////////////////////////////////////////////////////////////////////////
   bool bret = interface_base.get_prob_sizes(n_vars_, n_cons_); assert(bret);
   nlp_transformations_.clear();
+  fixed_vars_remover_ = nullptr;
+  presolver_ = nullptr;
   nlp_transformations_.setUserNlpNumVars(n_vars_);
 
   delete xl_;
@@ -282,7 +321,10 @@ bool hiopNlpFormulation::finalizeInitialization()
       
 
 #ifdef HIOP_USE_MPI
-      fixedVarsRemover->setFSVectorDistrib(vec_distrib_,num_ranks_);
+      //non-distributed NLPs (for example, the sparse and MDS ones) have no vector distribution
+      if(vec_distrib_ != nullptr) {
+        fixedVarsRemover->setFSVectorDistrib(vec_distrib_,num_ranks_);
+      }
       fixedVarsRemover->setMPIComm(comm_);
 #endif
       bret = fixedVarsRemover->setupDecisionVectorPart(); 
@@ -290,9 +332,11 @@ bool hiopNlpFormulation::finalizeInitialization()
     
       n_vars_ = fixedVarsRemover->rs_n();
 #ifdef HIOP_USE_MPI
-      index_type* vec_distrib_rs = fixedVarsRemover->allocRSVectorDistrib();
-      delete[] vec_distrib_;
-      vec_distrib_ = vec_distrib_rs;
+      if(vec_distrib_ != nullptr) {
+        index_type* vec_distrib_rs = fixedVarsRemover->allocRSVectorDistrib();
+        delete[] vec_distrib_;
+        vec_distrib_ = vec_distrib_rs;
+      }
 #endif
     
       hiopVector* xl_rs;
@@ -335,6 +379,7 @@ bool hiopNlpFormulation::finalizeInitialization()
       n_bnds_lu_        -= nfixed_vars_local;
       
       nlp_transformations_.append(fixedVarsRemover);
+      fixed_vars_remover_ = fixedVarsRemover;
     } else {
       /*
       * Relax fixed variables according to 2 conditions:
@@ -377,6 +422,12 @@ bool hiopNlpFormulation::finalizeInitialization()
   //save the new value of 'fixed_var' option
   strFixedVars_ = options->GetString("fixed_var");
 
+  if(!presolve_constraints()) {
+    log->printf(hovError,  "Presolve of the constraints failed.\n");
+    return false;
+  }
+  strPresolve_ = options->GetString("presolve");
+
   //compute the overall n_low and n_upp
 #ifdef HIOP_USE_MPI
   size_type aux[3]={n_bnds_low_local_, n_bnds_upp_local_, n_bnds_lu_};
@@ -426,6 +477,11 @@ bool hiopNlpFormulation::finalizeInitialization()
   delete cons_lambdas_;
   cons_lambdas_ = nullptr;
 
+  delete zl_user_;
+  zl_user_ = nullptr;
+  delete zu_user_;
+  zu_user_ = nullptr;
+
   return bret;
 }
 
@@ -576,11 +632,29 @@ bool hiopNlpFormulation::process_constraints()
   }
   assert(it_eq==n_cons_eq_); assert(it_ineq==n_cons_ineq_);
 
+  /* the linear constraints: the Jacobian rows of the linear constraints are constant */
+  cons_type_user_.assign(cons_type, cons_type+n_cons_);
+  n_cons_lin_ = 0;
+  for(int i=0; i<n_cons_; i++) {
+    if(cons_type[i]==hiopInterfaceBase::hiopLinear) {
+      n_cons_lin_++;
+    }
+  }
+  if(n_cons_lin_>0) {
+    log->printf(hovScalars, "%d linear constraints: their Jacobian rows are evaluated once per solve\n", n_cons_lin_);
+  }
+
   /* delete the temporary buffers */
   delete gl; 
   delete gu; 
   delete[] cons_type;
 
+  build_ineq_bounds_indicators();
+  return true;
+}
+
+void hiopNlpFormulation::build_ineq_bounds_indicators()
+{
   delete idl_; 
   delete idu_;
   /* iterate over the inequalities and build the idl(ow) and idu(pp) vectors */
@@ -590,6 +664,8 @@ bool hiopNlpFormulation::process_constraints()
   n_ineq_upp_ = 0; 
   n_ineq_lu_ = 0;
 
+  const double* dl_vec = dl_->local_data_host_const();
+  const double* du_vec = du_->local_data_host_const();
   double* idl_vec= idl_->local_data_host(); 
   double* idu_vec= idu_->local_data_host();
   for(int i=0; i<n_cons_ineq_; i++) {
@@ -609,7 +685,6 @@ bool hiopNlpFormulation::process_constraints()
       idu_vec[i]=0.;
     }
   }
-  return true;
 }
 
 bool hiopNlpFormulation::apply_scaling(hiopVector& c, hiopVector& d, hiopVector& gradf, 
@@ -666,7 +741,8 @@ hiopVector* hiopNlpFormulation::alloc_dual_ineq_vec() const
 
 hiopVector* hiopNlpFormulation::alloc_dual_vec() const
 {
-  assert(n_cons_eq_+n_cons_ineq_ == n_cons_);
+  //the user's constraints, which include the ones removed by the presolve
+  assert(n_cons_eq_+n_cons_ineq_ <= n_cons_);
   hiopVector* ret = LinearAlgebraFactory::create_vector(options->GetString("mem_space"),
                                                         n_cons_);
 #ifdef HIOP_DEEPCHECKS
@@ -711,9 +787,7 @@ bool hiopNlpFormulation::get_starting_point(hiopVector& x0_for_hiop,
 {
   bool bret; 
 
-  hiopVector* lambdas = hiop::LinearAlgebraFactory::
-    create_vector(options->GetString("mem_space"),
-                  yc0_for_hiop.get_size() + yd0_for_hiop.get_size());
+  hiopVector* lambdas = hiop::LinearAlgebraFactory::create_vector(options->GetString("mem_space"), n_cons_);
 
   hiopVector* x0_for_user = nlp_transformations_.apply_inv_to_x(x0_for_hiop, true);
   double* zL0_for_user = zL0_for_hiop.local_data();
@@ -736,9 +810,8 @@ bool hiopNlpFormulation::get_starting_point(hiopVector& x0_for_hiop,
 
     assert(n_cons_eq_   == yc0_for_hiop.get_size() && "when did the cons change?");
     assert(n_cons_ineq_ == yd0_for_hiop.get_size() && "when did the cons change?");
-    assert(n_cons_eq_+n_cons_ineq_ == n_cons_);
     
-    //copy back 
+    //copy back (the multipliers of the constraints removed by the presolve are dropped)
     lambdas->copy_to_two_vec_w_pattern(yc0_for_hiop, *cons_eq_mapping_, yd0_for_hiop, *cons_ineq_mapping_);
   }
   if(!bret) {
@@ -765,8 +838,7 @@ bool hiopNlpFormulation::get_starting_point(hiopVector& x0_for_hiop,
 {
   bool bret; 
 
-  hiopVector* lambdas = hiop::LinearAlgebraFactory::create_vector(options->GetString("mem_space"),
-                                                                  yc0_for_hiop.get_size() + yd0_for_hiop.get_size());
+  hiopVector* lambdas = hiop::LinearAlgebraFactory::create_vector(options->GetString("mem_space"), n_cons_);
   
   hiopVector* x0_for_user = nlp_transformations_.apply_inv_to_x(x0_for_hiop, true);
   double* zL0_for_user = zL0_for_hiop.local_data();
@@ -791,9 +863,8 @@ bool hiopNlpFormulation::get_starting_point(hiopVector& x0_for_hiop,
 
     assert(n_cons_eq_   == yc0_for_hiop.get_size() && "when did the cons change?");
     assert(n_cons_ineq_ == yd0_for_hiop.get_size() && "when did the cons change?");
-    assert(n_cons_eq_+n_cons_ineq_ == n_cons_);
     
-    //copy back 
+    //copy back (the multipliers of the constraints removed by the presolve are dropped)
     lambdas->copy_to_two_vec_w_pattern(yc0_for_hiop, *cons_eq_mapping_, yd0_for_hiop, *cons_ineq_mapping_);
   }
   
@@ -816,42 +887,41 @@ bool hiopNlpFormulation::get_starting_point(hiopVector& x0_for_hiop,
 bool hiopNlpFormulation::eval_c(hiopVector& x, bool new_x, hiopVector& c)
 {
   hiopVector* xx = nlp_transformations_.apply_inv_to_x(x, new_x);
-  hiopVector* cc = &c;
-  // nlp_transformations_.apply_inv_to_cons_eq(c, n_cons_eq_);  // NOT required
-  
+  //the user's equalities, which include the ones removed by the presolve
+  hiopVector* cc = nlp_transformations_.apply_inv_to_cons_eq(c, n_cons_eq_);
 
   runStats.tmEvalCons.start();
   bool bret = interface_base.eval_cons(nlp_transformations_.n_pre(),
                                        n_cons_,
-                                       n_cons_eq_,
-                                       cons_eq_mapping_->local_data_const(),
+                                       user_m_eq(),
+                                       user_cons_eq_mapping().local_data_const(),
                                        xx->local_data_const(),
                                        new_x,
                                        cc->local_data());
   runStats.tmEvalCons.stop(); runStats.nEvalCons_eq++;
 
   // scale the constraint
-  c = *(nlp_transformations_.apply_to_cons_eq(c, n_cons_eq_));
+  c = *(nlp_transformations_.apply_to_cons_eq(*cc, n_cons_eq_));
   return bret;
 }
 bool hiopNlpFormulation::eval_d(hiopVector& x, bool new_x, hiopVector& d)
 {
   hiopVector* xx = nlp_transformations_.apply_inv_to_x(x, new_x);
-  hiopVector* dd = &d;
-  // nlp_transformations_.apply_inv_to_cons_ineq(d, n_cons_ineq_);  // NOT required for now
+  //the user's inequalities, which include the ones removed by the presolve
+  hiopVector* dd = nlp_transformations_.apply_inv_to_cons_ineq(d, n_cons_ineq_);
 
   runStats.tmEvalCons.start();
   bool bret = interface_base.eval_cons(nlp_transformations_.n_pre(),
                                        n_cons_,
-                                       n_cons_ineq_,
-                                       cons_ineq_mapping_->local_data_const(),
+                                       user_m_ineq(),
+                                       user_cons_ineq_mapping().local_data_const(),
                                        xx->local_data_const(),
                                        new_x,
                                        dd->local_data());
   runStats.tmEvalCons.stop(); runStats.nEvalCons_ineq++;
 
   // scale the constraint
-  d = *(nlp_transformations_.apply_to_cons_ineq(d, n_cons_ineq_));
+  d = *(nlp_transformations_.apply_to_cons_ineq(*dd, n_cons_ineq_));
   return bret;
 }
 
@@ -893,6 +963,8 @@ bool hiopNlpFormulation::eval_c_d(hiopVector& x, bool new_x, hiopVector& c, hiop
     hiopVector* xx = nlp_transformations_.apply_inv_to_x(x, new_x);
     // FIXME do NOT support removing fixed var for now
     // double* body = cons_body_;//nlp_transformations_.apply_inv_to_cons(d, n_cons_ineq_); //not needed for now
+    hiopVector* cc = nlp_transformations_.apply_inv_to_cons_eq(c, n_cons_eq_);
+    hiopVector* dd = nlp_transformations_.apply_inv_to_cons_ineq(d, n_cons_ineq_);
 
     runStats.tmEvalCons.start();
     bool bret = interface_base.eval_cons(nlp_transformations_.n_pre(),
@@ -900,14 +972,14 @@ bool hiopNlpFormulation::eval_c_d(hiopVector& x, bool new_x, hiopVector& c, hiop
                                          xx->local_data_const(),
                                          new_x,
                                          cons_body_->local_data());
-    //copy back to c and d
-    cons_body_->copy_to_two_vec_w_pattern(c, *cons_eq_mapping_, d, *cons_ineq_mapping_);
+    //copy back to the user's equalities and inequalities
+    cons_body_->copy_to_two_vec_w_pattern(*cc, user_cons_eq_mapping(), *dd, user_cons_ineq_mapping());
     
     // scale c
-    c = *(nlp_transformations_.apply_to_cons_eq(c, n_cons_eq_));
+    c = *(nlp_transformations_.apply_to_cons_eq(*cc, n_cons_eq_));
     
     // scale d
-    d = *(nlp_transformations_.apply_to_cons_ineq(d, n_cons_ineq_));
+    d = *(nlp_transformations_.apply_to_cons_ineq(*dd, n_cons_ineq_));
     
     runStats.tmEvalCons.stop();
     runStats.nEvalCons_eq++;
@@ -962,18 +1034,54 @@ bool hiopNlpFormulation::eval_Jac_c_d(hiopVector& x, bool new_x, hiopMatrix& Jac
 void hiopNlpFormulation::
 get_dual_solutions(const hiopIterate& it, double* zl_a, double* zu_a, double* lambda_a)
 {
-  const hiopVector& zl = *it.get_zl();
-  const hiopVector& zu = *it.get_zu();
-  zl.copyTo(zl_a);
-  zu.copyTo(zu_a);
-  
   if(cons_lambdas_ == nullptr) {
     cons_lambdas_ = this->alloc_dual_vec();
+    //the multipliers of the constraints removed by the presolve are set by 'postsolve_duals'
+    cons_lambdas_->setToZero();
   }
   cons_lambdas_->copy_from_two_vec_w_pattern(*it.get_yc(), *cons_eq_mapping_, *it.get_yd(), *cons_ineq_mapping_);
+
+  const hiopVector* zl = it.get_zl();
+  const hiopVector* zu = it.get_zu();
+  postsolve_duals(zl, zu);
+  zl->copyTo(zl_a);
+  zu->copyTo(zu_a);
   cons_lambdas_->copyTo(lambda_a);
 }
 
+void hiopNlpFormulation::postsolve_duals(const hiopVector*& zl, const hiopVector*& zu)
+{
+  if(nullptr == presolver_) {
+    return;
+  }
+  if(nullptr == zl_user_) {
+    zl_user_ = zl->alloc_clone();
+    zu_user_ = zu->alloc_clone();
+  }
+  zl_user_->copyFrom(*zl);
+  zu_user_->copyFrom(*zu);
+  presolver_->postsolve_duals(*zl_user_, *zu_user_, *cons_lambdas_);
+  zl = zl_user_;
+  zu = zu_user_;
+}
+
+void hiopNlpFormulation::get_transformations_key(std::vector<index_type>& key) const
+{
+  key.clear();
+  if(fixed_vars_remover_) {
+    const std::vector<int>& fs2rs = fixed_vars_remover_->get_fs2rs_idx_map();
+    key.push_back(fs2rs.size());
+    key.insert(key.end(), fs2rs.begin(), fs2rs.end());
+  }
+  if(presolver_) {
+    const hiopVectorInt* maps[] = {&presolver_->eq_rs2fs(), &presolver_->ineq_rs2fs()};
+    for(const hiopVectorInt* map : maps) {
+      key.push_back(map->size());
+      key.insert(key.end(), map->local_data_const(), map->local_data_const()+map->size());
+    }
+  }
+}
+
 void hiopNlpFormulation::user_callback_solution(hiopSolveStatus status,
                                                 const hiopVector& x,
                                                 const hiopVector& z_L,
@@ -990,18 +1098,26 @@ void hiopNlpFormulation::user_callback_solution(hiopSolveStatus status,
 
   if(cons_lambdas_ == nullptr) {
     cons_lambdas_ = this->alloc_dual_vec();
+    //the multipliers of the constraints removed by the presolve are set by 'postsolve_duals'
+    cons_lambdas_->setToZero();
   }
   cons_lambdas_->copy_from_two_vec_w_pattern(y_c, *cons_eq_mapping_, y_d, *cons_ineq_mapping_);
+  const hiopVector* zl_user = &z_L;
+  const hiopVector* zu_user = &z_U;
+  postsolve_duals(zl_user, zu_user);
 
   //concatenate 'c' and 'd' into user's constraint body
   if(cons_body_ == nullptr) {
     cons_body_ = cons_lambdas_->alloc_clone();
   }
   if(nlp_scaling_) {
-    c = *(nlp_transformations_.apply_to_cons_eq(c, n_cons_eq_));
-    d = *(nlp_transformations_.apply_to_cons_ineq(d, n_cons_ineq_));
+    c = *(nlp_scaling_->apply_to_cons_eq(c, n_cons_eq_));
+    d = *(nlp_scaling_->apply_to_cons_ineq(d, n_cons_ineq_));
   }
   cons_body_->copy_from_two_vec_w_pattern(c, *cons_eq_mapping_, d, *cons_ineq_mapping_);
+  if(presolver_) {
+    presolver_->postsolve_cons_body(x, *cons_body_);
+  }
 
   //! todo -> test this when fixed variables are removed -> the internal
   //! zl and zu may have different sizes than what user expects since HiOp removes
@@ -1009,8 +1125,8 @@ void hiopNlpFormulation::user_callback_solution(hiopSolveStatus status,
   interface_base.solution_callback(status, 
                                    (int)n_vars_,
                                    x.local_data_const(),
-                                   z_L.local_data_const(),
-                                   z_U.local_data_const(),
+                                   zl_user->local_data_const(),
+                                   zu_user->local_data_const(),
                                    (int)n_cons_,
                                    cons_body_->local_data_const(),
                                    cons_lambdas_->local_data_const(),
@@ -1037,21 +1153,30 @@ bool hiopNlpFormulation::user_callback_iterate(int iter,
                                                int ls_trials)
 {
   assert(x.get_size()==n_vars_);
-  assert(c.get_size()+d.get_size()==n_cons_);
+  assert(c.get_size() == n_cons_eq_);
+  assert(d.get_size() == n_cons_ineq_);
 
   assert(y_c.get_size() == n_cons_eq_);
   assert(y_d.get_size() == n_cons_ineq_);
 
   if(cons_lambdas_ == NULL) {
     cons_lambdas_ = this->alloc_dual_vec();
+    //the multipliers of the constraints removed by the presolve are set by 'postsolve_duals'
+    cons_lambdas_->setToZero();
   }
   cons_lambdas_->copy_from_two_vec_w_pattern(y_c, *cons_eq_mapping_, y_d, *cons_ineq_mapping_);
+  const hiopVector* zl_user = &z_L;
+  const hiopVector* zu_user = &z_U;
+  postsolve_duals(zl_user, zu_user);
 
   //concatenate 'c' and 'd' into user's constrainty body
   if(cons_body_ == NULL) {
     cons_body_ = cons_lambdas_->alloc_clone();
   }
   cons_body_->copy_from_two_vec_w_pattern(c, *cons_eq_mapping_, d, *cons_ineq_mapping_);
+  if(presolver_) {
+    presolver_->postsolve_cons_body(x, *cons_body_);
+  }
 
   //! todo -> test this when fixed variables are removed -> the internal
   //! zl and zu may have different sizes than what user expects since HiOp removes
@@ -1062,8 +1187,8 @@ bool hiopNlpFormulation::user_callback_iterate(int iter,
                                          logbar_obj_value,
                                          (int)n_vars_,
                                          x.local_data_const(),
-                                         z_L.local_data_const(),
-                                         z_U.local_data_const(),
+                                         zl_user->local_data_const(),
+                                         zu_user->local_data_const(),
                                          (int)n_cons_ineq_,
                                          s.local_data_const(),
                                          (int)n_cons_,
@@ -1093,7 +1218,8 @@ bool hiopNlpFormulation::user_force_update(int iter,
 {
   bool retval;
   assert(x.get_size()==n_vars_);
-  assert(c.get_size()+d.get_size()==n_cons_);
+  assert(c.get_size() == n_cons_eq_);
+  assert(d.get_size() == n_cons_ineq_);
 
   assert(y_c.get_size() == n_cons_eq_);
   assert(y_d.get_size() == n_cons_ineq_);
@@ -1160,6 +1286,98 @@ void hiopNlpFormulation::reset_bounds(double bound_relax_perturb)
   relax_bounds_->relax_from_ori(bound_relax_perturb, *xl_, *xu_, *dl_, *du_);
 }
 
+bool hiopNlpFormulation::eval_Jac_rows_cached(size_type num_cons,
+                                              const index_type* cons_mapping,
+                                              size_type nnz,
+                                              index_type* irow,
+                                              index_type* jcol,
+                                              double* vals,
+                                              size_type ndense,
+                                              double* dense,
+                                              const JacRowsEvalFunc& eval,
+                                              LinearJacTripletRowsCache& cache)
+{
+  if(!cache.is_valid) {
+    //first evaluation: all the rows are requested from the user
+    if(!eval(num_cons, cons_mapping, nnz, irow, jcol, vals, dense)) {
+      return false;
+    }
+    cache.idx_nl.clear();
+    cache.rows_nl.clear();
+    cache.nz_nl.clear();
+    std::vector<char> row_is_nl(num_cons, 1);
+    for(index_type i=0; i<num_cons; i++) {
+      if(cons_type_user_[cons_mapping[i]]==hiopInterfaceBase::hiopLinear) {
+        row_is_nl[i] = 0;
+      } else {
+        cache.idx_nl.push_back(cons_mapping[i]);
+        cache.rows_nl.push_back(i);
+      }
+    }
+    cache.is_used = static_cast<size_type>(cache.rows_nl.size()) < num_cons;
+    if(cache.is_used) {
+      cache.irow.assign(irow, irow+nnz);
+      cache.jcol.assign(jcol, jcol+nnz);
+      cache.vals.assign(vals, vals+nnz);
+      cache.dense.assign(dense, dense+num_cons*ndense);
+      for(index_type k=0; k<nnz; k++) {
+        assert(irow[k]>=0 && irow[k]<num_cons);
+        if(row_is_nl[irow[k]]) {
+          cache.nz_nl.push_back(k);
+        }
+      }
+      cache.irow_nl.resize(cache.nz_nl.size());
+      cache.jcol_nl.resize(cache.nz_nl.size());
+      cache.vals_nl.resize(cache.nz_nl.size());
+      cache.dense_nl.resize(cache.rows_nl.size()*ndense);
+    }
+    cache.is_valid = true;
+    return true;
+  }
+
+  if(!cache.is_used) {
+    return eval(num_cons, cons_mapping, nnz, irow, jcol, vals, dense);
+  }
+
+  const size_type num_nl = cache.rows_nl.size();
+  const size_type nnz_nl = cache.nz_nl.size();
+  if(num_nl>0) {
+    bool bret = eval(num_nl,
+                     cache.idx_nl.data(),
+                     nnz_nl,
+                     cache.irow_nl.data(),
+                     cache.jcol_nl.data(),
+                     cache.vals_nl.data(),
+                     cache.dense_nl.data());
+    //the triplets of the rows of the nonlinear constraints should be the ones of the first evaluation
+    for(index_type k=0; bret && k<nnz_nl; k++) {
+      const index_type nz = cache.nz_nl[k];
+      bret = cache.irow_nl[k]>=0 && cache.irow_nl[k]<num_nl &&
+             cache.rows_nl[cache.irow_nl[k]]==cache.irow[nz] && cache.jcol_nl[k]==cache.jcol[nz];
+    }
+    if(!bret) {
+      log->printf(hovWarning,
+                  "The Jacobian rows of the nonlinear constraints could not be evaluated separately; the "
+                  "Jacobian rows of the linear constraints are evaluated at every iteration.\n");
+      cache.is_used = false;
+      return eval(num_cons, cons_mapping, nnz, irow, jcol, vals, dense);
+    }
+  }
+
+  std::copy(cache.irow.begin(), cache.irow.end(), irow);
+  std::copy(cache.jcol.begin(), cache.jcol.end(), jcol);
+  std::copy(cache.vals.begin(), cache.vals.end(), vals);
+  std::copy(cache.dense.begin(), cache.dense.end(), dense);
+  //scatter the rows of the nonlinear constraints
+  for(index_type k=0; k<nnz_nl; k++) {
+    vals[cache.nz_nl[k]] = cache.vals_nl[k];
+  }
+  for(index_type k=0; k<num_nl && ndense>0; k++) {
+    memcpy(dense + cache.rows_nl[k]*ndense, cache.dense_nl.data() + k*ndense, ndense*sizeof(double));
+  }
+  return true;
+}
+
 /* ***********************************************************************************
  *    hiopNlpDenseConstraints class implementation 
  * ***********************************************************************************
@@ -1177,6 +1395,9 @@ hiopNlpDenseConstraints::~hiopNlpDenseConstraints()
 
 bool hiopNlpDenseConstraints::finalizeInitialization()
 {
+  //the Jacobian rows of the linear constraints are evaluated again in the new solve
+  Jac_c_cache_.is_valid = false;
+  Jac_d_cache_.is_valid = false;
   return hiopNlpFormulation::finalizeInitialization();
 }
 
@@ -1273,6 +1494,71 @@ bool hiopNlpDenseConstraints::eval_Jac_c_d_interface_impl(hiopVector& x, bool ne
   return bret;
 }
 
+bool hiopNlpDenseConstraints::eval_Jac_cons_cached(const hiopVector& x_user,
+                                                   bool new_x,
+                                                   size_type num_cons,
+                                                   const index_type* cons_mapping,
+                                                   const hiopInterfaceBase::NonlinearityType* cons_type,
+                                                   hiopMatrixDense& Jac_user,
+                                                   LinearJacRowsCache& cache)
+{
+  if(!cache.is_valid) {
+    //first evaluation: all the rows are requested from the user
+    if(!interface.eval_Jac_cons(nlp_transformations_.n_pre(), n_cons_,
+                                num_cons, cons_mapping,
+                                x_user.local_data_const(), new_x, Jac_user.local_data())) {
+      return false;
+    }
+    cache.idx_nl.clear();
+    cache.rows_nl.clear();
+    for(index_type i=0; i<num_cons; i++) {
+      if(cons_type[i]!=hiopInterfaceBase::hiopLinear) {
+        cache.idx_nl.push_back(cons_mapping[i]);
+        cache.rows_nl.push_back(i);
+      }
+    }
+    delete cache.jac;
+    delete cache.jac_nl;
+    cache.jac = nullptr;
+    cache.jac_nl = nullptr;
+    if(static_cast<size_type>(cache.rows_nl.size()) < num_cons) {
+      cache.jac = Jac_user.new_copy();
+      if(!cache.rows_nl.empty()) {
+        //only the first rows_nl.size() rows of the buffer are used
+        cache.jac_nl = Jac_user.alloc_clone();
+      }
+    }
+    cache.is_valid = true;
+    return true;
+  }
+
+  if(nullptr == cache.jac) {
+    //no linear constraints in this block
+    return interface.eval_Jac_cons(nlp_transformations_.n_pre(), n_cons_,
+                                   num_cons, cons_mapping,
+                                   x_user.local_data_const(), new_x, Jac_user.local_data());
+  }
+
+  const size_type num_nl = cache.idx_nl.size();
+  if(num_nl>0) {
+    if(!interface.eval_Jac_cons(nlp_transformations_.n_pre(), n_cons_,
+                                num_nl, cache.idx_nl.data(),
+                                x_user.local_data_const(), new_x, cache.jac_nl->local_data())) {
+      return false;
+    }
+  }
+  Jac_user.copyFrom(*cache.jac);
+
+  //scatter the rows of the nonlinear constraints
+  const size_type n_local = Jac_user.get_local_size_n();
+  double* Jac_user_data = Jac_user.local_data();
+  const double* jac_nl_data = cache.jac_nl ? cache.jac_nl->local_data() : nullptr;
+  for(index_type k=0; k<num_nl; k++) {
+    memcpy(Jac_user_data + cache.rows_nl[k]*n_local, jac_nl_data + k*n_local, n_local*sizeof(double));
+  }
+  return true;
+}
+
 bool hiopNlpDenseConstraints::eval_Jac_c(hiopVector& x, bool new_x, hiopMatrix& Jac_c)
 {
   hiopMatrixDense* Jac_cde = dynamic_cast<hiopMatrixDense*>(&Jac_c);
@@ -1292,9 +1578,9 @@ bool hiopNlpDenseConstraints::eval_Jac_c(hiopVector& x, bool new_x, hiopMatrix&
     assert(Jac_c_user_de);
 
     runStats.tmEvalJac_con.start();
-    bool bret = interface.eval_Jac_cons(nlp_transformations_.n_pre(), n_cons_,
-                                        n_cons_eq_, cons_eq_mapping_->local_data_const(),
-                                        x_user->local_data_const(), new_x, Jac_c_user_de->local_data());
+    bool bret = eval_Jac_cons_cached(*x_user, new_x,
+                                     n_cons_eq_, cons_eq_mapping_->local_data_const(), cons_eq_type_,
+                                     *Jac_c_user_de, Jac_c_cache_);
     runStats.tmEvalJac_con.stop(); runStats.nEvalJac_con_eq++;
 
     Jac_c = *(nlp_transformations_.apply_to_jacob_eq(*Jac_c_user, n_cons_eq_));
@@ -1326,9 +1612,9 @@ bool hiopNlpDenseConstraints::eval_Jac_d(hiopVector& x, bool new_x, hiopMatrix&
     assert(Jac_d_user_de);
 
     runStats.tmEvalJac_con.start();
-    bool bret = interface.eval_Jac_cons(nlp_transformations_.n_pre(), n_cons_,
-                                        n_cons_ineq_, cons_ineq_mapping_->local_data_const(),
-                                        x_user->local_data_const(), new_x,Jac_d_user_de->local_data());
+    bool bret = eval_Jac_cons_cached(*x_user, new_x,
+                                     n_cons_ineq_, cons_ineq_mapping_->local_data_const(), cons_ineq_type_,
+                                     *Jac_d_user_de, Jac_d_cache_);
     runStats.tmEvalJac_con.stop(); runStats.nEvalJac_con_ineq++;
 
     Jac_d = *(nlp_transformations_.apply_to_jacob_ineq(*Jac_d_user, n_cons_ineq_));
@@ -1408,27 +1694,29 @@ hiopDualsLsqUpdate* hiopNlpMDS::alloc_duals_lsq_updater()
 
 bool hiopNlpMDS::eval_Jac_c(hiopVector& x, bool new_x, hiopMatrix& Jac_c)
 {
-  hiopMatrixMDS* pJac_c = dynamic_cast<hiopMatrixMDS*>(&Jac_c);
+  hiopMatrix* Jac_c_user = nlp_transformations_.apply_inv_to_jacob_eq(Jac_c, n_cons_eq_);
+  hiopMatrixMDS* pJac_c = dynamic_cast<hiopMatrixMDS*>(Jac_c_user);
   assert(pJac_c);
   if(pJac_c) {
     hiopVector* x_user = nlp_transformations_.apply_inv_to_x(x, new_x);
-    
-    // NOT needed for now
-//    hiopMatrix* Jac_c_user = nlp_transformations_.apply_inv_to_jacob_eq(Jac_c, n_cons_eq);
-//    assert(Jac_c_user);
 
     runStats.tmEvalJac_con.start();
     
-    int nnz = pJac_c->sp_nnz();
-    bool bret = interface.eval_Jac_cons(n_vars_, n_cons_, 
-                                        n_cons_eq_, cons_eq_mapping_->local_data_const(), 
-                                        x_user->local_data_const(), new_x,
-                                        pJac_c->n_sp(), pJac_c->n_de(), 
-                                        nnz, pJac_c->sp_irow(), pJac_c->sp_jcol(), pJac_c->sp_M(),
-                                        pJac_c->de_local_data());
-
-    // scale the matrix
-    Jac_c = *(nlp_transformations_.apply_to_jacob_eq(Jac_c, n_cons_eq_));
+    auto eval_rows = [&](size_type num_cons, const index_type* idx_cons, size_type nnz,
+                         index_type* irow, index_type* jcol, double* vals, double* dense) {
+      return interface.eval_Jac_cons(nlp_transformations_.n_pre(), n_cons_,
+                                     num_cons, idx_cons,
+                                     x_user->local_data_const(), new_x,
+                                     pJac_c->n_sp(), pJac_c->n_de(),
+                                     nnz, irow, jcol, vals, dense);
+    };
+    bool bret = eval_Jac_rows_cached(n_cons_eq_, cons_eq_mapping_->local_data_const(),
+                                     pJac_c->sp_nnz(), pJac_c->sp_irow(), pJac_c->sp_jcol(), pJac_c->sp_M(),
+                                     pJac_c->n_de(), pJac_c->de_local_data(),
+                                     eval_rows, Jac_c_rows_cache_);
+
+    // remove the fixed variables and scale the matrix
+    Jac_c = *(nlp_transformations_.apply_to_jacob_eq(*Jac_c_user, n_cons_eq_));
 
     runStats.tmEvalJac_con.stop();
     runStats.nEvalJac_con_eq++;
@@ -1440,26 +1728,28 @@ bool hiopNlpMDS::eval_Jac_c(hiopVector& x, bool new_x, hiopMatrix& Jac_c)
 
 bool hiopNlpMDS::eval_Jac_d(hiopVector& x, bool new_x, hiopMatrix& Jac_d)
 {
-  hiopMatrixMDS* pJac_d = dynamic_cast<hiopMatrixMDS*>(&Jac_d);
+  hiopMatrix* Jac_d_user = nlp_transformations_.apply_inv_to_jacob_ineq(Jac_d, n_cons_ineq_);
+  hiopMatrixMDS* pJac_d = dynamic_cast<hiopMatrixMDS*>(Jac_d_user);
   assert(pJac_d);
   if(pJac_d) {
     hiopVector* x_user      = nlp_transformations_.apply_inv_to_x(x, new_x);
     
-    // NOT needed for now
-//    hiopMatrix* Jac_d_user = nlp_transformations_.apply_inv_to_jacob_ineq(Jac_d, n_cons_ineq_);
-//    assert(Jac_d_user);
-    
     runStats.tmEvalJac_con.start();
   
-    int nnz = pJac_d->sp_nnz();
-    bool bret =  interface.eval_Jac_cons(n_vars_, n_cons_, 
-                                         n_cons_ineq_, cons_ineq_mapping_->local_data_const(), 
-                                         x_user->local_data_const(), new_x,
-                                         pJac_d->n_sp(), pJac_d->n_de(), 
-                                         nnz, pJac_d->sp_irow(), pJac_d->sp_jcol(), pJac_d->sp_M(),
-                                         pJac_d->de_local_data());
-    // scale the matrix
-    Jac_d = *(nlp_transformations_.apply_to_jacob_ineq(Jac_d, n_cons_ineq_));
+    auto eval_rows = [&](size_type num_cons, const index_type* idx_cons, size_type nnz,
+                         index_type* irow, index_type* jcol, double* vals, double* dense) {
+      return interface.eval_Jac_cons(nlp_transformations_.n_pre(), n_cons_,
+                                     num_cons, idx_cons,
+                                     x_user->local_data_const(), new_x,
+                                     pJac_d->n_sp(), pJac_d->n_de(),
+                                     nnz, irow, jcol, vals, dense);
+    };
+    bool bret = eval_Jac_rows_cached(n_cons_ineq_, cons_ineq_mapping_->local_data_const(),
+                                     pJac_d->sp_nnz(), pJac_d->sp_irow(), pJac_d->sp_jcol(), pJac_d->sp_M(),
+                                     pJac_d->n_de(), pJac_d->de_local_data(),
+                                     eval_rows, Jac_d_rows_cache_);
+    // remove the fixed variables and scale the matrix
+    Jac_d = *(nlp_transformations_.apply_to_jacob_ineq(*Jac_d_user, n_cons_ineq_));
 
     runStats.tmEvalJac_con.stop();
     runStats.nEvalJac_con_ineq++;
@@ -1474,9 +1764,12 @@ bool hiopNlpMDS::eval_Jac_c_d_interface_impl(hiopVector& x,
                                              hiopMatrix& Jac_c,
                                              hiopMatrix& Jac_d)
 {
-  hiopMatrixMDS* pJac_c = dynamic_cast<hiopMatrixMDS*>(&Jac_c);
-  hiopMatrixMDS* pJac_d = dynamic_cast<hiopMatrixMDS*>(&Jac_d);
-  hiopMatrixMDS* cons_Jac = dynamic_cast<hiopMatrixMDS*>(cons_Jac_);
+  hiopMatrix* Jac_c_user = nlp_transformations_.apply_inv_to_jacob_eq(Jac_c, n_cons_eq_);
+  hiopMatrix* Jac_d_user = nlp_transformations_.apply_inv_to_jacob_ineq(Jac_d, n_cons_ineq_);
+  hiopMatrix* cons_Jac_user = nlp_transformations_.apply_inv_to_jacob_cons(*cons_Jac_, n_cons_);
+  hiopMatrixMDS* pJac_c = dynamic_cast<hiopMatrixMDS*>(Jac_c_user);
+  hiopMatrixMDS* pJac_d = dynamic_cast<hiopMatrixMDS*>(Jac_d_user);
+  hiopMatrixMDS* cons_Jac = dynamic_cast<hiopMatrixMDS*>(cons_Jac_user);
   if(pJac_c && pJac_d) {
     assert(cons_Jac);
     if(NULL == cons_Jac)
@@ -1487,13 +1780,11 @@ bool hiopNlpMDS::eval_Jac_c_d_interface_impl(hiopVector& x,
     assert(cons_Jac->sp_nnz() == pJac_c->sp_nnz() + pJac_d->sp_nnz());
     
     hiopVector* x_user = nlp_transformations_.apply_inv_to_x(x, new_x);
-    //! todo -> need hiopNlpTransformation::apply_to_jacob_ineq to work with MDS Jacobian
-    //double** Jac_d_user = nlp_transformations_.apply_inv_to_jacob_ineq(Jac_d, n_cons_ineq_);
     
     runStats.tmEvalJac_con.start();
 
     int nnz = cons_Jac->sp_nnz();
-    bool bret = interface.eval_Jac_cons(n_vars_, n_cons_, 
+    bool bret = interface.eval_Jac_cons(nlp_transformations_.n_pre(), n_cons_, 
                                         x_user->local_data_const(), new_x,
                                         pJac_d->n_sp(), pJac_d->n_de(), 
                                         nnz, cons_Jac->sp_irow(), cons_Jac->sp_jcol(), cons_Jac->sp_M(),
@@ -1502,9 +1793,10 @@ bool hiopNlpMDS::eval_Jac_c_d_interface_impl(hiopVector& x,
     pJac_c->copyRowsFrom(*cons_Jac, cons_eq_mapping_->local_data_const(), n_cons_eq_);
     pJac_d->copyRowsFrom(*cons_Jac, cons_ineq_mapping_->local_data_const(), n_cons_ineq_);
 
-    // scale the matrices
-    Jac_c = *(nlp_transformations_.apply_to_jacob_eq(Jac_c, n_cons_eq_));
-    Jac_d = *(nlp_transformations_.apply_to_jacob_ineq(Jac_d, n_cons_ineq_));
+    // remove the fixed variables and scale the matrices
+    cons_Jac_ = nlp_transformations_.apply_to_jacob_cons(*cons_Jac_user, n_cons_);
+    Jac_c = *(nlp_transformations_.apply_to_jacob_eq(*Jac_c_user, n_cons_eq_));
+    Jac_d = *(nlp_transformations_.apply_to_jacob_ineq(*Jac_d_user, n_cons_ineq_));
 
     runStats.tmEvalJac_con.stop();
     runStats.nEvalJac_con_eq++;
@@ -1525,13 +1817,16 @@ bool hiopNlpMDS::eval_Hess_Lagr(const hiopVector& x,
                                 bool new_lambdas,
                                 hiopMatrix& Hess_L)
 {
-  hiopMatrixSymBlockDiagMDS* pHessL = dynamic_cast<hiopMatrixSymBlockDiagMDS*>(&Hess_L);
+  hiopMatrix* Hess_L_user = nlp_transformations_.apply_inv_to_larg_hess(Hess_L, n_vars_);
+  hiopMatrixSymBlockDiagMDS* pHessL = dynamic_cast<hiopMatrixSymBlockDiagMDS*>(Hess_L_user);
   assert(pHessL);
 
   runStats.tmEvalHessL.start();
 
   bool bret = false;
   if(pHessL) {
+    //the Hessian is evaluated at the point as seen by the user (for example, including the fixed variables)
+    hiopVector* x_user = nlp_transformations_.apply_inv_to_x(const_cast<hiopVector&>(x), true);
     
     if(n_cons_eq_ + n_cons_ineq_ != buf_lambda_->get_size()) {
       delete buf_lambda_;
@@ -1549,7 +1844,7 @@ bool hiopNlpMDS::eval_Hess_Lagr(const hiopVector& x,
 
     int nnzHSS = pHessL->sp_nnz(), nnzHSD = 0;
     
-    bret = interface.eval_Hess_Lagr(n_vars_, n_cons_, x.local_data_const(), new_x, 
+    bret = interface.eval_Hess_Lagr(nlp_transformations_.n_pre(), n_cons_, x_user->local_data_const(), new_x, 
                                     obj_factor_with_scale,
                                     buf_lambda_->local_data(), new_lambdas, 
                                     pHessL->n_sp(), pHessL->n_de(),
@@ -1558,7 +1853,11 @@ bool hiopNlpMDS::eval_Hess_Lagr(const hiopVector& x,
                                     nnzHSD, NULL, NULL, NULL);
     assert(nnzHSD==0);
     assert(nnzHSS==pHessL->sp_nnz());
-    
+
+    // remove the fixed variables
+    if(nullptr == nlp_transformations_.apply_to_larg_hess(*Hess_L_user, n_vars_)) {
+      bret = false;
+    }
   } else {
     bret = false;
   }
@@ -1578,7 +1877,96 @@ bool hiopNlpMDS::finalizeInitialization()
     return false;
   }
   assert(0==nnz_sparse_Hess_Lagr_SD);
-  return hiopNlpFormulation::finalizeInitialization();
+  //the Jacobian rows of the linear constraints are evaluated again in the new solve
+  Jac_c_rows_cache_.is_valid = false;
+  Jac_d_rows_cache_.is_valid = false;
+  if(!hiopNlpFormulation::finalizeInitialization()) {
+    return false;
+  }
+  assert(nx_sparse+nx_dense == nlp_transformations_.n_pre());
+  return setup_fixed_vars_removal();
+}
+
+bool hiopNlpMDS::setup_fixed_vars_removal()
+{
+  if(nullptr == fixed_vars_remover_) {
+    return true;
+  }
+  if(!fixed_vars_remover_->has_sparse_part()) {
+    fixed_vars_remover_->setup_mds_part(n_cons_eq_,
+                                        n_cons_ineq_,
+                                        nx_sparse,
+                                        nx_dense,
+                                        nnz_sparse_Jaceq,
+                                        nnz_sparse_Jacineq,
+                                        nnz_sparse_Hess_Lagr_SS);
+
+    //the sparsity patterns of the user's derivatives are obtained at a point with the fixed variables at their
+    //values and are used to build the maps of the nonzeros in the reduced space
+    const size_type n_fs = nlp_transformations_.n_pre();
+    hiopVector* x_rs = alloc_primal_vec();
+    hiopVector* x_fs = LinearAlgebraFactory::create_vector(options->GetString("mem_space"), n_fs);
+    x_rs->setToZero();
+    fixed_vars_remover_->copyRsToFs(*x_rs, *x_fs);
+
+    hiopMatrixMDS* Jac_c_fs = dynamic_cast<hiopMatrixMDS*>(fixed_vars_remover_->jacob_eq_fs());
+    hiopMatrixMDS* Jac_d_fs = dynamic_cast<hiopMatrixMDS*>(fixed_vars_remover_->jacob_ineq_fs());
+    hiopMatrixMDS* Jac_fs = dynamic_cast<hiopMatrixMDS*>(fixed_vars_remover_->jacob_cons_fs());
+    hiopMatrixSymBlockDiagMDS* Hess_fs = dynamic_cast<hiopMatrixSymBlockDiagMDS*>(fixed_vars_remover_->larg_hess_fs());
+    assert(Jac_c_fs && Jac_d_fs && Jac_fs && Hess_fs);
+
+    bool bret = interface.eval_Jac_cons(n_fs, n_cons_,
+                                        n_cons_eq_, cons_eq_mapping_->local_data_const(),
+                                        x_fs->local_data_const(), true,
+                                        nx_sparse, nx_dense,
+                                        Jac_c_fs->sp_nnz(), Jac_c_fs->sp_irow(), Jac_c_fs->sp_jcol(), nullptr,
+                                        Jac_c_fs->de_local_data());
+    bret = bret && interface.eval_Jac_cons(n_fs, n_cons_,
+                                           n_cons_ineq_, cons_ineq_mapping_->local_data_const(),
+                                           x_fs->local_data_const(), true,
+                                           nx_sparse, nx_dense,
+                                           Jac_d_fs->sp_nnz(), Jac_d_fs->sp_irow(), Jac_d_fs->sp_jcol(), nullptr,
+                                           Jac_d_fs->de_local_data());
+    if(!bret) {
+      //the user implements only the one-call Jacobian
+      bret = interface.eval_Jac_cons(n_fs, n_cons_,
+                                     x_fs->local_data_const(), true,
+                                     nx_sparse, nx_dense,
+                                     Jac_fs->sp_nnz(), Jac_fs->sp_irow(), Jac_fs->sp_jcol(), nullptr,
+                                     Jac_fs->de_local_data());
+      if(bret) {
+        Jac_c_fs->copyRowsFrom(*Jac_fs, cons_eq_mapping_->local_data_const(), n_cons_eq_);
+        Jac_d_fs->copyRowsFrom(*Jac_fs, cons_ineq_mapping_->local_data_const(), n_cons_ineq_);
+      }
+    }
+
+    hiopVector* lambda = alloc_dual_vec();
+    lambda->setToZero();
+    size_type nnzHSD = 0;
+    bret = bret && interface.eval_Hess_Lagr(n_fs, n_cons_, x_fs->local_data_const(), true,
+                                            get_obj_scale(), lambda->local_data_const(), true,
+                                            nx_sparse, nx_dense,
+                                            Hess_fs->sp_nnz(), Hess_fs->sp_irow(), Hess_fs->sp_jcol(), nullptr,
+                                            Hess_fs->de_local_data(),
+                                            nnzHSD, nullptr, nullptr, nullptr);
+    delete lambda;
+    delete x_fs;
+    delete x_rs;
+    if(!bret) {
+      log->printf(hovError, "Could not obtain the sparsity patterns of the derivatives needed to remove the "
+                  "fixed variables.\n");
+      return false;
+    }
+    fixed_vars_remover_->setup_nnz_maps();
+  }
+
+  //sizes of the derivatives blocks in the reduced space
+  nx_sparse = fixed_vars_remover_->rs_nx_sp();
+  nx_dense = n_vars_ - nx_sparse;
+  nnz_sparse_Jaceq = fixed_vars_remover_->rs_nnz_jacob_eq();
+  nnz_sparse_Jacineq = fixed_vars_remover_->rs_nnz_jacob_ineq();
+  nnz_sparse_Hess_Lagr_SS = fixed_vars_remover_->rs_nnz_larg_hess();
+  return true;
 }
 
 /* ***********************************************************************************
@@ -1592,27 +1980,54 @@ hiopDualsLsqUpdate* hiopNlpSparse::alloc_duals_lsq_updater()
 
 bool hiopNlpSparse::eval_Jac_c(hiopVector& x, bool new_x, hiopMatrix& Jac_c)
 {
-  hiopMatrixSparse* pJac_c = dynamic_cast<hiopMatrixSparse*>(&Jac_c);
+  hiopMatrix* Jac_c_user = nlp_transformations_.apply_inv_to_jacob_eq(Jac_c, n_cons_eq_);
+  hiopMatrixSparse* pJac_c = dynamic_cast<hiopMatrixSparse*>(Jac_c_user);
   assert(pJac_c);
   if(pJac_c) {
     hiopVector* x_user = nlp_transformations_.apply_inv_to_x(x, new_x);
     
     runStats.tmEvalJac_con.start();
 
-    int nnz = pJac_c->numberOfNonzeros();
-    bool bret = interface.eval_Jac_cons(n_vars_,
-                                        n_cons_,
-                                        n_cons_eq_,
-                                        cons_eq_mapping_->local_data_const(),
-                                        x_user->local_data_const(),
-                                        new_x,
-                                        nnz,
-                                        pJac_c->i_row(),
-                                        pJac_c->j_col(),
-                                        pJac_c->M());
+    auto eval_rows = [&](size_type num_cons, const index_type* idx_cons, size_type nnz,
+                         index_type* irow, index_type* jcol, double* vals, double* dense) {
+      return interface.eval_Jac_cons(nlp_transformations_.n_pre(),
+                                     n_cons_,
+                                     num_cons,
+                                     idx_cons,
+                                     x_user->local_data_const(),
+                                     new_x,
+                                     nnz,
+                                     irow,
+                                     jcol,
+                                     vals);
+    };
+    bool bret;
+    if(fd_jacobian_) {
+      //with finite-difference derivatives the user provides only the sparsity pattern
+      bret = eval_rows(user_m_eq(), user_cons_eq_mapping().local_data_const(), pJac_c->numberOfNonzeros(),
+                       pJac_c->i_row(), pJac_c->j_col(), nullptr, nullptr);
+    } else {
+      bret = eval_Jac_rows_cached(user_m_eq(), user_cons_eq_mapping().local_data_const(),
+                                  pJac_c->numberOfNonzeros(), pJac_c->i_row(), pJac_c->j_col(), pJac_c->M(),
+                                  0, nullptr,
+                                  eval_rows, Jac_c_rows_cache_);
+    }
+    if(bret && fd_jacobian_) {
+      auto cons_eq = [&](const double* xx, double* cons) {
+        return interface.eval_cons(nlp_transformations_.n_pre(),
+                                   n_cons_,
+                                   user_m_eq(),
+                                   user_cons_eq_mapping().local_data_const(),
+                                   xx,
+                                   true,
+                                   cons);
+      };
+      bret = eval_finite_diff(fd_jac_c_, user_m_eq(), cons_eq, *x_user, *pJac_c, false,
+                              "Jacobian of the equalities");
+    }
 
-    // scale the matrix
-    Jac_c = *(nlp_transformations_.apply_to_jacob_eq(Jac_c, n_cons_eq_));
+    // remove the fixed variables and scale the matrix
+    Jac_c = *(nlp_transformations_.apply_to_jacob_eq(*Jac_c_user, n_cons_eq_));
 
     runStats.tmEvalJac_con.stop();
     runStats.nEvalJac_con_eq++;
@@ -1624,28 +2039,54 @@ bool hiopNlpSparse::eval_Jac_c(hiopVector& x, bool new_x, hiopMatrix& Jac_c)
 
 bool hiopNlpSparse::eval_Jac_d(hiopVector& x, bool new_x, hiopMatrix& Jac_d)
 {
-  hiopMatrixSparse* pJac_d = dynamic_cast<hiopMatrixSparse*>(&Jac_d);
+  hiopMatrix* Jac_d_user = nlp_transformations_.apply_inv_to_jacob_ineq(Jac_d, n_cons_ineq_);
+  hiopMatrixSparse* pJac_d = dynamic_cast<hiopMatrixSparse*>(Jac_d_user);
   assert(pJac_d);
   if(pJac_d) {
     hiopVector* x_user = nlp_transformations_.apply_inv_to_x(x, new_x);
 
     runStats.tmEvalJac_con.start();
 
-    int nnz = pJac_d->numberOfNonzeros();
-
-    bool bret =  interface.eval_Jac_cons(n_vars_,
-                                         n_cons_,
-                                         n_cons_ineq_,
-                                         cons_ineq_mapping_->local_data_const(),
-                                         x_user->local_data_const(),
-                                         new_x,
-                                         nnz,
-                                         pJac_d->i_row(),
-                                         pJac_d->j_col(),
-                                         pJac_d->M());
+    auto eval_rows = [&](size_type num_cons, const index_type* idx_cons, size_type nnz,
+                         index_type* irow, index_type* jcol, double* vals, double* dense) {
+      return interface.eval_Jac_cons(nlp_transformations_.n_pre(),
+                                     n_cons_,
+                                     num_cons,
+                                     idx_cons,
+                                     x_user->local_data_const(),
+                                     new_x,
+                                     nnz,
+                                     irow,
+                                     jcol,
+                                     vals);
+    };
+    bool bret;
+    if(fd_jacobian_) {
+      //with finite-difference derivatives the user provides only the sparsity pattern
+      bret = eval_rows(user_m_ineq(), user_cons_ineq_mapping().local_data_const(), pJac_d->numberOfNonzeros(),
+                       pJac_d->i_row(), pJac_d->j_col(), nullptr, nullptr);
+    } else {
+      bret = eval_Jac_rows_cached(user_m_ineq(), user_cons_ineq_mapping().local_data_const(),
+                                  pJac_d->numberOfNonzeros(), pJac_d->i_row(), pJac_d->j_col(), pJac_d->M(),
+                                  0, nullptr,
+                                  eval_rows, Jac_d_rows_cache_);
+    }
+    if(bret && fd_jacobian_) {
+      auto cons_ineq = [&](const double* xx, double* cons) {
+        return interface.eval_cons(nlp_transformations_.n_pre(),
+                                   n_cons_,
+                                   user_m_ineq(),
+                                   user_cons_ineq_mapping().local_data_const(),
+                                   xx,
+                                   true,
+                                   cons);
+      };
+      bret = eval_finite_diff(fd_jac_d_, user_m_ineq(), cons_ineq, *x_user, *pJac_d, false,
+                              "Jacobian of the inequalities");
+    }
 
-    // scale the matrix
-    Jac_d = *(nlp_transformations_.apply_to_jacob_ineq(Jac_d, n_cons_ineq_));
+    // remove the fixed variables and scale the matrix
+    Jac_d = *(nlp_transformations_.apply_to_jacob_ineq(*Jac_d_user, n_cons_ineq_));
 
     runStats.tmEvalJac_con.stop();
     runStats.nEvalJac_con_ineq++;
@@ -1660,9 +2101,12 @@ bool hiopNlpSparse::eval_Jac_c_d_interface_impl(hiopVector& x,
                                                 hiopMatrix& Jac_c,
                                                 hiopMatrix& Jac_d)
 {
-  hiopMatrixSparse* pJac_c = dynamic_cast<hiopMatrixSparse*>(&Jac_c);
-  hiopMatrixSparse* pJac_d = dynamic_cast<hiopMatrixSparse*>(&Jac_d);
-  hiopMatrixSparse* cons_Jac = dynamic_cast<hiopMatrixSparse*>(cons_Jac_);
+  hiopMatrix* Jac_c_user = nlp_transformations_.apply_inv_to_jacob_eq(Jac_c, n_cons_eq_);
+  hiopMatrix* Jac_d_user = nlp_transformations_.apply_inv_to_jacob_ineq(Jac_d, n_cons_ineq_);
+  hiopMatrix* cons_Jac_user = nlp_transformations_.apply_inv_to_jacob_cons(*cons_Jac_, n_cons_);
+  hiopMatrixSparse* pJac_c = dynamic_cast<hiopMatrixSparse*>(Jac_c_user);
+  hiopMatrixSparse* pJac_d = dynamic_cast<hiopMatrixSparse*>(Jac_d_user);
+  hiopMatrixSparse* cons_Jac = dynamic_cast<hiopMatrixSparse*>(cons_Jac_user);
   if(pJac_c && pJac_d) {
     assert(cons_Jac);
     if(NULL == cons_Jac)
@@ -1678,7 +2122,7 @@ bool hiopNlpSparse::eval_Jac_c_d_interface_impl(hiopVector& x,
     bool bret=false;
     if(0==num_jac_eval_)
     {
-      bret = interface.eval_Jac_cons(n_vars_, 
+      bret = interface.eval_Jac_cons(nlp_transformations_.n_pre(), 
                                      n_cons_,
                                      x_user->local_data_const(), 
                                      new_x,
@@ -1689,22 +2133,31 @@ bool hiopNlpSparse::eval_Jac_c_d_interface_impl(hiopVector& x,
       num_jac_eval_++;
     }
     
-    bret = interface.eval_Jac_cons(n_vars_, 
-                                   n_cons_,
-                                   x_user->local_data_const(), 
-                                   new_x,
-                                   nnz, 
-                                   nullptr, 
-                                   nullptr, 
-                                   cons_Jac->M());
+    if(fd_jacobian_) {
+      //the values are approximated by finite differences of the constraints
+      auto cons = [&](const double* xx, double* cons_body) {
+        return interface.eval_cons(nlp_transformations_.n_pre(), n_cons_, xx, true, cons_body);
+      };
+      bret = eval_finite_diff(fd_jac_cons_, n_cons_, cons, *x_user, *cons_Jac, false, "Jacobian");
+    } else {
+      bret = interface.eval_Jac_cons(nlp_transformations_.n_pre(), 
+                                     n_cons_,
+                                     x_user->local_data_const(), 
+                                     new_x,
+                                     nnz, 
+                                     nullptr, 
+                                     nullptr, 
+                                     cons_Jac->M());
+    }
 
-    //copy back to Jac_c and Jac_d
-    pJac_c->copyRowsFrom(*cons_Jac, cons_eq_mapping_->local_data_const(), n_cons_eq_);
-    pJac_d->copyRowsFrom(*cons_Jac, cons_ineq_mapping_->local_data_const(), n_cons_ineq_);
+    //copy back to the Jacobians of the user's equalities and inequalities
+    pJac_c->copyRowsFrom(*cons_Jac, user_cons_eq_mapping().local_data_const(), user_m_eq());
+    pJac_d->copyRowsFrom(*cons_Jac, user_cons_ineq_mapping().local_data_const(), user_m_ineq());
 
-    // scale the matrix
-    Jac_c = *(nlp_transformations_.apply_to_jacob_eq(Jac_c, n_cons_eq_));
-    Jac_d = *(nlp_transformations_.apply_to_jacob_ineq(Jac_d, n_cons_ineq_));
+    // remove the fixed variables and scale the matrices
+    cons_Jac_ = nlp_transformations_.apply_to_jacob_cons(*cons_Jac_user, n_cons_);
+    Jac_c = *(nlp_transformations_.apply_to_jacob_eq(*Jac_c_user, n_cons_eq_));
+    Jac_d = *(nlp_transformations_.apply_to_jacob_ineq(*Jac_d_user, n_cons_ineq_));
 
     runStats.tmEvalJac_con.stop();
     runStats.nEvalJac_con_eq++;
@@ -1725,17 +2178,23 @@ bool hiopNlpSparse::eval_Hess_Lagr(const hiopVector& x,
                                    bool new_lambdas,
                                    hiopMatrix& Hess_L)
 {
-  hiopMatrixSparse* pHessL = dynamic_cast<hiopMatrixSparse*>(&Hess_L);
+  hiopMatrix* Hess_L_user = nlp_transformations_.apply_inv_to_larg_hess(Hess_L, n_vars_);
+  hiopMatrixSparse* pHessL = dynamic_cast<hiopMatrixSparse*>(Hess_L_user);
   assert(pHessL);
   
   runStats.tmEvalHessL.start();
 
   bool bret = false;
   if(pHessL) {
-    if(n_cons_eq_ + n_cons_ineq_ != buf_lambda_->get_size()) {
+    //the Hessian is evaluated at the point as seen by the user (for example, including the fixed variables)
+    hiopVector* x_user = nlp_transformations_.apply_inv_to_x(const_cast<hiopVector&>(x), true);
+
+    //the multipliers are passed to the user for all the user's constraints; the ones of the constraints
+    //removed by the presolve stay zero
+    if(n_cons_ != buf_lambda_->get_size()) {
       delete buf_lambda_;
-      buf_lambda_ = LinearAlgebraFactory::create_vector(options->GetString("mem_space"),
-                                                        n_cons_eq_ + n_cons_ineq_);
+      buf_lambda_ = LinearAlgebraFactory::create_vector(options->GetString("mem_space"), n_cons_);
+      buf_lambda_->setToZero();
     }
     assert(buf_lambda_);
     
@@ -1747,8 +2206,7 @@ bool hiopNlpSparse::eval_Hess_Lagr(const hiopVector& x,
       copy_from_two_vec_w_pattern(lambda_eq, *cons_eq_mapping_, lambda_ineq, *cons_ineq_mapping_);
 
     // scale lambda before passing it to user interface to compute Hess
-    int n_cons_eq_ineq = n_cons_eq_ + n_cons_ineq_;
-    buf_lambda_ = nlp_transformations_.apply_to_cons(*buf_lambda_, n_cons_eq_ineq);
+    buf_lambda_ = nlp_transformations_.apply_to_cons(*buf_lambda_, n_cons_);
     
     double obj_factor_with_scale = obj_factor*get_obj_scale();
 
@@ -1756,9 +2214,9 @@ bool hiopNlpSparse::eval_Hess_Lagr(const hiopVector& x,
 
     if(0==num_hess_eval_)
     {
-      bret = interface.eval_Hess_Lagr(n_vars_,
+      bret = interface.eval_Hess_Lagr(nlp_transformations_.n_pre(),
                                       n_cons_,
-                                      x.local_data_const(),
+                                      x_user->local_data_const(),
                                       new_x,
                                       obj_factor_with_scale,
                                       buf_lambda_->local_data(),
@@ -1770,19 +2228,48 @@ bool hiopNlpSparse::eval_Hess_Lagr(const hiopVector& x,
       num_hess_eval_++;
     }
 
-    bret = interface.eval_Hess_Lagr(n_vars_,
-                                    n_cons_,
-                                    x.local_data_const(),
-                                    new_x,
-                                    obj_factor_with_scale,
-                                    buf_lambda_->local_data(),
-                                    new_lambdas,
-                                    nnzHSS,
-                                    nullptr,
-                                    nullptr,
-                                    pHessL->M());
+    if(fd_hessian_) {
+      //the values are approximated by finite differences of the gradient of the Lagrangian; the term of
+      //the constraints uses the user's Jacobian and is skipped when all the constraints are linear
+      const size_type n_user = nlp_transformations_.n_pre();
+      const bool with_cons = n_cons_lin_<n_cons_;
+      assert(!with_cons || !fd_jacobian_);
+      bret = true;
+      if(with_cons && -1==fd_jac_nnz_eq_) {
+        bret = get_Jac_pattern_finite_diff(x_user->local_data_const());
+      }
+      const double* lambda_arr = buf_lambda_->local_data_const();
+      auto grad_lagr = [&](const double* xx, double* g) {
+        if(!interface.eval_grad_f(n_user, xx, true, g)) {
+          return false;
+        }
+        for(index_type i=0; i<n_user; i++) {
+          g[i] *= obj_factor_with_scale;
+        }
+        return !with_cons || add_Jac_trans_lambda(xx, lambda_arr, g);
+      };
+      if(bret) {
+        bret = eval_finite_diff(fd_hess_, n_user, grad_lagr, *x_user, *pHessL, true, "Hessian");
+      }
+    } else {
+      bret = interface.eval_Hess_Lagr(nlp_transformations_.n_pre(),
+                                      n_cons_,
+                                      x_user->local_data_const(),
+                                      new_x,
+                                      obj_factor_with_scale,
+                                      buf_lambda_->local_data(),
+                                      new_lambdas,
+                                      nnzHSS,
+                                      nullptr,
+                                      nullptr,
+                                      pHessL->M());
+    }
     assert(nnzHSS==pHessL->numberOfNonzeros());
 
+    // remove the fixed variables
+    if(nullptr == nlp_transformations_.apply_to_larg_hess(*Hess_L_user, n_vars_)) {
+      bret = false;
+    }
   } else {
     bret = false;
   }
@@ -1793,6 +2280,50 @@ bool hiopNlpSparse::eval_Hess_Lagr(const hiopVector& x,
   return bret;
 }
 
+bool hiopNlpSparse::eval_Hess_Lagr_structure(const hiopVector& x, hiopMatrix& Hess_L)
+{
+  if(num_hess_eval_>0) {
+    //the pattern was obtained from the user already
+    return true;
+  }
+  hiopMatrix* Hess_L_user = nlp_transformations_.apply_inv_to_larg_hess(Hess_L, n_vars_);
+  hiopMatrixSparse* pHessL = dynamic_cast<hiopMatrixSparse*>(Hess_L_user);
+  assert(pHessL);
+  if(nullptr == pHessL) {
+    return false;
+  }
+  hiopVector* x_user = nlp_transformations_.apply_inv_to_x(const_cast<hiopVector&>(x), true);
+
+  if(n_cons_ != buf_lambda_->get_size()) {
+    delete buf_lambda_;
+    buf_lambda_ = LinearAlgebraFactory::create_vector(options->GetString("mem_space"), n_cons_);
+  }
+  buf_lambda_->setToZero();
+
+  runStats.tmEvalHessL.start();
+  int nnzHSS = pHessL->numberOfNonzeros();
+  bool bret = interface.eval_Hess_Lagr(nlp_transformations_.n_pre(),
+                                       n_cons_,
+                                       x_user->local_data_const(),
+                                       true,
+                                       get_obj_scale(),
+                                       buf_lambda_->local_data(),
+                                       true,
+                                       nnzHSS,
+                                       pHessL->i_row(),
+                                       pHessL->j_col(),
+                                       nullptr);
+  runStats.tmEvalHessL.stop();
+  if(bret && nullptr == nlp_transformations_.apply_to_larg_hess(*Hess_L_user, n_vars_)) {
+    bret = false;
+  }
+  if(bret) {
+    //the next call of eval_Hess_Lagr only needs to evaluate the values
+    num_hess_eval_++;
+  }
+  return bret;
+}
+
 bool hiopNlpSparse::finalizeInitialization()
 {
   int nx = 0;
@@ -1802,8 +2333,459 @@ bool hiopNlpSparse::finalizeInitialization()
                                        nnz_sparse_Hess_Lagr_)) {
     return false;
   }
-  assert(nx == n_vars_);
-  return hiopNlpFormulation::finalizeInitialization();
+  //the Jacobian rows of the linear constraints are evaluated again in the new solve
+  Jac_c_rows_cache_.is_valid = false;
+  Jac_d_rows_cache_.is_valid = false;
+  if(!hiopNlpFormulation::finalizeInitialization()) {
+    return false;
+  }
+  assert(nx == nlp_transformations_.n_pre());
+  //the one-call Jacobian is released on reinitialization and its sparsity pattern needs to be obtained again
+  if(nullptr == cons_Jac_) {
+    num_jac_eval_ = 0;
+  }
+  //the sparsity patterns of the finite-difference derivatives are colored again
+  delete_finite_diff();
+  fd_jacobian_ = options->GetString("fd_jacobian")=="yes";
+  fd_hessian_ = options->GetString("fd_hessian")=="yes";
+  setup_presolved_nnz();
+  if(!setup_fixed_vars_removal()) {
+    return false;
+  }
+  //checked once 'this' is fully initialized, so that its state is consistent when the check fails
+  if(fd_jacobian_ && fd_hessian_ && n_cons_lin_<n_cons_) {
+    //the finite-difference Hessian needs the user's Jacobian for the curvature of the nonlinear constraints
+    log->printf(hovError,
+                "The options 'fd_jacobian=yes' and 'fd_hessian=yes' cannot be used together when there are "
+                "nonlinear constraints.\n");
+    return false;
+  }
+  return true;
+}
+
+bool hiopNlpSparse::eval_finite_diff(hiopFiniteDiffSparse*& fd,
+                                     size_type m,
+                                     const hiopFiniteDiffSparse::EvalFunc& f,
+                                     const hiopVector& x_user,
+                                     hiopMatrixSparse& M,
+                                     bool symmetric,
+                                     const char* name)
+{
+  if(nullptr == fd) {
+    fd = new hiopFiniteDiffSparse(m,
+                                  x_user.get_local_size(),
+                                  M.numberOfNonzeros(),
+                                  M.i_row(),
+                                  M.j_col(),
+                                  symmetric,
+                                  options->GetNumeric("fd_rel_step"),
+                                  options->GetInteger("fd_num_threads"));
+    log->printf(hovSummary,
+                "Finite-difference %s: %d colors for %d variables\n",
+                name,
+                fd->num_colors(),
+                x_user.get_local_size());
+  }
+  return fd->eval(f, x_user.local_data_const(), M.M());
+}
+
+bool hiopNlpSparse::get_Jac_pattern_finite_diff(const double* x_user)
+{
+  //the numbers of nonzeros of the user's Jacobians, which include the fixed variables and the constraints
+  //removed by the presolve
+  size_type nx, nnz_eq, nnz_ineq, nnz_hess;
+  if(!interface.get_sparse_blocks_info(nx, nnz_eq, nnz_ineq, nnz_hess)) {
+    return false;
+  }
+  fd_jac_irow_.resize(nnz_eq+nnz_ineq);
+  fd_jac_jcol_.resize(nnz_eq+nnz_ineq);
+  bool bret;
+  if(1 == cons_eval_type_) {
+    fd_jac_nnz_eq_ = nnz_eq+nnz_ineq;
+    bret = interface.eval_Jac_cons(nx, n_cons_, x_user, true, nnz_eq+nnz_ineq,
+                                   fd_jac_irow_.data(), fd_jac_jcol_.data(), nullptr);
+  } else {
+    fd_jac_nnz_eq_ = nnz_eq;
+    bret = interface.eval_Jac_cons(nx, n_cons_, user_m_eq(), user_cons_eq_mapping().local_data_const(),
+                                   x_user, true, nnz_eq, fd_jac_irow_.data(), fd_jac_jcol_.data(), nullptr) &&
+           interface.eval_Jac_cons(nx, n_cons_, user_m_ineq(), user_cons_ineq_mapping().local_data_const(),
+                                   x_user, true, nnz_ineq, fd_jac_irow_.data()+nnz_eq, fd_jac_jcol_.data()+nnz_eq,
+                                   nullptr);
+    //the rows of the equalities and inequalities become indexes of the user's constraints
+    const index_type* eq_map = user_cons_eq_mapping().local_data_const();
+    const index_type* ineq_map = user_cons_ineq_mapping().local_data_const();
+    for(index_type k=0; k<nnz_eq; k++) {
+      fd_jac_irow_[k] = eq_map[fd_jac_irow_[k]];
+    }
+    for(index_type k=nnz_eq; k<nnz_eq+nnz_ineq; k++) {
+      fd_jac_irow_[k] = ineq_map[fd_jac_irow_[k]];
+    }
+  }
+  if(!bret) {
+    fd_jac_nnz_eq_ = -1;
+  }
+  return bret;
+}
+
+bool hiopNlpSparse::add_Jac_trans_lambda(const double* x_user, const double* lambda, double* g)
+{
+  assert(fd_jac_nnz_eq_>=0);
+  const size_type n_user = nlp_transformations_.n_pre();
+  const size_type nnz = fd_jac_irow_.size();
+  //local buffer since this is called concurrently by the threads of the finite-difference Hessian
+  std::vector<double> vals(nnz);
+  bool bret;
+  if(1 == cons_eval_type_) {
+    bret = interface.eval_Jac_cons(n_user, n_cons_, x_user, true, nnz, nullptr, nullptr, vals.data());
+  } else {
+    bret = interface.eval_Jac_cons(n_user, n_cons_, user_m_eq(), user_cons_eq_mapping().local_data_const(),
+                                   x_user, true, fd_jac_nnz_eq_, nullptr, nullptr, vals.data()) &&
+           interface.eval_Jac_cons(n_user, n_cons_, user_m_ineq(), user_cons_ineq_mapping().local_data_const(),
+                                   x_user, true, nnz-fd_jac_nnz_eq_, nullptr, nullptr, vals.data()+fd_jac_nnz_eq_);
+  }
+  for(index_type k=0; k<nnz; k++) {
+    g[fd_jac_jcol_[k]] += vals[k]*lambda[fd_jac_irow_[k]];
+  }
+  return bret;
+}
+
+void hiopNlpSparse::delete_finite_diff()
+{
+  delete fd_jac_c_;
+  delete fd_jac_d_;
+  delete fd_jac_cons_;
+  delete fd_hess_;
+  fd_jac_c_ = nullptr;
+  fd_jac_d_ = nullptr;
+  fd_jac_cons_ = nullptr;
+  fd_hess_ = nullptr;
+  fd_jac_nnz_eq_ = -1;
+}
+
+bool hiopNlpSparse::setup_fixed_vars_removal()
+{
+  if(nullptr == fixed_vars_remover_) {
+    return true;
+  }
+  if(!fixed_vars_remover_->has_sparse_part()) {
+    fixed_vars_remover_->setup_sparse_part(n_cons_eq_,
+                                           n_cons_ineq_,
+                                           nnz_sparse_Jaceq_,
+                                           nnz_sparse_Jacineq_,
+                                           nnz_sparse_Hess_Lagr_);
+
+    //the sparsity patterns of the user's derivatives are obtained at a point with the fixed variables at their
+    //values and are used to build the maps of the nonzeros in the reduced space
+    const size_type n_fs = nlp_transformations_.n_pre();
+    hiopVector* x_rs = alloc_primal_vec();
+    hiopVector* x_fs = LinearAlgebraFactory::create_vector(options->GetString("mem_space"), n_fs);
+    x_rs->setToZero();
+    fixed_vars_remover_->copyRsToFs(*x_rs, *x_fs);
+
+    hiopMatrixSparse* Jac_c_fs = dynamic_cast<hiopMatrixSparse*>(fixed_vars_remover_->jacob_eq_fs());
+    hiopMatrixSparse* Jac_d_fs = dynamic_cast<hiopMatrixSparse*>(fixed_vars_remover_->jacob_ineq_fs());
+    hiopMatrixSparse* Jac_fs = dynamic_cast<hiopMatrixSparse*>(fixed_vars_remover_->jacob_cons_fs());
+    hiopMatrixSparse* Hess_fs = dynamic_cast<hiopMatrixSparse*>(fixed_vars_remover_->larg_hess_fs());
+    assert(Jac_c_fs && Jac_d_fs && Jac_fs && Hess_fs);
+
+    bool bret = interface.eval_Jac_cons(n_fs,
+                                        n_cons_,
+                                        n_cons_eq_,
+                                        cons_eq_mapping_->local_data_const(),
+                                        x_fs->local_data_const(),
+                                        true,
+                                        Jac_c_fs->numberOfNonzeros(),
+                                        Jac_c_fs->i_row(),
+                                        Jac_c_fs->j_col(),
+                                        nullptr);
+    bret = bret && interface.eval_Jac_cons(n_fs,
+                                           n_cons_,
+                                           n_cons_ineq_,
+                                           cons_ineq_mapping_->local_data_const(),
+                                           x_fs->local_data_const(),
+                                           true,
+                                           Jac_d_fs->numberOfNonzeros(),
+                                           Jac_d_fs->i_row(),
+                                           Jac_d_fs->j_col(),
+                                           nullptr);
+    if(!bret) {
+      //the user implements only the one-call Jacobian
+      bret = interface.eval_Jac_cons(n_fs,
+                                     n_cons_,
+                                     x_fs->local_data_const(),
+                                     true,
+                                     Jac_fs->numberOfNonzeros(),
+                                     Jac_fs->i_row(),
+                                     Jac_fs->j_col(),
+                                     nullptr);
+      if(bret) {
+        Jac_c_fs->copyRowsFrom(*Jac_fs, cons_eq_mapping_->local_data_const(), n_cons_eq_);
+        Jac_d_fs->copyRowsFrom(*Jac_fs, cons_ineq_mapping_->local_data_const(), n_cons_ineq_);
+      }
+    }
+
+    hiopVector* lambda = alloc_dual_vec();
+    lambda->setToZero();
+    bret = bret && interface.eval_Hess_Lagr(n_fs,
+                                            n_cons_,
+                                            x_fs->local_data_const(),
+                                            true,
+                                            get_obj_scale(),
+                                            lambda->local_data_const(),
+                                            true,
+                                            Hess_fs->numberOfNonzeros(),
+                                            Hess_fs->i_row(),
+                                            Hess_fs->j_col(),
+                                            nullptr);
+    delete lambda;
+    delete x_fs;
+    delete x_rs;
+    if(!bret) {
+      log->printf(hovError, "Could not obtain the sparsity patterns of the derivatives needed to remove the "
+                  "fixed variables.\n");
+      return false;
+    }
+    fixed_vars_remover_->setup_nnz_maps();
+  }
+
+  //number of nonzeros of the derivatives in the reduced space
+  nnz_sparse_Jaceq_ = fixed_vars_remover_->rs_nnz_jacob_eq();
+  nnz_sparse_Jacineq_ = fixed_vars_remover_->rs_nnz_jacob_ineq();
+  nnz_sparse_Hess_Lagr_ = fixed_vars_remover_->rs_nnz_larg_hess();
+  return true;
+}
+
+bool hiopNlpSparse::presolve_constraints()
+{
+  if(options->GetString("presolve") != "yes") {
+    return true;
+  }
+  if(fixed_vars_remover_) {
+    log->printf(hovWarning, "Presolve is not performed when the fixed variables are removed.\n");
+    return true;
+  }
+  size_type n_lin = 0;
+  for(index_type i=0; i<n_cons_eq_; i++) {
+    if(cons_eq_type_[i]==hiopInterfaceBase::hiopLinear) n_lin++;
+  }
+  for(index_type i=0; i<n_cons_ineq_; i++) {
+    if(cons_ineq_type_[i]==hiopInterfaceBase::hiopLinear) n_lin++;
+  }
+  if(0 == n_lin) {
+    return true;
+  }
+
+  const string mem_space = options->GetString("mem_space");
+  hiopSparseNlpPresolver* presolver = new hiopSparseNlpPresolver(this,
+                                                                 n_vars_,
+                                                                 *cons_eq_mapping_,
+                                                                 *cons_ineq_mapping_,
+                                                                 nnz_sparse_Jaceq_,
+                                                                 nnz_sparse_Jacineq_);
+
+  //the linear constraints and their Jacobians are evaluated at the projection of zero onto the bounds
+  hiopVector* x0 = xl_->alloc_clone();
+  {
+    const double* xl_vec = xl_->local_data_host_const();
+    const double* xu_vec = xu_->local_data_host_const();
+    double* x0_vec = x0->local_data_host();
+    for(index_type i=0; i<n_vars_; i++) {
+      x0_vec[i] = fmin(fmax(0., xl_vec[i]), xu_vec[i]);
+    }
+    x0->copyToDev();
+  }
+  hiopVector* c = presolver->cons_eq_fs();
+  hiopVector* d = presolver->cons_ineq_fs();
+  hiopMatrixSparse* Jac_c = presolver->jacob_eq_fs();
+  hiopMatrixSparse* Jac_d = presolver->jacob_ineq_fs();
+
+  bool bret = interface.eval_cons(n_vars_,
+                                  n_cons_,
+                                  n_cons_eq_,
+                                  cons_eq_mapping_->local_data_const(),
+                                  x0->local_data_const(),
+                                  true,
+                                  c->local_data());
+  bret = bret && interface.eval_cons(n_vars_,
+                                     n_cons_,
+                                     n_cons_ineq_,
+                                     cons_ineq_mapping_->local_data_const(),
+                                     x0->local_data_const(),
+                                     false,
+                                     d->local_data());
+  if(!bret) {
+    //the user implements only the one-call constraints
+    hiopVector* cd = alloc_dual_vec();
+    bret = interface.eval_cons(n_vars_, n_cons_, x0->local_data_const(), true, cd->local_data());
+    if(bret) {
+      cd->copy_to_two_vec_w_pattern(*c, *cons_eq_mapping_, *d, *cons_ineq_mapping_);
+    }
+    delete cd;
+  }
+
+  bool bret_jac = interface.eval_Jac_cons(n_vars_,
+                                          n_cons_,
+                                          n_cons_eq_,
+                                          cons_eq_mapping_->local_data_const(),
+                                          x0->local_data_const(),
+                                          false,
+                                          Jac_c->numberOfNonzeros(),
+                                          Jac_c->i_row(),
+                                          Jac_c->j_col(),
+                                          nullptr);
+  bret_jac = bret_jac && interface.eval_Jac_cons(n_vars_,
+                                                 n_cons_,
+                                                 n_cons_eq_,
+                                                 cons_eq_mapping_->local_data_const(),
+                                                 x0->local_data_const(),
+                                                 false,
+                                                 Jac_c->numberOfNonzeros(),
+                                                 nullptr,
+                                                 nullptr,
+                                                 Jac_c->M());
+  bret_jac = bret_jac && interface.eval_Jac_cons(n_vars_,
+                                                 n_cons_,
+                                                 n_cons_ineq_,
+                                                 cons_ineq_mapping_->local_data_const(),
+                                                 x0->local_data_const(),
+                                                 false,
+                                                 Jac_d->numberOfNonzeros(),
+                                                 Jac_d->i_row(),
+                                                 Jac_d->j_col(),
+                                                 nullptr);
+  bret_jac = bret_jac && interface.eval_Jac_cons(n_vars_,
+                                                 n_cons_,
+                                                 n_cons_ineq_,
+                                                 cons_ineq_mapping_->local_data_const(),
+                                                 x0->local_data_const(),
+                                                 false,
+                                                 Jac_d->numberOfNonzeros(),
+                                                 nullptr,
+                                                 nullptr,
+                                                 Jac_d->M());
+  if(!bret_jac) {
+    //the user implements only the one-call Jacobian
+    hiopMatrixSparse* Jac = LinearAlgebraFactory::create_matrix_sparse(mem_space,
+                                                                       n_cons_,
+                                                                       n_vars_,
+                                                                       nnz_sparse_Jaceq_+nnz_sparse_Jacineq_);
+    bret_jac = interface.eval_Jac_cons(n_vars_,
+                                       n_cons_,
+                                       x0->local_data_const(),
+                                       false,
+                                       Jac->numberOfNonzeros(),
+                                       Jac->i_row(),
+                                       Jac->j_col(),
+                                       nullptr);
+    bret_jac = bret_jac && interface.eval_Jac_cons(n_vars_,
+                                                   n_cons_,
+                                                   x0->local_data_const(),
+                                                   false,
+                                                   Jac->numberOfNonzeros(),
+                                                   nullptr,
+                                                   nullptr,
+                                                   Jac->M());
+    if(bret_jac) {
+      Jac_c->copyRowsFrom(*Jac, cons_eq_mapping_->local_data_const(), n_cons_eq_);
+      Jac_d->copyRowsFrom(*Jac, cons_ineq_mapping_->local_data_const(), n_cons_ineq_);
+    }
+    delete Jac;
+  }
+  if(!bret || !bret_jac) {
+    log->printf(hovError, "Could not evaluate the constraints and their Jacobian needed by the presolve.\n");
+    delete x0;
+    delete presolver;
+    return false;
+  }
+
+  const size_type n_removed = presolver->presolve(*x0,
+                                                  *c_rhs_,
+                                                  *dl_,
+                                                  *du_,
+                                                  cons_eq_type_,
+                                                  cons_ineq_type_,
+                                                  *xl_,
+                                                  *xu_,
+                                                  options->GetNumeric("tolerance"),
+                                                  options->GetNumeric("fixed_var_tolerance"),
+                                                  options->GetNumeric("bound_relax_perturb")>0);
+  delete x0;
+  if(0 == n_removed) {
+    delete presolver;
+    return true;
+  }
+
+  //
+  //shrink the constraints data to the constraints kept by the presolve
+  //
+  const size_type m_eq = presolver->rs_m_eq();
+  const size_type m_ineq = presolver->rs_m_ineq();
+  const index_type* eq_rs2fs = presolver->eq_rs2fs().local_data_const();
+  const index_type* ineq_rs2fs = presolver->ineq_rs2fs().local_data_const();
+
+  hiopVector* c_rhs = LinearAlgebraFactory::create_vector(mem_space, m_eq);
+  c_rhs->copy_from_indexes(*c_rhs_, presolver->eq_rs2fs());
+  hiopVector* dl = LinearAlgebraFactory::create_vector(mem_space, m_ineq);
+  dl->copy_from_indexes(*dl_, presolver->ineq_rs2fs());
+  hiopVector* du = LinearAlgebraFactory::create_vector(mem_space, m_ineq);
+  du->copy_from_indexes(*du_, presolver->ineq_rs2fs());
+  hiopVectorInt* cons_eq_mapping = LinearAlgebraFactory::create_vector_int(mem_space, m_eq);
+  hiopVectorInt* cons_ineq_mapping = LinearAlgebraFactory::create_vector_int(mem_space, m_ineq);
+  hiopInterfaceBase::NonlinearityType* cons_eq_type = new hiopInterfaceBase::NonlinearityType[m_eq];
+  hiopInterfaceBase::NonlinearityType* cons_ineq_type = new hiopInterfaceBase::NonlinearityType[m_ineq];
+  {
+    const index_type* eq_map_fs = cons_eq_mapping_->local_data_const();
+    const index_type* ineq_map_fs = cons_ineq_mapping_->local_data_const();
+    index_type* eq_map = cons_eq_mapping->local_data();
+    index_type* ineq_map = cons_ineq_mapping->local_data();
+    for(index_type i=0; i<m_eq; i++) {
+      eq_map[i] = eq_map_fs[eq_rs2fs[i]];
+      cons_eq_type[i] = cons_eq_type_[eq_rs2fs[i]];
+    }
+    for(index_type i=0; i<m_ineq; i++) {
+      ineq_map[i] = ineq_map_fs[ineq_rs2fs[i]];
+      cons_ineq_type[i] = cons_ineq_type_[ineq_rs2fs[i]];
+    }
+  }
+  delete c_rhs_;
+  delete dl_;
+  delete du_;
+  delete cons_eq_mapping_;
+  delete cons_ineq_mapping_;
+  delete[] cons_eq_type_;
+  delete[] cons_ineq_type_;
+  c_rhs_ = c_rhs;
+  dl_ = dl;
+  du_ = du;
+  cons_eq_mapping_ = cons_eq_mapping;
+  cons_ineq_mapping_ = cons_ineq_mapping;
+  cons_eq_type_ = cons_eq_type;
+  cons_ineq_type_ = cons_ineq_type;
+  n_cons_eq_ = m_eq;
+  n_cons_ineq_ = m_ineq;
+  dl_->copyFromDev();
+  du_->copyFromDev();
+  build_ineq_bounds_indicators();
+
+  //the bounds of the variables tightened by the singleton rows
+  xl_->copyFromDev();
+  xu_->copyFromDev();
+  size_type nfixed_vars_local;
+  process_bounds(n_bnds_low_local_, n_bnds_upp_local_, n_bnds_lu_, nfixed_vars_local);
+  xl_->copyToDev();  xu_->copyToDev();
+  ixl_->copyToDev(); ixu_->copyToDev();
+
+  nlp_transformations_.append(presolver);
+  presolver_ = presolver;
+  return true;
+}
+
+void hiopNlpSparse::setup_presolved_nnz()
+{
+  if(presolver_) {
+    nnz_sparse_Jaceq_ = presolver_->rs_nnz_jacob_eq();
+    nnz_sparse_Jacineq_ = presolver_->rs_nnz_jacob_ineq();
+  }
 }
 
 /////////////////////////////////////////////////////////////
@@ -1818,13 +2800,18 @@ bool hiopNlpSparseIneq::finalizeInitialization()
                                        nnz_sparse_Hess_Lagr_)) {
     return false;
   }
-  assert(nx == n_vars_);
   nnz_sparse_Jacineq_ += nnz_sparse_Jaceq_;
   nnz_sparse_Jaceq_ = 0.;
   
-
-  return hiopNlpFormulation::finalizeInitialization();
-  
+  if(!hiopNlpFormulation::finalizeInitialization()) {
+    return false;
+  }
+  assert(nx == nlp_transformations_.n_pre());
+  if(nullptr == cons_Jac_) {
+    num_jac_eval_ = 0;
+  }
+  setup_presolved_nnz();
+  return setup_fixed_vars_removal();
 }
 
 bool hiopNlpSparseIneq::process_constraints()
@@ -1900,6 +2887,15 @@ bool hiopNlpSparseIneq::process_constraints()
     }
   }
 
+  /* the linear constraints: the Jacobian rows of the linear constraints are constant */
+  cons_type_user_.assign(cons_type, cons_type+n_cons_);
+  n_cons_lin_ = 0;
+  for(int i=0; i<n_cons_; i++) {
+    if(cons_type[i]==hiopInterfaceBase::hiopLinear) {
+      n_cons_lin_++;
+    }
+  }
+
   /* delete the temporary buffers */
   delete gl; 
   delete gu; 
@@ -72,8 +72,11 @@
 #include "hiopOptions.hpp"
 
 #include "hiopVectorInt.hpp"
+#include "hiopFiniteDiffSparse.hpp"
 
 #include <cstring>
+#include <vector>
+#include <functional>
 
 namespace hiop
 {
@@ -93,6 +96,17 @@ class hiopDualsLsqUpdate;
  *   ii. the interface provided (general sparse (not yet supported), mixed sparse-dense, or dense
  * constraints).
  * Exact matching of MATRICES and hiopInterface is to be done by specializations of this class.
+ *
+ * Reentrancy: an NLP formulation, its options, logger, and the algorithm objects built on top of
+ * it own all their (mutable) state, so that independent NLPs can be constructed and solved
+ * concurrently by different threads of the same process. The memory tracker and the host memory
+ * pool are owned by each solver and made active on the calling thread (through thread_local
+ * pointers) while the solver runs. The only process-wide resource is the MPI initialization,
+ * which is serialized by the NLP constructor. Each
+ * concurrently solved NLP should pass its own communicator via hiopInterfaceBase::get_MPI_comm
+ * (for example, a duplicate of MPI_COMM_SELF created before the threads are spawned), MPI must
+ * provide MPI_THREAD_MULTIPLE, and the BLAS/LAPACK library must be thread safe. A given NLP and
+ * its solver object must not be used by more than one thread at a time.
  */
 class hiopNlpFormulation
 {
@@ -101,6 +115,19 @@ public:
   virtual ~hiopNlpFormulation();
 
   virtual bool finalizeInitialization();
+
+  /**
+   * Instructs the next call of finalizeInitialization to read again the problem data (sizes, 
+   * variables bounds, constraints bounds and types) from the user interface. Used when the
+   * interface starts to provide the data of a different instance of the same problem.
+   */
+  void reload_problem_data()
+  {
+    strFixedVars_ = ""; //uninitialized
+    dFixedVarsTol_ = -1.; //uninitialized
+    strPresolve_ = ""; //uninitialized
+  }
+
   virtual bool apply_scaling(hiopVector& c, hiopVector& d, hiopVector& gradf, 
                              hiopMatrix& Jac_c, hiopMatrix& Jac_d);
 
@@ -220,7 +247,10 @@ public:
   
   /** const accessors */
   inline size_type n() const      {return n_vars_;}
-  inline size_type m() const      {return n_cons_;}
+  /// number of constraints of the NLP solved internally, which excludes the constraints removed by the presolve
+  inline size_type m() const      {return n_cons_eq_+n_cons_ineq_;}
+  /// number of constraints of the user's NLP
+  inline size_type m_user() const {return n_cons_;}
   inline size_type m_eq() const   {return n_cons_eq_;}
   inline size_type m_ineq() const {return n_cons_ineq_;}
   inline size_type n_low() const  {return n_bnds_low_;}
@@ -284,6 +314,13 @@ public:
     return num_ranks_;
   }
 #endif
+
+  /**
+   * Returns in 'key' the variables removed as fixed and the constraints kept by the presolve. Two 
+   * initializations of the NLP with the same sizes and keys map the user's derivatives in the same way,
+   * hence the sparsity patterns of their KKT systems are the same.
+   */
+  void get_transformations_key(std::vector<index_type>& key) const;
 protected:
   /* Preprocess bounds in a form supported by the NLP formulation. Returns counts of
    * the variables with lower, upper, and lower and lower bounds, as well of the fixed 
@@ -295,6 +332,36 @@ protected:
                               size_type& nfixed_vars);
   /* Preprocess constraints in a form supported the NLP formulation. */
   virtual bool process_constraints();
+
+  /// Builds the idl(ow) and idu(pp) vectors and the counts of the bounds of the inequalities from dl and du
+  void build_ineq_bounds_indicators();
+
+  /**
+   * Removes or simplifies constraints after they were processed; called by finalizeInitialization before
+   * the bounds are relaxed. The base formulation does not support presolve and returns true.
+   */
+  virtual bool presolve_constraints() { return true; }
+
+  /**
+   * The user's equalities and inequalities as indexes into the user's constraints, which include the 
+   * constraints removed by the presolve, and their number.
+   */
+  inline size_type user_m_eq() const
+  {
+    return presolver_ ? presolver_->fs_m_eq() : n_cons_eq_;
+  }
+  inline size_type user_m_ineq() const
+  {
+    return presolver_ ? presolver_->fs_m_ineq() : n_cons_ineq_;
+  }
+  inline const hiopVectorInt& user_cons_eq_mapping() const
+  {
+    return presolver_ ? presolver_->fs_cons_eq_mapping() : *cons_eq_mapping_;
+  }
+  inline const hiopVectorInt& user_cons_ineq_mapping() const
+  {
+    return presolver_ ? presolver_->fs_cons_ineq_mapping() : *cons_ineq_mapping_;
+  }
 protected:
 #ifdef HIOP_USE_MPI
   MPI_Comm comm_;
@@ -328,9 +395,14 @@ protected:
   // keep track of the constraints indexes in the original, user's formulation
   hiopVectorInt *cons_eq_mapping_, *cons_ineq_mapping_; 
 
+  /// Number of linear constraints and the types of the constraints in the user's ordering
+  size_type n_cons_lin_;
+  std::vector<hiopInterfaceBase::NonlinearityType> cons_type_user_;
+
   //options for which this class was setup
   std::string strFixedVars_; //"none", "fixed", "relax"
   double dFixedVarsTol_;
+  std::string strPresolve_; //"no", "yes"
 
   /**
    * @brief Internal NLP transformations that supports fixing and relaxing variables as well as
@@ -343,6 +415,12 @@ protected:
 
   /// @brief internal NLP transformations that relaxes the bounds
   hiopBoundsRelaxer* relax_bounds_;
+
+  /// @brief internal NLP transformation that removes the fixed variables (owned by 'nlp_transformations_')
+  hiopFixedVarsRemover* fixed_vars_remover_;
+
+  /// @brief internal NLP transformation that presolves the constraints (owned by 'nlp_transformations_')
+  hiopSparseNlpPresolver* presolver_;
   
 
 #ifdef HIOP_USE_MPI
@@ -379,6 +457,77 @@ protected:
    * ineq. into and to return it to the user via @user_callback_solution and @user_callback_iterate
    */
   hiopVector* cons_lambdas_;
+
+  /** 
+   * Internal buffers for the multipliers of the bounds returned to the user. Used only when the presolve
+   * removed constraints, otherwise NULL.
+   */
+  hiopVector* zl_user_;
+  hiopVector* zu_user_;
+
+  /**
+   * Recovers in 'cons_lambdas_' the multipliers of the constraints removed by the presolve and moves to 
+   * them the multipliers of the bounds set by the presolve. On return, 'zl' and 'zu' point to the 
+   * multipliers of the bounds to be returned to the user.
+   */
+  void postsolve_duals(const hiopVector*& zl, const hiopVector*& zu);
+
+  /**
+   * Cache of the Jacobian rows of the linear equality or inequality constraints for the Jacobians with
+   * a sparse (triplet) block, i.e., of the MDS and sparse formulations. The sparsity patterns are fixed 
+   * during a solve, hence the values of the linear rows are cached by their position in the triplets 
+   * of the first evaluation. Afterwards only the rows of the nonlinear constraints are requested from the
+   * user through the row-subset `eval_Jac_cons` callback.
+   */
+  struct LinearJacTripletRowsCache
+  {
+    LinearJacTripletRowsCache()
+      : is_valid(false),
+        is_used(false)
+    {}
+    /// triplets and dense block (MDS only, row-major) of the Jacobian block of the first evaluation
+    std::vector<index_type> irow;
+    std::vector<index_type> jcol;
+    std::vector<double> vals;
+    std::vector<double> dense;
+    /// indexes of the nonlinear constraints in the user's numbering and their rows in the Jacobian block
+    std::vector<index_type> idx_nl;
+    std::vector<index_type> rows_nl;
+    /// positions in the triplets of the nonzeros of the rows of the nonlinear constraints
+    std::vector<index_type> nz_nl;
+    /// buffers for the rows of the nonlinear constraints evaluated by the user
+    std::vector<index_type> irow_nl;
+    std::vector<index_type> jcol_nl;
+    std::vector<double> vals_nl;
+    std::vector<double> dense_nl;
+    bool is_valid;
+    /// false when the block has no linear constraints or the user does not evaluate subsets of rows
+    bool is_used;
+  };
+
+  /// Evaluates the rows `idx_cons` of the Jacobian in the user's row-subset `eval_Jac_cons` callback
+  typedef std::function<bool(size_type num_cons,
+                             const index_type* idx_cons,
+                             size_type nnz,
+                             index_type* irow,
+                             index_type* jcol,
+                             double* vals,
+                             double* dense)> JacRowsEvalFunc;
+
+  /**
+   * Evaluates the Jacobian block of the constraints in `cons_mapping`, whose triplets are `irow`, `jcol`
+   * and `vals` and whose dense block (`ndense` columns, MDS only) is `dense`, using and updating `cache`.
+   */
+  bool eval_Jac_rows_cached(size_type num_cons,
+                            const index_type* cons_mapping,
+                            size_type nnz,
+                            index_type* irow,
+                            index_type* jcol,
+                            double* vals,
+                            size_type ndense,
+                            double* dense,
+                            const JacRowsEvalFunc& eval,
+                            LinearJacTripletRowsCache& cache);
 private:
   hiopNlpFormulation(const hiopNlpFormulation& s)
     : interface_base(s.interface_base),
@@ -436,9 +585,49 @@ public:
    */
   virtual hiopMatrixDense* alloc_multivector_primal(int nrows, int max_rows=-1) const;
 
+private:
+  /**
+   * Cache of the Jacobian rows of the linear equality or inequality constraints. The rows are evaluated
+   * once per solve; afterwards only the rows of the nonlinear constraints are requested from the user
+   * through the row-subset `eval_Jac_cons` callback.
+   */
+  struct LinearJacRowsCache
+  {
+    LinearJacRowsCache()
+      : jac(nullptr),
+        jac_nl(nullptr),
+        is_valid(false)
+    {}
+    ~LinearJacRowsCache()
+    {
+      delete jac;
+      delete jac_nl;
+    }
+    /// copy of the Jacobian block in user space; only the rows of the linear constraints are up to date
+    hiopMatrixDense* jac;
+    /// buffer for the rows of the nonlinear constraints evaluated by the user
+    hiopMatrixDense* jac_nl;
+    /// indexes of the nonlinear constraints in the user's numbering
+    std::vector<index_type> idx_nl;
+    /// rows of the nonlinear constraints in the Jacobian block
+    std::vector<index_type> rows_nl;
+    bool is_valid;
+  };
+
+  /// Evaluates the Jacobian block of the constraints in `cons_mapping` using and updating `cache`
+  bool eval_Jac_cons_cached(const hiopVector& x_user,
+                            bool new_x,
+                            size_type num_cons,
+                            const index_type* cons_mapping,
+                            const hiopInterfaceBase::NonlinearityType* cons_type,
+                            hiopMatrixDense& Jac_user,
+                            LinearJacRowsCache& cache);
 private:
   /* interface implemented and provided by the user */
   hiopInterfaceDenseConstraints& interface;
+
+  LinearJacRowsCache Jac_c_cache_;
+  LinearJacRowsCache Jac_d_cache_;
 };
 
 
@@ -514,6 +703,12 @@ public:
   inline int get_nnz_sp_Hess_Lagr_SS()  const { return nnz_sparse_Hess_Lagr_SS; }
   inline int get_nnz_sp_Hess_Lagr_SD()  const { return nnz_sparse_Hess_Lagr_SD; }
 
+private:
+  /**
+   * Sets up the removal of the fixed variables for the MDS Jacobians and Hessian (when fixed variables
+   * are removed) and updates the sizes of the derivatives blocks to the reduced space.
+   */
+  bool setup_fixed_vars_removal();
 private:
   hiopInterfaceMDS& interface;
   int nx_sparse, nx_dense;
@@ -521,6 +716,9 @@ private:
   int nnz_sparse_Hess_Lagr_SS, nnz_sparse_Hess_Lagr_SD;
 
   hiopVector* buf_lambda_;
+
+  LinearJacTripletRowsCache Jac_c_rows_cache_;
+  LinearJacTripletRowsCache Jac_d_rows_cache_;
 };
 
 
@@ -533,13 +731,16 @@ class hiopNlpSparse : public hiopNlpFormulation
 public:
   hiopNlpSparse(hiopInterfaceSparse& interface_, const char* option_file = nullptr)
     : hiopNlpFormulation(interface_, option_file), interface(interface_),
-      num_jac_eval_{0}, num_hess_eval_{0}
+      num_jac_eval_{0}, num_hess_eval_{0},
+      fd_jacobian_(false), fd_hessian_(false),
+      fd_jac_c_(nullptr), fd_jac_d_(nullptr), fd_jac_cons_(nullptr), fd_hess_(nullptr), fd_jac_nnz_eq_(-1)
   {
     buf_lambda_ = LinearAlgebraFactory::create_vector(options->GetString("mem_space"), 0);
   }
   virtual ~hiopNlpSparse()
   {
     delete buf_lambda_;
+    delete_finite_diff();
   }
 
   virtual bool finalizeInitialization();
@@ -559,6 +760,13 @@ public:
                             const hiopVector& lambda_ineq,
                             bool new_lambdas,
                             hiopMatrix& Hess_L);
+
+  /**
+   * Obtains from the user the sparsity pattern of the Hessian of the Lagrangian, without evaluating it; 
+   * does nothing if the pattern is already available in 'Hess_L'.
+   */
+  bool eval_Hess_Lagr_structure(const hiopVector& x, hiopMatrix& Hess_L);
+
   /* Allocates the LSQ duals update class. */
   virtual hiopDualsLsqUpdate* alloc_duals_lsq_updater();
   
@@ -574,11 +782,17 @@ public:
   }
   virtual hiopMatrix* alloc_Jac_cons()
   {
-    return LinearAlgebraFactory::create_matrix_sparse(options->GetString("mem_space"),n_cons_, n_vars_, nnz_sparse_Jaceq_ + nnz_sparse_Jacineq_);
+    //the one-call Jacobian is evaluated by the user and includes the constraints removed by the presolve
+    const int nnz = presolver_ ?
+      presolver_->fs_nnz_jacob_eq() + presolver_->fs_nnz_jacob_ineq() :
+      nnz_sparse_Jaceq_ + nnz_sparse_Jacineq_;
+    return LinearAlgebraFactory::create_matrix_sparse(options->GetString("mem_space"),n_cons_, n_vars_, nnz);
     //return new hiopMatrixSparseTriplet(n_cons_, n_vars_, nnz_sparse_Jaceq_ + nnz_sparse_Jacineq_);
   }
   virtual hiopMatrix* alloc_Hess_Lagr()
   {
+    //the sparsity pattern of the new matrix needs to be obtained from the user
+    num_hess_eval_ = 0;
     return LinearAlgebraFactory::create_matrix_sym_sparse(options->GetString("mem_space"),n_vars_, nnz_sparse_Hess_Lagr_);
     //return new hiopMatrixSymSparseTriplet(n_vars_, nnz_sparse_Hess_Lagr_);
   }
@@ -595,9 +809,8 @@ public:
    */
   virtual hiopVector* alloc_primal_dual_vec() const
   {
-    assert(n_cons_ == n_cons_eq_+n_cons_ineq_);
     return LinearAlgebraFactory::create_vector(options->GetString("mem_space"),
-                                               n_vars_+n_cons_);
+                                               n_vars_+n_cons_eq_+n_cons_ineq_);
   }
 
   /** const accessors */
@@ -605,6 +818,45 @@ public:
   inline int get_nnz_Jacineq()  const { return nnz_sparse_Jacineq_; }
   inline int get_nnz_Hess_Lagr()  const { return nnz_sparse_Hess_Lagr_; }
   
+protected:
+  /**
+   * Sets up the removal of the fixed variables for the sparse Jacobians and Hessian (when fixed variables
+   * are removed) and updates the number of nonzeros of the derivatives to the reduced space.
+   */
+  bool setup_fixed_vars_removal();
+
+  /**
+   * Presolves the linear constraints when the option 'presolve' is 'yes': empty, singleton, and duplicate
+   * rows are removed (see hiopSparseNlpPresolver) and the constraints data is reduced to the kept rows.
+   */
+  virtual bool presolve_constraints();
+
+  /// Sets the numbers of nonzeros of the Jacobians to the ones of the presolved constraints
+  void setup_presolved_nnz();
+
+  /**
+   * Approximates by finite differences of 'f' the values of the user's sparse matrix of derivatives 'M' 
+   * at the user's point 'x_user'; the sparsity pattern of 'M' should be already obtained from the user.
+   * The coloring 'fd' is computed from this pattern at the first call.
+   */
+  bool eval_finite_diff(hiopFiniteDiffSparse*& fd,
+                        size_type m,
+                        const hiopFiniteDiffSparse::EvalFunc& f,
+                        const hiopVector& x_user,
+                        hiopMatrixSparse& M,
+                        bool symmetric,
+                        const char* name);
+
+  /**
+   * Obtains from the user the sparsity pattern of the Jacobian of all the user's constraints, which is
+   * used by the finite-difference Hessian for the constraints' term of the gradient of the Lagrangian.
+   */
+  bool get_Jac_pattern_finite_diff(const double* x_user);
+
+  /// g += J^T*lambda, with the Jacobian J of the user's constraints evaluated by the user at 'x_user'
+  bool add_Jac_trans_lambda(const double* x_user, const double* lambda, double* g);
+
+  void delete_finite_diff();
 protected:
   hiopInterfaceSparse& interface;
   int nnz_sparse_Jaceq_;
@@ -614,6 +866,30 @@ protected:
   int num_hess_eval_;
 
   hiopVector* buf_lambda_;
+
+  /// values of the options 'fd_jacobian' and 'fd_hessian', read by finalizeInitialization
+  bool fd_jacobian_;
+  bool fd_hessian_;
+
+  /// finite-difference approximations of the derivatives (options 'fd_jacobian' and 'fd_hessian')
+  hiopFiniteDiffSparse* fd_jac_c_;
+  hiopFiniteDiffSparse* fd_jac_d_;
+  hiopFiniteDiffSparse* fd_jac_cons_;
+  hiopFiniteDiffSparse* fd_hess_;
+
+  /**
+   * Sparsity pattern of the Jacobian of the user's constraints (rows are indexes of the user's constraints)
+   * used by the finite-difference Hessian. The first 'fd_jac_nnz_eq_' nonzeros are evaluated by the first
+   * call of the user's Jacobian (of the equalities or of all the constraints) and the remaining ones by the
+   * call for the inequalities. 'fd_jac_nnz_eq_' is -1 until the pattern is obtained.
+   */
+  std::vector<index_type> fd_jac_irow_;
+  std::vector<index_type> fd_jac_jcol_;
+  size_type fd_jac_nnz_eq_;
+
+  /// Jacobian rows of the linear constraints, not used with finite-difference Jacobians
+  LinearJacTripletRowsCache Jac_c_rows_cache_;
+  LinearJacTripletRowsCache Jac_d_rows_cache_;
 };
 
 /**
@@ -56,8 +56,12 @@
  
 #include "hiopNlpTransforms.hpp"
 #include "hiopNlpFormulation.hpp"
+#include "hiopMatrixMDS.hpp"
 
 #include <cmath>
+#include <algorithm>
+#include <map>
+#include <utility>
 namespace hiop
 {
 
@@ -72,7 +76,11 @@ hiopFixedVarsRemover(hiopNlpFormulation* nlp,
     n_fixed_vars_local(numFixedVars_local), fixedVarTol(fixedVarTol_),
     Jacc_fs(NULL), Jacd_fs(NULL),
     fs2rs_idx_map(xl.get_local_size()),
-    x_rs_ref_(nullptr), Jacc_rs_ref(NULL), Jacd_rs_ref(NULL)
+    x_rs_ref_(nullptr), Jacc_rs_ref(NULL), Jacd_rs_ref(NULL),
+    Jacc_fs_sp_(nullptr), Jacd_fs_sp_(nullptr), Jac_cons_fs_(nullptr), Hess_fs_(nullptr),
+    Jacc_rs_sp_ref_(nullptr), Jacd_rs_sp_ref_(nullptr), Jac_cons_rs_ref_(nullptr), Hess_rs_ref_(nullptr),
+    nnz_jacc_rs_(0), nnz_jacd_rs_(0), nnz_hess_rs_(0),
+    nx_sp_fs_(0), nx_sp_rs_(0)
 {
   xl_fs = xl.new_copy();
   xu_fs = xu.new_copy();
@@ -91,6 +99,10 @@ hiopFixedVarsRemover::~hiopFixedVarsRemover()
   delete grad_fs;
   if(Jacc_fs) delete Jacc_fs;
   if(Jacd_fs) delete Jacd_fs;
+  delete Jacc_fs_sp_;
+  delete Jacd_fs_sp_;
+  delete Jac_cons_fs_;
+  delete Hess_fs_;
 };
 
 #ifdef HIOP_USE_MPI
@@ -175,37 +187,220 @@ bool hiopFixedVarsRemover::setupConstraintsPart(const int& neq, const int& nineq
   assert(Jacc_fs==NULL && "should not be allocated at this point");
   assert(Jacd_fs==NULL && "should not be allocated at this point");
 
+  //the full-space dense Jacobians are allocated when first needed since the sparse and MDS NLP formulations
+  //do not use them
+  return true;
+}
+
+hiopMatrixDense* hiopFixedVarsRemover::alloc_fs_jacob_dense(const int& m_in)
+{
 #ifdef HIOP_USE_MPI
   if(fs_vec_distrib.size()) {
-    Jacc_fs = LinearAlgebraFactory::
-      create_matrix_dense(nlp_->options->GetString("mem_space"),neq, n_fs, fs_vec_distrib.data(), comm);
-    Jacd_fs = LinearAlgebraFactory::
-      create_matrix_dense(nlp_->options->GetString("mem_space"), nineq, n_fs, fs_vec_distrib.data(), comm);
+    return LinearAlgebraFactory::
+      create_matrix_dense(nlp_->options->GetString("mem_space"), m_in, n_fs, fs_vec_distrib.data(), comm);
   } else {
-    Jacc_fs = LinearAlgebraFactory::
-      create_matrix_dense(nlp_->options->GetString("mem_space"), neq, n_fs, NULL, comm);
-    Jacd_fs = LinearAlgebraFactory::
-      create_matrix_dense(nlp_->options->GetString("mem_space"), nineq, n_fs, NULL, comm);
+    return LinearAlgebraFactory::
+      create_matrix_dense(nlp_->options->GetString("mem_space"), m_in, n_fs, NULL, comm);
   }
 #else
-  Jacc_fs = LinearAlgebraFactory::create_matrix_dense(nlp_->options->GetString("mem_space"), neq, n_fs);
-  Jacd_fs = LinearAlgebraFactory::create_matrix_dense(nlp_->options->GetString("mem_space"), nineq, n_fs);
+  return LinearAlgebraFactory::create_matrix_dense(nlp_->options->GetString("mem_space"), m_in, n_fs);
 #endif
+}
+
+void hiopFixedVarsRemover::setup_sparse_part(const int& neq,
+                                             const int& nineq,
+                                             const size_type& nnz_jac_eq,
+                                             const size_type& nnz_jac_ineq,
+                                             const size_type& nnz_hess)
+{
+  assert(nullptr==Hess_fs_ && "should not be allocated at this point");
+  const std::string mem_space = nlp_->options->GetString("mem_space");
+
+  Jacc_fs_sp_ = LinearAlgebraFactory::create_matrix_sparse(mem_space, neq, n_fs, nnz_jac_eq);
+  Jacd_fs_sp_ = LinearAlgebraFactory::create_matrix_sparse(mem_space, nineq, n_fs, nnz_jac_ineq);
+  Jac_cons_fs_ = LinearAlgebraFactory::create_matrix_sparse(mem_space, neq+nineq, n_fs, nnz_jac_eq+nnz_jac_ineq);
+  Hess_fs_ = LinearAlgebraFactory::create_matrix_sym_sparse(mem_space, n_fs, nnz_hess);
+  Jacc_fs_sp_->setToZero();
+  Jacd_fs_sp_->setToZero();
+  Jac_cons_fs_->setToZero();
+  Hess_fs_->setToZero();
+
+  //all the variables are sparse
+  nx_sp_fs_ = n_fs;
+  nx_sp_rs_ = n_rs;
+}
+
+void hiopFixedVarsRemover::setup_mds_part(const int& neq,
+                                          const int& nineq,
+                                          const size_type& nx_sp,
+                                          const size_type& nx_de,
+                                          const size_type& nnz_jac_eq,
+                                          const size_type& nnz_jac_ineq,
+                                          const size_type& nnz_hess)
+{
+  assert(nullptr==Hess_fs_ && "should not be allocated at this point");
+  assert(nx_sp+nx_de == n_fs);
+  assert(n_fs == static_cast<size_type>(fs2rs_idx_map.size()) && "MDS NLPs are not distributed");
+  const std::string mem_space = nlp_->options->GetString("mem_space");
+
+  Jacc_fs_sp_ = new hiopMatrixMDS(neq, nx_sp, nx_de, nnz_jac_eq, mem_space);
+  Jacd_fs_sp_ = new hiopMatrixMDS(nineq, nx_sp, nx_de, nnz_jac_ineq, mem_space);
+  Jac_cons_fs_ = new hiopMatrixMDS(neq+nineq, nx_sp, nx_de, nnz_jac_eq+nnz_jac_ineq, mem_space);
+  Hess_fs_ = new hiopMatrixSymBlockDiagMDS(nx_sp, nx_de, nnz_hess, mem_space);
+  Jacc_fs_sp_->setToZero();
+  Jacd_fs_sp_->setToZero();
+  Jac_cons_fs_->setToZero();
+  Hess_fs_->setToZero();
+
+  nx_sp_fs_ = nx_sp;
+  nx_sp_rs_ = 0;
+  for(index_type i=0; i<nx_sp; i++) {
+    if(fs2rs_idx_map[i]>=0) {
+      nx_sp_rs_++;
+    }
+  }
+}
+
+void hiopFixedVarsRemover::setup_nnz_maps()
+{
+  assert(has_sparse_part());
+  nnz_jacc_rs_ = build_nnz_map(*Jacc_fs_sp_, false, jacc_nz_map_);
+  nnz_jacd_rs_ = build_nnz_map(*Jacd_fs_sp_, false, jacd_nz_map_);
+  nnz_hess_rs_ = build_nnz_map(*Hess_fs_, true, hess_nz_map_);
+}
+
+/// pointers to the triplet arrays of a sparse matrix or of the sparse block of an MDS matrix
+static bool get_sparse_block(hiopMatrix& M, size_type& nnz, index_type*& irow, index_type*& jcol, double*& vals)
+{
+  hiopMatrixSparse* M_sp = dynamic_cast<hiopMatrixSparse*>(&M);
+  if(M_sp) {
+    nnz = M_sp->numberOfNonzeros();
+    irow = M_sp->i_row();
+    jcol = M_sp->j_col();
+    vals = M_sp->M();
+    return true;
+  }
+  hiopMatrixMDS* M_mds = dynamic_cast<hiopMatrixMDS*>(&M);
+  if(M_mds) {
+    nnz = M_mds->sp_nnz();
+    irow = M_mds->sp_irow();
+    jcol = M_mds->sp_jcol();
+    vals = M_mds->sp_M();
+    return true;
+  }
+  hiopMatrixSymBlockDiagMDS* M_symmds = dynamic_cast<hiopMatrixSymBlockDiagMDS*>(&M);
+  if(M_symmds) {
+    nnz = M_symmds->sp_nnz();
+    irow = M_symmds->sp_irow();
+    jcol = M_symmds->sp_jcol();
+    vals = M_symmds->sp_M();
+    return true;
+  }
+  return false;
+}
+
+size_type hiopFixedVarsRemover::build_nnz_map(hiopMatrix& M_fs, bool compact_rows, std::vector<index_type>& nz_map)
+{
+  size_type nnz_fs;
+  index_type *irow, *jcol;
+  double* vals;
+  bool bret = get_sparse_block(M_fs, nnz_fs, irow, jcol, vals);
+  assert(bret);
+  
+  nz_map.resize(nnz_fs);
+  size_type nnz_rs = 0;
+  for(index_type k=0; k<nnz_fs; k++) {
+    assert(jcol[k]>=0 && jcol[k]<nx_sp_fs_);
+    if(fs2rs_idx_map[jcol[k]]<0 || (compact_rows && fs2rs_idx_map[irow[k]]<0)) {
+      nz_map[k] = -1;
+    } else {
+      nz_map[k] = nnz_rs++;
+    }
+  }
+  return nnz_rs;
+}
+
+bool hiopFixedVarsRemover::apply_to_sparse_matrix(hiopMatrix& M_fs,
+                                                  const std::vector<index_type>& nz_map,
+                                                  bool compact_rows,
+                                                  hiopMatrix& M_rs)
+{
+  size_type nnz_fs, nnz_rs;
+  index_type *irow_fs, *jcol_fs, *irow_rs, *jcol_rs;
+  double *vals_fs, *vals_rs;
+  if(!get_sparse_block(M_fs, nnz_fs, irow_fs, jcol_fs, vals_fs) ||
+     !get_sparse_block(M_rs, nnz_rs, irow_rs, jcol_rs, vals_rs)) {
+    return false;
+  }
+  assert(nnz_fs == static_cast<size_type>(nz_map.size()));
+  
+  //the (compacted) indexes are copied too since 'M_rs' gets its sparsity pattern only from here
+  for(index_type k=0; k<nnz_fs; k++) {
+    const index_type k_rs = nz_map[k];
+    if(k_rs>=0) {
+      assert(k_rs<nnz_rs);
+      irow_rs[k_rs] = compact_rows ? fs2rs_idx_map[irow_fs[k]] : irow_fs[k];
+      jcol_rs[k_rs] = fs2rs_idx_map[jcol_fs[k]];
+      vals_rs[k_rs] = vals_fs[k];
+    }
+  }
+
+  //dense blocks of the MDS matrices
+  hiopMatrixMDS* M_fs_mds = dynamic_cast<hiopMatrixMDS*>(&M_fs);
+  if(M_fs_mds) {
+    hiopMatrixMDS* M_rs_mds = dynamic_cast<hiopMatrixMDS*>(&M_rs);
+    assert(M_rs_mds);
+    apply_to_dense_block(M_fs_mds->de_local_data(), M_fs_mds->m(), false, M_rs_mds->de_local_data());
+  }
+  hiopMatrixSymBlockDiagMDS* M_fs_symmds = dynamic_cast<hiopMatrixSymBlockDiagMDS*>(&M_fs);
+  if(M_fs_symmds) {
+    hiopMatrixSymBlockDiagMDS* M_rs_symmds = dynamic_cast<hiopMatrixSymBlockDiagMDS*>(&M_rs);
+    assert(M_rs_symmds);
+    apply_to_dense_block(M_fs_symmds->de_local_data(),
+                         M_fs_symmds->n_de(),
+                         true,
+                         M_rs_symmds->de_local_data());
+  }
   return true;
 }
 
+void hiopFixedVarsRemover::apply_to_dense_block(const double* M_fs, const int& m_in, bool compact_rows, double* M_rs)
+{
+  const size_type nde_fs = n_fs - nx_sp_fs_;
+  const size_type nde_rs = n_rs - nx_sp_rs_;
+  index_type i_rs = 0;
+  for(index_type i=0; i<m_in; i++) {
+    if(compact_rows && fs2rs_idx_map[nx_sp_fs_+i]<0) {
+      continue;
+    }
+    for(index_type j=0; j<nde_fs; j++) {
+      const index_type rs_idx = fs2rs_idx_map[nx_sp_fs_+j];
+      if(rs_idx>=0) {
+        M_rs[i_rs*nde_rs + rs_idx-nx_sp_rs_] = M_fs[i*nde_fs + j];
+      }
+    }
+    i_rs++;
+  }
+}
+
 /* "copies" a full space vector/array to a reduced space vector/array */
 void hiopFixedVarsRemover::copyFsToRs(const hiopVector& fsVec,  hiopVector& rsVec)
 {
-  assert(fsVec.get_local_size()==fs2rs_idx_map.size());
+  assert(fsVec.get_local_size()==static_cast<size_type>(fs2rs_idx_map.size()));
   apply_to_vector(&fsVec, &rsVec);
 }
 
+void hiopFixedVarsRemover::copyRsToFs(const hiopVector& rsVec,  hiopVector& fsVec)
+{
+  assert(fsVec.get_local_size()==static_cast<size_type>(fs2rs_idx_map.size()));
+  apply_inv_to_vector(&rsVec, &fsVec);
+}
+
 void hiopFixedVarsRemover::
 copyFsToRs(const hiopInterfaceBase::NonlinearityType* fs, hiopInterfaceBase::NonlinearityType* rs)
 {
   int rs_idx;
-  for(int i=0; i<fs2rs_idx_map.size(); i++) {
+  for(size_t i=0; i<fs2rs_idx_map.size(); i++) {
     rs_idx = fs2rs_idx_map[i];
     if(rs_idx>=0) {
       rs[rs_idx] = fs[i];
@@ -220,7 +415,7 @@ void hiopFixedVarsRemover::apply_inv_to_vector(const hiopVector* vec_rs, hiopVec
   const double* vec_rs_arr = vec_rs->local_data_const();
   double* vec_fs_arr = vec_fs->local_data();
   int rs_idx;
-  for(int i=0; i<fs2rs_idx_map.size(); i++) {
+  for(size_t i=0; i<fs2rs_idx_map.size(); i++) {
     rs_idx = fs2rs_idx_map[i];
     if(rs_idx<0) {
       vec_fs_arr[i] = xl_fs_arr[i];
@@ -236,7 +431,7 @@ void hiopFixedVarsRemover::apply_to_vector(const hiopVector* vec_fs, hiopVector*
   double* vec_rs_arr = vec_rs->local_data();
   const double* vec_fs_arr = vec_fs->local_data_const();
   int rs_idx;
-  for(int i=0; i<fs2rs_idx_map.size(); i++) {
+  for(size_t i=0; i<fs2rs_idx_map.size(); i++) {
     rs_idx = fs2rs_idx_map[i];
     if(rs_idx>=0) {
       vec_rs_arr[rs_idx]=vec_fs_arr[i];
@@ -249,11 +444,11 @@ void hiopFixedVarsRemover::applyToMatrix(const double* M_rs, const int& m_in, do
 {
   int rs_idx;
   const size_t nfs = fs2rs_idx_map.size();
-  assert(nfs == fs_n_local());
+  assert(nfs == static_cast<size_t>(fs_n_local()));
   const int nrs = rs_n_local();
 
   for(int i=0; i<m_in; i++) {
-    for(int j=0; j<nfs; j++) {
+    for(size_t j=0; j<nfs; j++) {
       rs_idx = fs2rs_idx_map[j];
       if(rs_idx<0) {
   	//M_fs[i][j] = 0.; //really no need to initialize this, these entries will be later ignored
@@ -271,11 +466,11 @@ void hiopFixedVarsRemover::applyInvToMatrix(const double* M_fs, const int& m_in,
 {
   int rs_idx;
   const size_t nfs = fs2rs_idx_map.size();
-  assert(nfs == fs_n_local());
+  assert(nfs == static_cast<size_t>(fs_n_local()));
   const int nrs = rs_n_local();
 
   for(int i=0; i<m_in; i++) {
-    for(int j=0; j<fs2rs_idx_map.size(); j++) {  
+    for(size_t j=0; j<fs2rs_idx_map.size(); j++) {  
       rs_idx = fs2rs_idx_map[j];
       if(rs_idx>=0) {
   	M_rs[i*nrs+rs_idx] = M_fs[i*nfs+j];
@@ -436,8 +631,9 @@ hiopNLPObjGradScaling::hiopNLPObjGradScaling(hiopNlpFormulation* nlp,
   
   scale_factor_c = c.new_copy();
   scale_factor_d = d.new_copy();
+  //indexed as the user's constraints, which include the ones removed by the presolve
   scale_factor_cd = LinearAlgebraFactory::create_vector(nlp_->options->GetString("mem_space"),
-                                                        n_eq + n_ineq);
+                                                        nlp_->m_user());
 
   Jac_c.row_max_abs_value(*scale_factor_c);
   scale_factor_c->scale(1./max_grad);
@@ -453,6 +649,7 @@ hiopNLPObjGradScaling::hiopNLPObjGradScaling(hiopNlpFormulation* nlp,
   const double* ineq_arr = scale_factor_d->local_data_const();
   double* scale_factor_cd_arr = scale_factor_cd->local_data();
 
+  scale_factor_cd->setToConstant(1.);
   scale_factor_cd->copy_from_two_vec_w_pattern(*scale_factor_c, cons_eq_mapping, *scale_factor_d, cons_ineq_mapping);
 
 }
@@ -464,9 +661,414 @@ hiopNLPObjGradScaling::~hiopNLPObjGradScaling()
   if(scale_factor_cd) delete scale_factor_cd;
 }
 
+/**
+* For class hiopSparseNlpPresolver
+*/
+hiopSparseNlpPresolver::hiopSparseNlpPresolver(hiopNlpFormulation* nlp,
+                                               const size_type& n_vars,
+                                               const hiopVectorInt& cons_eq_mapping,
+                                               const hiopVectorInt& cons_ineq_mapping,
+                                               const size_type& nnz_jac_eq,
+                                               const size_type& nnz_jac_ineq)
+  : hiopNlpTransformation(nlp),
+    n_vars_(n_vars),
+    eq_rs2fs_(nullptr),
+    ineq_rs2fs_(nullptr),
+    nnz_jacc_rs_(nnz_jac_eq),
+    nnz_jacd_rs_(nnz_jac_ineq),
+    c_rs_ref_(nullptr),
+    d_rs_ref_(nullptr),
+    Jacc_rs_ref_(nullptr),
+    Jacd_rs_ref_(nullptr)
+{
+  const std::string mem_space = nlp_->options->GetString("mem_space");
+  const size_type m_eq = cons_eq_mapping.size();
+  const size_type m_ineq = cons_ineq_mapping.size();
+
+  cons_eq_mapping_fs_ = LinearAlgebraFactory::create_vector_int(mem_space, m_eq);
+  cons_eq_mapping_fs_->copy_from(cons_eq_mapping.local_data_const());
+  cons_ineq_mapping_fs_ = LinearAlgebraFactory::create_vector_int(mem_space, m_ineq);
+  cons_ineq_mapping_fs_->copy_from(cons_ineq_mapping.local_data_const());
+
+  //all the constraints are kept until 'presolve' is called
+  eq_rs2fs_ = LinearAlgebraFactory::create_vector_int(mem_space, m_eq);
+  eq_rs2fs_->linspace(0, 1);
+  ineq_rs2fs_ = LinearAlgebraFactory::create_vector_int(mem_space, m_ineq);
+  ineq_rs2fs_->linspace(0, 1);
+
+  c_fs_ = LinearAlgebraFactory::create_vector(mem_space, m_eq);
+  d_fs_ = LinearAlgebraFactory::create_vector(mem_space, m_ineq);
+  Jacc_fs_ = LinearAlgebraFactory::create_matrix_sparse(mem_space, m_eq, n_vars_, nnz_jac_eq);
+  Jacd_fs_ = LinearAlgebraFactory::create_matrix_sparse(mem_space, m_ineq, n_vars_, nnz_jac_ineq);
+  c_fs_->setToZero();
+  d_fs_->setToZero();
+  Jacc_fs_->setToZero();
+  Jacd_fs_->setToZero();
+}
+
+hiopSparseNlpPresolver::~hiopSparseNlpPresolver()
+{
+  delete cons_eq_mapping_fs_;
+  delete cons_ineq_mapping_fs_;
+  delete eq_rs2fs_;
+  delete ineq_rs2fs_;
+  delete c_fs_;
+  delete d_fs_;
+  delete Jacc_fs_;
+  delete Jacd_fs_;
+}
+
+/// sorted (column, value) pairs of the nonzeros of the rows of a sparse (triplet) matrix
+static void get_sparse_rows(const hiopMatrixSparse& M,
+                            index_type row_offset,
+                            std::vector<std::vector<std::pair<index_type, double> > >& rows)
+{
+  const index_type* irow = M.i_row();
+  const index_type* jcol = M.j_col();
+  const double* values = M.M();
+  for(index_type k=0; k<M.numberOfNonzeros(); ++k) {
+    rows[row_offset+irow[k]].push_back(std::make_pair(jcol[k], values[k]));
+  }
+  for(index_type r=row_offset; r<row_offset+M.m(); ++r) {
+    auto& row = rows[r];
+    std::sort(row.begin(), row.end());
+    //sum up the repeated entries and drop the zeros
+    size_t nz = 0;
+    for(size_t k=0; k<row.size(); ++k) {
+      if(nz>0 && row[nz-1].first==row[k].first) {
+        row[nz-1].second += row[k].second;
+      } else {
+        row[nz++] = row[k];
+      }
+    }
+    row.resize(nz);
+    row.erase(std::remove_if(row.begin(),
+                             row.end(),
+                             [](const std::pair<index_type, double>& e) { return e.second==0.; }),
+              row.end());
+  }
+}
+
+size_type hiopSparseNlpPresolver::presolve(const hiopVector& x,
+                                           const hiopVector& c_rhs,
+                                           hiopVector& dl,
+                                           hiopVector& du,
+                                           const hiopInterfaceBase::NonlinearityType* cons_eq_type,
+                                           const hiopInterfaceBase::NonlinearityType* cons_ineq_type,
+                                           hiopVector& xl,
+                                           hiopVector& xu,
+                                           const double& feas_tol,
+                                           const double& fixed_var_tol,
+                                           const bool& allow_fixed_vars)
+{
+  const size_type m_eq = fs_m_eq();
+  const size_type m_ineq = fs_m_ineq();
+  const size_type m = m_eq + m_ineq;
+  assert(c_rhs.get_size()==m_eq && dl.get_size()==m_ineq && du.get_size()==m_ineq);
+  assert(x.get_size()==n_vars_ && xl.get_size()==n_vars_ && xu.get_size()==n_vars_);
+
+  const index_type* eq_map = cons_eq_mapping_fs_->local_data_const();
+  const index_type* ineq_map = cons_ineq_mapping_fs_->local_data_const();
+  const double* xa = x.local_data_const();
+  double* xla = xl.local_data();
+  double* xua = xu.local_data();
+  double* dla = dl.local_data();
+  double* dua = du.local_data();
+
+  //the rows of the linear constraints, the equalities followed by the inequalities, with their bounds and
+  //the constant term 'offset' in their body
+  std::vector<std::vector<std::pair<index_type, double> > > rows(m);
+  get_sparse_rows(*Jacc_fs_, 0, rows);
+  get_sparse_rows(*Jacd_fs_, m_eq, rows);
+
+  std::vector<bool> is_lin(m);
+  std::vector<double> lo(m), up(m), offset(m);
+  for(index_type r=0; r<m; ++r) {
+    if(r<m_eq) {
+      is_lin[r] = cons_eq_type[r]==hiopInterfaceBase::hiopLinear;
+      lo[r] = up[r] = c_rhs.local_data_const()[r];
+      offset[r] = c_fs_->local_data_const()[r];
+    } else {
+      is_lin[r] = cons_ineq_type[r-m_eq]==hiopInterfaceBase::hiopLinear;
+      lo[r] = dla[r-m_eq];
+      up[r] = dua[r-m_eq];
+      offset[r] = d_fs_->local_data_const()[r-m_eq];
+    }
+    for(auto& e : rows[r]) {
+      offset[r] -= e.second*xa[e.first];
+    }
+  }
+  auto cons_idx = [&](index_type r) { return r<m_eq ? eq_map[r] : ineq_map[r-m_eq]; };
+  auto is_close = [&](double a, double b) { return fabs(a-b) <= feas_tol*fmax(1., fabs(b)); };
+
+  std::vector<bool> removed(m, false);
+  removed_cons_.clear();
+
+  //the removed constraints, as indexes into 'removed_cons_', that set the lower/upper bounds of the
+  //variables (singleton rows) and of the kept rows (duplicate rows); -1 for the bounds of the user
+  std::vector<index_type> var_lo_owner(n_vars_, -1), var_up_owner(n_vars_, -1);
+  std::vector<index_type> row_lo_owner(m, -1), row_up_owner(m, -1);
+  size_type n_empty=0, n_singleton=0, n_duplicate=0, n_inconsistent=0;
+
+  //
+  // empty rows and singleton rows
+  //
+  for(index_type r=0; r<m; ++r) {
+    if(!is_lin[r] || rows[r].size()>1) {
+      continue;
+    }
+    if(rows[r].empty()) {
+      if((lo[r]<=-1e20 || offset[r]>=lo[r] || is_close(offset[r], lo[r])) &&
+         (up[r]>=1e20 || offset[r]<=up[r] || is_close(offset[r], up[r]))) {
+        removed[r] = true;
+        removed_cons_.push_back({RemovedCons::EMPTY, cons_idx(r), -1, 0., offset[r], false, false});
+        n_empty++;
+      } else {
+        n_inconsistent++;
+      }
+      continue;
+    }
+
+    //singleton row a*x_j+offset: the bounds of the row give bounds on x_j
+    const index_type j = rows[r][0].first;
+    const double a = rows[r][0].second;
+    double bnd_lo = lo[r]>-1e20 ? (lo[r]-offset[r])/a : -1e20;
+    double bnd_up = up[r]< 1e20 ? (up[r]-offset[r])/a :  1e20;
+    if(a<0) {
+      std::swap(bnd_lo, bnd_up);
+      if(bnd_lo>=1e20) bnd_lo = -1e20;
+      if(bnd_up<=-1e20) bnd_up = 1e20;
+    }
+    const bool sets_lo = bnd_lo > xla[j];
+    const bool sets_up = bnd_up < xua[j];
+    bnd_lo = fmax(bnd_lo, xla[j]);
+    bnd_up = fmin(bnd_up, xua[j]);
+    if(bnd_lo>bnd_up && !is_close(bnd_lo, bnd_up)) {
+      n_inconsistent++;
+      continue;
+    }
+    if(bnd_up<1e20 && fabs(bnd_up-bnd_lo) <= fmax(fixed_var_tol, feas_tol)*fmax(1., fabs(bnd_up))) {
+      //the row fixes x_j
+      if(!allow_fixed_vars) {
+        continue;
+      }
+      bnd_lo = bnd_up = 0.5*(bnd_lo+bnd_up);
+    }
+    xla[j] = bnd_lo;
+    xua[j] = bnd_up;
+    removed[r] = true;
+    if(sets_lo) {
+      var_lo_owner[j] = removed_cons_.size();
+    }
+    if(sets_up) {
+      var_up_owner[j] = removed_cons_.size();
+    }
+    removed_cons_.push_back({RemovedCons::SINGLETON, cons_idx(r), j, a, offset[r], false, false});
+    n_singleton++;
+  }
+
+  //
+  // duplicate rows: the rows are grouped by their sparsity pattern and a row of a group is merged into a
+  // previous (kept) row of the group with proportional values; the equalities come first and are kept
+  //
+  std::map<std::vector<index_type>, std::vector<index_type> > groups;
+  for(index_type r=0; r<m; ++r) {
+    if(is_lin[r] && !removed[r] && rows[r].size()>1) {
+      std::vector<index_type> pattern(rows[r].size());
+      for(size_t k=0; k<rows[r].size(); ++k) {
+        pattern[k] = rows[r][k].first;
+      }
+      groups[pattern].push_back(r);
+    }
+  }
+  for(auto& group : groups) {
+    std::vector<index_type> kept;
+    for(index_type r : group.second) {
+      //look for a kept row 'p' such that row 'r' is 'ratio' times row 'p'
+      index_type p = -1;
+      double ratio = 0.;
+      for(index_type q : kept) {
+        ratio = rows[r][0].second/rows[q][0].second;
+        bool proportional = true;
+        for(size_t k=1; k<rows[r].size() && proportional; ++k) {
+          const double a_r = rows[r][k].second;
+          proportional = fabs(a_r-ratio*rows[q][k].second) <= 1e-12*fabs(a_r);
+        }
+        if(proportional) {
+          p = q;
+          break;
+        }
+      }
+      if(p<0) {
+        kept.push_back(r);
+        continue;
+      }
+
+      //row 'r' is lo[r] <= ratio*(body_p-offset_p)+offset_r <= up[r], which gives bounds on body_p
+      double bnd_lo = lo[r]>-1e20 ? (lo[r]-offset[r])/ratio+offset[p] : -1e20;
+      double bnd_up = up[r]< 1e20 ? (up[r]-offset[r])/ratio+offset[p] :  1e20;
+      if(ratio<0) {
+        std::swap(bnd_lo, bnd_up);
+        if(bnd_lo>=1e20) bnd_lo = -1e20;
+        if(bnd_up<=-1e20) bnd_up = 1e20;
+      }
+      bool sets_lo = false, sets_up = false;
+      if(p<m_eq) {
+        //row 'r' should be satisfied when the equality 'p' is satisfied
+        if((bnd_lo>-1e20 && lo[p]<bnd_lo && !is_close(lo[p], bnd_lo)) ||
+           (bnd_up< 1e20 && lo[p]>bnd_up && !is_close(lo[p], bnd_up))) {
+          n_inconsistent++;
+          continue;
+        }
+      } else {
+        //the bounds of the inequality 'p' are tightened; the row is kept if they become (almost) equal
+        sets_lo = bnd_lo > lo[p];
+        sets_up = bnd_up < up[p];
+        bnd_lo = fmax(bnd_lo, lo[p]);
+        bnd_up = fmin(bnd_up, up[p]);
+        if(bnd_lo>bnd_up && !is_close(bnd_lo, bnd_up)) {
+          n_inconsistent++;
+          continue;
+        }
+        if(bnd_up<1e20 && fabs(bnd_up-bnd_lo) <= feas_tol*fmax(1., fabs(bnd_up))) {
+          continue;
+        }
+        lo[p] = bnd_lo;
+        up[p] = bnd_up;
+      }
+      removed[r] = true;
+      if(sets_lo) {
+        row_lo_owner[p] = removed_cons_.size();
+      }
+      if(sets_up) {
+        row_up_owner[p] = removed_cons_.size();
+      }
+      removed_cons_.push_back({RemovedCons::DUPLICATE,
+                               cons_idx(r),
+                               cons_idx(p),
+                               ratio,
+                               offset[r]-ratio*offset[p],
+                               false,
+                               false});
+      n_duplicate++;
+    }
+  }
+
+  //only the last of the removed constraints that tightened a bound holds its multiplier
+  for(index_type j=0; j<n_vars_; ++j) {
+    if(var_lo_owner[j]>=0) removed_cons_[var_lo_owner[j]].sets_lo = true;
+    if(var_up_owner[j]>=0) removed_cons_[var_up_owner[j]].sets_up = true;
+  }
+  for(index_type r=0; r<m; ++r) {
+    if(row_lo_owner[r]>=0) removed_cons_[row_lo_owner[r]].sets_lo = true;
+    if(row_up_owner[r]>=0) removed_cons_[row_up_owner[r]].sets_up = true;
+  }
+
+  for(index_type i=0; i<m_ineq; ++i) {
+    dla[i] = lo[m_eq+i];
+    dua[i] = up[m_eq+i];
+  }
+
+  //the kept rows
+  std::vector<bool> removed_eq(removed.begin(), removed.begin()+m_eq);
+  std::vector<bool> removed_ineq(removed.begin()+m_eq, removed.end());
+  nnz_jacc_rs_ = build_rs2fs(*Jacc_fs_, removed_eq, eq_rs2fs_);
+  nnz_jacd_rs_ = build_rs2fs(*Jacd_fs_, removed_ineq, ineq_rs2fs_);
+
+  const size_type n_removed = n_empty + n_singleton + n_duplicate;
+  nlp_->log->printf(hovSummary,
+                    "Presolve removed %d constraints: %d empty, %d singleton (converted to variables bounds), "
+                    "and %d duplicate rows.\n",
+                    n_removed, n_empty, n_singleton, n_duplicate);
+  if(n_inconsistent>0) {
+    nlp_->log->printf(hovWarning,
+                      "Presolve detected %d inconsistent linear constraints, which were not removed.\n",
+                      n_inconsistent);
+  }
+  return n_removed;
+}
 
+size_type hiopSparseNlpPresolver::build_rs2fs(const hiopMatrixSparse& Jac_fs,
+                                              const std::vector<bool>& removed,
+                                              hiopVectorInt*& rs2fs)
+{
+  const size_type m_rs = std::count(removed.begin(), removed.end(), false);
+  delete rs2fs;
+  rs2fs = LinearAlgebraFactory::create_vector_int(nlp_->options->GetString("mem_space"), m_rs);
+  index_type* rs2fs_arr = rs2fs->local_data();
+  index_type it = 0;
+  for(size_t i=0; i<removed.size(); ++i) {
+    if(!removed[i]) {
+      rs2fs_arr[it++] = i;
+    }
+  }
+  assert(it==m_rs);
 
+  size_type nnz_rs = 0;
+  const index_type* irow = Jac_fs.i_row();
+  for(index_type k=0; k<Jac_fs.numberOfNonzeros(); ++k) {
+    if(!removed[irow[k]]) {
+      nnz_rs++;
+    }
+  }
+  return nnz_rs;
+}
 
+void hiopSparseNlpPresolver::postsolve_cons_body(const hiopVector& x, hiopVector& cons_body) const
+{
+  const double* xa = x.local_data_const();
+  double* body = cons_body.local_data();
+  for(const RemovedCons& rc : removed_cons_) {
+    switch(rc.type) {
+    case RemovedCons::EMPTY:
+      body[rc.cons_idx] = rc.offset;
+      break;
+    case RemovedCons::SINGLETON:
+      body[rc.cons_idx] = rc.coef*xa[rc.ref_idx] + rc.offset;
+      break;
+    case RemovedCons::DUPLICATE:
+      //the body of the kept row was already computed
+      body[rc.cons_idx] = rc.coef*body[rc.ref_idx] + rc.offset;
+      break;
+    }
+  }
+}
 
+void hiopSparseNlpPresolver::postsolve_duals(hiopVector& zl, hiopVector& zu, hiopVector& lambda) const
+{
+  double* zla = zl.local_data();
+  double* zua = zu.local_data();
+  double* lambdaa = lambda.local_data();
+  for(const RemovedCons& rc : removed_cons_) {
+    switch(rc.type) {
+    case RemovedCons::EMPTY:
+      lambdaa[rc.cons_idx] = 0.;
+      break;
+    case RemovedCons::SINGLETON:
+      //the multipliers of the bounds set by the row 'coef*x_j+offset' become the multiplier of the row: 
+      //the term -zl_j+zu_j of the gradient of the Lagrangian is replaced by coef*lambda_r
+      lambdaa[rc.cons_idx] = 0.;
+      if(rc.sets_lo) {
+        lambdaa[rc.cons_idx] -= zla[rc.ref_idx]/rc.coef;
+        zla[rc.ref_idx] = 0.;
+      }
+      if(rc.sets_up) {
+        lambdaa[rc.cons_idx] += zua[rc.ref_idx]/rc.coef;
+        zua[rc.ref_idx] = 0.;
+      }
+      break;
+    case RemovedCons::DUPLICATE:
+      //the row is 'coef' times the kept row, hence its multiplier is the one of the kept row divided by 
+      //'coef' when the active bound of the kept row was set by this row; a negative multiplier 
+      //corresponds to the lower bound
+      lambdaa[rc.cons_idx] = 0.;
+      if((rc.sets_lo && lambdaa[rc.ref_idx]<0.) || (rc.sets_up && lambdaa[rc.ref_idx]>0.)) {
+        lambdaa[rc.cons_idx] = lambdaa[rc.ref_idx]/rc.coef;
+        lambdaa[rc.ref_idx] = 0.;
+      }
+      break;
+    }
+  }
+}
 
 } //end of namespace
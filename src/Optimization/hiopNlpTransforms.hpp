@@ -59,6 +59,7 @@
 #include "hiopInterface.hpp"
 #include "hiopVector.hpp"
 #include "hiopMatrixDense.hpp"
+#include "hiopMatrixSparse.hpp"
 
 #include <cassert>
 #include <list>
@@ -146,6 +147,12 @@ protected:
  *
  * applyInvToXXX: takes XXX as seen by the user calling code and returns the corresponding
  * reduced-space XXX object.
+ *
+ * Dense Jacobians are compacted column-wise. The sparse (triplet) Jacobians and Hessian of the sparse
+ * and MDS NLP formulations are compacted using maps from the full-space nonzeros to the reduced-space
+ * ones, which are built once from the sparsity patterns provided by the user (see 'setup_sparse_part',
+ * 'setup_mds_part', and 'setup_nnz_maps'); the dense blocks of the MDS matrices are compacted column-wise
+ * (and also row-wise for the Hessian).
  */
 class hiopFixedVarsRemover : public hiopNlpTransformation
 {
@@ -216,7 +223,13 @@ public:
   {
     hiopMatrixDense* Jac_de = dynamic_cast<hiopMatrixDense*>(&Jac_in);
     if(Jac_de==nullptr) {
-      return nullptr;
+      //sparse or MDS Jacobian: the user evaluates it in the full-space buffer
+      Jacc_rs_sp_ref_ = &Jac_in;
+      assert(nullptr==Jacc_fs_sp_ || Jacc_fs_sp_->m()==m_in);
+      return Jacc_fs_sp_;
+    }
+    if(nullptr==Jacc_fs) {
+      Jacc_fs = alloc_fs_jacob_dense(m_in);
     }
     Jacc_rs_ref = Jac_de;
     assert(Jacc_fs->m()==m_in);
@@ -227,7 +240,10 @@ public:
   {
     hiopMatrixDense* Jac_de = dynamic_cast<hiopMatrixDense*>(&Jac_in);
     if(Jac_de==NULL) {
-      return nullptr;
+      if(nullptr==Jacc_rs_sp_ref_ || !apply_to_sparse_matrix(Jac_in, jacc_nz_map_, false, *Jacc_rs_sp_ref_)) {
+        return nullptr;
+      }
+      return Jacc_rs_sp_ref_;
     }    
     assert(Jacc_fs->m()==m_in);
     applyInvToMatrix(Jac_de->local_data(), m_in, Jacc_rs_ref->local_data());
@@ -237,7 +253,12 @@ public:
   {
     hiopMatrixDense* Jac_de = dynamic_cast<hiopMatrixDense*>(&Jac_in);
     if(Jac_de==NULL) {
-      return nullptr;
+      Jacd_rs_sp_ref_ = &Jac_in;
+      assert(nullptr==Jacd_fs_sp_ || Jacd_fs_sp_->m()==m_in);
+      return Jacd_fs_sp_;
+    }
+    if(nullptr==Jacd_fs) {
+      Jacd_fs = alloc_fs_jacob_dense(m_in);
     }
     Jacd_rs_ref = Jac_de;
     assert(Jacd_fs->m()==m_in);
@@ -248,16 +269,114 @@ public:
   {
     hiopMatrixDense* Jac_de = dynamic_cast<hiopMatrixDense*>(&Jac_in);
     if(Jac_de==NULL) {
-      return nullptr;
+      if(nullptr==Jacd_rs_sp_ref_ || !apply_to_sparse_matrix(Jac_in, jacd_nz_map_, false, *Jacd_rs_sp_ref_)) {
+        return nullptr;
+      }
+      return Jacd_rs_sp_ref_;
     }    
     assert(Jacd_fs->m()==m_in);
     applyInvToMatrix(Jac_de->local_data(), m_in, Jacd_rs_ref->local_data());
     return Jacd_rs_ref;
   }
 
+  /**
+   * from rs to fs: for sparse and MDS Jacobians returns the full-space buffer for the one-call Jacobian; 
+   * dense Jacobians are returned unchanged
+   */
+  inline hiopMatrix* apply_inv_to_jacob_cons(hiopMatrix& Jac_in, const int& m_in)
+  {
+    if(nullptr==Jac_cons_fs_ || dynamic_cast<hiopMatrixDense*>(&Jac_in)) {
+      return &Jac_in;
+    }
+    assert(Jac_cons_fs_->m()==m_in);
+    Jac_cons_rs_ref_ = &Jac_in;
+    return Jac_cons_fs_;
+  }
+  /**
+   * from fs to rs: the one-call Jacobian is not compacted, only its rows copied to the full-space 
+   * Jacobians of the equalities and inequalities are (by 'apply_to_jacob_eq' and 'apply_to_jacob_ineq')
+   */
+  inline hiopMatrix* apply_to_jacob_cons(hiopMatrix& Jac_in, const int& m_in)
+  {
+    if(&Jac_in != Jac_cons_fs_) {
+      return &Jac_in;
+    }
+    return Jac_cons_rs_ref_;
+  }
+
+  /* from rs to fs: sparse and MDS Hessians only */
+  inline hiopMatrix* apply_inv_to_larg_hess(hiopMatrix& Hess_in, const int& m_in)
+  {
+    if(nullptr==Hess_fs_) {
+      return &Hess_in;
+    }
+    Hess_rs_ref_ = &Hess_in;
+    return Hess_fs_;
+  }
+  /* from fs to rs */
+  inline hiopMatrix* apply_to_larg_hess(hiopMatrix& Hess_in, const int& m_in)
+  {
+    if(&Hess_in != Hess_fs_) {
+      return &Hess_in;
+    }
+    assert(Hess_rs_ref_);
+    if(!apply_to_sparse_matrix(Hess_in, hess_nz_map_, true, *Hess_rs_ref_)) {
+      return nullptr;
+    }
+    return Hess_rs_ref_;
+  }
+
   /** methods not inherited from parent class */
   bool setupDecisionVectorPart();
   bool setupConstraintsPart(const int& neq, const int& nineq);
+
+  /**
+   * Allocates the full-space (user's) Jacobians and Hessian of the sparse NLP formulation, with 'nnz_jac_eq', 
+   * 'nnz_jac_ineq', and 'nnz_hess' nonzeros. The caller should obtain their sparsity patterns from the user,
+   * in the matrices returned by 'jacob_eq_fs', 'jacob_ineq_fs', and 'larg_hess_fs', and then call 
+   * 'setup_nnz_maps'.
+   */
+  void setup_sparse_part(const int& neq,
+                         const int& nineq,
+                         const size_type& nnz_jac_eq,
+                         const size_type& nnz_jac_ineq,
+                         const size_type& nnz_hess);
+
+  /**
+   * Same as 'setup_sparse_part', but for the MDS NLP formulation, whose first 'nx_sp' variables are sparse
+   * and the remaining 'nx_de' dense; the number of nonzeros refer to the sparse blocks of the matrices.
+   */
+  void setup_mds_part(const int& neq,
+                      const int& nineq,
+                      const size_type& nx_sp,
+                      const size_type& nx_de,
+                      const size_type& nnz_jac_eq,
+                      const size_type& nnz_jac_ineq,
+                      const size_type& nnz_hess);
+
+  /**
+   * Builds the maps from the nonzeros of the full-space sparse Jacobians and Hessian to the nonzeros of the
+   * reduced-space ones. The nonzeros in the columns (and, for the Hessian, in the rows) of the fixed variables
+   * are dropped.
+   */
+  void setup_nnz_maps();
+
+  /// true if 'setup_sparse_part' or 'setup_mds_part' was called
+  inline bool has_sparse_part() const { return nullptr!=Hess_fs_; }
+
+  /* full-space (user's) sparse or MDS Jacobians and Hessian */
+  inline hiopMatrix* jacob_eq_fs() { return Jacc_fs_sp_; }
+  inline hiopMatrix* jacob_ineq_fs() { return Jacd_fs_sp_; }
+  inline hiopMatrix* jacob_cons_fs() { return Jac_cons_fs_; }
+  inline hiopMatrix* larg_hess_fs() { return Hess_fs_; }
+
+  /* number of nonzeros in the (sparse blocks of the) reduced-space Jacobians and Hessian */
+  inline size_type rs_nnz_jacob_eq() const { return nnz_jacc_rs_; }
+  inline size_type rs_nnz_jacob_ineq() const { return nnz_jacd_rs_; }
+  inline size_type rs_nnz_larg_hess() const { return nnz_hess_rs_; }
+
+  /// number of sparse variables in the reduced space (MDS NLP formulation)
+  inline size_type rs_nx_sp() const { return nx_sp_rs_; }
 #ifdef HIOP_USE_MPI
   /* saves the inter-process distribution of (primal) vectors distribution */
   void setFSVectorDistrib(index_type* vec_distrib,int num_ranks);
@@ -267,12 +386,16 @@ public:
 #endif
   /* "copies" a full space vector to a reduced space vector */
   void copyFsToRs(const hiopVector& fsVec,  hiopVector& rsVec);
+  /* "copies" a reduced space vector to a full space vector, with the fixed variables at their values */
+  void copyRsToFs(const hiopVector& rsVec,  hiopVector& fsVec);
   void copyFsToRs(const hiopInterfaceBase::NonlinearityType* fs, hiopInterfaceBase::NonlinearityType* rs);
   
   inline size_type fs_n() const { return n_fs;}
   inline size_type rs_n() const { return n_rs;}
   inline size_type fs_n_local() const { assert(xl_fs); return xl_fs->get_local_size(); }
   inline size_type rs_n_local() const { assert(xl_fs); return fs_n_local()-n_fixed_vars_local;}
+  /// index of each (local) full-space variable in the reduced space, -1 for the fixed variables
+  inline const std::vector<int>& get_fs2rs_idx_map() const { return fs2rs_idx_map; }
 protected: 
 #if 0 //old interface
   void applyToArray   (const double* vec_rs, double* vec_fs);
@@ -283,6 +406,28 @@ protected:
   
   void applyToMatrix   (const double* M_rs, const int& m_in, double* M_fs);
   void applyInvToMatrix(const double* M_fs, const int& m_in, double* M_rs);
+
+  /// allocates a full-space dense Jacobian with 'm_in' rows
+  hiopMatrixDense* alloc_fs_jacob_dense(const int& m_in);
+
+  /**
+   * Builds the map 'nz_map' from the nonzeros of the (sparse block of the) full-space matrix 'M_fs' to the 
+   * reduced-space nonzeros, with -1 for the dropped ones, and returns the number of reduced-space nonzeros.
+   * The rows are also compacted when 'compact_rows' is true (Hessian).
+   */
+  size_type build_nnz_map(hiopMatrix& M_fs, bool compact_rows, std::vector<index_type>& nz_map);
+  
+  /**
+   * Compacts the full-space sparse or MDS matrix 'M_fs' into 'M_rs' using the map 'nz_map' for the (sparse 
+   * block) nonzeros. Returns false if the matrices are not sparse or MDS matrices.
+   */
+  bool apply_to_sparse_matrix(hiopMatrix& M_fs,
+                              const std::vector<index_type>& nz_map,
+                              bool compact_rows,
+                              hiopMatrix& M_rs);
+
+  /// compacts the columns (and the rows if 'compact_rows') of the dense block of an MDS matrix with 'm_in' rows
+  void apply_to_dense_block(const double* M_fs, const int& m_in, bool compact_rows, double* M_rs);
 protected:
   size_type n_fixed_vars_local;
   size_type n_fixed_vars;
@@ -308,6 +453,16 @@ protected:
   //references to reduced-space buffers - returned in applyInvXXX
   hiopVector* x_rs_ref_;
   hiopVector* grad_rs_ref;
+
+  //full-space buffers for the sparse or MDS Jacobians (including the one-call Jacobian) and Hessian
+  hiopMatrix *Jacc_fs_sp_, *Jacd_fs_sp_, *Jac_cons_fs_, *Hess_fs_;
+  //references to the reduced-space sparse or MDS Jacobians and Hessian
+  hiopMatrix *Jacc_rs_sp_ref_, *Jacd_rs_sp_ref_, *Jac_cons_rs_ref_, *Hess_rs_ref_;
+  //maps from the full-space nonzeros to the reduced-space ones (-1 for the dropped nonzeros)
+  std::vector<index_type> jacc_nz_map_, jacd_nz_map_, hess_nz_map_;
+  size_type nnz_jacc_rs_, nnz_jacd_rs_, nnz_hess_rs_;
+  //number of sparse variables in the full and reduced space (all variables are sparse for the sparse NLP)
+  size_type nx_sp_fs_, nx_sp_rs_;
 #ifdef HIOP_USE_MPI
   std::vector<index_type> fs_vec_distrib;
   MPI_Comm comm;
@@ -438,7 +593,7 @@ public:
   /* from scaled to unscaled*/
   inline hiopVector* apply_inv_to_cons(hiopVector& cd_in, const int& m_in)
   { 
-    assert(n_ineq+n_eq==m_in);
+    assert(scale_factor_cd->get_size()==m_in);
     cd_in.componentDiv(*scale_factor_cd);
     return &cd_in;
   }
@@ -446,7 +601,7 @@ public:
   /* from unscaled to scaled*/
   inline hiopVector* apply_to_cons(hiopVector& cd_in, const int& m_in)
   { 
-    assert(n_ineq+n_eq==m_in);
+    assert(scale_factor_cd->get_size()==m_in);
     cd_in.componentMult(*scale_factor_cd);
     return &cd_in;
   }
@@ -551,7 +706,213 @@ private:
   size_type n_ineq;
 };
 
+/** Presolve of the linear constraints of the sparse NLP formulation.
+ *
+ * The linear (hiopInterfaceBase::hiopLinear) constraints are analyzed once, when the NLP formulation is
+ * initialized, and the following constraints are removed from the problem solved internally:
+ *  - empty rows, when they are satisfied by their constant body;
+ *  - singleton rows, which are converted to bounds on the variable they involve;
+ *  - duplicate rows, i.e., rows with the same sparsity pattern and proportional values, which are merged into
+ * the bounds or the right-hand side of one of them.
+ * Constraints that are found inconsistent are not removed and are left to the optimization algorithm.
+ *
+ * apply_inv_to_XXX: takes the constraints or Jacobian of the presolved NLP and returns the buffers for all the
+ * user's equalities or inequalities, to be evaluated by the user.
+ *
+ * apply_to_XXX: takes the buffers evaluated by the user and extracts the rows of the constraints kept by the
+ * presolve into the constraints or Jacobian of the presolved NLP.
+ *
+ * The bodies of the removed constraints are recovered by 'postsolve_cons_body'; their multipliers are zero.
+ */
+class hiopSparseNlpPresolver : public hiopNlpTransformation
+{
+public:
+  hiopSparseNlpPresolver(hiopNlpFormulation* nlp,
+                         const size_type& n_vars,
+                         const hiopVectorInt& cons_eq_mapping,
+                         const hiopVectorInt& cons_ineq_mapping,
+                         const size_type& nnz_jac_eq,
+                         const size_type& nnz_jac_ineq);
+  virtual ~hiopSparseNlpPresolver();
+
+  inline size_type n_post() { return n_vars_; }
+  inline size_type n_pre () { return n_vars_; }
+  inline size_type n_post_local() { return n_vars_; }
+  inline size_type n_pre_local() { return n_vars_; }
+  inline bool setup() { return true; }
+
+  inline hiopVector* apply_to_x(hiopVector& x)
+  {
+    return hiopNlpTransformation::apply_to_x(x);
+  }
+
+  inline void apply_to_x(hiopVector& x_in, hiopVector& x_out)
+  {
+  }
+
+  /* from presolved to user's equalities */
+  inline hiopVector* apply_inv_to_cons_eq(hiopVector& c_in, const int& m_in)
+  {
+    assert(c_in.get_size()==m_in && rs_m_eq()==m_in);
+    c_rs_ref_ = &c_in;
+    return c_fs_;
+  }
+  /* from user's to presolved equalities */
+  inline hiopVector* apply_to_cons_eq(hiopVector& c_in, const int& m_in)
+  {
+    assert(&c_in==c_fs_ && c_rs_ref_ && c_rs_ref_->get_size()==m_in);
+    c_rs_ref_->copy_from_indexes(*c_fs_, *eq_rs2fs_);
+    return c_rs_ref_;
+  }
+  /* from presolved to user's inequalities */
+  inline hiopVector* apply_inv_to_cons_ineq(hiopVector& d_in, const int& m_in)
+  {
+    assert(d_in.get_size()==m_in && rs_m_ineq()==m_in);
+    d_rs_ref_ = &d_in;
+    return d_fs_;
+  }
+  /* from user's to presolved inequalities */
+  inline hiopVector* apply_to_cons_ineq(hiopVector& d_in, const int& m_in)
+  {
+    assert(&d_in==d_fs_ && d_rs_ref_ && d_rs_ref_->get_size()==m_in);
+    d_rs_ref_->copy_from_indexes(*d_fs_, *ineq_rs2fs_);
+    return d_rs_ref_;
+  }
+
+  /* from presolved to user's Jacobian of the equalities */
+  inline hiopMatrix* apply_inv_to_jacob_eq(hiopMatrix& Jac_in, const int& m_in)
+  {
+    assert(Jac_in.m()==m_in && rs_m_eq()==m_in);
+    Jacc_rs_ref_ = &Jac_in;
+    return Jacc_fs_;
+  }
+  /* from user's to presolved Jacobian of the equalities */
+  inline hiopMatrix* apply_to_jacob_eq(hiopMatrix& Jac_in, const int& m_in)
+  {
+    assert(&Jac_in==Jacc_fs_ && Jacc_rs_ref_ && Jacc_rs_ref_->m()==m_in);
+    Jacc_rs_ref_->copyRowsFrom(*Jacc_fs_, eq_rs2fs_->local_data_const(), m_in);
+    return Jacc_rs_ref_;
+  }
+  /* from presolved to user's Jacobian of the inequalities */
+  inline hiopMatrix* apply_inv_to_jacob_ineq(hiopMatrix& Jac_in, const int& m_in)
+  {
+    assert(Jac_in.m()==m_in && rs_m_ineq()==m_in);
+    Jacd_rs_ref_ = &Jac_in;
+    return Jacd_fs_;
+  }
+  /* from user's to presolved Jacobian of the inequalities */
+  inline hiopMatrix* apply_to_jacob_ineq(hiopMatrix& Jac_in, const int& m_in)
+  {
+    assert(&Jac_in==Jacd_fs_ && Jacd_rs_ref_ && Jacd_rs_ref_->m()==m_in);
+    Jacd_rs_ref_->copyRowsFrom(*Jacd_fs_, ineq_rs2fs_->local_data_const(), m_in);
+    return Jacd_rs_ref_;
+  }
+
+  /**
+   * Analyzes the linear constraints and decides which constraints are removed. The user's constraints 'c'
+   * and 'd' and their Jacobians, in the buffers returned by 'cons_eq_fs', 'cons_ineq_fs', 'jacob_eq_fs', and
+   * 'jacob_ineq_fs', should be evaluated at 'x' before this method is called.
+   *
+   * @param x point at which the constraints and the Jacobians were evaluated
+   * @param c_rhs right-hand side of the user's equalities
+   * @param dl, du bounds of the user's inequalities; the bounds of the inequalities into which duplicate
+   * inequalities are merged are tightened
+   * @param cons_eq_type, cons_ineq_type types of the user's equalities and inequalities
+   * @param xl, xu bounds of the variables, tightened by the singleton rows
+   * @param feas_tol tolerance used to decide whether the removed constraints are consistent
+   * @param fixed_var_tol tolerance used to detect the variables fixed by the singleton rows
+   * @param allow_fixed_vars whether the singleton rows can fix variables; if not, such rows are kept
+   *
+   * Returns the number of removed constraints.
+   */
+  size_type presolve(const hiopVector& x,
+                     const hiopVector& c_rhs,
+                     hiopVector& dl,
+                     hiopVector& du,
+                     const hiopInterfaceBase::NonlinearityType* cons_eq_type,
+                     const hiopInterfaceBase::NonlinearityType* cons_ineq_type,
+                     hiopVector& xl,
+                     hiopVector& xu,
+                     const double& feas_tol,
+                     const double& fixed_var_tol,
+                     const bool& allow_fixed_vars);
+
+  /**
+   * Fills in the entries of the removed constraints in the user's constraints body 'cons_body' (indexed as
+   * the user's constraints) given the (user's) variables 'x'. The entries of the kept constraints should be
+   * already present in 'cons_body'.
+   */
+  void postsolve_cons_body(const hiopVector& x, hiopVector& cons_body) const;
+
+  /**
+   * Recovers the multipliers of the removed constraints in 'lambda' (indexed as the user's constraints)
+   * from the multipliers of the bounds of the variables 'zl' and 'zu' set by the singleton rows and from
+   * the multipliers of the rows into which the duplicate rows were merged. The multipliers of the 
+   * bounds set by the presolve are moved to the singleton rows, hence they are zero on return.
+   */
+  void postsolve_duals(hiopVector& zl, hiopVector& zu, hiopVector& lambda) const;
+
+  /// buffers for the user's equalities and inequalities, and for their Jacobians
+  inline hiopVector* cons_eq_fs() { return c_fs_; }
+  inline hiopVector* cons_ineq_fs() { return d_fs_; }
+  inline hiopMatrixSparse* jacob_eq_fs() { return Jacc_fs_; }
+  inline hiopMatrixSparse* jacob_ineq_fs() { return Jacd_fs_; }
+
+  /// the user's equalities and inequalities
+  inline size_type fs_m_eq() const { return cons_eq_mapping_fs_->size(); }
+  inline size_type fs_m_ineq() const { return cons_ineq_mapping_fs_->size(); }
+  inline const hiopVectorInt& fs_cons_eq_mapping() const { return *cons_eq_mapping_fs_; }
+  inline const hiopVectorInt& fs_cons_ineq_mapping() const { return *cons_ineq_mapping_fs_; }
+  inline size_type fs_nnz_jacob_eq() const { return Jacc_fs_->numberOfNonzeros(); }
+  inline size_type fs_nnz_jacob_ineq() const { return Jacd_fs_->numberOfNonzeros(); }
+
+  /// the equalities and inequalities kept by the presolve, as indexes into the user's ones
+  inline size_type rs_m_eq() const { return eq_rs2fs_->size(); }
+  inline size_type rs_m_ineq() const { return ineq_rs2fs_->size(); }
+  inline const hiopVectorInt& eq_rs2fs() const { return *eq_rs2fs_; }
+  inline const hiopVectorInt& ineq_rs2fs() const { return *ineq_rs2fs_; }
+  inline size_type rs_nnz_jacob_eq() const { return nnz_jacc_rs_; }
+  inline size_type rs_nnz_jacob_ineq() const { return nnz_jacd_rs_; }
+private:
+  /// a removed constraint and the data needed to recover its body
+  struct RemovedCons
+  {
+    enum Type {EMPTY=0, SINGLETON, DUPLICATE};
+    Type type;
+    /// index of the constraint in the user's numbering
+    index_type cons_idx;
+    /// variable of a singleton row or user's index of the constraint a duplicate row was merged into
+    index_type ref_idx;
+    /// the body is coef*x[ref_idx]+offset, coef*body[ref_idx]+offset, or offset
+    double coef;
+    double offset;
+    /// whether the row set the lower/upper bound of x[ref_idx] (singleton) or of row ref_idx (duplicate)
+    bool sets_lo;
+    bool sets_up;
+  };
 
+  /// builds the list of the indexes of the kept rows in 'rs2fs' and returns their number of nonzeros
+  size_type build_rs2fs(const hiopMatrixSparse& Jac_fs, const std::vector<bool>& removed, hiopVectorInt*& rs2fs);
+private:
+  size_type n_vars_;
+
+  //user's equalities and inequalities, as indexes into the user's constraints
+  hiopVectorInt* cons_eq_mapping_fs_;
+  hiopVectorInt* cons_ineq_mapping_fs_;
+  //the equalities and inequalities kept by the presolve, as indexes into the user's ones
+  hiopVectorInt* eq_rs2fs_;
+  hiopVectorInt* ineq_rs2fs_;
+  size_type nnz_jacc_rs_, nnz_jacd_rs_;
+
+  //buffers for the user's constraints and Jacobians
+  hiopVector *c_fs_, *d_fs_;
+  hiopMatrixSparse *Jacc_fs_, *Jacd_fs_;
+  //references to the presolved constraints and Jacobians - returned in apply_to_XXX
+  hiopVector *c_rs_ref_, *d_rs_ref_;
+  hiopMatrix *Jacc_rs_ref_, *Jacd_rs_ref_;
+
+  std::vector<RemovedCons> removed_cons_;
+};
 
 class hiopNlpTransformations : public hiopNlpTransformation
 {
@@ -788,6 +1149,41 @@ public:
     return ret;
   }
 
+  hiopMatrix* apply_inv_to_jacob_cons(hiopMatrix& Jac_in, const int& m_in)
+  {
+    hiopMatrix* ret = &Jac_in;
+    for(std::list<hiopNlpTransformation*>::reverse_iterator it=list_trans_.rbegin(); it!=list_trans_.rend(); ++it) {
+      ret = (*it)->apply_inv_to_jacob_cons(*ret, m_in);
+    }
+    return ret;
+  }
+
+  hiopMatrix* apply_to_jacob_cons(hiopMatrix& Jac_in, const int& m_in)
+  {
+    hiopMatrix* ret = &Jac_in;
+    for(std::list<hiopNlpTransformation*>::iterator it=list_trans_.begin(); it!=list_trans_.end(); ++it) {
+      ret = (*it)->apply_to_jacob_cons(*ret, m_in);
+    }
+    return ret;
+  }
+
+  hiopMatrix* apply_inv_to_larg_hess(hiopMatrix& Hess_in, const int& m_in)
+  {
+    hiopMatrix* ret = &Hess_in;
+    for(std::list<hiopNlpTransformation*>::reverse_iterator it=list_trans_.rbegin(); it!=list_trans_.rend(); ++it) {
+      ret = (*it)->apply_inv_to_larg_hess(*ret, m_in);
+    }
+    return ret;
+  }
+
+  hiopMatrix* apply_to_larg_hess(hiopMatrix& Hess_in, const int& m_in)
+  {
+    hiopMatrix* ret = &Hess_in;
+    for(std::list<hiopNlpTransformation*>::iterator it=list_trans_.begin(); it!=list_trans_.end(); ++it) {
+      ret = (*it)->apply_to_larg_hess(*ret, m_in);
+    }
+    return ret;
+  }
 
 private:
   std::list<hiopNlpTransformation*> list_trans_;
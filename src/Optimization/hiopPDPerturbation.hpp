@@ -1,6 +1,8 @@
 #ifndef HIOP_PERTURB_PD_LINSSYS
 #define HIOP_PERTURB_PD_LINSSYS
 
+#include "hiopCheckpoint.hpp"
+
 namespace hiop
 {
 
@@ -230,6 +232,65 @@ public:
     delta_cd = delta_cd_curr_;
     return true;
   }
+
+  /** Last nonzero perturbations, which are the reference for the next perturbations. */
+  inline void get_last_perturbations(double& delta_wx, double& delta_wd,
+                                     double& delta_cc, double& delta_cd) const
+  {
+    delta_wx = delta_wx_last_;
+    delta_wd = delta_wd_last_;
+    delta_cc = delta_cc_last_;
+    delta_cd = delta_cd_last_;
+  }
+
+  /** Sets the last perturbations, for example, to the ones of a previous solve (warm start). */
+  inline void set_last_perturbations(const double& delta_wx, const double& delta_wd,
+                                     const double& delta_cc, const double& delta_cd)
+  {
+    delta_wx_last_ = delta_wx;
+    delta_wd_last_ = delta_wd;
+    delta_cc_last_ = delta_cc;
+    delta_cd_last_ = delta_cd;
+  }
+
+  /** Writes the perturbations and the degeneracy information to a checkpoint. */
+  void save_state(hiopCheckpointFile& file) const
+  {
+    file.write_marker("pd_perturb");
+    const double deltas[8] = {delta_wx_curr_, delta_wd_curr_, delta_cc_curr_, delta_cd_curr_,
+                              delta_wx_last_, delta_wd_last_, delta_cc_last_, delta_cd_last_};
+    file.write_array(deltas, 8);
+    file.write_scalar(static_cast<int>(hess_degenerate_));
+    file.write_scalar(static_cast<int>(jac_degenerate_));
+    file.write_scalar(num_degen_iters_);
+    file.write_scalar(static_cast<int>(deltas_test_type_));
+    file.write_scalar(mu_);
+  }
+
+  /** Reads the state written by \ref save_state. The algorithmic parameters are not changed. */
+  bool load_state(hiopCheckpointFile& file)
+  {
+    file.read_marker("pd_perturb");
+    double deltas[8];
+    file.read_array(deltas, 8);
+    int hess_degenerate, jac_degenerate, deltas_test_type;
+    file.read_scalar(hess_degenerate);
+    file.read_scalar(jac_degenerate);
+    file.read_scalar(num_degen_iters_);
+    file.read_scalar(deltas_test_type);
+    file.read_scalar(mu_);
+    if(!file.good()) {
+      return false;
+    }
+    delta_wx_curr_ = deltas[0]; delta_wd_curr_ = deltas[1];
+    delta_cc_curr_ = deltas[2]; delta_cd_curr_ = deltas[3];
+    delta_wx_last_ = deltas[4]; delta_wd_last_ = deltas[5];
+    delta_cc_last_ = deltas[6]; delta_cd_last_ = deltas[7];
+    hess_degenerate_ = static_cast<DegeneracyType>(hess_degenerate);
+    jac_degenerate_ = static_cast<DegeneracyType>(jac_degenerate);
+    deltas_test_type_ = static_cast<DeltasTestType>(deltas_test_type);
+    return true;
+  }
 private:
   /** Current and last perturbations, primal is split in x and d, dual in c and d. */
   double delta_wx_curr_, delta_wd_curr_;
@@ -0,0 +1,202 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory (LLNL).
+// Written by Cosmin G. Petra, petra1@llnl.gov.
+// LLNL-CODE-742473. All rights reserved.
+//
+// This file is part of HiOp. For details, see https://github.com/LLNL/hiop. HiOp 
+// is released under the BSD 3-clause license (https://opensource.org/licenses/BSD-3-Clause). 
+// Please also read “Additional BSD Notice” below.
+//
+// Redistribution and use in source and binary forms, with or without modification, 
+// are permitted provided that the following conditions are met:
+// i. Redistributions of source code must retain the above copyright notice, this list 
+// of conditions and the disclaimer below.
+// ii. Redistributions in binary form must reproduce the above copyright notice, 
+// this list of conditions and the disclaimer (as noted below) in the documentation and/or 
+// other materials provided with the distribution.
+// iii. Neither the name of the LLNS/LLNL nor the names of its contributors may be used to 
+// endorse or promote products derived from this software without specific prior written 
+// permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY 
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES 
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT 
+// SHALL LAWRENCE LIVERMORE NATIONAL SECURITY, LLC, THE U.S. DEPARTMENT OF ENERGY OR 
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS 
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+// AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Additional BSD Notice
+// 1. This notice is required to be provided under our contract with the U.S. Department 
+// of Energy (DOE). This work was produced at Lawrence Livermore National Laboratory under 
+// Contract No. DE-AC52-07NA27344 with the DOE.
+// 2. Neither the United States Government nor Lawrence Livermore National Security, LLC 
+// nor any of their employees, makes any warranty, express or implied, or assumes any 
+// liability or responsibility for the accuracy, completeness, or usefulness of any 
+// information, apparatus, product, or process disclosed, or represents that its use would
+// not infringe privately-owned rights.
+// 3. Also, reference herein to any specific commercial products, process, or services by 
+// trade name, trademark, manufacturer or otherwise does not necessarily constitute or 
+// imply its endorsement, recommendation, or favoring by the United States Government or 
+// Lawrence Livermore National Security, LLC. The views and opinions of authors expressed 
+// herein do not necessarily state or reflect those of the United States Government or 
+// Lawrence Livermore National Security, LLC, and shall not be used for advertising or 
+// product endorsement purposes.
+
+
+/**
+ * @file hiopCheckpoint.cpp
+ *
+ * Binary files used to checkpoint the state of the optimization solvers.
+ */
+
+#include "hiopCheckpoint.hpp"
+#include "hiopVector.hpp"
+
+#include <cstring>
+#include <cassert>
+
+namespace hiop
+{
+
+hiopCheckpointFile::hiopCheckpointFile(const std::string& path, Mode mode)
+  : path_(path),
+    path_tmp_(path + ".tmp"),
+    mode_(mode),
+    f_(nullptr),
+    good_(false),
+    pending_commit_(false)
+{
+  if(Write == mode_) {
+    f_ = fopen(path_tmp_.c_str(), "wb");
+  } else {
+    f_ = fopen(path_.c_str(), "rb");
+  }
+  good_ = (nullptr != f_);
+}
+
+hiopCheckpointFile::~hiopCheckpointFile()
+{
+  if(nullptr != f_) {
+    //not closed by the owner, hence the checkpoint is incomplete
+    fclose(f_);
+    if(Write == mode_) {
+      remove(path_tmp_.c_str());
+    }
+  }
+  if(pending_commit_) {
+    remove(path_tmp_.c_str());
+  }
+}
+
+std::string hiopCheckpointFile::rank_file_name(const std::string& path, int rank, int num_ranks)
+{
+  if(num_ranks <= 1) {
+    return path;
+  }
+  return path + "." + std::to_string(rank);
+}
+
+bool hiopCheckpointFile::close()
+{
+  if(nullptr == f_) {
+    return false;
+  }
+  if(Write == mode_) {
+    good_ = good_ && (0 == fflush(f_));
+    good_ = (0 == fclose(f_)) && good_;
+    f_ = nullptr;
+    if(good_) {
+      pending_commit_ = true;
+    } else {
+      remove(path_tmp_.c_str());
+    }
+  } else {
+    fclose(f_);
+    f_ = nullptr;
+  }
+  return good_;
+}
+
+bool hiopCheckpointFile::commit(bool all_good)
+{
+  assert(Write == mode_);
+  if(!pending_commit_) {
+    return false;
+  }
+  pending_commit_ = false;
+  if(all_good && 0 == rename(path_tmp_.c_str(), path_.c_str())) {
+    return true;
+  }
+  remove(path_tmp_.c_str());
+  return false;
+}
+
+void hiopCheckpointFile::write_raw(const void* buf, size_t bytes)
+{
+  assert(Write == mode_);
+  if(good_ && bytes > 0) {
+    good_ = (fwrite(buf, 1, bytes, f_) == bytes);
+  }
+}
+
+void hiopCheckpointFile::read_raw(void* buf, size_t bytes)
+{
+  assert(Read == mode_);
+  if(good_ && bytes > 0) {
+    good_ = (fread(buf, 1, bytes, f_) == bytes);
+  }
+}
+
+void hiopCheckpointFile::write_array(const double* a, size_type len)
+{
+  write_scalar(len);
+  write_raw(a, len*sizeof(double));
+}
+
+void hiopCheckpointFile::read_array(double* a, size_type len)
+{
+  size_type len_file = -1;
+  read_scalar(len_file);
+  good_ = good_ && (len_file == len);
+  read_raw(a, len*sizeof(double));
+}
+
+void hiopCheckpointFile::write_vector(const hiopVector& v)
+{
+  v.copyFromDev();
+  write_array(v.local_data_host_const(), v.get_local_size());
+}
+
+void hiopCheckpointFile::read_vector(hiopVector& v)
+{
+  read_array(v.local_data_host(), v.get_local_size());
+  if(good_) {
+    v.copyToDev();
+  }
+}
+
+void hiopCheckpointFile::write_marker(const char* tag)
+{
+  const size_t len = strlen(tag);
+  write_scalar(len);
+  write_raw(tag, len);
+}
+
+void hiopCheckpointFile::read_marker(const char* tag)
+{
+  const size_t len = strlen(tag);
+  size_t len_file = 0;
+  read_scalar(len_file);
+  good_ = good_ && (len_file == len);
+  if(good_) {
+    std::string tag_file(len, ' ');
+    read_raw(&tag_file[0], len);
+    good_ = good_ && (tag_file == tag);
+  }
+}
+
+} //end namespace
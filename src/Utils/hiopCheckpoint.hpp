@@ -0,0 +1,152 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory (LLNL).
+// Written by Cosmin G. Petra, petra1@llnl.gov.
+// LLNL-CODE-742473. All rights reserved.
+//
+// This file is part of HiOp. For details, see https://github.com/LLNL/hiop. HiOp 
+// is released under the BSD 3-clause license (https://opensource.org/licenses/BSD-3-Clause). 
+// Please also read “Additional BSD Notice” below.
+//
+// Redistribution and use in source and binary forms, with or without modification, 
+// are permitted provided that the following conditions are met:
+// i. Redistributions of source code must retain the above copyright notice, this list 
+// of conditions and the disclaimer below.
+// ii. Redistributions in binary form must reproduce the above copyright notice, 
+// this list of conditions and the disclaimer (as noted below) in the documentation and/or 
+// other materials provided with the distribution.
+// iii. Neither the name of the LLNS/LLNL nor the names of its contributors may be used to 
+// endorse or promote products derived from this software without specific prior written 
+// permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY 
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES 
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT 
+// SHALL LAWRENCE LIVERMORE NATIONAL SECURITY, LLC, THE U.S. DEPARTMENT OF ENERGY OR 
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS 
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+// AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Additional BSD Notice
+// 1. This notice is required to be provided under our contract with the U.S. Department 
+// of Energy (DOE). This work was produced at Lawrence Livermore National Laboratory under 
+// Contract No. DE-AC52-07NA27344 with the DOE.
+// 2. Neither the United States Government nor Lawrence Livermore National Security, LLC 
+// nor any of their employees, makes any warranty, express or implied, or assumes any 
+// liability or responsibility for the accuracy, completeness, or usefulness of any 
+// information, apparatus, product, or process disclosed, or represents that its use would
+// not infringe privately-owned rights.
+// 3. Also, reference herein to any specific commercial products, process, or services by 
+// trade name, trademark, manufacturer or otherwise does not necessarily constitute or 
+// imply its endorsement, recommendation, or favoring by the United States Government or 
+// Lawrence Livermore National Security, LLC. The views and opinions of authors expressed 
+// herein do not necessarily state or reflect those of the United States Government or 
+// Lawrence Livermore National Security, LLC, and shall not be used for advertising or 
+// product endorsement purposes.
+
+
+/**
+ * @file hiopCheckpoint.hpp
+ *
+ * Binary files used to checkpoint the state of the optimization solvers.
+ */
+
+#ifndef HIOP_CHECKPOINT
+#define HIOP_CHECKPOINT
+
+#include "hiop_defs.hpp"
+#include "hiop_types.h"
+
+#include <cstdio>
+#include <string>
+
+namespace hiop
+{
+
+class hiopVector;
+
+/**
+ * @brief Binary file holding the part of a solver checkpoint owned by one MPI rank.
+ *
+ * Each rank writes and reads its own file, which contains only the local parts of the distributed 
+ * vectors, so that the ranks perform their I/O in parallel and without communication. The data is 
+ * stored in the native binary format, hence a checkpoint can be read only on the same architecture 
+ * and with the same number of ranks and distribution of the vectors.
+ *
+ * A checkpoint is written to a temporary file that replaces the target file only when it is committed,
+ * which the callers do once all the ranks have written their files completely; a failure while writing 
+ * (e.g., the job is killed) leaves the previous checkpoint intact.
+ *
+ * Failures are sticky: after the first failed read or write the subsequent calls have no effect
+ * and `good` returns false, so that the callers need to check only once, at the end.
+ */
+class hiopCheckpointFile
+{
+public:
+  enum Mode
+  {
+    Read=0,
+    Write
+  };
+
+  hiopCheckpointFile(const std::string& path, Mode mode);
+  ~hiopCheckpointFile();
+
+  /// Returns the name of the file of rank `rank` for the checkpoint `path` when using `num_ranks` ranks
+  static std::string rank_file_name(const std::string& path, int rank, int num_ranks);
+
+  inline bool good() const { return good_; }
+
+  /**
+   * Closes the file. Returns false if any of the reads or writes failed. In write mode the checkpoint 
+   * stays in the temporary file until `commit` is called.
+   */
+  bool close();
+
+  /**
+   * Moves the closed temporary file in place of the target file when `all_good` is true, otherwise 
+   * removes it. `all_good` should tell whether all the ranks wrote their files. Returns false if the 
+   * file was not moved.
+   */
+  bool commit(bool all_good);
+
+  template<typename T> void write_scalar(const T& val) { write_raw(&val, sizeof(T)); }
+  template<typename T> void read_scalar(T& val) { read_raw(&val, sizeof(T)); }
+
+  /// Writes the length of the array followed by its entries
+  void write_array(const double* a, size_type len);
+  /// Reads an array written by `write_array`; fails if the length in the file is not `len`
+  void read_array(double* a, size_type len);
+
+  /// Writes the local (host) entries of `v`
+  void write_vector(const hiopVector& v);
+  /// Reads the local entries of `v`, which should have the same local size as the vector written
+  void read_vector(hiopVector& v);
+
+  /**
+   * Writes/checks a marker, which is used to detect corrupted files and mismatches between the writer 
+   * and the reader of a section of the checkpoint
+   */
+  void write_marker(const char* tag);
+  void read_marker(const char* tag);
+private:
+  void write_raw(const void* buf, size_t bytes);
+  void read_raw(void* buf, size_t bytes);
+
+  std::string path_;
+  std::string path_tmp_;
+  Mode mode_;
+  FILE* f_;
+  bool good_;
+  /// the temporary file was written and closed, but not yet committed
+  bool pending_commit_;
+private:
+  hiopCheckpointFile(const hiopCheckpointFile&) = delete;
+  hiopCheckpointFile& operator=(const hiopCheckpointFile&) = delete;
+};
+
+} //end namespace
+
+#endif
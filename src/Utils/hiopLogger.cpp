@@ -54,15 +54,325 @@
 #include "hiopFilter.hpp"
 #include "hiopOptions.hpp"
 
+#include <cstring>
+#include <cstdlib>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
 namespace hiop
 {
 
+/**
+ * Background writer of the logger in async mode. 
+ *
+ * The messages are passed from the producer, the logger, to the writer thread through a bounded lock-free
+ * single-producer/single-consumer ring: the producer moves a message into the slot at `head_` and then 
+ * publishes it by advancing `head_`, the writer writes the slots up to `head_` and then releases them by 
+ * advancing `tail_`. There is a single producer since a logger belongs to one NLP, which is used by one 
+ * thread at a time (see hiopNlpFormulation).
+ *
+ * The mutex and the condition variables are used only to sleep: by the writer when the ring is empty and by
+ * the producer when the ring is full or, in `flush`, until the writer wrote all the messages queued so far.
+ * A side takes the mutex to notify only when the other side announced that it sleeps (`writer_waits_` and 
+ * `producer_waits_`), hence pushing a message in a ring that is not full is lock-free.
+ */
+class hiopLogAsyncWriter
+{
+public:
+  hiopLogAsyncWriter(FILE* f)
+    : ring_(capacity),
+      head_(0),
+      tail_(0),
+      writer_waits_(false),
+      producer_waits_(false),
+      stop_(false),
+      f_(f)
+  {
+    thread_ = std::thread(&hiopLogAsyncWriter::run, this);
+  }
+
+  ~hiopLogAsyncWriter()
+  {
+    stop_.store(true);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      cv_writer_.notify_one();
+    }
+    thread_.join();
+    fflush(f_);
+  }
+
+  /// Queues `text`; on return, `text` is empty
+  void push(std::string& text)
+  {
+    const size_t head = head_.load(std::memory_order_relaxed);
+    if(head - tail_.load(std::memory_order_acquire) >= capacity) {
+      //the ring is full
+      wait_written(head - capacity + 1);
+    }
+    ring_[head & (capacity-1)].swap(text);
+    head_.store(head+1);
+    if(writer_waits_.load()) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      cv_writer_.notify_one();
+    }
+  }
+
+  /// Waits until the writer wrote all the messages queued so far and flushes the stream
+  void flush()
+  {
+    wait_written(head_.load(std::memory_order_relaxed));
+    fflush(f_);
+  }
+
+private:
+  /// Producer side: sleeps until the writer released the messages before the position `pos`
+  void wait_written(size_t pos)
+  {
+    if(tail_.load(std::memory_order_acquire) >= pos) {
+      return;
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    producer_waits_.store(true);
+    cv_producer_.wait(lock, [this, pos] { return tail_.load() >= pos; });
+    producer_waits_.store(false);
+  }
+
+  void run()
+  {
+    while(true) {
+      const size_t tail = tail_.load(std::memory_order_relaxed);
+      size_t head = head_.load(std::memory_order_acquire);
+      if(head == tail) {
+        if(stop_.load()) {
+          //stop requested and all the messages written; the producer does not push after requesting it
+          break;
+        }
+        std::unique_lock<std::mutex> lock(mutex_);
+        writer_waits_.store(true);
+        cv_writer_.wait(lock, [this, tail] { return head_.load() != tail || stop_.load(); });
+        writer_waits_.store(false);
+        continue;
+      }
+
+      for(size_t pos = tail; pos < head; pos++) {
+        std::string& text = ring_[pos & (capacity-1)];
+        fputs(text.c_str(), f_);
+        std::string().swap(text);
+      }
+      fflush(f_);
+
+      tail_.store(head);
+      if(producer_waits_.load()) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        cv_producer_.notify_one();
+      }
+    }
+  }
+  
+  /// max number of messages in the ring; a power of two
+  static const size_t capacity = 4096;
+  std::vector<std::string> ring_;
+  /// number of messages queued by the producer and released by the writer since the creation of the writer
+  std::atomic<size_t> head_;
+  std::atomic<size_t> tail_;
+  /// set by a side before sleeping on its condition variable; the accesses are sequentially consistent so 
+  /// that a side either sees the announcement or the other side sees the new position when rechecking it
+  std::atomic<bool> writer_waits_;
+  std::atomic<bool> producer_waits_;
+  std::atomic<bool> stop_;
+  std::mutex mutex_;
+  std::condition_variable cv_writer_;
+  std::condition_variable cv_producer_;
+  std::thread thread_;
+  FILE* f_;
+};
+
+/// Formats the variable list of arguments into a string
+static std::string vformat(const char* format, va_list args)
+{
+  char buff[1024];
+  va_list args_copy;
+  va_copy(args_copy, args);
+  const int len = vsnprintf(buff, sizeof(buff), format, args);
+  std::string str;
+  if(len < 0) {
+    //encoding error
+  } else if(len < static_cast<int>(sizeof(buff))) {
+    str.assign(buff, len);
+  } else {
+    std::vector<char> large_buff(len+1);
+    vsnprintf(large_buff.data(), len+1, format, args_copy);
+    str.assign(large_buff.data(), len);
+  }
+  va_end(args_copy);
+  return str;
+}
+
+static const char* verbosity_name(hiopOutVerbosity v)
+{
+  switch(v) {
+  case hovError:             return "error";
+  case hovVerySilent:        return "verysilent";
+  case hovWarning:           return "warning";
+  case hovNoOutput:          return "nooutput";
+  case hovSummary:           return "summary";
+  case hovScalars:           return "scalars";
+  case hovFcnEval:           return "fcneval";
+  case hovLinesearch:        return "linesearch";
+  case hovLinAlgScalars:     return "linalgscalars";
+  case hovLinesearchVerb:    return "linesearchverb";
+  case hovLinAlgScalarsVerb: return "linalgscalarsverb";
+  case hovIteration:         return "iteration";
+  case hovMatrices:          return "matrices";
+  default:                   return "maxverbose";
+  }
+}
+
+hiopLogger::~hiopLogger()
+{
+  output_pending_line();
+  delete async_writer_;
+}
+
+void hiopLogger::reload_options()
+{
+  output_pending_line();
+  keyvalue_format_ = options_->GetString("log_format") == "keyvalue";
+
+  const bool async = options_->GetString("log_async") == "yes";
+  if(async && nullptr == async_writer_ && master_rank_ == my_rank_) {
+    async_writer_ = new hiopLogAsyncWriter(f_);
+  } else if(!async && nullptr != async_writer_) {
+    //the destructor writes all the messages queued
+    delete async_writer_;
+    async_writer_ = nullptr;
+  }
+}
+
+void hiopLogger::flush()
+{
+  output_pending_line();
+  if(async_writer_) {
+    async_writer_->flush();
+  } else {
+    fflush(f_);
+  }
+}
+
+FILE* hiopLogger::capture_begin()
+{
+  output_pending_line();
+  if(nullptr == async_writer_) {
+    return f_;
+  }
+#ifdef HIOP_HAVE_OPEN_MEMSTREAM
+  FILE* f = open_memstream(&capture_buf_, &capture_len_);
+#else
+  //the printed text is read back from a temporary file in `capture_end`
+  FILE* f = tmpfile();
+#endif
+  if(nullptr == f) {
+    //fall back to writing synchronously
+    async_writer_->flush();
+    return f_;
+  }
+  return f;
+}
+
+void hiopLogger::capture_end(FILE* f)
+{
+  if(f == f_) {
+    return;
+  }
+#ifdef HIOP_HAVE_OPEN_MEMSTREAM
+  fclose(f);
+  std::string text(capture_buf_, capture_len_);
+  free(capture_buf_);
+  capture_buf_ = nullptr;
+  capture_len_ = 0;
+#else
+  std::string text;
+  rewind(f);
+  char buff[4096];
+  size_t len;
+  while((len = fread(buff, 1, sizeof(buff), f)) > 0) {
+    text.append(buff, len);
+  }
+  fclose(f);
+#endif
+  async_writer_->push(text);
+}
+
+void hiopLogger::output(std::string& text)
+{
+  if(async_writer_) {
+    async_writer_->push(text);
+  } else {
+    fputs(text.c_str(), f_);
+  }
+}
+
+std::string hiopLogger::format_keyvalue(hiopOutVerbosity v, const std::string& text) const
+{
+  const double t = std::chrono::duration<double>(std::chrono::steady_clock::now()-tm_start_).count();
+  char prefix[128];
+  snprintf(prefix, sizeof(prefix), "t=%.6f rank=%d level=%s msg=\"", t, my_rank_, verbosity_name(v));
+
+  std::string record(prefix);
+  size_t len = text.size();
+  while(len>0 && text[len-1]=='\n') {
+    len--;
+  }
+  for(size_t i=0; i<len; i++) {
+    switch(text[i]) {
+    case '"':  record += "\\\""; break;
+    case '\\': record += "\\\\"; break;
+    case '\n': record += "\\n"; break;
+    case '\t': record += "\\t"; break;
+    default:   record += text[i];
+    }
+  }
+  record += "\"\n";
+  return record;
+}
+
+void hiopLogger::output_keyvalue(hiopOutVerbosity v, const std::string& text)
+{
+  if(pending_line_.empty()) {
+    pending_level_ = v;
+  }
+  pending_line_ += text;
+  const size_t pos = pending_line_.find_last_of('\n');
+  if(pos == std::string::npos) {
+    return;
+  }
+  std::string record = format_keyvalue(pending_level_, pending_line_.substr(0, pos+1));
+  pending_line_.erase(0, pos+1);
+  pending_level_ = v;
+  output(record);
+}
+
+void hiopLogger::output_pending_line()
+{
+  if(pending_line_.empty()) {
+    return;
+  }
+  std::string record = format_keyvalue(pending_level_, pending_line_);
+  pending_line_.clear();
+  output(record);
+}
 
 void hiopLogger::write(const char* msg, const hiopVector& vec, hiopOutVerbosity v, int loggerid/*=0*/) 
 {
   hiopOutVerbosity _verb = (hiopOutVerbosity) options_->GetInteger("verbosity_level");
   if(v>_verb) return;
-  vec.print(f_, msg);
+  FILE* f = capture_begin();
+  vec.print(f, msg);
+  capture_end(f);
 }
 
 void hiopLogger::write(const char* msg, const hiopMatrix& M, hiopOutVerbosity v, int loggerid/*=0*/) 
@@ -70,7 +380,9 @@ void hiopLogger::write(const char* msg, const hiopMatrix& M, hiopOutVerbosity v,
   if(master_rank_ != my_rank_) return;
   hiopOutVerbosity _verb = (hiopOutVerbosity) options_->GetInteger("verbosity_level");
   if(v>_verb) return;
-  M.print(f_, msg);
+  FILE* f = capture_begin();
+  M.print(f, msg);
+  capture_end(f);
 }
 
 void hiopLogger::write(const char* msg, const hiopResidual& r, hiopOutVerbosity v, int loggerid/*=0*/) 
@@ -78,14 +390,22 @@ void hiopLogger::write(const char* msg, const hiopResidual& r, hiopOutVerbosity
   if(master_rank_ != my_rank_) return;
   hiopOutVerbosity _verb = (hiopOutVerbosity) options_->GetInteger("verbosity_level");
   if(v>_verb) return;
-  r.print(f_,msg);
+  FILE* f = capture_begin();
+  r.print(f, msg);
+  capture_end(f);
 }
 void hiopLogger::write(const char* msg, hiopOutVerbosity v, int loggerid/*=0*/) 
 { 
   if(master_rank_ != my_rank_) return;
   hiopOutVerbosity _verb = (hiopOutVerbosity) options_->GetInteger("verbosity_level");
   if(v>_verb) return;
-  fprintf(f_, "%s\n", msg); 
+  std::string text(msg);
+  text += "\n";
+  if(keyvalue_format_) {
+    output_keyvalue(v, text);
+  } else {
+    output(text);
+  }
 }
 
 void hiopLogger::write(const char* msg, const hiopIterate& it, hiopOutVerbosity v, int loggerid/*=0*/)
@@ -93,7 +413,9 @@ void hiopLogger::write(const char* msg, const hiopIterate& it, hiopOutVerbosity
   if(master_rank_ != my_rank_) return;
   hiopOutVerbosity _verb = (hiopOutVerbosity) options_->GetInteger("verbosity_level");
   if(v>_verb) return;
-  it.print(f_, msg);
+  FILE* f = capture_begin();
+  it.print(f, msg);
+  capture_end(f);
 }
 
 #ifdef HIOP_DEEPCHECKS
@@ -102,7 +424,9 @@ void hiopLogger::write(const char* msg, const hiopHessianLowRank& Hess, hiopOutV
   if(master_rank_ != my_rank_) return;
   hiopOutVerbosity _verb = (hiopOutVerbosity) options_->GetInteger("verbosity_level");
   if(v>_verb) return;
-  Hess.print(f_, v, msg);
+  FILE* f = capture_begin();
+  Hess.print(f, v, msg);
+  capture_end(f);
 }
 #endif
 
@@ -111,7 +435,9 @@ void hiopLogger::write(const char* msg, const hiopOptions& options,     hiopOutV
   if(master_rank_ != my_rank_) return;
   hiopOutVerbosity _verb = (hiopOutVerbosity) options_->GetInteger("verbosity_level");
   if(v>_verb) return;
-  options.print(f_, msg);
+  FILE* f = capture_begin();
+  options.print(f, msg);
+  capture_end(f);
 }
 
 void hiopLogger::write(const char* msg, const hiopNlpFormulation& nlp,  hiopOutVerbosity v, int loggerid)
@@ -119,7 +445,9 @@ void hiopLogger::write(const char* msg, const hiopNlpFormulation& nlp,  hiopOutV
   if(master_rank_ != my_rank_) return;
   hiopOutVerbosity _verb = (hiopOutVerbosity) options_->GetInteger("verbosity_level");
   if(v>_verb) return;
-  nlp.print(f_, msg);
+  FILE* f = capture_begin();
+  nlp.print(f, msg);
+  capture_end(f);
 }
 
 void hiopLogger::write(const char* msg, const hiopFilter& filt, hiopOutVerbosity v, int loggerid/*=0*/)
@@ -127,7 +455,9 @@ void hiopLogger::write(const char* msg, const hiopFilter& filt, hiopOutVerbosity
   if(master_rank_ != my_rank_) return;
   hiopOutVerbosity _verb = (hiopOutVerbosity) options_->GetInteger("verbosity_level");
   if(v>_verb) return;
-  filt.print(f_, msg);
+  FILE* f = capture_begin();
+  filt.print(f, msg);
+  capture_end(f);
 }
 
   //only for loggerid=0 for now
@@ -137,19 +467,47 @@ void hiopLogger::printf(hiopOutVerbosity v, const char* format, ...)
   hiopOutVerbosity _verb = (hiopOutVerbosity) options_->GetInteger("verbosity_level");
   if(v>_verb) return;
 
-  char label[16];label[0]='\0';
-  if(v==hovError) strcpy(label, "[Error] ");
-  else if(v==hovWarning) strcpy(label, "[Warning] ");
-  fprintf(f_, "%s", label);
-
   va_list args;
   va_start(args, format);
-  vsprintf(buff_,format, args);
-  fprintf(f_,"%s",buff_);
+  std::string text = vformat(format, args);
   va_end(args);
 
+  if(keyvalue_format_) {
+    output_keyvalue(v, text);
+  } else {
+    if(v==hovError) text.insert(0, "[Error] ");
+    else if(v==hovWarning) text.insert(0, "[Warning] ");
+    output(text);
+  }
+
+  //errors are written right away
+  if(v==hovError) {
+    flush();
+  }
 };
 
+void hiopLogger::printf_record(hiopOutVerbosity v, const char* record_name, const char* format, ...)
+{
+  if(master_rank_ != my_rank_) return;
+  hiopOutVerbosity _verb = (hiopOutVerbosity) options_->GetInteger("verbosity_level");
+  if(v>_verb) return;
+
+  va_list args;
+  va_start(args, format);
+  std::string text = vformat(format, args);
+  va_end(args);
+
+  if(keyvalue_format_) {
+    output_pending_line();
+    const double t = std::chrono::duration<double>(std::chrono::steady_clock::now()-tm_start_).count();
+    char prefix[128];
+    snprintf(prefix, sizeof(prefix), "t=%.6f rank=%d record=%s ", t, my_rank_, record_name);
+    text.insert(0, prefix);
+  }
+  text += "\n";
+  output(text);
+}
+
 void hiopLogger::printf_error(hiopOutVerbosity v, const char* format, ...)
 {
   char buff[4096];
@@ -55,6 +55,8 @@
 #include <cstdio>
 #include <cstdarg>
 #include <cassert>
+#include <string>
+#include <chrono>
 
 namespace hiop
 {
@@ -66,6 +68,7 @@ class hiopHessianLowRank;
 class hiopNlpFormulation;
 class hiopOptions;
 class hiopFilter;
+class hiopLogAsyncWriter;
 
 /* Verbosity 0 to 9 */
 enum hiopOutVerbosity {
@@ -85,11 +88,32 @@ enum hiopOutVerbosity {
   hovMaxVerbose=12
 };
 
+/**
+ * Logger of the solver. 
+ *
+ * By default, the messages are formatted and written synchronously to the output stream. When the option 
+ * 'log_async' is 'yes', the messages are formatted by the calling thread and pushed into a bounded lock-free 
+ * queue, from which a background writer thread writes them to the output stream; in this case, `flush` should 
+ * be called before other output is written to the same stream.
+ *
+ * When the option 'log_format' is 'keyvalue', each message is written as a record of space-separated
+ * key=value pairs, e.g., `t=0.0123 rank=0 level=summary msg="..."`, and the IPM iterations are output
+ * as `record=iteration iter=1 objective=...` records, which makes the output machine-parseable. Messages
+ * printed in fragments are buffered until a newline, so that a line is not split across records.
+ */
 class hiopLogger
 {
 public:
   hiopLogger(hiopOptions* options, FILE* f, int masterrank=0, MPI_Comm comm_wrld=MPI_COMM_WORLD) 
-    : options_(options), f_(f), master_rank_(masterrank)
+    : options_(options),
+      f_(f),
+      async_writer_(nullptr),
+      capture_buf_(nullptr),
+      capture_len_(0),
+      keyvalue_format_(false),
+      pending_level_(hovSummary),
+      tm_start_(std::chrono::steady_clock::now()),
+      master_rank_(masterrank)
   {
 #ifdef HIOP_USE_MPI
     int ierr = MPI_Comm_rank(comm_wrld, &my_rank_);
@@ -98,7 +122,20 @@ public:
     my_rank_ = 0;
 #endif
   };
-  virtual ~hiopLogger() {};
+  virtual ~hiopLogger();
+
+  /**
+   * (Re)loads the options 'log_async' and 'log_format' and starts or stops the background writer thread 
+   * accordingly. Should be called only for loggers whose options are NLP options.
+   */
+  void reload_options();
+
+  /// Blocks until all the queued messages are written and flushes the output stream
+  void flush();
+
+  /// Returns true when the messages are written as key/value records
+  inline bool is_keyvalue_format() const { return keyvalue_format_; }
+
   /* outputs a vector. loggerid indicates which logger should be used, by default stdout*/
   void write(const char* msg, const hiopVector& vec,          hiopOutVerbosity v, int loggerid=0);
   void write(const char* msg, const hiopResidual& r,          hiopOutVerbosity v, int loggerid=0);
@@ -114,16 +151,44 @@ public:
   //only for loggerid=0 for now
   void printf(hiopOutVerbosity v, const char* format, ...); 
 
+  /**
+   * Outputs a key/value record named `record_name`. The `format` should produce space-separated key=value
+   * pairs, e.g., "iter=%d objective=%.7e".
+   */
+  void printf_record(hiopOutVerbosity v, const char* record_name, const char* format, ...); 
+
   /**
    * This static method is to be used before NLP created its internal instance of hiopLogger. To be used
    * for displaying errors (on stderr) that occur during initialization of the NLP or PriDec solver class. 
    */
   static void printf_error(hiopOutVerbosity v, const char* format, ...); 
 
+protected:
+  /// Returns the stream to which objects should print: `f_` or, in async mode, a memory stream
+  FILE* capture_begin();
+  /// Queues what was printed to the memory stream `f` returned by `capture_begin`
+  void capture_end(FILE* f);
+  /// Writes `text` to `f_` or, in async mode, pushes it in the writer's queue
+  void output(std::string& text);
+  /// Formats `text` as a key/value record of verbosity `v`
+  std::string format_keyvalue(hiopOutVerbosity v, const std::string& text) const;
+  /// Appends `text` to the pending line and outputs the complete lines as one key/value record
+  void output_keyvalue(hiopOutVerbosity v, const std::string& text);
+  /// Outputs the pending (incomplete) line, if any, as a key/value record
+  void output_pending_line();
 protected:
   hiopOptions* options_;
   FILE* f_;
-  char buff_[4096];
+  /// background writer, only in async mode
+  hiopLogAsyncWriter* async_writer_;
+  /// buffer and size of the memory stream returned by `capture_begin`
+  char* capture_buf_;
+  size_t capture_len_;
+  bool keyvalue_format_;
+  /// text printed in key/value format not yet terminated by a newline and the verbosity of its first fragment
+  std::string pending_line_;
+  hiopOutVerbosity pending_level_;
+  std::chrono::steady_clock::time_point tm_start_;
 private:
   int master_rank_;
   int my_rank_;
@@ -0,0 +1,197 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory (LLNL).
+// Written by Cosmin G. Petra, petra1@llnl.gov.
+// LLNL-CODE-742473. All rights reserved.
+//
+// This file is part of HiOp. For details, see https://github.com/LLNL/hiop. HiOp 
+// is released under the BSD 3-clause license (https://opensource.org/licenses/BSD-3-Clause). 
+// Please also read “Additional BSD Notice” below.
+//
+// Redistribution and use in source and binary forms, with or without modification, 
+// are permitted provided that the following conditions are met:
+// i. Redistributions of source code must retain the above copyright notice, this list 
+// of conditions and the disclaimer below.
+// ii. Redistributions in binary form must reproduce the above copyright notice, 
+// this list of conditions and the disclaimer (as noted below) in the documentation and/or 
+// other materials provided with the distribution.
+// iii. Neither the name of the LLNS/LLNL nor the names of its contributors may be used to 
+// endorse or promote products derived from this software without specific prior written 
+// permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY 
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES 
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT 
+// SHALL LAWRENCE LIVERMORE NATIONAL SECURITY, LLC, THE U.S. DEPARTMENT OF ENERGY OR 
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS 
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+// AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Additional BSD Notice
+// 1. This notice is required to be provided under our contract with the U.S. Department 
+// of Energy (DOE). This work was produced at Lawrence Livermore National Laboratory under 
+// Contract No. DE-AC52-07NA27344 with the DOE.
+// 2. Neither the United States Government nor Lawrence Livermore National Security, LLC 
+// nor any of their employees, makes any warranty, express or implied, or assumes any 
+// liability or responsibility for the accuracy, completeness, or usefulness of any 
+// information, apparatus, product, or process disclosed, or represents that its use would
+// not infringe privately-owned rights.
+// 3. Also, reference herein to any specific commercial products, process, or services by 
+// trade name, trademark, manufacturer or otherwise does not necessarily constitute or 
+// imply its endorsement, recommendation, or favoring by the United States Government or 
+// Lawrence Livermore National Security, LLC. The views and opinions of authors expressed 
+// herein do not necessarily state or reflect those of the United States Government or 
+// Lawrence Livermore National Security, LLC, and shall not be used for advertising or 
+// product endorsement purposes.
+
+/**
+ * @file hiopMemoryTracker.cpp
+ *
+ */
+
+#include "hiopMemoryTracker.hpp"
+
+#include <sstream>
+#include <iomanip>
+#include <cassert>
+
+namespace hiop
+{
+
+/// the subsystem active on each thread
+static thread_local hiopMemoryTracker::Subsystem active_subsystem = hiopMemoryTracker::Other;
+/// the tracker active on each thread
+static thread_local hiopMemoryTracker* active_tracker = nullptr;
+
+hiopMemoryTracker::hiopMemoryTracker()
+  : current_total_(0),
+    peak_total_(0),
+    budget_(0),
+    budget_exceeded_(false)
+{
+  for(int s=0; s<NumSubsystems; s++) {
+    current_[s] = peak_[s] = 0;
+  }
+}
+
+hiopMemoryTracker* hiopMemoryTracker::active()
+{
+  return active_tracker;
+}
+
+hiopMemoryTracker* hiopMemoryTracker::set_active(hiopMemoryTracker* tracker)
+{
+  hiopMemoryTracker* prev = active_tracker;
+  active_tracker = tracker;
+  return prev;
+}
+
+void hiopMemoryTracker::record_alloc(const void* ptr, std::size_t bytes, Subsystem s)
+{
+  if(nullptr == ptr) {
+    return;
+  }
+  assert(s>=0 && s<NumSubsystems);
+  
+  auto it = allocs_.find(ptr);
+  if(it != allocs_.end()) {
+    //the address was not released through the tracker; discard the stale record
+    current_[it->second.subsystem] -= it->second.bytes;
+    current_total_ -= it->second.bytes;
+    it->second.bytes = bytes;
+    it->second.subsystem = s;
+  } else {
+    allocs_.emplace(ptr, AllocRecord{bytes, s});
+  }
+  
+  current_[s] += bytes;
+  current_total_ += bytes;
+  if(current_[s] > peak_[s]) {
+    peak_[s] = current_[s];
+  }
+  if(current_total_ > peak_total_) {
+    peak_total_ = current_total_;
+  }
+  if(budget_ > 0 && current_total_ > budget_) {
+    budget_exceeded_ = true;
+  }
+}
+
+void hiopMemoryTracker::record_free(const void* ptr)
+{
+  if(nullptr == ptr) {
+    return;
+  }
+  auto it = allocs_.find(ptr);
+  if(it == allocs_.end()) {
+    return;
+  }
+  assert(current_[it->second.subsystem] >= it->second.bytes);
+  current_[it->second.subsystem] -= it->second.bytes;
+  current_total_ -= it->second.bytes;
+  allocs_.erase(it);
+}
+
+hiopMemoryTracker::Subsystem hiopMemoryTracker::current_subsystem()
+{
+  return active_subsystem;
+}
+
+hiopMemoryTracker::Subsystem hiopMemoryTracker::set_current_subsystem(Subsystem s)
+{
+  const Subsystem prev = active_subsystem;
+  active_subsystem = s;
+  return prev;
+}
+
+const char* hiopMemoryTracker::subsystem_name(Subsystem s)
+{
+  switch(s) {
+  case Other:       return "other";
+  case Nlp:         return "nlp";
+  case Derivatives: return "Jac/Hess";
+  case Iterates:    return "iterates";
+  case KKT:         return "KKT";
+  case LinSolver:   return "linsolver";
+  case QuasiNewton: return "quasi-Newton";
+  default:          return "unknown";
+  }
+}
+
+void hiopMemoryTracker::reset_peaks()
+{
+  for(int s=0; s<NumSubsystems; s++) {
+    peak_[s] = current_[s];
+  }
+  peak_total_ = current_total_;
+  budget_exceeded_ = budget_ > 0 && current_total_ > budget_;
+}
+
+void hiopMemoryTracker::set_budget(double budget_mb)
+{
+  assert(budget_mb >= 0.);
+  budget_ = static_cast<std::size_t>(budget_mb * 1024. * 1024.);
+  budget_exceeded_ = budget_ > 0 && current_total_ > budget_;
+}
+
+std::string hiopMemoryTracker::get_summary() const
+{
+  const double MB = 1024.*1024.;
+  std::stringstream ss;
+  ss << std::fixed << std::setprecision(3);
+  ss << "Memory high-water mark " << peak_total_/MB << " MB  (current " << current_total_/MB << " MB";
+  if(budget_ > 0) {
+    ss << ", budget " << budget_/MB << " MB";
+  }
+  ss << ")" << std::endl;
+  ss << "\thigh-water mark (current) per subsystem in MB:";
+  for(int s=0; s<NumSubsystems; s++) {
+    ss << "  " << subsystem_name(static_cast<Subsystem>(s)) << " " << peak_[s]/MB << " (" << current_[s]/MB << ")";
+  }
+  ss << std::endl;
+  return ss.str();
+}
+
+} // end of namespace
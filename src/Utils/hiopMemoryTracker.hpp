@@ -0,0 +1,262 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory (LLNL).
+// Written by Cosmin G. Petra, petra1@llnl.gov.
+// LLNL-CODE-742473. All rights reserved.
+//
+// This file is part of HiOp. For details, see https://github.com/LLNL/hiop. HiOp 
+// is released under the BSD 3-clause license (https://opensource.org/licenses/BSD-3-Clause). 
+// Please also read “Additional BSD Notice” below.
+//
+// Redistribution and use in source and binary forms, with or without modification, 
+// are permitted provided that the following conditions are met:
+// i. Redistributions of source code must retain the above copyright notice, this list 
+// of conditions and the disclaimer below.
+// ii. Redistributions in binary form must reproduce the above copyright notice, 
+// this list of conditions and the disclaimer (as noted below) in the documentation and/or 
+// other materials provided with the distribution.
+// iii. Neither the name of the LLNS/LLNL nor the names of its contributors may be used to 
+// endorse or promote products derived from this software without specific prior written 
+// permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY 
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES 
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT 
+// SHALL LAWRENCE LIVERMORE NATIONAL SECURITY, LLC, THE U.S. DEPARTMENT OF ENERGY OR 
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS 
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+// AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Additional BSD Notice
+// 1. This notice is required to be provided under our contract with the U.S. Department 
+// of Energy (DOE). This work was produced at Lawrence Livermore National Laboratory under 
+// Contract No. DE-AC52-07NA27344 with the DOE.
+// 2. Neither the United States Government nor Lawrence Livermore National Security, LLC 
+// nor any of their employees, makes any warranty, express or implied, or assumes any 
+// liability or responsibility for the accuracy, completeness, or usefulness of any 
+// information, apparatus, product, or process disclosed, or represents that its use would
+// not infringe privately-owned rights.
+// 3. Also, reference herein to any specific commercial products, process, or services by 
+// trade name, trademark, manufacturer or otherwise does not necessarily constitute or 
+// imply its endorsement, recommendation, or favoring by the United States Government or 
+// Lawrence Livermore National Security, LLC. The views and opinions of authors expressed 
+// herein do not necessarily state or reflect those of the United States Government or 
+// Lawrence Livermore National Security, LLC, and shall not be used for advertising or 
+// product endorsement purposes.
+
+/**
+ * @file hiopMemoryTracker.hpp
+ *
+ * Accounting of the memory allocated by HiOp's linear algebra objects and linear solvers.
+ */
+
+#ifndef HIOP_MEMORY_TRACKER
+#define HIOP_MEMORY_TRACKER
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+
+namespace hiop
+{
+
+/**
+ * @brief Tracks the memory allocated by HiOp and attributes it to the subsystems of the solver.
+ *
+ * Each IPM solver owns a tracker, which is made active on the calling thread for the duration of the
+ * solver's constructor and of `run` (the feasibility restoration solver uses the tracker of the solver
+ * it belongs to). The raw arrays of the linear algebra objects are allocated through `LinearAlgebraFactory`,
+ * which records each allocation and deallocation in the tracker active on the calling thread. The work arrays 
+ * of the linear solvers that are not allocated through the factory are recorded explicitly by the solver
+ * classes. When no tracker is active, e.g., when tracking is disabled, nothing is recorded.
+ *
+ * Each allocation is attributed to the subsystem that is active (on the calling thread) at the time of the 
+ * allocation; the active subsystem is selected with `hiopMemoryTrackerScope` objects. The tracker keeps,
+ * for each subsystem and in total, the current number of bytes allocated and the high-water mark.
+ *
+ * Optionally, a memory budget can be specified. The tracker flags when the budget is exceeded, which the
+ * IPM solver owning the tracker checks at each iteration to stop with a per-subsystem report.
+ *
+ * A tracker is not thread safe: it should be active on at most one thread at a time. Memory released while
+ * a different tracker (or none) is active is not accounted for. The amounts are local to the MPI rank.
+ */
+class hiopMemoryTracker
+{
+public:
+  enum Subsystem
+  {
+    /// allocations performed outside of any of the subsystems below
+    Other=0,
+    /// problem data, e.g., bounds, scaling, and internal vectors of the NLP formulation
+    Nlp,
+    /// Jacobian and Hessian of the problem
+    Derivatives,
+    /// iterates, search directions, residuals, trial points, and other vectors of the algorithm
+    Iterates,
+    /// KKT linear systems (excluding linear solvers)
+    KKT,
+    /// linear solvers, i.e., system matrices, factors, and work arrays
+    LinSolver,
+    /// quasi-Newton Hessian (hiopHessianLowRank)
+    QuasiNewton,
+    NumSubsystems
+  };
+
+  hiopMemoryTracker();
+
+  /// Returns the tracker active on the calling thread or nullptr if none is active
+  static hiopMemoryTracker* active();
+
+  /// Sets the tracker active on the calling thread and returns the previously active tracker
+  static hiopMemoryTracker* set_active(hiopMemoryTracker* tracker);
+
+  /// Records an allocation of `bytes` at address `ptr` for the current subsystem in the active tracker, if any
+  static void track_alloc(const void* ptr, std::size_t bytes)
+  {
+    hiopMemoryTracker* tracker = active();
+    if(tracker) {
+      tracker->record_alloc(ptr, bytes, current_subsystem());
+    }
+  }
+
+  /// Records an allocation of `bytes` at address `ptr` for subsystem `s` in the active tracker, if any
+  static void track_alloc(const void* ptr, std::size_t bytes, Subsystem s)
+  {
+    hiopMemoryTracker* tracker = active();
+    if(tracker) {
+      tracker->record_alloc(ptr, bytes, s);
+    }
+  }
+
+  /// Records the deallocation of the memory at `ptr` in the active tracker, if any
+  static void track_free(const void* ptr)
+  {
+    hiopMemoryTracker* tracker = active();
+    if(tracker) {
+      tracker->record_free(ptr);
+    }
+  }
+
+  /// Records an allocation of `bytes` at address `ptr` for subsystem `s`
+  void record_alloc(const void* ptr, std::size_t bytes, Subsystem s);
+
+  /// Records the deallocation of the memory at `ptr`. Untracked or null pointers are ignored.
+  void record_free(const void* ptr);
+
+  /// Returns the subsystem currently active on the calling thread
+  static Subsystem current_subsystem();
+
+  /// Sets the active subsystem on the calling thread and returns the previously active subsystem
+  static Subsystem set_current_subsystem(Subsystem s);
+
+  /// Returns the name of subsystem `s`
+  static const char* subsystem_name(Subsystem s);
+
+  /// Resets the high-water marks to the amounts currently allocated
+  void reset_peaks();
+
+  /// Sets the memory budget in MB; a zero value means no budget
+  void set_budget(double budget_mb);
+
+  /// Returns true if the total amount of memory exceeded the budget since the last `reset_peaks` 
+  bool budget_exceeded() const
+  {
+    return budget_exceeded_;
+  }
+
+  /// Bytes currently allocated for subsystem `s`
+  std::size_t current_bytes(Subsystem s) const
+  {
+    return current_[s];
+  }
+
+  /// High-water mark in bytes of subsystem `s`
+  std::size_t peak_bytes(Subsystem s) const
+  {
+    return peak_[s];
+  }
+
+  /// Bytes currently allocated by all subsystems
+  std::size_t current_bytes_total() const
+  {
+    return current_total_;
+  }
+
+  /// High-water mark in bytes of the total memory
+  std::size_t peak_bytes_total() const
+  {
+    return peak_total_;
+  }
+
+  /// Returns a report with the current amounts and the high-water marks for each subsystem
+  std::string get_summary() const;
+
+private:
+  hiopMemoryTracker(const hiopMemoryTracker&) = delete;
+  hiopMemoryTracker& operator=(const hiopMemoryTracker&) = delete;
+
+  struct AllocRecord
+  {
+    std::size_t bytes;
+    Subsystem subsystem;
+  };
+
+  /// size and subsystem of each live allocation
+  std::unordered_map<const void*, AllocRecord> allocs_;
+  
+  std::size_t current_[NumSubsystems];
+  std::size_t peak_[NumSubsystems];
+  std::size_t current_total_;
+  std::size_t peak_total_;
+
+  /// memory budget in bytes (0 means no budget)
+  std::size_t budget_;
+  bool budget_exceeded_;
+};
+
+/**
+ * @brief Makes a tracker (or none, for a nullptr) active on the calling thread for the lifetime of the object.
+ * The previously active tracker is restored on destruction.
+ */
+class hiopMemoryTrackerActivation
+{
+public:
+  hiopMemoryTrackerActivation(hiopMemoryTracker* tracker)
+    : prev_(hiopMemoryTracker::set_active(tracker))
+  {
+  }
+  ~hiopMemoryTrackerActivation()
+  {
+    hiopMemoryTracker::set_active(prev_);
+  }
+private:
+  hiopMemoryTrackerActivation(const hiopMemoryTrackerActivation&) = delete;
+  hiopMemoryTrackerActivation& operator=(const hiopMemoryTrackerActivation&) = delete;
+  hiopMemoryTracker* prev_;
+};
+
+/**
+ * @brief Selects the active subsystem of the memory tracker for the lifetime of the object. The previously
+ * active subsystem is restored on destruction, so that scopes can be nested.
+ */
+class hiopMemoryTrackerScope
+{
+public:
+  hiopMemoryTrackerScope(hiopMemoryTracker::Subsystem s)
+    : prev_(hiopMemoryTracker::set_current_subsystem(s))
+  {
+  }
+  ~hiopMemoryTrackerScope()
+  {
+    hiopMemoryTracker::set_current_subsystem(prev_);
+  }
+private:
+  hiopMemoryTrackerScope(const hiopMemoryTrackerScope&) = delete;
+  hiopMemoryTrackerScope& operator=(const hiopMemoryTrackerScope&) = delete;
+  hiopMemoryTracker::Subsystem prev_;
+};
+
+} // end of namespace
+#endif
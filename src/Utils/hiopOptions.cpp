@@ -249,6 +249,29 @@ bool hiopOptions::is_user_defined(const char* option_name)
   return (it->second->specifiedInFile || it->second->specifiedAtRuntime);
 }
 
+void hiopOptions::copy_from(const hiopOptions& other)
+{
+  for(auto& it_other : other.mOptions_) {
+    const Option* opt_other = it_other.second;
+    map<string, Option*>::iterator it = mOptions_.find(it_other.first);
+    if(it==mOptions_.end()) {
+      assert(false && "options objects of different types");
+      continue;
+    }
+    Option* opt = it->second;
+    if(auto* opt_num = dynamic_cast<OptionNum*>(opt)) {
+      opt_num->val = dynamic_cast<const OptionNum*>(opt_other)->val;
+    } else if(auto* opt_int = dynamic_cast<OptionInt*>(opt)) {
+      opt_int->val = dynamic_cast<const OptionInt*>(opt_other)->val;
+    } else if(auto* opt_str = dynamic_cast<OptionStr*>(opt)) {
+      opt_str->val = dynamic_cast<const OptionStr*>(opt_other)->val;
+    }
+    opt->specifiedInFile = opt_other->specifiedInFile;
+    opt->specifiedAtRuntime = opt_other->specifiedAtRuntime;
+  }
+  ensure_consistence();
+}
+
 bool hiopOptions::set_val(const char* name, const double& value)
 {
   map<string, Option*>::iterator it = mOptions_.find(name);
@@ -702,6 +725,18 @@ void hiopOptionsNLP::register_options()
                         "fixed_var_perturb (default 1e-8)");
   }
 
+  // presolve
+  {
+    vector<string> range(2); range[0] = "no"; range[1] = "yes";
+    register_str_option("presolve",
+                        "no",
+                        range,
+                        "Presolve of the linear constraints of sparse NLPs: empty constraints and duplicate "
+                        "constraints are removed and singleton constraints are turned into bounds of the "
+                        "variables (default no). Value 'yes' is available only when 'compute_mode' is "
+                        "'hybrid' or 'cpu'.");
+  }
+
   // warm_start
   {
     vector<string> range(2); range[0] = "no"; range[1] = "yes";
@@ -711,6 +746,43 @@ void hiopOptionsNLP::register_options()
                         "Wart start from the user provided primal-dual point. (default no)");    
   }
 
+  register_num_option("warm_start_bound_push",
+                      1e-9,
+                      0.,
+                      1e-1,
+                      "Amount by which the primals of a saved solver state are pushed inside the bounds "
+                      "when warm starting from it (default 1e-9)");
+
+  register_num_option("warm_start_mult_bound_push",
+                      1e-9,
+                      0.,
+                      1e-1,
+                      "Lower bound on the bound multipliers of a saved solver state when warm starting "
+                      "from it (default 1e-9)");
+
+  // checkpointing
+  {
+    vector<string> range(2); range[0]="no"; range[1]="yes";
+    register_str_option("checkpoint_save",
+                        "no",
+                        range,
+                        "Save the state of the solver to a checkpoint file every 'checkpoint_save_N' "
+                        "iterations (default no)");
+    register_int_option("checkpoint_save_N",
+                        10,
+                        1,
+                        1e+6,
+                        "Number of iterations between two checkpoints (default 10)");
+    register_str_option("checkpoint_file",
+                        "hiop_state_chkpnt",
+                        "Path of the checkpoint file; with more than one MPI rank each rank uses its own "
+                        "file, with the rank appended to the path (default hiop_state_chkpnt)");
+    register_str_option("checkpoint_load_on_start",
+                        "no",
+                        range,
+                        "Resume from the checkpoint 'checkpoint_file' if it exists (default no)");
+  }
+
   // scaling
   {
     vector<string> range(2); range[0]="none"; range[1]="gradient";
@@ -779,6 +851,37 @@ void hiopOptionsNLP::register_options()
                         "Type of Hessian used with the filter IPM: 'quasinewton_approx' built internally "
                         "by HiOp (default option) or 'analytical_exact' provided by the user");
   }
+
+  //finite-difference derivatives for the sparse NLPs
+  {
+    vector<string> range {"no", "yes"};
+    register_str_option("fd_jacobian",
+                        "no",
+                        range,
+                        "Approximate the values of the sparse Jacobian of the constraints by finite differences "
+                        "of the constraints: 'no' (default) or 'yes'. The sparsity pattern is still provided by "
+                        "the user and is colored such that the cost is one constraints evaluation per color.");
+    register_str_option("fd_hessian",
+                        "no",
+                        range,
+                        "Approximate the values of the sparse Hessian of the Lagrangian by finite differences "
+                        "of the gradient of the Lagrangian: 'no' (default) or 'yes', in which case "
+                        "'Hessian=analytical_exact' is used. The sparsity pattern is still provided by the user. "
+                        "It cannot be used with 'fd_jacobian=yes' when there are nonlinear constraints.");
+    register_num_option("fd_rel_step",
+                        1e-7,
+                        1e-12,
+                        1e-2,
+                        "Relative perturbation of the variables for the finite-difference derivatives "
+                        "(default 1e-7).");
+    register_int_option("fd_num_threads",
+                        1,
+                        1,
+                        1024,
+                        "Number of threads evaluating the perturbations of the finite-difference derivatives "
+                        "(default 1). With more than one thread, the user's function evaluations should "
+                        "be thread safe.");
+  }
   //linear algebra
   {
     vector<string> range = {"auto", "xycyd", "xdycyd", "full", "condensed"};
@@ -792,6 +895,25 @@ void hiopOptionsNLP::register_options()
                         "'Hessian=analyticalExact'.");
   }
 
+  //equilibration of the KKT linear system
+  {
+    vector<string> range {"none", "ruiz"};
+    register_str_option("kkt_equilibration",
+                        "none",
+                        range,
+                        "Symmetric equilibration of the compressed KKT matrix before it is factorized: 'none' "
+                        "(default) or 'ruiz', which scales the rows and columns to unit infinity norm. Used by "
+                        "the 'XYcYd' and 'XDYcYd' KKT linear systems of the dense, MDS, and sparse NLPs and "
+                        "available only when 'mem_space' is 'default'.");
+    register_num_option("kkt_equilibration_drift",
+                        10.,
+                        1.5,
+                        1e+6,
+                        "The equilibration scaling of the KKT matrix is reused as long as the rows of the "
+                        "scaled matrix have infinity norm within this factor of one; otherwise it is "
+                        "recomputed (default 10).");
+  }
+
   //
   // choose direct linear solver for sparse linear system on CPU
   //
@@ -817,7 +939,9 @@ void hiopOptionsNLP::register_options()
     register_str_option("duals_init_linear_solver_sparse",
                         "auto",
                         range,
-                        "Selects among MA57, PARDISO, cuSOLVER, and STRUMPACK for the sparse linear solves.");
+                        "Selects among MA57, PARDISO, cuSOLVER, and STRUMPACK for the sparse linear solves. "
+                        "Not used with 'KKTLinsys xdycyd' and the Newton IPM, in which case the initial duals "
+                        "are computed by the linear solver of the KKT (see 'linear_solver_sparse').");
   }
 
   // choose sparsity permutation (to reduce nz in the factors). This option is available only when using
@@ -980,6 +1104,30 @@ void hiopOptionsNLP::register_options()
                         "no", // default value for the option
                         vector<string>({"yes", "no"}), // range
                         "prints options before algorithm starts (default 'no')");
+    register_str_option("log_async",
+                        "no",
+                        vector<string>({"no", "yes"}),
+                        "Write the output through a background thread so that the iterations do not wait on I/O "
+                        "(default 'no')");
+    register_str_option("log_format",
+                        "text",
+                        vector<string>({"text", "keyvalue"}),
+                        "Format of the output: human-readable 'text' or machine-parsable 'keyvalue' records "
+                        "with timestamps and MPI rank (default 'text')");
+
+    register_str_option("memory_tracking",
+                        "no",
+                        vector<string>({"no", "yes"}),
+                        "Track the memory of HiOp's linear algebra objects and linear solvers per subsystem and "
+                        "report the high-water marks in the run summary; always on when 'memory_budget' is "
+                        "set (default 'no')");
+    register_num_option("memory_budget",
+                        0.,
+                        0.,
+                        1e+20,
+                        "Memory budget in MB for HiOp's linear algebra objects and linear solvers on each MPI rank. "
+                        "The solver stops with a per-subsystem memory report once the budget is exceeded. "
+                        "A zero value means no budget (default 0)");
   }
   
   // memory space selection
@@ -998,6 +1146,17 @@ void hiopOptionsNLP::register_options()
                         range[0],
                         range,
                         "Determines the memory space in which future linear algebra objects will be created");
+
+    register_str_option("mem_space_pool",
+                        "no",
+                        vector<string>({"no", "yes"}),
+                        "Recycle the host memory of the linear algebra objects through a pool with size classes, "
+                        "which reduces the allocation overhead of repeated solves (default 'no')");
+    register_num_option("mem_space_pool_max_cached",
+                        1024.,
+                        0.,
+                        1e+20,
+                        "Max amount of memory in MB kept by the host memory pool for reuse (default 1024)");
   }
 }
 
@@ -1016,6 +1175,16 @@ void hiopOptionsNLP::ensure_consistence()
     }
   }
 
+  if(GetString("fd_hessian")=="yes" && GetString("Hessian")!="analytical_exact") {
+    if(is_user_defined("Hessian")) {
+      log_printf(hovWarning,
+                 "The option 'Hessian=%s' is not valid with 'fd_hessian=yes'. Will use "
+                 "'Hessian=analytical_exact'.\n",
+                 GetString("Hessian").c_str());
+    }
+    set_val("Hessian", "analytical_exact");
+  }
+
   if(GetString("Hessian")=="quasinewton_approx") {
     string strKKT = GetString("KKTLinsys");
     if(strKKT=="xycyd" || strKKT=="xdycyd" || strKKT=="full") {
@@ -1090,6 +1259,18 @@ void hiopOptionsNLP::ensure_consistence()
   }
 #endif
 
+  // The KKT equilibration works on matrices in the host memory
+  if(GetString("kkt_equilibration")!="none" && GetString("mem_space")!="default") {
+    if(is_user_defined("kkt_equilibration")) {
+      log_printf(hovWarning,
+                 "option kkt_equilibration=%s was changed to 'none' since it is not supported with "
+                 "mem_space=%s.\n",
+                 GetString("kkt_equilibration").c_str(),
+                 GetString("mem_space").c_str());
+    }
+    set_val("kkt_equilibration", "none");
+  }
+
   // No hybrid or GPU compute mode if HiOp is built without GPU linear solvers
 #ifndef HIOP_USE_GPU
   if(GetString("compute_mode")=="hybrid") {
@@ -1111,7 +1292,7 @@ void hiopOptionsNLP::ensure_consistence()
   }
 #endif
   
-  // No removing of fixed variables in GPU compute mode ...
+  // No removing of fixed variables and no presolve in GPU compute mode ...
   if(GetString("compute_mode")=="gpu") {
     if(GetString("fixed_var")=="remove") {
       
@@ -1120,6 +1301,12 @@ void hiopOptionsNLP::ensure_consistence()
                  "is supported in GPU compute mode.\n");
       set_val("fixed_var", "relax");
     }
+    if(GetString("presolve")=="yes") {
+      log_printf(hovWarning,
+                 "option presolve=yes was changed to 'no' since presolve is not supported in GPU "
+                 "compute mode.\n");
+      set_val("presolve", "no");
+    }
   }
 
 }
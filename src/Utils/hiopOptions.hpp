@@ -150,6 +150,10 @@ public:
   //Returns true if an option was set by the user (via options file or at runtime) or false if the option was not set
   //by the user or cannot be found
   virtual bool is_user_defined(const char* option_name);
+
+  //Copies the values of the options in 'other', including whether they were set by the user, into this 
+  //object. Both objects should be of the same type.
+  void copy_from(const hiopOptions& other);
 protected:
   void log_printf(hiopOutVerbosity v, const char* format, ...);
 
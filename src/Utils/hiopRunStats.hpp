@@ -99,6 +99,9 @@ public:
   /// Number of inertia corrections or regularizations
   int nUpdateICCorr;
 
+  /// Number of (re)computations of the equilibration scaling of the KKT matrix
+  int nEquilUpdates;
+
   /** 
    * Records time spent in compressing or decompressing rhs (or in other words, pre- and post-inner solve). Should
    * not include rhs manipulations done in the inner solve, which are recorded by `tmSolveInner`.
@@ -149,6 +152,8 @@ public:
   double tmTotalResid;
   /// Total number of inner IR steps
   double nTotalIterRefinInner;
+  /// Total number of (re)computations of the equilibration scaling
+  int nTotalEquilUpdates;
   
   inline void initialize() {
     tmTotalPerIter.reset();
@@ -156,6 +161,7 @@ public:
     tmUpdateLinsys.reset();
     tmUpdateInnerFact.reset();
     nUpdateICCorr = 0;
+    nEquilUpdates = 0;
     tmSolveRhsManip.reset();
     tmSolveInner.reset();
     tmResid.reset();
@@ -169,6 +175,7 @@ public:
     tmTotalSolveInner = 0.;
     tmTotalResid = 0.;
     nTotalIterRefinInner = 0.;
+    nTotalEquilUpdates = 0;
   }
 
   inline void start_optimiz_iteration()
@@ -180,6 +187,7 @@ public:
     tmUpdateLinsys.reset();
     tmUpdateInnerFact.reset();
     nUpdateICCorr = 0;
+    nEquilUpdates = 0;
     tmSolveRhsManip.reset();
     tmSolveInner.reset();
     tmResid.reset();
@@ -197,6 +205,7 @@ public:
     tmTotalSolveInner += tmSolveInner.getElapsedTime();
     tmTotalResid += tmResid.getElapsedTime();
     nTotalIterRefinInner += nIterRefinInner;
+    nTotalEquilUpdates += nEquilUpdates;
   }
   inline std::string get_summary_last_iter() {
     std::stringstream ss;
@@ -207,7 +216,8 @@ public:
     ss << "\tupdate init " << std::setprecision(3) << tmUpdateInit.getElapsedTime() << " sec "
        << "update linsys " << tmUpdateLinsys.getElapsedTime() << " sec " 
        << "fact " << tmUpdateInnerFact.getElapsedTime() << " sec " 
-       << "inertia corrections " << nUpdateICCorr << std::endl;
+       << "inertia corrections " << nUpdateICCorr << " "
+       << "equilibrations " << nEquilUpdates << std::endl;
 
     ss << "\tsolve rhs-manip " <<tmSolveRhsManip.getElapsedTime() << " sec "
        << "inner solve " << tmSolveInner.getElapsedTime() << " sec "
@@ -223,7 +233,8 @@ public:
 
     ss << "\tupdate init " << std::setprecision(3) << tmTotalUpdateInit <<  " sec "
        << "   update linsys " << tmTotalUpdateLinsys << " sec " 
-       << "   fact " << tmTotalUpdateInnerFact << " sec " << std::endl;
+       << "   fact " << tmTotalUpdateInnerFact << " sec "
+       << "   equilibrations " << nTotalEquilUpdates << std::endl;
 
     ss << "\tsolve rhs-manip " <<tmTotalSolveRhsManip << " sec "
        << "  inner solve " << tmTotalSolveInner << " sec "
@@ -394,6 +394,62 @@ public:
     return reduceReturn(fail, &A);
   }
 
+  /*
+   *  upper triangle of W = alpha * [this; X] * [this; X]^T
+   *
+   *  A: mxn
+   *  X: kxn
+   *  W: (m+k)x(m+k) local
+   *
+   */
+  int matrixStackedGramToSymDenseMatrixUpperTriangle(
+      hiop::hiopMatrixDense& A,
+      hiop::hiopMatrixDense& X,
+      hiop::hiopMatrixDense& W,
+      const int rank)
+  {
+    const local_ordinal_type A_M = getNumLocRows(&A);
+    const local_ordinal_type X_M = getNumLocRows(&X);
+    assert(getNumLocCols(&A) == getNumLocCols(&X)       && "Matrices have mismatched sizes");
+    assert(getNumLocRows(&W) == A_M + X_M                && "Matrices have mismatched sizes");
+    assert(getNumLocCols(&W) == getNumLocRows(&W)       && "Matrices have mismatched sizes");
+    const real_type A_val = two,
+          X_val = three,
+          W_val = one,
+          alpha = half;
+    const real_type Nglob = static_cast<real_type>(A.n());
+
+    A.setToConstant(A_val);
+    X.setToConstant(X_val);
+    W.setToConstant(W_val);
+
+    // Set a row of X to zero
+    local_ordinal_type idx_of_zero_row = X_M - 1;
+    setLocalRow(&X, idx_of_zero_row, zero);
+
+    A.stackedGramToSymDenseMatrixUpperTriangle(alpha, X, W);
+
+    // Row and column of W corresponding to the zero row of X
+    local_ordinal_type idx_of_zero = A_M + idx_of_zero_row;
+    int fail = verifyAnswer(&W,
+      [=] (local_ordinal_type i, local_ordinal_type j) -> real_type
+      {
+        if(j < i) {
+          // the strictly lower triangle is not accessed
+          return W_val;
+        }
+        if(i == idx_of_zero || j == idx_of_zero) {
+          return zero;
+        }
+        const real_type left = i < A_M ? A_val : X_val;
+        const real_type right = j < A_M ? A_val : X_val;
+        return alpha * left * right * Nglob;
+      });
+
+    printMessage(fail, __func__, rank);
+    return reduceReturn(fail, &A);
+  }
+
   /*
    * this += alpha * diag
    */
@@ -621,6 +677,25 @@ public:
    * Set bottom right value to ensure that all values
    * are checked.
    */
+  /**
+   * @brief Verify that setUpperTriangleToZero zeroes the upper triangle (including the diagonal)
+   * and leaves the strictly lower triangle untouched.
+   */
+  int matrixSetUpperTriangleToZero(hiop::hiopMatrixDense& A, const int rank=0)
+  {
+    assert(A.m() == A.n());
+    A.setToConstant(two);
+    A.setUpperTriangleToZero();
+
+    const int fail = verifyAnswer(&A, [=](int i, int j)
+    {
+      return j < i ? two : zero;
+    });
+
+    printMessage(fail, __func__, rank);
+    return reduceReturn(fail, &A);
+  }
+
   int matrixMaxAbsValue(
       hiop::hiopMatrixDense& A,
       const int rank)
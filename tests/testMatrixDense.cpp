@@ -214,6 +214,8 @@ static int runTests(const char* mem_space, MPI_Comm comm)
   hiopMatrixDense* A_mxn_nodist = LinearAlgebraFactory::create_matrix_dense(mem_space, M_local, N_local);
   hiopMatrixDense* A_nxn_nodist = LinearAlgebraFactory::create_matrix_dense(mem_space, N_local, N_local);
   hiopMatrixDense* B_nxn_nodist = LinearAlgebraFactory::create_matrix_dense(mem_space, N_local, N_local);
+  hiopMatrixDense* A_mkxmk_nodist =
+    LinearAlgebraFactory::create_matrix_dense(mem_space, M_local+K_local, M_local+K_local);
 
   // Vectors with shape of the form:
   // x_<size>_[non-distributed]
@@ -241,6 +243,7 @@ static int runTests(const char* mem_space, MPI_Comm comm)
     fail += test.matrixAddSubDiagonal(*A_nxn_nodist, *x_m_nodist);
     fail += test.matrixTransAddToSymDenseMatrixUpperTriangle(*A_nxn_nodist, *A_kxm_nodist);
     fail += test.matrixAddUpperTriangleToSymDenseMatrixUpperTriangle(*A_nxn_nodist, *A_mxm_nodist);
+    fail += test.matrixSetUpperTriangleToZero(*A_nxn_nodist);
 #ifdef HIOP_DEEPCHECKS
     fail += test.matrixAssertSymmetry(*A_nxn_nodist);
     fail += test.matrixOverwriteUpperTriangleWithLower(*A_nxn_nodist);
@@ -255,6 +258,7 @@ static int runTests(const char* mem_space, MPI_Comm comm)
 
   fail += test.matrixTransTimesMat(*A_mxk_nodist, *A_kxn, *A_mxn, rank);
   fail += test.matrixTimesMatTrans(*A_mxn, *A_mxk_nodist, *A_kxn, rank);
+  fail += test.matrixStackedGramToSymDenseMatrixUpperTriangle(*A_mxn, *A_kxn, *A_mkxmk_nodist, rank);
   fail += test.matrixAddMatrix(*A_mxn, *B_mxn, rank);
   fail += test.matrixMaxAbsValue(*A_mxn, rank);
   fail += test.matrix_row_max_abs_value(*A_mxn, *x_m_nodist, rank);
@@ -288,6 +292,7 @@ static int runTests(const char* mem_space, MPI_Comm comm)
   delete A_mxn_nodist;
   delete A_nxn_nodist;
   delete B_nxn_nodist;
+  delete A_mkxmk_nodist;
   delete x_n;
   delete x_n_nodist;
   delete x_m_nodist;